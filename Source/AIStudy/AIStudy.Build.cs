@@ -8,6 +8,9 @@ public class AIStudy : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "NavigationSystem" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "NavigationSystem", "Navmesh", "AIModule", "GameplayTasks", "MassEntity", "MassCommon", "AnimationBudgetAllocator", "ReplicationGraph", "NetCore" });
+
+		// Gameplay Debugger 카테고리 (WITH_GAMEPLAY_DEBUGGER)
+		SetupGameplayDebuggerSupport(Target);
 	}
 }
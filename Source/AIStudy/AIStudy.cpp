@@ -2,6 +2,84 @@
 
 #include "AIStudy.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/CoreDelegates.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, AIStudy, "AIStudy" );
- 
\ No newline at end of file
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "Debug_GameplayDebuggerCategory.h"
+#endif
+
+DEFINE_LOG_CATEGORY(LogAIStudy);
+
+DEFINE_STAT(STAT_AIStudy_ChasersIdle);
+DEFINE_STAT(STAT_AIStudy_ChasersSuspicious);
+DEFINE_STAT(STAT_AIStudy_ChasersChasing);
+DEFINE_STAT(STAT_AIStudy_MoveToCalls);
+DEFINE_STAT(STAT_AIStudy_FailedMoves);
+DEFINE_STAT(STAT_AIStudy_PerceptionEvents);
+
+#if COUNTERSTRACE_ENABLED
+TRACE_DECLARE_INT_COUNTER(AIStudy_ChasersIdle, TEXT("AIStudy/Chasers Idle"));
+TRACE_DECLARE_INT_COUNTER(AIStudy_ChasersSuspicious, TEXT("AIStudy/Chasers Suspicious"));
+TRACE_DECLARE_INT_COUNTER(AIStudy_ChasersChasing, TEXT("AIStudy/Chasers Chasing"));
+TRACE_DECLARE_INT_COUNTER(AIStudy_MoveToCalls, TEXT("AIStudy/MoveTo Calls"));
+TRACE_DECLARE_INT_COUNTER(AIStudy_FailedMoves, TEXT("AIStudy/Failed Moves"));
+TRACE_DECLARE_INT_COUNTER(AIStudy_PerceptionEvents, TEXT("AIStudy/Perception Events"));
+
+int32 FAIStudyTraceCounters::Values[static_cast<int32>(EAIStudyCounter::MAX)] = {};
+
+void FAIStudyTraceCounters::Flush()
+{
+	TRACE_COUNTER_SET(AIStudy_ChasersIdle, Values[static_cast<int32>(EAIStudyCounter::ChasersIdle)]);
+	TRACE_COUNTER_SET(AIStudy_ChasersSuspicious, Values[static_cast<int32>(EAIStudyCounter::ChasersSuspicious)]);
+	TRACE_COUNTER_SET(AIStudy_ChasersChasing, Values[static_cast<int32>(EAIStudyCounter::ChasersChasing)]);
+	TRACE_COUNTER_SET(AIStudy_MoveToCalls, Values[static_cast<int32>(EAIStudyCounter::MoveToCalls)]);
+	TRACE_COUNTER_SET(AIStudy_FailedMoves, Values[static_cast<int32>(EAIStudyCounter::FailedMoves)]);
+	TRACE_COUNTER_SET(AIStudy_PerceptionEvents, Values[static_cast<int32>(EAIStudyCounter::PerceptionEvents)]);
+
+	for (int32& Value : Values)
+	{
+		Value = 0;
+	}
+}
+#endif
+
+class FAIStudyModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if COUNTERSTRACE_ENABLED
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FAIStudyTraceCounters::Flush);
+#endif
+
+#if WITH_GAMEPLAY_DEBUGGER
+		// 아포스트로피(') 키 → 5번 슬롯 AIStudy 카테고리. 꺼진 채로 등록해 숫자 키로 켜기 전까지 비용이 없다
+		IGameplayDebugger& GameplayDebugger = IGameplayDebugger::Get();
+		GameplayDebugger.RegisterCategory(TEXT("AIStudy"), IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_AIStudy::MakeInstance),
+			EGameplayDebuggerCategoryState::Disabled, 5);
+		GameplayDebugger.NotifyCategoriesChanged();
+#endif
+	}
+
+	virtual void ShutdownModule() override
+	{
+#if COUNTERSTRACE_ENABLED
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+#endif
+
+#if WITH_GAMEPLAY_DEBUGGER
+		if (IGameplayDebugger::IsAvailable())
+		{
+			IGameplayDebugger& GameplayDebugger = IGameplayDebugger::Get();
+			GameplayDebugger.UnregisterCategory(TEXT("AIStudy"));
+			GameplayDebugger.NotifyCategoriesChanged();
+		}
+#endif
+	}
+
+private:
+	FDelegateHandle EndFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FAIStudyModule, AIStudy, "AIStudy" );
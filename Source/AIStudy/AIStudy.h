@@ -3,3 +3,67 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+// AIStudy 모듈 공용 로그 카테고리
+DECLARE_LOG_CATEGORY_EXTERN(LogAIStudy, Log, All);
+
+// `stat AIStudy` 로 확인하는 모듈 전용 스탯 그룹
+DECLARE_STATS_GROUP(TEXT("AIStudy"), STATGROUP_AIStudy, STATCAT_Advanced);
+
+// 스탯이 있는 구성에서는 사이클 스탯(Insights에도 같은 이름으로 기록),
+// 스탯이 빠지는 Test/Shipping에서는 CPU 프로파일러 트레이스 스코프로 대체한다.
+// 둘 다 컴파일에서 빠지면 아무 코드도 남지 않는다.
+#if STATS
+#define AISTUDY_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define AISTUDY_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
+
+// 여러 파일에서 올리는 프레임 단위 카운터
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Chasers Idle"), STAT_AIStudy_ChasersIdle, STATGROUP_AIStudy, AISTUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Chasers Suspicious"), STAT_AIStudy_ChasersSuspicious, STATGROUP_AIStudy, AISTUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Chasers Chasing"), STAT_AIStudy_ChasersChasing, STATGROUP_AIStudy, AISTUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("MoveTo Calls"), STAT_AIStudy_MoveToCalls, STATGROUP_AIStudy, AISTUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Failed Moves"), STAT_AIStudy_FailedMoves, STATGROUP_AIStudy, AISTUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Perception Events"), STAT_AIStudy_PerceptionEvents, STATGROUP_AIStudy, AISTUDY_API);
+
+#if COUNTERSTRACE_ENABLED
+// 트레이스 카운터는 프레임마다 초기화되지 않으므로 프레임 동안 모았다가 프레임 끝에 한 번에 기록한다
+enum class EAIStudyCounter : uint8
+{
+	ChasersIdle,
+	ChasersSuspicious,
+	ChasersChasing,
+	MoveToCalls,
+	FailedMoves,
+	PerceptionEvents,
+	MAX
+};
+
+struct AISTUDY_API FAIStudyTraceCounters
+{
+	static void Add(EAIStudyCounter Counter, int32 Amount) { Values[static_cast<int32>(Counter)] += Amount; }
+	// FCoreDelegates::OnEndFrame에서 호출
+	static void Flush();
+
+private:
+	static int32 Values[static_cast<int32>(EAIStudyCounter::MAX)];
+};
+
+#define AISTUDY_TRACE_COUNTER_ADD(Counter, Amount) FAIStudyTraceCounters::Add(EAIStudyCounter::Counter, Amount)
+#else
+#define AISTUDY_TRACE_COUNTER_ADD(Counter, Amount)
+#endif
+
+// 프레임 카운터 증가 (stat AIStudy와 Insights 양쪽)
+#define AISTUDY_INC_COUNTER_BY(Counter, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_AIStudy_##Counter, Amount); \
+		AISTUDY_TRACE_COUNTER_ADD(Counter, Amount); \
+	} while (0)
+
+#define AISTUDY_INC_COUNTER(Counter) AISTUDY_INC_COUNTER_BY(Counter, 1)
@@ -11,13 +11,27 @@
 #include "Kismet/GameplayStatics.h" // 이하 헤더추가
 #include "NavigationSystem.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "Path_RequestSubsystem.h"
+#include "TargetPoint_RegistrySubsystem.h"
+#include "Nav_PredictiveInvokerComponent.h"
+#include "Agent_BudgetedMeshComponent.h"
+#include "Agent_MovementComponent.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "AIStudy.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
+DECLARE_CYCLE_STAT(TEXT("Find Target Points"), STAT_AIStudyCharacter_FindTargetPoints, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("AIStudyCharacter MoveToTarget"), STAT_AIStudyCharacter_MoveToTarget, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("AIStudyCharacter OnMoveCompleted"), STAT_AIStudyCharacter_OnMoveCompleted, STATGROUP_AIStudy);
+
 //////////////////////////////////////////////////////////////////////////
 // AAIStudyCharacter
 
-AAIStudyCharacter::AAIStudyCharacter()
+AAIStudyCharacter::AAIStudyCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UAgent_MovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<UAgent_BudgetedMeshComponent>(ACharacter::MeshComponentName))
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
@@ -60,6 +74,9 @@ AAIStudyCharacter::AAIStudyCharacter()
 	// SetGenerationRadii 함수를 사용하여 생성 반경과 제거 반경 설정
 	NavInvoker->SetGenerationRadii(NavGenerationRadius, NavRemovalRadius);
 
+	// 예측 인보커 (bUsePredictiveNavInvoker일 때 BeginPlay에서 활성화)
+	PredictiveNavInvoker = CreateDefaultSubobject<UNav_PredictiveInvokerComponent>(TEXT("PredictiveNavInvoker"));
+
 	// AI Modifier 테스트 관련 변수 초기화
 	bIsSucceeded = false;
 	bIsMoving = false;
@@ -74,12 +91,56 @@ void AAIStudyCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// 메시가 할당기에 등록된 뒤에 플레이어 메시를 건너뛰지 않게 표시한다 (BeginPlay 전에 빙의된 경우)
+	if (IsPlayerControlled())
+	{
+		if (UAgent_BudgetedMeshComponent* BudgetedMesh = Cast<UAgent_BudgetedMeshComponent>(GetMesh()))
+		{
+			BudgetedMesh->MarkPlayerControlled();
+		}
+	}
+
+	if (bUsePredictiveNavInvoker && PredictiveNavInvoker)
+	{
+		PredictiveNavInvoker->Activate();
+	}
+
+	StartPatrol();
+}
+
+void AAIStudyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+	{
+		Significance->UnregisterAgent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAIStudyCharacter::StartPatrol()
+{
 	// AI 컨트롤러 찾기
 	AIController = Cast<AAIController>(GetController());
 
 	// AI 컨트롤러가 없으면 자동으로 생성하지 않음 (필요시 생성 코드 추가)
 	if (AIController)
 	{
+		// 플레이어가 조종하는 캐릭터는 빼고 AI 순찰자만 LOD/애니메이션 예산 대상으로 등록
+		if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+		{
+			Significance->RegisterAgent(this);
+		}
+
+		// 플레이어와 같은 클래스라 복제 속성은 그대로 두고, AI일 때만 이동 복제 양자화를 거칠게 한다 (cm 정수, 바이트 회전)
+		if (HasAuthority())
+		{
+			FRepMovement& RepMovement = GetReplicatedMovement_Mutable();
+			RepMovement.LocationQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+			RepMovement.VelocityQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+			RepMovement.RotationQuantizationLevel = ERotatorQuantization::ByteComponents;
+		}
+
 		// 디버깅 에러 방지를 위해 언비인딩 코드 실행
 		AIController->ReceiveMoveCompleted.RemoveDynamic(this, &AAIStudyCharacter::OnMoveCompleted);
 		// 이동 완료 이벤트 델리게이트 바인딩
@@ -91,6 +152,56 @@ void AAIStudyCharacter::BeginPlay()
 	}
 }
 
+void AAIStudyCharacter::OnPoolAcquired()
+{
+	// 내비 인보커를 다시 등록해 주변 타일 생성을 요청
+	NavInvoker->Activate();
+	if (bUsePredictiveNavInvoker && PredictiveNavInvoker)
+	{
+		PredictiveNavInvoker->Activate();
+	}
+
+	StartPatrol();
+}
+
+void AAIStudyCharacter::OnPoolReleased()
+{
+	// 재시도 타이머가 남아 있으면 풀에 있는 동안 이동을 다시 시작하므로 지운다
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	if (AIController)
+	{
+		if (UPath_RequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+		{
+			PathRequests->CancelRequest(AIController);
+		}
+		AIController->StopMovement();
+		AIController->ReceiveMoveCompleted.RemoveDynamic(this, &AAIStudyCharacter::OnMoveCompleted);
+	}
+
+	if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+	{
+		Significance->UnregisterAgent(this);
+	}
+
+	// 풀에 있는 동안 타일을 붙잡고 있지 않도록 인보커 등록 해제
+	NavInvoker->Deactivate();
+	if (PredictiveNavInvoker)
+	{
+		PredictiveNavInvoker->Deactivate();
+	}
+
+	// 클래스 기본값으로 되돌린다
+	const AAIStudyCharacter* Defaults = GetClass()->GetDefaultObject<AAIStudyCharacter>();
+	Target = Defaults->Target;
+	Target2 = Defaults->Target2;
+	bIsSucceeded = Defaults->bIsSucceeded;
+	PatrolGroup = Defaults->PatrolGroup;
+	bUsePredictiveNavInvoker = Defaults->bUsePredictiveNavInvoker;
+	bUsePathRequestScheduler = Defaults->bUsePathRequestScheduler;
+	bIsMoving = false;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // AI Modifier Texst 인풋 로직 구현 (Invoker로직에서 수정)
 
@@ -105,6 +216,12 @@ void AAIStudyCharacter::NotifyControllerChanged()
 		{
 			Subsystem->AddMappingContext(DefaultMappingContext, 0);
 		}
+
+		// 플레이어 애니메이션은 예산 할당기가 줄이지 않게 한다
+		if (UAgent_BudgetedMeshComponent* BudgetedMesh = Cast<UAgent_BudgetedMeshComponent>(GetMesh()))
+		{
+			BudgetedMesh->MarkPlayerControlled();
+		}
 	}
 	else // Input Mapping Context가 없는 경우(AI인 경우) 컨트롤러 추가.
 	{
@@ -184,6 +301,27 @@ void AAIStudyCharacter::FindTargetPoints()
 	// 여기서는 역논리 연산자가 bool 변수 앞에 붙어있으므로 bool변수가 하나라도 false 일 경우 True로 판정합니다.
 	if (!Target || !Target2) 
 	{
+		AISTUDY_SCOPE_CYCLE_COUNTER(STAT_AIStudyCharacter_FindTargetPoints);
+
+		// 레지스트리가 있으면 액터 전체 순회 없이 그룹에서 바로 가져온다
+		if (const UTargetPoint_RegistrySubsystem* Registry = GetWorld()->GetSubsystem<UTargetPoint_RegistrySubsystem>())
+		{
+			ATargetPoint* First = nullptr;
+			ATargetPoint* Second = nullptr;
+			if (Registry->GetPatrolPair(PatrolGroup, First, Second))
+			{
+				Target = First;
+				Target2 = Second;
+				UE_LOG(LogTemplateCharacter, Display, TEXT("Found TargetPoints: %s and %s"),
+					*Target->GetName(), *Target2->GetName());
+			}
+			else
+			{
+				UE_LOG(LogTemplateCharacter, Warning, TEXT("Not enough TargetPoints found in group %s, need at least 2!"), *PatrolGroup.ToString());
+			}
+			return;
+		}
+
 		TArray<AActor*> FoundTargets;
 		UGameplayStatics::GetAllActorsOfClass(GetWorld(), ATargetPoint::StaticClass(), FoundTargets);
 
@@ -210,6 +348,8 @@ void AAIStudyCharacter::StartMoving()
 
 void AAIStudyCharacter::MoveToTarget()
 {
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_AIStudyCharacter_MoveToTarget);
+
 	if (!AIController)
 	{
 		UE_LOG(LogTemplateCharacter, Error, TEXT("AIController is not valid! Make sure the character is possessed by an AIController."));
@@ -228,9 +368,22 @@ void AAIStudyCharacter::MoveToTarget()
 	if (SelectedTarget)
 	{
 		bIsMoving = true;
+		AISTUDY_INC_COUNTER(MoveToCalls);
 
 		// AI MoveTo 함수 호출
 		FVector TargetLocation = SelectedTarget->GetActorLocation();
+
+		// 스케줄러를 쓰면 결과는 OnPathRequestFinished로 비동기 전달
+		UPath_RequestSubsystem* PathRequests = bUsePathRequestScheduler ? GetWorld()->GetSubsystem<UPath_RequestSubsystem>() : nullptr;
+		if (PathRequests)
+		{
+			// 같은 두 지점을 오가므로 경로 캐시를 사용
+			PathRequests->RequestMoveToLocation(AIController, TargetLocation, AcceptanceRadius, EPathRequestPriority::Patrol,
+				FOnPathRequestFinished::CreateUObject(this, &AAIStudyCharacter::OnPathRequestFinished), true);
+			UE_LOG(LogTemplateCharacter, Display, TEXT("Requested path to %s"), *SelectedTarget->GetName());
+			return;
+		}
+
 		EPathFollowingRequestResult::Type MoveResult = AIController->MoveToLocation(
 			TargetLocation,
 			AcceptanceRadius,
@@ -242,6 +395,7 @@ void AAIStudyCharacter::MoveToTarget()
 
 		if (MoveResult == EPathFollowingRequestResult::Failed)
 		{
+			AISTUDY_INC_COUNTER(FailedMoves);
 			UE_LOG(LogTemplateCharacter, Warning, TEXT("Failed to start movement to target!"));
 			bIsMoving = false;
 		}
@@ -257,8 +411,24 @@ void AAIStudyCharacter::MoveToTarget()
 	}
 }
 
+void AAIStudyCharacter::OnPathRequestFinished(EPathFollowingRequestResult::Type Result)
+{
+	if (Result == EPathFollowingRequestResult::Failed)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("Failed to start movement to target!"));
+		bIsMoving = false;
+	}
+	else if (Result == EPathFollowingRequestResult::AlreadyAtGoal)
+	{
+		// 이동 없이 끝나 ReceiveMoveCompleted가 오지 않으므로 성공한 이동과 똑같이 처리
+		OnMoveCompleted(FAIRequestID::InvalidRequest, EPathFollowingResult::Success);
+	}
+}
+
 void AAIStudyCharacter::OnMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result)
 {
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_AIStudyCharacter_OnMoveCompleted);
+
 	bIsMoving = false;
 
 	// 이동 결과에 따라 IsSucceeded 값 토글
@@ -276,6 +446,7 @@ void AAIStudyCharacter::OnMoveCompleted(FAIRequestID RequestID, EPathFollowingRe
 	else
 	{
 		// 이동 실패
+		AISTUDY_INC_COUNTER(FailedMoves);
 		UE_LOG(LogTemplateCharacter, Warning, TEXT("Move failed with result: %d"), static_cast<int32>(Result));
 
 		// 실패 시에도 다시 시도
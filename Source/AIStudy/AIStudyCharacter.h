@@ -5,6 +5,7 @@
 #include "NavigationInvokerComponent.h"
 #include "AIController.h"
 #include "Engine/TargetPoint.h"
+#include "Agent_Poolable.h"
 #include "AIStudyCharacter.generated.h"
 
 class USpringArmComponent;
@@ -16,7 +17,7 @@ struct FInputActionValue;
 DECLARE_LOG_CATEGORY_EXTERN(LogTemplateCharacter, Log, All);
 
 UCLASS(config=Game)
-class AAIStudyCharacter : public ACharacter
+class AAIStudyCharacter : public ACharacter, public IAgent_Poolable
 {
 	GENERATED_BODY()
 	/** Camera boom positioning the camera behind the character */
@@ -28,6 +29,9 @@ class AAIStudyCharacter : public ACharacter
 	/** Navigation Invoker component */
 	UPROPERTY(BlueprintReadWrite, Category = Navigation, meta = (AllowPrivateAccess = "true"))
 	UNavigationInvokerComponent* NavInvoker;
+	/** Predictive navigation invoker component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Navigation, meta = (AllowPrivateAccess = "true"))
+	class UNav_PredictiveInvokerComponent* PredictiveNavInvoker;
 	/** MappingContext */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputMappingContext* DefaultMappingContext;
@@ -42,13 +46,16 @@ class AAIStudyCharacter : public ACharacter
 	UInputAction* LookAction;
 
 public:
-	AAIStudyCharacter();
+	AAIStudyCharacter(const FObjectInitializer& ObjectInitializer);
 
 	// 네비게이션 메시 반경 설정
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Navigation)
 	float NavGenerationRadius;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Navigation)
 	float NavRemovalRadius;
+	// true면 이동 경로를 따라 앞으로 도착할 타일의 내비메시 생성을 미리 요청
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Navigation)
+	bool bUsePredictiveNavInvoker = false;
 
 	// AI Modifier 테스트 관련 변수 및 함수
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
@@ -63,6 +70,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
 	float AcceptanceRadius = 50.0f;
 
+	// true면 MoveToLocation 대신 UPath_RequestSubsystem을 통해 비동기로 경로를 요청
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
+	bool bUsePathRequestScheduler = true;
+
 	UFUNCTION(BlueprintCallable, Category = "AI Movement")
 	void MoveToTarget();
 
@@ -77,6 +88,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI Movement")
 	void FindTargetPoints();
 
+	// 순찰 웨이포인트 그룹(TargetPoint 태그). None이면 레벨의 모든 TargetPoint에서 선택
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
+	FName PatrolGroup;
+
+	// IAgent_Poolable
+	virtual void OnPoolAcquired() override;
+	virtual void OnPoolReleased() override;
+
 protected:
 	/** Called for movement input */
 	void Move(const FInputActionValue& Value);
@@ -84,10 +103,17 @@ protected:
 	void Look(const FInputActionValue& Value);
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void NotifyControllerChanged() override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 private:
+	// 컨트롤러 캐싱, LOD 등록, 이동 완료 델리게이트 바인딩, 순찰 시작 (BeginPlay와 풀에서 꺼낼 때 공유)
+	void StartPatrol();
+
+	// 비동기 경로 요청 결과 처리 (실패 시 MoveToLocation 실패와 동일하게 처리)
+	void OnPathRequestFinished(EPathFollowingRequestResult::Type Result);
+
 	UPROPERTY()
 	AAIController* AIController;
 
@@ -101,4 +127,6 @@ public:
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
 	/** Returns NavInvoker subobject **/
 	FORCEINLINE class UNavigationInvokerComponent* GetNavInvoker() const { return NavInvoker; }
+	/** Returns PredictiveNavInvoker subobject **/
+	FORCEINLINE class UNav_PredictiveInvokerComponent* GetPredictiveNavInvoker() const { return PredictiveNavInvoker; }
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "Agent_BudgetedMeshComponent.h"
+#include "Benchmark_Metrics.h"
+#include "IAnimationBudgetAllocator.h"
+
+UAgent_BudgetedMeshComponent::UAgent_BudgetedMeshComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// 할당기의 기본 중요도 계산 대신 LOD 서브시스템이 넣어 주는 값을 쓴다
+	SetAutoCalculateSignificance(false);
+}
+
+void UAgent_BudgetedMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// 할당기가 건너뛴 프레임에는 불리지 않으므로 예산 효과가 그대로 지표에 나타난다
+	AISTUDY_BENCHMARK_SCOPE(Animation);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UAgent_BudgetedMeshComponent::MarkPlayerControlled()
+{
+	// 할당기 등록은 BeginPlay에서 되므로 그 전에 불리면 무시된다 (폰 BeginPlay에서 다시 부른다)
+	if (IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld()))
+	{
+		Allocator->SetComponentSignificance(this, 1.0f, true, true, false);
+	}
+}
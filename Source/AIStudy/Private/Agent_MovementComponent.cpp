@@ -0,0 +1,303 @@
+#include "Agent_MovementComponent.h"
+#include "Agent_NavFloorSubsystem.h"
+#include "RVO_ORCASubsystem.h"
+#include "Benchmark_Metrics.h"
+#include "AIStudy.h"
+#include "NavigationSystem.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lean NavWalking"), STAT_Agent_LeanNavWalking, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lean NavWalking Floor Fallbacks"), STAT_Agent_LeanFloorFallbacks, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lean NavWalking Sweeping"), STAT_Agent_LeanSweeping, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarLeanMovement(
+	TEXT("AIStudy.Movement.Lean"),
+	false,
+	TEXT("켜면 BeginPlay에서 모든 UAgent_MovementComponent를 가벼운 NavWalking으로 전환 (bUseLeanNavWalking과 같음, 플레이어 조종 폰 제외)"));
+
+void UAgent_MovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 플레이어 템플릿과 같은 클래스일 수 있으므로 빙의가 바뀔 때마다 다시 판단한다
+	if (CharacterOwner)
+	{
+		CharacterOwner->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &UAgent_MovementComponent::OnOwnerControllerChanged);
+	}
+	if (bUseLeanNavWalking || CVarLeanMovement.GetValueOnGameThread())
+	{
+		SetLeanNavWalking(true);
+	}
+
+	if (AvoidanceMode == EAgentAvoidanceMode::ORCA)
+	{
+		SetAvoidanceEnabled(false);
+		RegisterWithORCA();
+	}
+}
+
+void UAgent_MovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterFromORCA();
+	if (CharacterOwner)
+	{
+		CharacterOwner->ReceiveControllerChangedDelegate.RemoveDynamic(this, &UAgent_MovementComponent::OnOwnerControllerChanged);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAgent_MovementComponent::SetAvoidanceMode(EAgentAvoidanceMode NewMode)
+{
+	if (AvoidanceMode == NewMode)
+	{
+		return;
+	}
+	AvoidanceMode = NewMode;
+
+	if (!HasBegunPlay())
+	{
+		return;
+	}
+
+	if (AvoidanceMode == EAgentAvoidanceMode::ORCA)
+	{
+		// 두 방식이 동시에 속도를 바꾸지 않도록 엔진 RVO는 끈다
+		SetAvoidanceEnabled(false);
+		RegisterWithORCA();
+	}
+	else
+	{
+		UnregisterFromORCA();
+	}
+}
+
+void UAgent_MovementComponent::RegisterWithORCA()
+{
+	if (URVO_ORCASubsystem* ORCA = GetWorld() ? GetWorld()->GetSubsystem<URVO_ORCASubsystem>() : nullptr)
+	{
+		ORCA->RegisterAgent(this);
+	}
+}
+
+void UAgent_MovementComponent::UnregisterFromORCA()
+{
+	if (URVO_ORCASubsystem* ORCA = GetWorld() ? GetWorld()->GetSubsystem<URVO_ORCASubsystem>() : nullptr)
+	{
+		ORCA->UnregisterAgent(this);
+	}
+	bHasORCAVelocity = false;
+}
+
+void UAgent_MovementComponent::CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration)
+{
+	Super::CalcVelocity(DeltaTime, Friction, bFluid, BrakingDeceleration);
+
+	if (ORCAIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// 다음 풀이에 쓸 희망 속도를 기록하고, 이웃 때문에 바뀐 결과가 있으면 수평 속도만 덮어쓴다
+	PreferredVelocity = Velocity;
+	if (bHasORCAVelocity && !Acceleration.IsNearlyZero())
+	{
+		const FVector2D Avoided = FVector2D(ORCAVelocity).GetClampedToMaxSize(GetMaxSpeed());
+		Velocity.X = Avoided.X;
+		Velocity.Y = Avoided.Y;
+	}
+}
+
+void UAgent_MovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	AISTUDY_BENCHMARK_SCOPE(Movement);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UAgent_MovementComponent::SetLeanNavWalking(bool bEnable)
+{
+	bUseLeanNavWalking = bEnable;
+	UpdateLeanNavWalking();
+}
+
+void UAgent_MovementComponent::UpdateLeanNavWalking()
+{
+	// 플레이어는 WorldStatic 충돌, 계단 오르기, 바닥 스윕이 필요하므로 일반 Walking으로 둔다
+	const bool bActive = bUseLeanNavWalking && !(CharacterOwner && CharacterOwner->IsPlayerControlled());
+	if (bActive == bLeanNavWalkingActive)
+	{
+		return;
+	}
+	bLeanNavWalkingActive = bActive;
+
+	// 지상 이동 모드만 바꾼다. 공중에 있으면 착지할 때 새 모드로 들어간다.
+	DefaultLandMovementMode = bActive ? MOVE_NavWalking : MOVE_Walking;
+	if (IsMovingOnGround() && MovementMode != DefaultLandMovementMode)
+	{
+		SetMovementMode(DefaultLandMovementMode);
+	}
+}
+
+void UAgent_MovementComponent::OnOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	UpdateLeanNavWalking();
+}
+
+void UAgent_MovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// NavWalking에 들어오면 엔진이 WorldStatic/WorldDynamic 충돌을 끈다. 장애물 확인은 다음 이동에서 바로 다시 한다.
+	if (MovementMode == MOVE_NavWalking)
+	{
+		bHasNavFloor = false;
+		bNearDynamicObstacle = false;
+		ObstacleCheckTimer = 0.0f;
+	}
+}
+
+void UAgent_MovementComponent::PhysNavWalking(float DeltaTime, int32 Iterations)
+{
+	if (!bLeanNavWalkingActive)
+	{
+		Super::PhysNavWalking(DeltaTime, Iterations);
+		return;
+	}
+
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Agent_LeanNavWalking);
+
+	if (DeltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	if ((!CharacterOwner || !CharacterOwner->Controller) && !bRunPhysicsWithNoController && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		Acceleration = FVector::ZeroVector;
+		Velocity = FVector::ZeroVector;
+		return;
+	}
+
+	RestorePreAdditiveRootMotionVelocity();
+
+	// 수평으로만 움직이고 높이는 내비메시에서 얻는다
+	Velocity.Z = 0.0f;
+	Acceleration.Z = 0.0f;
+	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		CalcVelocity(DeltaTime, GroundFriction, false, GetMaxBrakingDeceleration());
+	}
+	ApplyRootMotionToVelocity(DeltaTime);
+	Iterations++;
+
+	UpdateObstacleProximity(DeltaTime);
+
+	const FVector OldLocation = GetActorFeetLocation();
+	const FVector Destination = OldLocation + Velocity * DeltaTime;
+
+	FNavLocation Floor;
+	if (!FindLeanNavFloor(Destination, Floor))
+	{
+		// 내비메시를 벗어나면 일반 걷기로 돌아간다 (엔진 NavWalking과 같음)
+		SetMovementMode(MOVE_Walking);
+		return;
+	}
+
+	const FVector Delta = FVector(Destination.X, Destination.Y, Floor.Location.Z) - OldLocation;
+	if (!Delta.IsNearlyZero())
+	{
+		FHitResult Hit;
+		SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), bNearDynamicObstacle, Hit);
+		if (Hit.IsValidBlockingHit())
+		{
+			SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+		}
+	}
+
+	// 회피와 애님 BP가 읽는 속도는 실제 이동량으로 맞춘다
+	const FVector NewLocation = GetActorFeetLocation();
+	if (!bJustTeleported && !HasAnimRootMotion() && !CurrentRootMotion.HasVelocity())
+	{
+		Velocity = (NewLocation - OldLocation) / DeltaTime;
+	}
+	bJustTeleported = false;
+
+	// 다음 프레임 목적지의 바닥을 모든 틱이 끝난 뒤 한 번에 투영
+	const ANavigationData* NavData = LeanNavData.Get();
+	UAgent_NavFloorSubsystem* NavFloors = GetWorld()->GetSubsystem<UAgent_NavFloorSubsystem>();
+	if (NavData && NavFloors && !Velocity.IsNearlyZero())
+	{
+		const FNavAgentProperties& AgentProps = CharacterOwner->GetNavAgentPropertiesRef();
+		const float SearchRadius = AgentProps.AgentRadius * 2.0f;
+		const float SearchHeight = AgentProps.AgentHeight * AgentProps.NavWalkingSearchHeightScale;
+		NavFloors->RequestFloor(this, NavData, NewLocation + FVector(Velocity.X, Velocity.Y, 0.0f) * DeltaTime, FVector(SearchRadius, SearchRadius, SearchHeight));
+	}
+}
+
+bool UAgent_MovementComponent::FindLeanNavFloor(const FVector& Destination, FNavLocation& OutFloor)
+{
+	if (bHasNavFloor && FVector::DistSquared2D(NavFloorQuery, Destination) <= FMath::Square(NavFloorReuseDistance))
+	{
+		OutFloor = NavFloor;
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_Agent_LeanFloorFallbacks);
+	if (!LeanNavData.IsValid())
+	{
+		const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+		LeanNavData = NavSys && CharacterOwner ? NavSys->GetNavDataForProps(CharacterOwner->GetNavAgentPropertiesRef(), Destination) : nullptr;
+	}
+
+	bHasNavFloor = FindNavFloor(Destination, NavFloor);
+	NavFloorQuery = Destination;
+	OutFloor = NavFloor;
+	return bHasNavFloor;
+}
+
+void UAgent_MovementComponent::SetBatchedNavFloor(const FVector& Query, bool bSuccess, const FNavLocation& Floor)
+{
+	// 실패한 투영은 버리고 다음 이동에서 개별 투영으로 확인한다
+	if (bSuccess && MovementMode == MOVE_NavWalking)
+	{
+		NavFloorQuery = Query;
+		NavFloor = Floor;
+		bHasNavFloor = true;
+	}
+}
+
+void UAgent_MovementComponent::UpdateObstacleProximity(float DeltaTime)
+{
+	if (bNearDynamicObstacle)
+	{
+		INC_DWORD_STAT(STAT_Agent_LeanSweeping);
+	}
+
+	ObstacleCheckTimer -= DeltaTime;
+	if (ObstacleCheckTimer > 0.0f || !UpdatedPrimitive || !CharacterOwner)
+	{
+		return;
+	}
+	// 여러 에이전트가 같은 프레임에 확인하지 않도록 간격을 흩뜨린다
+	ObstacleCheckTimer = ObstacleCheckInterval * FMath::FRandRange(0.9f, 1.1f);
+
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AgentLeanObstacle), false, CharacterOwner);
+
+	float Radius = 0.0f;
+	float HalfHeight = 0.0f;
+	CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(Radius, HalfHeight);
+	const float Margin = GetMaxSpeed() * ObstacleCheckInterval;
+	const bool bNear = GetWorld()->OverlapAnyTestByObjectType(UpdatedComponent->GetComponentLocation(), FQuat::Identity, ObjectParams,
+		FCollisionShape::MakeCapsule(Radius + Margin, HalfHeight), QueryParams);
+
+	if (bNear != bNearDynamicObstacle)
+	{
+		bNearDynamicObstacle = bNear;
+		UpdatedPrimitive->SetCollisionResponseToChannel(ECC_WorldDynamic, bNear ? ECR_Block : ECR_Ignore);
+	}
+}
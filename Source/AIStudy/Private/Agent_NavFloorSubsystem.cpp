@@ -0,0 +1,65 @@
+#include "Agent_NavFloorSubsystem.h"
+#include "Agent_MovementComponent.h"
+#include "AIStudy.h"
+
+DECLARE_CYCLE_STAT(TEXT("Nav Floor Batch Project"), STAT_NavFloor_BatchProject, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Floor Batched Points"), STAT_NavFloor_BatchedPoints, STATGROUP_AIStudy);
+
+bool UAgent_NavFloorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAgent_NavFloorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAgent_NavFloorSubsystem, STATGROUP_Tickables);
+}
+
+void UAgent_NavFloorSubsystem::RequestFloor(UAgent_MovementComponent* Agent, const ANavigationData* NavData, const FVector& Point, const FVector& Extent)
+{
+	if (!Agent || !NavData)
+	{
+		return;
+	}
+
+	FBatch* Batch = Batches.FindByPredicate([NavData](const FBatch& Candidate) { return Candidate.NavData.Get() == NavData; });
+	if (!Batch)
+	{
+		Batch = &Batches.AddDefaulted_GetRef();
+		Batch->NavData = NavData;
+		Batch->Extent = Extent;
+	}
+
+	Batch->Workload.Emplace(Point);
+	Batch->Agents.Add(Agent);
+}
+
+void UAgent_NavFloorSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NavFloor_BatchProject);
+
+	for (FBatch& Batch : Batches)
+	{
+		const ANavigationData* NavData = Batch.NavData.Get();
+		if (!NavData || Batch.Workload.Num() == 0)
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT_BY(STAT_NavFloor_BatchedPoints, Batch.Workload.Num());
+		NavData->BatchProjectPoints(Batch.Workload, Batch.Extent);
+
+		for (int32 Index = 0; Index < Batch.Workload.Num(); ++Index)
+		{
+			if (UAgent_MovementComponent* Agent = Batch.Agents[Index].Get())
+			{
+				const FNavigationProjectionWork& Work = Batch.Workload[Index];
+				Agent->SetBatchedNavFloor(Work.Point, Work.bResult, Work.OutLocation);
+			}
+		}
+
+		// 배열 메모리는 다음 프레임에 재사용
+		Batch.Workload.Reset();
+		Batch.Agents.Reset();
+	}
+}
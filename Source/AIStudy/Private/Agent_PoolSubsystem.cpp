@@ -0,0 +1,268 @@
+#include "Agent_PoolSubsystem.h"
+#include "AIStudy.h"
+#include "Agent_Poolable.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "Spatial_HashSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Agent Pool Acquire"), STAT_AgentPool_Acquire, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Agent Pool Release"), STAT_AgentPool_Release, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Agent Pool Parked"), STAT_AgentPool_NumParked, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<int32> CVarAgentPoolMaxPerClass(
+	TEXT("AIStudy.Pool.MaxPerClass"),
+	512,
+	TEXT("폰/컨트롤러 클래스 쌍마다 풀에 남겨 둘 최대 에이전트 수. 넘치면 돌려받은 에이전트를 파괴한다."));
+
+bool UAgent_PoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAgent_PoolSubsystem::Deinitialize()
+{
+	// 월드가 내려가면서 액터는 함께 파괴된다
+	Pools.Reset();
+	Super::Deinitialize();
+}
+
+void UAgent_PoolSubsystem::Prewarm(UClass* PawnClass, UClass* ControllerClass, int32 Count)
+{
+	if (!PawnClass || Count <= 0)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<APawn>>& Pool = Pools.FindOrAdd(MakeKey(PawnClass, ControllerClass));
+	Pool.Reserve(Pool.Num() + Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		APawn* Pawn = SpawnPawn(PawnClass, ControllerClass, FTransform::Identity, [](APawn*) {});
+		if (!Pawn)
+		{
+			break;
+		}
+
+		AController* Controller = Pawn->GetController();
+		if (IAgent_Poolable* Poolable = Cast<IAgent_Poolable>(Controller))
+		{
+			Poolable->OnPoolReleased();
+		}
+		if (IAgent_Poolable* Poolable = Cast<IAgent_Poolable>(Pawn))
+		{
+			Poolable->OnPoolReleased();
+		}
+		Park(*Pawn, Controller);
+		Pool.Add(Pawn);
+		++Stats.NumPrewarmed;
+		INC_DWORD_STAT(STAT_AgentPool_NumParked);
+	}
+}
+
+APawn* UAgent_PoolSubsystem::Acquire(UClass* PawnClass, UClass* ControllerClass, const FTransform& Transform, TFunctionRef<void(APawn*)> Configure)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_AgentPool_Acquire);
+	++Stats.NumAcquires;
+
+	if (TArray<TWeakObjectPtr<APawn>>* Pool = Pools.Find(MakeKey(PawnClass, ControllerClass)))
+	{
+		while (Pool->Num() > 0)
+		{
+			APawn* Pawn = Pool->Pop(EAllowShrinking::No).Get();
+			DEC_DWORD_STAT(STAT_AgentPool_NumParked);
+			if (!IsValid(Pawn))
+			{
+				continue;
+			}
+
+			AController* Controller = Pawn->GetController();
+			Unpark(*Pawn, Controller, Transform);
+			Configure(Pawn);
+
+			// 컨트롤러가 먼저 등록되어야 폰이 이동을 시작할 때 컨트롤러를 찾는다
+			if (IAgent_Poolable* Poolable = Cast<IAgent_Poolable>(Controller))
+			{
+				Poolable->OnPoolAcquired();
+			}
+			if (IAgent_Poolable* Poolable = Cast<IAgent_Poolable>(Pawn))
+			{
+				Poolable->OnPoolAcquired();
+			}
+			++Stats.NumHits;
+			return Pawn;
+		}
+	}
+
+	return SpawnPawn(PawnClass, ControllerClass, Transform, Configure);
+}
+
+void UAgent_PoolSubsystem::Release(APawn* Pawn)
+{
+	if (!IsValid(Pawn))
+	{
+		return;
+	}
+
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_AgentPool_Release);
+	++Stats.NumReleases;
+
+	AController* Controller = Pawn->GetController();
+	TArray<TWeakObjectPtr<APawn>>& Pool = Pools.FindOrAdd(FPoolKey(Pawn->GetClass(), Controller ? Controller->GetClass() : nullptr));
+	if (Pool.Num() >= CVarAgentPoolMaxPerClass.GetValueOnGameThread())
+	{
+		++Stats.NumOverflows;
+		DestroyPair(*Pawn);
+		return;
+	}
+
+	if (IAgent_Poolable* Poolable = Cast<IAgent_Poolable>(Controller))
+	{
+		Poolable->OnPoolReleased();
+	}
+	if (IAgent_Poolable* Poolable = Cast<IAgent_Poolable>(Pawn))
+	{
+		Poolable->OnPoolReleased();
+	}
+	Park(*Pawn, Controller);
+	Pool.Add(Pawn);
+	INC_DWORD_STAT(STAT_AgentPool_NumParked);
+}
+
+void UAgent_PoolSubsystem::Drain()
+{
+	for (TPair<FPoolKey, TArray<TWeakObjectPtr<APawn>>>& Pair : Pools)
+	{
+		for (const TWeakObjectPtr<APawn>& Pawn : Pair.Value)
+		{
+			if (APawn* Parked = Pawn.Get())
+			{
+				DestroyPair(*Parked);
+			}
+		}
+	}
+	Pools.Reset();
+	SET_DWORD_STAT(STAT_AgentPool_NumParked, 0);
+}
+
+int32 UAgent_PoolSubsystem::GetNumParked() const
+{
+	int32 Count = 0;
+	for (const TPair<FPoolKey, TArray<TWeakObjectPtr<APawn>>>& Pair : Pools)
+	{
+		Count += Pair.Value.Num();
+	}
+	return Count;
+}
+
+UAgent_PoolSubsystem::FPoolKey UAgent_PoolSubsystem::MakeKey(UClass* PawnClass, UClass* ControllerClass)
+{
+	if (!ControllerClass && PawnClass)
+	{
+		ControllerClass = PawnClass->GetDefaultObject<APawn>()->AIControllerClass.Get();
+	}
+	return FPoolKey(PawnClass, ControllerClass);
+}
+
+APawn* UAgent_PoolSubsystem::SpawnPawn(UClass* PawnClass, UClass* ControllerClass, const FTransform& Transform, TFunctionRef<void(APawn*)> Configure) const
+{
+	// BeginPlay 전에 컨트롤러가 빙의되도록 지연 스폰
+	APawn* Pawn = GetWorld()->SpawnActorDeferred<APawn>(PawnClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Pawn)
+	{
+		return nullptr;
+	}
+
+	Pawn->AutoPossessAI = EAutoPossessAI::Spawned;
+	if (ControllerClass)
+	{
+		Pawn->AIControllerClass = ControllerClass;
+	}
+	Configure(Pawn);
+	Pawn->FinishSpawning(Transform);
+	return Pawn;
+}
+
+void UAgent_PoolSubsystem::Park(APawn& Pawn, AController* Controller) const
+{
+	if (UCharacterMovementComponent* Movement = Cast<UCharacterMovementComponent>(Pawn.GetMovementComponent()))
+	{
+		Movement->StopMovementImmediately();
+		Movement->SetAvoidanceEnabled(false);
+	}
+
+	// 숨기고 충돌/틱을 모두 끈다. 컴포넌트 틱은 액터 틱과 따로 돌기 때문에 하나씩 끈다
+	Pawn.SetActorHiddenInGame(true);
+	Pawn.SetActorEnableCollision(false);
+	Pawn.SetActorTickEnabled(false);
+	for (UActorComponent* Component : Pawn.GetComponents())
+	{
+		UAgent_SignificanceSubsystem::SetAgentComponentTickEnabled(*Component, false);
+	}
+	if (Controller)
+	{
+		Controller->SetActorTickEnabled(false);
+	}
+
+	// 풀에 있는 폰이 추적 대상이나 이웃으로 잡히지 않도록 공간 해시에서 뺀다
+	if (USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>())
+	{
+		SpatialHash->UntrackPawn(&Pawn);
+	}
+}
+
+void UAgent_PoolSubsystem::Unpark(APawn& Pawn, AController* Controller, const FTransform& Transform) const
+{
+	Pawn.SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	Pawn.SetActorHiddenInGame(false);
+	Pawn.SetActorEnableCollision(true);
+	Pawn.SetActorTickEnabled(Pawn.PrimaryActorTick.bStartWithTickEnabled);
+	for (UActorComponent* Component : Pawn.GetComponents())
+	{
+		UAgent_SignificanceSubsystem::SetAgentComponentTickEnabled(*Component, Component->PrimaryComponentTick.bStartWithTickEnabled);
+	}
+	if (Controller)
+	{
+		Controller->SetActorTickEnabled(Controller->PrimaryActorTick.bStartWithTickEnabled);
+	}
+
+	// 회피는 클래스 기본값으로 되돌리고, 방식 전환(ORCA 등)은 OnPoolAcquired에서 한다
+	if (UCharacterMovementComponent* Movement = Cast<UCharacterMovementComponent>(Pawn.GetMovementComponent()))
+	{
+		const UCharacterMovementComponent* Archetype = Cast<UCharacterMovementComponent>(Movement->GetArchetype());
+		Movement->SetAvoidanceEnabled(Archetype ? Archetype->bUseRVOAvoidance : false);
+	}
+
+	if (USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>())
+	{
+		SpatialHash->TrackPawn(&Pawn);
+	}
+}
+
+void UAgent_PoolSubsystem::DestroyPair(APawn& Pawn)
+{
+	if (AController* Controller = Pawn.GetController())
+	{
+		Controller->Destroy();
+	}
+	Pawn.Destroy();
+}
+
+void UAgent_PoolSubsystem::LogReport() const
+{
+	UE_LOG(LogAIStudy, Display, TEXT("Agent pool: %d parked in %d pools, %llu acquires, hit rate %.1f%%, %llu releases, %llu overflowed, %llu prewarmed"),
+		GetNumParked(), Pools.Num(), Stats.NumAcquires, Stats.GetHitRate() * 100.0, Stats.NumReleases, Stats.NumOverflows, Stats.NumPrewarmed);
+}
+
+static FAutoConsoleCommandWithWorld AgentPoolReportCommand(
+	TEXT("AIStudy.Pool.Report"),
+	TEXT("에이전트 풀 크기와 적중률을 로그로 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UAgent_PoolSubsystem* Pool = World ? World->GetSubsystem<UAgent_PoolSubsystem>() : nullptr)
+		{
+			Pool->LogReport();
+		}
+	}));
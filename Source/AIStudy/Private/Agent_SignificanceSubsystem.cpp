@@ -0,0 +1,471 @@
+#include "Agent_SignificanceSubsystem.h"
+#include "AIStudy.h"
+#include "Chaser_AIController.h"
+#include "Chaser_BrainSubsystem.h"
+#include "Chaser_RangeEventSubsystem.h"
+#include "Spatial_HashSubsystem.h"
+#include "AIController.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Sight.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_Significance_Update, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD High"), STAT_Significance_High, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Medium"), STAT_Significance_Medium, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Low"), STAT_Significance_Low, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Dormant"), STAT_Significance_Dormant, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarLODEnable(
+	TEXT("AIStudy.LOD.Enable"),
+	true,
+	TEXT("관찰자 거리에 따른 에이전트 LOD를 사용한다. 끄면 모든 에이전트를 High로 되돌린다."));
+
+static TAutoConsoleVariable<float> CVarLODUpdateInterval(
+	TEXT("AIStudy.LOD.UpdateInterval"),
+	0.25f,
+	TEXT("LOD 단계를 다시 계산하는 간격(초)."));
+
+static TAutoConsoleVariable<FString> CVarLODDistances(
+	TEXT("AIStudy.LOD.Distances"),
+	TEXT("3000,6000,12000"),
+	TEXT("High/Medium/Low 단계의 최대 거리. 마지막 값보다 멀면 Dormant."));
+
+static TAutoConsoleVariable<FString> CVarLODTickIntervals(
+	TEXT("AIStudy.LOD.TickIntervals"),
+	TEXT("0,0.1,0.3"),
+	TEXT("High/Medium/Low 단계의 컨트롤러/이동/경로 추종 틱 간격(초)."));
+
+static TAutoConsoleVariable<float> CVarLODOffscreenScale(
+	TEXT("AIStudy.LOD.OffscreenScale"),
+	2.0f,
+	TEXT("관찰자 시야 밖 에이전트의 거리에 곱하는 값. 클수록 화면 밖 에이전트가 빨리 낮은 단계로 내려간다."));
+
+static TAutoConsoleVariable<float> CVarLODWakeDuration(
+	TEXT("AIStudy.LOD.WakeDuration"),
+	5.0f,
+	TEXT("이벤트로 깨운 에이전트가 최소 Low 단계를 유지하는 시간(초)."));
+
+namespace AgentLOD
+{
+	// 단계를 내릴 때만 적용하는 여유 (경계에서 단계가 계속 바뀌지 않도록)
+	static constexpr float DemotionHysteresis = 1.1f;
+
+	static void ParseFloats(const FString& String, float (&OutValues)[3])
+	{
+		TArray<FString> Tokens;
+		String.ParseIntoArray(Tokens, TEXT(","));
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			if (Tokens.IsValidIndex(Index))
+			{
+				OutValues[Index] = FMath::Max(FCString::Atof(*Tokens[Index]), 0.0f);
+			}
+		}
+	}
+
+	static EAgentLODTier TierForDistance(float Distance, const float (&Distances)[3])
+	{
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			if (Distance <= Distances[Index])
+			{
+				return static_cast<EAgentLODTier>(Index);
+			}
+		}
+		return EAgentLODTier::Dormant;
+	}
+}
+
+bool UAgent_SignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAgent_SignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAgent_SignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UAgent_SignificanceSubsystem::RegisterAgent(APawn* Pawn)
+{
+	if (!Pawn || AgentIndices.Contains(Pawn))
+	{
+		return;
+	}
+
+	FAgentEntry& Entry = Agents.AddDefaulted_GetRef();
+	Entry.Pawn = Pawn;
+	Entry.Key = Pawn;
+	Entry.BudgetedMesh = Pawn->FindComponentByClass<USkeletalMeshComponentBudgeted>();
+	AgentIndices.Add(Pawn, Agents.Num() - 1);
+	++TierPopulation[static_cast<int32>(EAgentLODTier::High)];
+
+	Pawn->OnTakeAnyDamage.AddDynamic(this, &UAgent_SignificanceSubsystem::OnAgentDamaged);
+}
+
+void UAgent_SignificanceSubsystem::UnregisterAgent(APawn* Pawn)
+{
+	const int32* Index = Pawn ? AgentIndices.Find(Pawn) : nullptr;
+	if (!Index)
+	{
+		return;
+	}
+
+	// 잠든 채로 빙의 해제/파괴되는 경우를 위해 원래 상태로 돌려 놓는다
+	const int32 AgentIndex = *Index;
+	ApplyTier(Agents[AgentIndex], EAgentLODTier::High);
+	Pawn->OnTakeAnyDamage.RemoveDynamic(this, &UAgent_SignificanceSubsystem::OnAgentDamaged);
+	RemoveAgentAt(AgentIndex);
+}
+
+void UAgent_SignificanceSubsystem::RemoveAgentAt(int32 Index)
+{
+	--TierPopulation[static_cast<int32>(Agents[Index].Tier)];
+	AgentIndices.Remove(Agents[Index].Key);
+
+	// 마지막 원소를 빈 자리로 옮기고 인덱스 갱신
+	Agents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Agents.IsValidIndex(Index))
+	{
+		AgentIndices.Add(Agents[Index].Key, Index);
+	}
+}
+
+EAgentLODTier UAgent_SignificanceSubsystem::GetAgentTier(const APawn* Pawn) const
+{
+	const int32* Index = Pawn ? AgentIndices.Find(Pawn) : nullptr;
+	return Index ? Agents[*Index].Tier : EAgentLODTier::High;
+}
+
+void UAgent_SignificanceSubsystem::WakeAgent(APawn* Pawn, float Duration)
+{
+	const int32* Index = Pawn ? AgentIndices.Find(Pawn) : nullptr;
+	if (!Index)
+	{
+		return;
+	}
+
+	FAgentEntry& Entry = Agents[*Index];
+	Entry.WakeUntil = GetWorld()->GetTimeSeconds() + (Duration >= 0.0f ? Duration : CVarLODWakeDuration.GetValueOnGameThread());
+	if (Entry.Tier == EAgentLODTier::Dormant)
+	{
+		ApplyTier(Entry, EAgentLODTier::Low);
+	}
+}
+
+void UAgent_SignificanceSubsystem::OnAgentDamaged(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser)
+{
+	WakeAgent(Cast<APawn>(DamagedActor));
+}
+
+void UAgent_SignificanceSubsystem::GatherViewpoints(TArray<FViewpoint>& OutViewpoints) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController || !PlayerController->IsLocalController())
+		{
+			continue;
+		}
+
+		FVector Location;
+		FRotator Rotation;
+		PlayerController->GetPlayerViewPoint(Location, Rotation);
+		OutViewpoints.Add({ Location, Rotation.Vector(), true });
+	}
+
+	for (const FVector& Location : ViewpointOverrides)
+	{
+		OutViewpoints.Add({ Location, FVector::ZeroVector, false });
+	}
+}
+
+bool UAgent_SignificanceSubsystem::ShouldWakeOnProximity(const APawn& Pawn) const
+{
+	// 잠든 추적자는 시야 인지가 꺼져 있으므로 감지 반경 안에 추적 대상이 들어왔는지 공간 해시로 대신 확인
+	const AChaser_AIController* Chaser = Cast<AChaser_AIController>(Pawn.GetController());
+	const USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>();
+	return Chaser && SpatialHash && SpatialHash->FindNearestTarget(Pawn.GetActorLocation(), Chaser->DetectionRadius, &Pawn) != nullptr;
+}
+
+float UAgent_SignificanceSubsystem::ComputeViewScore(const APawn& Pawn, const TArray<FViewpoint>& Viewpoints, bool& bOutInView) const
+{
+	const float OffscreenScale = FMath::Max(CVarLODOffscreenScale.GetValueOnGameThread(), 1.0f);
+
+	// 시야 밖이면 멀리 있는 것으로 취급한다
+	const FVector Location = Pawn.GetActorLocation();
+	float Score = TNumericLimits<float>::Max();
+	bOutInView = false;
+	for (const FViewpoint& Viewpoint : Viewpoints)
+	{
+		const FVector ToAgent = Location - Viewpoint.Location;
+		const float Distance = ToAgent.Size();
+		const bool bInView = !Viewpoint.bHasDirection || (ToAgent.GetSafeNormal() | Viewpoint.Direction) > 0.5f;
+		Score = FMath::Min(Score, bInView ? Distance : Distance * OffscreenScale);
+		bOutInView |= bInView;
+	}
+	return Score;
+}
+
+EAgentLODTier UAgent_SignificanceSubsystem::EvaluateTier(const FAgentEntry& Entry, float Score, double Now) const
+{
+	const APawn* Pawn = Entry.Pawn.Get();
+	if (!Pawn || !CVarLODEnable.GetValueOnGameThread())
+	{
+		return EAgentLODTier::High;
+	}
+
+	float Distances[3] = { 3000.0f, 6000.0f, 12000.0f };
+	AgentLOD::ParseFloats(CVarLODDistances.GetValueOnGameThread(), Distances);
+
+	EAgentLODTier Tier = AgentLOD::TierForDistance(Score, Distances);
+	if (Tier > Entry.Tier)
+	{
+		Tier = FMath::Max(Entry.Tier, AgentLOD::TierForDistance(Score / AgentLOD::DemotionHysteresis, Distances));
+	}
+
+	// 이벤트로 깨어난 동안에는 잠들지 않는다
+	if (Tier == EAgentLODTier::Dormant && (Now < Entry.WakeUntil || ShouldWakeOnProximity(*Pawn)))
+	{
+		Tier = EAgentLODTier::Low;
+	}
+	return Tier;
+}
+
+void UAgent_SignificanceSubsystem::Tick(float DeltaTime)
+{
+	SET_DWORD_STAT(STAT_Significance_High, TierPopulation[static_cast<int32>(EAgentLODTier::High)]);
+	SET_DWORD_STAT(STAT_Significance_Medium, TierPopulation[static_cast<int32>(EAgentLODTier::Medium)]);
+	SET_DWORD_STAT(STAT_Significance_Low, TierPopulation[static_cast<int32>(EAgentLODTier::Low)]);
+	SET_DWORD_STAT(STAT_Significance_Dormant, TierPopulation[static_cast<int32>(EAgentLODTier::Dormant)]);
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate > 0.0f)
+	{
+		return;
+	}
+	TimeUntilUpdate = CVarLODUpdateInterval.GetValueOnGameThread();
+
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Significance_Update);
+
+	TArray<FViewpoint> Viewpoints;
+	GatherViewpoints(Viewpoints);
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = Agents.Num() - 1; Index >= 0; --Index)
+	{
+		FAgentEntry& Entry = Agents[Index];
+		if (!Entry.Pawn.IsValid())
+		{
+			// 등록 해제 없이 파괴된 폰 정리
+			RemoveAgentAt(Index);
+			continue;
+		}
+
+		// 관찰자가 없으면 LOD를 적용하지 않고 애니메이션 중요도도 등록 때 값(모두 같음)으로 둔다
+		if (Viewpoints.Num() == 0)
+		{
+			if (Entry.Tier != EAgentLODTier::High)
+			{
+				ApplyTier(Entry, EAgentLODTier::High);
+			}
+			continue;
+		}
+
+		bool bInView = false;
+		const float Score = ComputeViewScore(*Entry.Pawn, Viewpoints, bInView);
+		const EAgentLODTier NewTier = EvaluateTier(Entry, Score, Now);
+		if (NewTier != Entry.Tier)
+		{
+			ApplyTier(Entry, NewTier);
+		}
+		UpdateAnimationSignificance(Entry, Score, bInView);
+	}
+}
+
+void UAgent_SignificanceSubsystem::UpdateAnimationSignificance(const FAgentEntry& Entry, float Score, bool bInView) const
+{
+	USkeletalMeshComponentBudgeted* Mesh = Entry.BudgetedMesh.Get();
+	IAnimationBudgetAllocator* Allocator = Mesh ? IAnimationBudgetAllocator::Get(GetWorld()) : nullptr;
+	if (!Allocator)
+	{
+		return;
+	}
+
+	// 잠든 메시는 틱이 꺼져 있지만 마지막 중요도가 남아 있으면 할당기가 예산을 계속 배정하므로 가장 낮게 둔다
+	if (Entry.Tier == EAgentLODTier::Dormant)
+	{
+		Allocator->SetComponentSignificance(Mesh, 0.0f, false, false);
+		return;
+	}
+
+	// 할당기는 중요도가 큰 순서로 예산을 나눈다. 가까울수록, 시야 안일수록 크다.
+	const float Significance = 1.0f / FMath::Max(Score, 1.0f);
+	// 시야 안으로 판정한 메시는 렌더링 여부와 상관없이 틱한다 (헤드리스에서는 아무것도 렌더링되지 않는다).
+	// 시야 밖 메시는 할당기가 렌더링되지 않은 것으로 보고 평가를 줄이거나 건너뛴다.
+	Allocator->SetComponentSignificance(Mesh, Significance, false, bInView);
+}
+
+void UAgent_SignificanceSubsystem::SetAgentComponentTickEnabled(UActorComponent& Component, bool bEnabled)
+{
+	USkeletalMeshComponentBudgeted* Budgeted = Cast<USkeletalMeshComponentBudgeted>(&Component);
+	IAnimationBudgetAllocator* Allocator = Budgeted ? IAnimationBudgetAllocator::Get(Component.GetWorld()) : nullptr;
+	if (Allocator)
+	{
+		Allocator->SetComponentTickEnabled(Budgeted, bEnabled);
+	}
+	else
+	{
+		Component.SetComponentTickEnabled(bEnabled);
+	}
+}
+
+void UAgent_SignificanceSubsystem::SuspendActor(FAgentEntry& Entry, AActor* Actor, bool& bOutTickWasEnabled)
+{
+	bOutTickWasEnabled = Actor->IsActorTickEnabled();
+	Actor->SetActorTickEnabled(false);
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		// 예산 메시는 할당기가 프레임마다 틱을 켜고 끄므로 지금 꺼져 있어도 함께 멈춘다
+		if (Component && (Component->IsComponentTickEnabled() || Component == Entry.BudgetedMesh.Get()))
+		{
+			SetAgentComponentTickEnabled(*Component, false);
+			Entry.SuspendedComponents.Add(Component);
+		}
+	}
+}
+
+void UAgent_SignificanceSubsystem::ResumeActor(AActor* Actor, bool bTickWasEnabled)
+{
+	if (bTickWasEnabled)
+	{
+		Actor->SetActorTickEnabled(true);
+	}
+}
+
+void UAgent_SignificanceSubsystem::ApplyTier(FAgentEntry& Entry, EAgentLODTier NewTier)
+{
+	const EAgentLODTier OldTier = Entry.Tier;
+	if (OldTier == NewTier)
+	{
+		return;
+	}
+
+	--TierPopulation[static_cast<int32>(OldTier)];
+	++TierPopulation[static_cast<int32>(NewTier)];
+	Entry.Tier = NewTier;
+
+	APawn* Pawn = Entry.Pawn.Get();
+	if (!Pawn)
+	{
+		return;
+	}
+
+	AAIController* AIController = Cast<AAIController>(Pawn->GetController());
+	UPathFollowingComponent* PathFollowing = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	UAIPerceptionComponent* Perception = AIController ? AIController->GetPerceptionComponent() : nullptr;
+	UChaser_BrainSubsystem* Brain = GetWorld()->GetSubsystem<UChaser_BrainSubsystem>();
+	UChaser_RangeEventSubsystem* RangeEvents = GetWorld()->GetSubsystem<UChaser_RangeEventSubsystem>();
+	AChaser_AIController* Chaser = Cast<AChaser_AIController>(AIController);
+	// 일괄 시야를 쓰는 추적자는 엔진 시야가 꺼져 있고, 잠든 관찰자는 일괄 시야 쪽에서 건너뛴다
+	if (Chaser && Chaser->bUseBatchedSight)
+	{
+		Perception = nullptr;
+	}
+
+	// 잠들기: 경로 추종을 멈추고 시야 인지와 모든 틱을 끈다
+	if (NewTier == EAgentLODTier::Dormant)
+	{
+		if (PathFollowing && PathFollowing->GetStatus() == EPathFollowingStatus::Moving)
+		{
+			PathFollowing->PauseMove();
+		}
+		if (Perception)
+		{
+			Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
+		}
+		if (Brain && Chaser)
+		{
+			Brain->SetUpdateInterval(Chaser, UChaser_BrainSubsystem::DormantInterval);
+		}
+		if (RangeEvents && Chaser)
+		{
+			RangeEvents->SetDormant(Chaser, true);
+		}
+
+		Entry.SuspendedComponents.Reset();
+		SuspendActor(Entry, Pawn, Entry.bPawnTickWasEnabled);
+		if (AIController)
+		{
+			SuspendActor(Entry, AIController, Entry.bControllerTickWasEnabled);
+		}
+		return;
+	}
+
+	// 깨우기: 잠들 때 꺼 둔 것만 되돌린다. 틱 함수는 다시 켜질 때 잠든 시간을 한 번에 넘기지 않는다.
+	if (OldTier == EAgentLODTier::Dormant)
+	{
+		ResumeActor(Pawn, Entry.bPawnTickWasEnabled);
+		if (AIController)
+		{
+			ResumeActor(AIController, Entry.bControllerTickWasEnabled);
+		}
+		for (const TWeakObjectPtr<UActorComponent>& Component : Entry.SuspendedComponents)
+		{
+			if (Component.IsValid())
+			{
+				SetAgentComponentTickEnabled(*Component, true);
+			}
+		}
+		Entry.SuspendedComponents.Reset();
+
+		if (Perception)
+		{
+			Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), true);
+		}
+		if (PathFollowing && PathFollowing->GetStatus() == EPathFollowingStatus::Paused)
+		{
+			PathFollowing->ResumeMove();
+		}
+		// 범위 이벤트 모드는 잠든 동안 움직인 거리를 모르므로 깨어난 직후 다시 평가
+		if (RangeEvents && Chaser)
+		{
+			RangeEvents->SetDormant(Chaser, false);
+		}
+	}
+
+	// 단계별 틱 간격. 간격을 둔 틱은 엔진이 지난 시간을 누적해 DeltaTime으로 넘긴다.
+	float Intervals[3] = { 0.0f, 0.1f, 0.3f };
+	AgentLOD::ParseFloats(CVarLODTickIntervals.GetValueOnGameThread(), Intervals);
+	const float Interval = Intervals[static_cast<int32>(NewTier)];
+
+	Pawn->SetActorTickInterval(Interval);
+	for (UActorComponent* Component : Pawn->GetComponents())
+	{
+		// 예산 할당기에 등록된 메시의 틱 간격은 할당기가 정한다
+		if (Component && Component->PrimaryComponentTick.bCanEverTick && Component != Entry.BudgetedMesh.Get())
+		{
+			Component->SetComponentTickInterval(Interval);
+		}
+	}
+	if (AIController)
+	{
+		AIController->SetActorTickInterval(Interval);
+	}
+	if (PathFollowing)
+	{
+		PathFollowing->SetComponentTickInterval(Interval);
+		// 먼 단계에서는 막힘 감지를 꺼 경로 추종을 느슨하게 한다
+		PathFollowing->SetBlockDetectionState(NewTier == EAgentLODTier::High);
+	}
+	if (Brain && Chaser)
+	{
+		Brain->SetUpdateInterval(Chaser, Interval);
+	}
+}
@@ -0,0 +1,404 @@
+#include "BT_NPCNodes.h"
+#include "AIStudy.h"
+#include "Spatial_HashSubsystem.h"
+#include "TargetPoint_RegistrySubsystem.h"
+#include "AIController.h"
+#include "AISystem.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Enum.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "BehaviorTree/Composites/BTComposite_Selector.h"
+#include "BehaviorTree/Composites/BTComposite_Sequence.h"
+#include "Engine/TargetPoint.h"
+
+DECLARE_CYCLE_STAT(TEXT("NPC Update Target"), STAT_NPC_UpdateTarget, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("NPC Move To"), STAT_NPC_MoveTo, STATGROUP_AIStudy);
+
+namespace NPCBehavior
+{
+	const FName TargetActorKey(TEXT("TargetActor"));
+	const FName StateKey(TEXT("NPCState"));
+	const FName LastKnownLocationKey(TEXT("LastKnownLocation"));
+	const FName PatrolLocationKey(TEXT("PatrolLocation"));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UBTTask_NPCPatrol
+
+UBTTask_NPCPatrol::UBTTask_NPCPatrol()
+{
+	NodeName = TEXT("NPC Patrol");
+	INIT_TASK_NODE_NOTIFY_FLAGS();
+
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_NPCPatrol, BlackboardKey));
+	BlackboardKey.SelectedKeyName = NPCBehavior::PatrolLocationKey;
+}
+
+EBTNodeResult::Type UBTTask_NPCPatrol::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const UTargetPoint_RegistrySubsystem* Registry = OwnerComp.GetWorld()->GetSubsystem<UTargetPoint_RegistrySubsystem>();
+	if (!Blackboard || !Registry)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	TArray<ATargetPoint*> Waypoints;
+	Registry->GetWaypointsInGroup(PatrolGroup, Waypoints);
+	if (Waypoints.Num() == 0)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FMemory* Memory = CastInstanceNodeMemory<FMemory>(NodeMemory);
+	const ATargetPoint* Waypoint = Waypoints[Memory->NextWaypoint % Waypoints.Num()];
+	Memory->NextWaypoint = (Memory->NextWaypoint + 1) % Waypoints.Num();
+
+	Blackboard->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Waypoint->GetActorLocation());
+	return EBTNodeResult::Succeeded;
+}
+
+uint16 UBTTask_NPCPatrol::GetInstanceMemorySize() const
+{
+	return sizeof(FMemory);
+}
+
+void UBTTask_NPCPatrol::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_NPCPatrol::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTTask_NPCPatrol::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: next waypoint of %s"), *Super::GetStaticDescription(), PatrolGroup.IsNone() ? TEXT("all groups") : *PatrolGroup.ToString());
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UBTTask_NPCMoveTo
+
+UBTTask_NPCMoveTo::UBTTask_NPCMoveTo()
+{
+	NodeName = TEXT("NPC Move To");
+	INIT_TASK_NODE_NOTIFY_FLAGS();
+
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_NPCMoveTo, BlackboardKey), AActor::StaticClass());
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_NPCMoveTo, BlackboardKey));
+	BlackboardKey.SelectedKeyName = NPCBehavior::TargetActorKey;
+}
+
+EBTNodeResult::Type UBTTask_NPCMoveTo::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NPC_MoveTo);
+
+	AAIController* Controller = OwnerComp.GetAIOwner();
+	const UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	if (!Pawn || !Blackboard)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	// 키 이름 검색 없이 InitializeFromAsset에서 해석해 둔 키 ID로 읽는다
+	AActor* GoalActor = nullptr;
+	FVector GoalLocation;
+	if (BlackboardKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		GoalActor = Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+		if (!GoalActor)
+		{
+			return EBTNodeResult::Failed;
+		}
+		GoalLocation = GoalActor->GetActorLocation();
+	}
+	else
+	{
+		GoalLocation = Blackboard->GetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID());
+		if (!FAISystem::IsValidLocation(GoalLocation))
+		{
+			return EBTNodeResult::Failed;
+		}
+	}
+
+	// 이미 도착했으면 경로 요청 없이 끝낸다
+	if (FVector::DistSquared2D(Pawn->GetActorLocation(), GoalLocation) <= FMath::Square(AcceptanceRadius))
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	FMemory* Memory = CastInstanceNodeMemory<FMemory>(NodeMemory);
+	Memory->bExecuting = true;
+	Memory->ImmediateResult.Reset();
+
+	bool bRequested = true;
+	if (UPath_RequestSubsystem* PathRequests = Controller->GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+	{
+		FOnPathRequestFinished OnFinished = FOnPathRequestFinished::CreateUObject(this, &UBTTask_NPCMoveTo::OnPathRequestFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp));
+		bRequested = GoalActor
+			? PathRequests->RequestMoveToActor(Controller, GoalActor, AcceptanceRadius, Priority, bObserveGoalActor, MoveTemp(OnFinished), bAllowPartialPath)
+			: PathRequests->RequestMoveToLocation(Controller, GoalLocation, AcceptanceRadius, Priority, MoveTemp(OnFinished), false, bAllowPartialPath);
+	}
+	else
+	{
+		const EPathFollowingRequestResult::Type Result = GoalActor
+			? Controller->MoveToActor(GoalActor, AcceptanceRadius, true, true, true, nullptr, bAllowPartialPath)
+			: Controller->MoveToLocation(GoalLocation, AcceptanceRadius, true, true, false, true, nullptr, bAllowPartialPath);
+		OnPathRequestFinished(Result, &OwnerComp);
+	}
+	Memory->bExecuting = false;
+
+	if (!bRequested)
+	{
+		return EBTNodeResult::Failed;
+	}
+	if (Memory->ImmediateResult.IsSet())
+	{
+		return Memory->ImmediateResult.GetValue() == EPathFollowingRequestResult::AlreadyAtGoal ? EBTNodeResult::Succeeded : EBTNodeResult::Failed;
+	}
+	return EBTNodeResult::InProgress;
+}
+
+void UBTTask_NPCMoveTo::OnPathRequestFinished(EPathFollowingRequestResult::Type Result, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp) const
+{
+	UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get();
+	if (!OwnerComp || OwnerComp->GetTaskStatus(this) != EBTTaskStatus::Active)
+	{
+		return;
+	}
+
+	// 경로 추종이 시작되었으면 이 이동 요청의 완료 메시지를 기다린다 (UBTTaskNode::OnMessage가 태스크를 끝낸다)
+	if (Result == EPathFollowingRequestResult::RequestSuccessful)
+	{
+		if (const AAIController* Controller = OwnerComp->GetAIOwner())
+		{
+			WaitForMessage(*OwnerComp, UBrainComponent::AIMessage_MoveFinished, Controller->GetCurrentMoveRequestID().GetID());
+		}
+		return;
+	}
+
+	FMemory* Memory = CastInstanceNodeMemory<FMemory>(OwnerComp->GetNodeMemory(const_cast<UBTTask_NPCMoveTo*>(this), OwnerComp->FindInstanceContainingNode(this)));
+	if (Memory && Memory->bExecuting)
+	{
+		Memory->ImmediateResult = Result;
+		return;
+	}
+	FinishLatentTask(*OwnerComp, Result == EPathFollowingRequestResult::AlreadyAtGoal ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
+
+EBTNodeResult::Type UBTTask_NPCMoveTo::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (AAIController* Controller = OwnerComp.GetAIOwner())
+	{
+		if (UPath_RequestSubsystem* PathRequests = Controller->GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+		{
+			PathRequests->CancelRequest(Controller);
+		}
+		Controller->StopMovement();
+	}
+	return EBTNodeResult::Aborted;
+}
+
+uint16 UBTTask_NPCMoveTo::GetInstanceMemorySize() const
+{
+	return sizeof(FMemory);
+}
+
+void UBTTask_NPCMoveTo::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_NPCMoveTo::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTTask_NPCMoveTo::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s (acceptance %.0f)"), *Super::GetStaticDescription(), AcceptanceRadius);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UBTService_NPCUpdateTarget
+
+UBTService_NPCUpdateTarget::UBTService_NPCUpdateTarget()
+{
+	NodeName = TEXT("NPC Update Target");
+	INIT_SERVICE_NODE_NOTIFY_FLAGS();
+
+	Interval = 0.5f;
+	RandomDeviation = 0.1f;
+	// 분기에 들어가기 전에 한 번 평가해 첫 선택이 지난 상태로 되지 않게 한다
+	bCallTickOnSearchStart = true;
+
+	TargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_NPCUpdateTarget, TargetActorKey), AActor::StaticClass());
+	StateKey.AddEnumFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_NPCUpdateTarget, StateKey), StaticEnum<EAIState>());
+	LastKnownLocationKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_NPCUpdateTarget, LastKnownLocationKey));
+	TargetActorKey.SelectedKeyName = NPCBehavior::TargetActorKey;
+	StateKey.SelectedKeyName = NPCBehavior::StateKey;
+	LastKnownLocationKey.SelectedKeyName = NPCBehavior::LastKnownLocationKey;
+}
+
+void UBTService_NPCUpdateTarget::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BlackboardAsset = GetBlackboardAsset())
+	{
+		TargetActorKey.ResolveSelectedKey(*BlackboardAsset);
+		StateKey.ResolveSelectedKey(*BlackboardAsset);
+		LastKnownLocationKey.ResolveSelectedKey(*BlackboardAsset);
+	}
+}
+
+void UBTService_NPCUpdateTarget::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NPC_UpdateTarget);
+
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+
+	const AAIController* Controller = OwnerComp.GetAIOwner();
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	const USpatial_HashSubsystem* SpatialHash = OwnerComp.GetWorld()->GetSubsystem<USpatial_HashSubsystem>();
+	if (!Pawn || !Blackboard || !SpatialHash || !TargetActorKey.IsSet() || !StateKey.IsSet())
+	{
+		return;
+	}
+
+	// 가장 큰 반경 안에서 찾고, 없으면 기존 타겟을 유지해 거리 판정으로 추적을 끝낸다 (RefreshTarget과 같다)
+	const FVector Origin = Pawn->GetActorLocation();
+	AActor* Target = SpatialHash->FindNearestTarget(Origin, LoseInterestRadius, Pawn);
+	if (!Target)
+	{
+		Target = Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(TargetActorKey.GetSelectedKeyID()));
+	}
+
+	EAIState State = static_cast<EAIState>(Blackboard->GetValue<UBlackboardKeyType_Enum>(StateKey.GetSelectedKeyID()));
+	if (Target)
+	{
+		const float Distance = FVector::Dist(Origin, Target->GetActorLocation());
+		switch (State)
+		{
+		case EAIState::Idle:
+			State = Distance <= DetectionRadius ? EAIState::Suspicious : EAIState::Idle;
+			break;
+		case EAIState::Suspicious:
+			State = Distance <= ChaseRadius ? EAIState::Chasing : Distance > DetectionRadius ? EAIState::Idle : EAIState::Suspicious;
+			break;
+		case EAIState::Chasing:
+			State = Distance > LoseInterestRadius ? EAIState::Idle : EAIState::Chasing;
+			break;
+		}
+	}
+	else
+	{
+		State = EAIState::Idle;
+	}
+
+	// 값이 같으면 블랙보드가 관찰자에게 알리지 않으므로 매번 써도 된다
+	Blackboard->SetValue<UBlackboardKeyType_Object>(TargetActorKey.GetSelectedKeyID(), Target);
+	Blackboard->SetValue<UBlackboardKeyType_Enum>(StateKey.GetSelectedKeyID(), static_cast<uint8>(State));
+	if (Target && State != EAIState::Idle && LastKnownLocationKey.IsSet())
+	{
+		Blackboard->SetValue<UBlackboardKeyType_Vector>(LastKnownLocationKey.GetSelectedKeyID(), Target->GetActorLocation());
+	}
+}
+
+FString UBTService_NPCUpdateTarget::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s\nchase %.0f / detect %.0f / lose %.0f"), *Super::GetStaticDescription(), ChaseRadius, DetectionRadius, LoseInterestRadius);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UBTDecorator_NPCState
+
+UBTDecorator_NPCState::UBTDecorator_NPCState()
+{
+	NodeName = TEXT("NPC State");
+
+	BlackboardKey.AddEnumFilter(this, GET_MEMBER_NAME_CHECKED(UBTDecorator_NPCState, BlackboardKey), StaticEnum<EAIState>());
+	BlackboardKey.SelectedKeyName = NPCBehavior::StateKey;
+}
+
+void UBTDecorator_NPCState::Setup(FName KeyName, EAIState InState, EBTFlowAbortMode::Type AbortMode)
+{
+	BlackboardKey.SelectedKeyName = KeyName;
+	State = InState;
+	FlowAbortMode = AbortMode;
+}
+
+bool UBTDecorator_NPCState::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	const UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	return Blackboard && Blackboard->GetValue<UBlackboardKeyType_Enum>(BlackboardKey.GetSelectedKeyID()) == static_cast<uint8>(State);
+}
+
+FString UBTDecorator_NPCState::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s is %s"), *Super::GetStaticDescription(), *BlackboardKey.SelectedKeyName.ToString(), *UEnum::GetDisplayValueAsText(State).ToString());
+}
+
+//////////////////////////////////////////////////////////////////////////
+// NPCBehavior
+
+UBehaviorTree* NPCBehavior::CreateTree(UObject* Outer)
+{
+	UBehaviorTree* Tree = NewObject<UBehaviorTree>(Outer);
+	UBlackboardData* Blackboard = NewObject<UBlackboardData>(Tree);
+	Tree->BlackboardAsset = Blackboard;
+
+	auto AddKey = [Blackboard](FName Name, UBlackboardKeyType* KeyType)
+	{
+		FBlackboardEntry& Entry = Blackboard->Keys.AddDefaulted_GetRef();
+		Entry.EntryName = Name;
+		Entry.KeyType = KeyType;
+	};
+	UBlackboardKeyType_Object* ActorKeyType = NewObject<UBlackboardKeyType_Object>(Blackboard);
+	ActorKeyType->BaseClass = AActor::StaticClass();
+	UBlackboardKeyType_Enum* StateKeyType = NewObject<UBlackboardKeyType_Enum>(Blackboard);
+	StateKeyType->EnumType = StaticEnum<EAIState>();
+	AddKey(TargetActorKey, ActorKeyType);
+	AddKey(StateKey, StateKeyType);
+	AddKey(LastKnownLocationKey, NewObject<UBlackboardKeyType_Vector>(Blackboard));
+	AddKey(PatrolLocationKey, NewObject<UBlackboardKeyType_Vector>(Blackboard));
+
+	// 추적 > 의심 > 순찰. 상태가 바뀌면 데코레이터가 진행 중인 분기를 끊고 다시 고른다
+	UBTComposite_Selector* Root = NewObject<UBTComposite_Selector>(Tree);
+	Root->Services.Add(NewObject<UBTService_NPCUpdateTarget>(Tree));
+	Tree->RootNode = Root;
+
+	auto AddStateBranch = [Tree, Root](EAIState State, FName GoalKey, EPathRequestPriority Priority)
+	{
+		UBTDecorator_NPCState* Condition = NewObject<UBTDecorator_NPCState>(Tree);
+		Condition->Setup(StateKey, State, EBTFlowAbortMode::Both);
+		UBTTask_NPCMoveTo* MoveTo = NewObject<UBTTask_NPCMoveTo>(Tree);
+		MoveTo->SetBlackboardKey(GoalKey);
+		MoveTo->Priority = Priority;
+
+		FBTCompositeChild& Child = Root->Children.AddDefaulted_GetRef();
+		Child.ChildTask = MoveTo;
+		Child.Decorators.Add(Condition);
+	};
+	AddStateBranch(EAIState::Chasing, TargetActorKey, EPathRequestPriority::Chase);
+	AddStateBranch(EAIState::Suspicious, LastKnownLocationKey, EPathRequestPriority::Normal);
+
+	UBTComposite_Sequence* Patrol = NewObject<UBTComposite_Sequence>(Tree);
+	UBTTask_NPCPatrol* NextWaypoint = NewObject<UBTTask_NPCPatrol>(Tree);
+	UBTTask_NPCMoveTo* MoveToWaypoint = NewObject<UBTTask_NPCMoveTo>(Tree);
+	MoveToWaypoint->SetBlackboardKey(PatrolLocationKey);
+	MoveToWaypoint->Priority = EPathRequestPriority::Patrol;
+	Patrol->Children.AddDefaulted_GetRef().ChildTask = NextWaypoint;
+	Patrol->Children.AddDefaulted_GetRef().ChildTask = MoveToWaypoint;
+	Root->Children.AddDefaulted_GetRef().ChildComposite = Patrol;
+
+	return Tree;
+}
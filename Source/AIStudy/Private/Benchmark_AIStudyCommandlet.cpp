@@ -0,0 +1,1151 @@
+#include "Benchmark_AIStudyCommandlet.h"
+#include "AIStudy.h"
+#include "Agent_PoolSubsystem.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "AIStudyCharacter.h"
+#include "Benchmark_Metrics.h"
+#include "Chaser_AIController.h"
+#include "Chaser_RangeEventSubsystem.h"
+#include "Mass_AgentSubsystem.h"
+#include "Nav_HierarchicalSubsystem.h"
+#include "Nav_RebuildGovernorSubsystem.h"
+#include "Nav_TileCacheSubsystem.h"
+#include "NPC_AIController.h"
+#include "Chaser_Character.h"
+#include "IAnimationBudgetAllocator.h"
+#include "AnimationBudgetAllocatorParameters.h"
+#include "Path_RequestSubsystem.h"
+#include "Replay_AISubsystem.h"
+#include "RVO_Character.h"
+#include "RVO_SquadSubsystem.h"
+#include "Spatial_HashSubsystem.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/Engine.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Containers/Ticker.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+UBenchmark_AIStudyCommandlet::UBenchmark_AIStudyCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBenchmark_AIStudyCommandlet::Main(const FString& Params)
+{
+	// 명령행 옵션
+	FString MapPath;
+	GConfig->GetString(TEXT("/Script/EngineSettings.GameMapsSettings"), TEXT("GameDefaultMap"), MapPath, GEngineIni);
+	FParse::Value(*Params, TEXT("Map="), MapPath);
+
+	FString CountsString = TEXT("10,100,500,1000,2000,5000");
+	FParse::Value(*Params, TEXT("Counts="), CountsString);
+	TArray<FString> CountTokens;
+	CountsString.ParseIntoArray(CountTokens, TEXT(","));
+	TArray<int32> Counts;
+	for (const FString& Token : CountTokens)
+	{
+		Counts.Add(FMath::Max(FCString::Atoi(*Token), 0));
+	}
+
+	int32 Frames = 300;
+	int32 WarmupFrames = 60;
+	int32 Seed = 12345;
+	float DeltaTime = 1.0f / 30.0f;
+	float HalfExtent = 0.0f;
+	FParse::Value(*Params, TEXT("Frames="), Frames);
+	FParse::Value(*Params, TEXT("Warmup="), WarmupFrames);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+	FParse::Value(*Params, TEXT("Extent="), HalfExtent);
+
+	FString MixString;
+	FParse::Value(*Params, TEXT("Mix="), MixString);
+	const FAgentMix Mix = ParseMix(MixString);
+
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), FString::Printf(TEXT("AIStudy_%s.csv"), *FDateTime::Now().ToString()));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	bUseFlowField = FParse::Param(*Params, TEXT("FlowField"));
+	bUseORCA = FParse::Param(*Params, TEXT("ORCA"));
+	bUsePredictiveInvoker = FParse::Param(*Params, TEXT("PredictiveInvoker"));
+	bUseLOD = FParse::Param(*Params, TEXT("LOD"));
+	bUseMass = FParse::Param(*Params, TEXT("Mass"));
+	bUseRangeEvents = FParse::Param(*Params, TEXT("RangeEvents"));
+	bUseLeanMovement = FParse::Param(*Params, TEXT("LeanMovement"));
+	bUsePool = FParse::Param(*Params, TEXT("Pool"));
+	FParse::Value(*Params, TEXT("Churn="), ChurnPerFrame);
+	FParse::Value(*Params, TEXT("AnimBudget="), AnimBudgetMs);
+	FParse::Value(*Params, TEXT("Squad="), SquadSize);
+	// 흐름장 에이전트는 경로를 찾지 않고, Mass 에이전트는 액터가 아니므로 분대로 묶을 수 없다
+	if (SquadSize > 1 && (bUseFlowField || bUseMass))
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Benchmark: -Squad is ignored with -FlowField or -Mass"));
+		SquadSize = 0;
+	}
+
+	// 기본은 C++ 클래스. 메시/애님까지 포함하려면 블루프린트 클래스 경로를 넘긴다.
+	FString ClassPath;
+	RVOClass = FParse::Value(*Params, TEXT("RVOClass="), ClassPath) ? LoadClass<ARVO_Character>(nullptr, *ClassPath) : ARVO_Character::StaticClass();
+	ChaserPawnClass = FParse::Value(*Params, TEXT("ChaserPawnClass="), ClassPath) ? LoadClass<APawn>(nullptr, *ClassPath) : AChaser_Character::StaticClass();
+	PatrolClass = FParse::Value(*Params, TEXT("PatrolClass="), ClassPath) ? LoadClass<AAIStudyCharacter>(nullptr, *ClassPath) : AAIStudyCharacter::StaticClass();
+	NPCControllerClass = FParse::Value(*Params, TEXT("NPCControllerClass="), ClassPath) ? LoadClass<AAIController>(nullptr, *ClassPath) : ANPC_AIController::StaticClass();
+	if (!RVOClass || !ChaserPawnClass || !PatrolClass || !NPCControllerClass)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: failed to load an agent class override"));
+		return 1;
+	}
+
+	// 추적자 컨트롤러는 스폰 중에 BeginPlay가 불리므로 속성 대신 CVar로 범위 이벤트 모드를 켠다
+	if (bUseRangeEvents)
+	{
+		ApplyCVars(TEXT("AIStudy.Chaser.RangeEvents=1"));
+	}
+	if (bUseLeanMovement)
+	{
+		ApplyCVars(TEXT("AIStudy.Movement.Lean=1"));
+	}
+
+	// 내비메시 타일 캐시: Cold는 캐시를 지우고 시작 (이번 실행이 캐시를 다시 쓴다), Warm은 이전 실행의 캐시를 그대로, Off는 모든 타일을 빌드
+	FString NavCacheMode;
+	if (FParse::Value(*Params, TEXT("NavCache="), NavCacheMode))
+	{
+		if (NavCacheMode == TEXT("Cold"))
+		{
+			UNav_TileCacheSubsystem::ClearCache();
+		}
+		else if (NavCacheMode == TEXT("Off"))
+		{
+			ApplyCVars(TEXT("AIStudy.NavCache.Enable=0"));
+		}
+	}
+
+	FString CVarList;
+	if (FParse::Value(*Params, TEXT("CVars="), CVarList, false))
+	{
+		ApplyCVars(CVarList);
+	}
+
+	// 재생은 기록된 맵과 콘솔 변수로 월드를 띄운다 (서브시스템 초기화 때 읽는 변수가 있으므로 로드 전에 적용)
+	FString RecordPath;
+	FString ReplayPath;
+	FParse::Value(*Params, TEXT("Record="), RecordPath);
+	FReplay_AIStream ReplayStream;
+	if (FParse::Value(*Params, TEXT("Replay="), ReplayPath))
+	{
+		if (!ReplayStream.LoadFromFile(ReplayPath))
+		{
+			return 1;
+		}
+		MapPath = ReplayStream.MapName;
+		DeltaTime = ReplayStream.Frames.Num() > 0 ? ReplayStream.Frames[0].DeltaTime : DeltaTime;
+		ReplayStream.ApplyCVars();
+	}
+
+	if (FParse::Param(*Params, TEXT("CheckRangeEvents")))
+	{
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(DeltaTime);
+		const int32 MaxCount = Counts.Num() > 0 ? FMath::Max(Counts) : 0;
+		const float SpawnExtent = HalfExtent > 0.0f ? HalfExtent : FMath::Max(FMath::Sqrt(static_cast<float>(MaxCount)) * 150.0f, 2000.0f);
+		return RunRangeEventsCheck(MapPath, MaxCount, Mix, Frames, Seed, DeltaTime, SpawnExtent) ? 0 : 1;
+	}
+
+	// 고정 시드와 고정 스텝
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(DeltaTime);
+
+	const double LoadStartTime = FPlatformTime::Seconds();
+	UWorld* World = LoadWorld(MapPath);
+	if (!World)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: failed to load map %s"), *MapPath);
+		return 1;
+	}
+
+	WaitForNavigation(World, DeltaTime);
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: navigation pathable %.1f ms after the map load started"), (FPlatformTime::Seconds() - LoadStartTime) * 1000.0);
+	if (const UNav_TileCacheSubsystem* NavCache = World->GetSubsystem<UNav_TileCacheSubsystem>())
+	{
+		NavCache->LogReport();
+	}
+
+	if (!ReplayPath.IsEmpty())
+	{
+		const bool bIdentical = RunReplay(World, MoveTemp(ReplayStream), OutputPath);
+		DestroyWorld(World);
+		return bIdentical ? 0 : 1;
+	}
+
+	// 웨이포인트부터 기록되도록 스폰 전에 시작한다
+	UReplay_AISubsystem* Recorder = RecordPath.IsEmpty() ? nullptr : World->GetSubsystem<UReplay_AISubsystem>();
+	if (Recorder)
+	{
+		Recorder->StartRecording(Seed);
+	}
+
+	const int32 MaxCount = Counts.Num() > 0 ? FMath::Max(Counts) : 0;
+	const float SpawnExtent = HalfExtent > 0.0f ? HalfExtent : FMath::Max(FMath::Sqrt(static_cast<float>(MaxCount)) * 150.0f, 2000.0f);
+	FRandomStream WaypointRandom(Seed);
+	SpawnWaypoints(World, WaypointRandom, SpawnExtent);
+
+	int32 NumPathQueries = 0;
+	if (FParse::Value(*Params, TEXT("PathQueries="), NumPathQueries) && NumPathQueries > 0)
+	{
+		FRandomStream QueryRandom(Seed);
+		RunPathQueryBenchmark(World, NumPathQueries, QueryRandom, SpawnExtent, DeltaTime, FPaths::ChangeExtension(OutputPath, TEXT("")) + TEXT("_paths.csv"));
+		if (Recorder)
+		{
+			// 경로 쿼리만 도는 실행은 재생할 에이전트가 없으므로 기록을 버린다
+			Recorder->StopRecording(FString());
+		}
+		DestroyWorld(World);
+		return 0;
+	}
+
+	// 헤드리스에는 플레이어 시점이 없으므로 배치 중심을 관찰 지점으로 둔다. 관찰 지점이 없으면 모든 에이전트가 High로 남는다.
+	// 애니메이션 예산의 중요도도 같은 관찰 지점에서 계산한다.
+	UAgent_SignificanceSubsystem* Significance = World->GetSubsystem<UAgent_SignificanceSubsystem>();
+	if (Significance && (bUseLOD || AnimBudgetMs > 0.0f))
+	{
+		Significance->AddViewpointOverride(FVector::ZeroVector);
+	}
+
+	// 할당기를 끄면 예산 메시도 일반 메시처럼 매 프레임 평가된다 (비교 기준)
+	if (IAnimationBudgetAllocator* AnimBudget = IAnimationBudgetAllocator::Get(World))
+	{
+		AnimBudget->SetEnabled(AnimBudgetMs > 0.0f);
+		if (AnimBudgetMs > 0.0f)
+		{
+			FAnimationBudgetAllocatorParameters AnimBudgetParameters;
+			AnimBudgetParameters.BudgetInMs = AnimBudgetMs;
+			AnimBudget->SetParameters(AnimBudgetParameters);
+		}
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: map %s, %d frames (+%d warmup) at %.4f s, seed %d, extent %.0f, mix RVO %.2f / Chaser %.2f / Patrol %.2f / NPC %.2f%s%s%s%s%s%s%s%s, churn %d/frame, anim budget %.2f ms, squad size %d"),
+		*MapPath, Frames, WarmupFrames, DeltaTime, Seed, SpawnExtent, Mix.RVO, Mix.Chaser, Mix.Patrol, Mix.NPC,
+		bUseFlowField ? TEXT(", flow field") : TEXT(""), bUseORCA ? TEXT(", ORCA") : TEXT(""), bUsePredictiveInvoker ? TEXT(", predictive invokers") : TEXT(""),
+		bUseLOD ? TEXT(", LOD") : TEXT(""), bUseMass ? TEXT(", Mass") : TEXT(""), bUseRangeEvents ? TEXT(", range events") : TEXT(""),
+		bUseLeanMovement ? TEXT(", lean movement") : TEXT(""), bUsePool ? TEXT(", pool") : TEXT(""), ChurnPerFrame, AnimBudgetMs, SquadSize);
+
+	// 풀을 쓰면 가장 큰 단계만큼 미리 만들어 두어 측정 중에는 스폰이 일어나지 않게 한다
+	UAgent_PoolSubsystem* Pool = bUsePool && !bUseMass ? World->GetSubsystem<UAgent_PoolSubsystem>() : nullptr;
+	if (Pool)
+	{
+		if (Recorder)
+		{
+			UE_LOG(LogAIStudy, Warning, TEXT("Benchmark: pooled agents are reused instead of respawned, so the recording will not replay them"));
+		}
+
+		int32 NumRVO = 0;
+		int32 NumChasers = 0;
+		int32 NumPatrol = 0;
+		int32 NumNPC = 0;
+		SplitMix(MaxCount, Mix, NumRVO, NumChasers, NumPatrol, NumNPC);
+		Pool->Prewarm(RVOClass, nullptr, NumRVO);
+		Pool->Prewarm(ChaserPawnClass, AChaser_AIController::StaticClass(), NumChasers);
+		Pool->Prewarm(PatrolClass, AAIController::StaticClass(), NumPatrol);
+		Pool->Prewarm(ChaserPawnClass, NPCControllerClass, NumNPC);
+		TickWorld(World, DeltaTime);
+		Pool->LogReport();
+	}
+
+	TArray<FFrameSample> Samples;
+	Samples.Reserve(Counts.Num() * Frames);
+	FBenchmark_Metrics::SetEnabled(true);
+
+	for (const int32 NumAgents : Counts)
+	{
+		// 단계마다 같은 시드에서 시작해 배치가 재현되도록 한다
+		FRandomStream Random(Seed + NumAgents);
+		TArray<APawn*> Pawns;
+		TArray<FMassEntityHandle> MassEntities;
+		if (bUseMass)
+		{
+			SpawnMassAgents(World, NumAgents, Mix, Random, SpawnExtent, MassEntities);
+		}
+		else
+		{
+			SpawnAgents(World, NumAgents, Mix, Random, SpawnExtent, Pawns);
+		}
+		const int32 NumSpawned = Pawns.Num() + MassEntities.Num();
+
+		for (int32 Frame = 0; Frame < WarmupFrames; ++Frame)
+		{
+			TickWorld(World, DeltaTime);
+		}
+
+		const UPath_RequestSubsystem* PathRequests = World->GetSubsystem<UPath_RequestSubsystem>();
+		FPathRequestCounters PreviousCounters = PathRequests ? PathRequests->GetCounters() : FPathRequestCounters();
+		const int32 FirstSample = Samples.Num();
+		TMap<const APawn*, FVector> Headings;
+
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			FBenchmark_Metrics::ResetFrame();
+			const double StartTime = FPlatformTime::Seconds();
+			// 제거/재스폰 비용도 프레임 시간에 포함한다
+			if (ChurnPerFrame > 0)
+			{
+				ChurnAgents(World, Pawns, ChurnPerFrame, Random, SpawnExtent);
+			}
+			TickWorld(World, DeltaTime);
+			const double GameThreadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			FFrameSample& Sample = AddSample(Samples, NumSpawned, Frame, GameThreadMs, PathRequests, PreviousCounters);
+			Sample.RVOHeadingChangeDeg = MeasureHeadingChange(Pawns, Headings);
+		}
+
+		LogSummary(NumSpawned, Samples, FirstSample);
+		if (Pool)
+		{
+			Pool->LogReport();
+		}
+		const URVO_SquadSubsystem* Squads = World->GetSubsystem<URVO_SquadSubsystem>();
+		if (Squads && Squads->GetNumSquads() > 0)
+		{
+			Squads->LogReport();
+		}
+		// 움직이는 내비 모디파이어가 있는 맵에서만 재빌드가 생긴다
+		const UNav_RebuildGovernorSubsystem* NavGovernor = World->GetSubsystem<UNav_RebuildGovernorSubsystem>();
+		if (NavGovernor && NavGovernor->GetStats().MaxQueueDepth > 0)
+		{
+			NavGovernor->LogReport();
+		}
+		if (Significance && bUseLOD)
+		{
+			UE_LOG(LogAIStudy, Display, TEXT("Benchmark: %d agents LOD high %d / medium %d / low %d / dormant %d"), NumSpawned,
+				Significance->GetTierPopulation(EAgentLODTier::High), Significance->GetTierPopulation(EAgentLODTier::Medium),
+				Significance->GetTierPopulation(EAgentLODTier::Low), Significance->GetTierPopulation(EAgentLODTier::Dormant));
+		}
+		const UChaser_RangeEventSubsystem* RangeEvents = World->GetSubsystem<UChaser_RangeEventSubsystem>();
+		if (RangeEvents && RangeEvents->GetNumChasers() > 0)
+		{
+			UE_LOG(LogAIStudy, Display, TEXT("Benchmark: %d agents, range events %d / %d chasers sleeping"), NumSpawned,
+				RangeEvents->GetNumSleeping(), RangeEvents->GetNumChasers());
+		}
+		if (UMass_AgentSubsystem* MassAgents = MassEntities.Num() > 0 ? World->GetSubsystem<UMass_AgentSubsystem>() : nullptr)
+		{
+			MassAgents->DestroyAgents(MassEntities);
+		}
+		DestroyAgents(World, Pawns);
+	}
+
+	FBenchmark_Metrics::SetEnabled(false);
+	WriteCsv(OutputPath, Samples);
+	if (Recorder)
+	{
+		Recorder->StopRecording(RecordPath);
+	}
+	DestroyWorld(World);
+	return 0;
+}
+
+bool UBenchmark_AIStudyCommandlet::RunReplay(UWorld* World, FReplay_AIStream&& Stream, const FString& OutputPath) const
+{
+	UReplay_AISubsystem* Replay = World->GetSubsystem<UReplay_AISubsystem>();
+	const int32 NumFrames = Stream.Frames.Num();
+	if (!Replay || !Replay->StartReplay(MoveTemp(Stream)))
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: failed to start the replay"));
+		return false;
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: replaying %d frames on %s"), NumFrames, *Replay->GetStream().MapName);
+
+	TArray<FFrameSample> Samples;
+	Samples.Reserve(NumFrames);
+	const UPath_RequestSubsystem* PathRequests = World->GetSubsystem<UPath_RequestSubsystem>();
+	FPathRequestCounters PreviousCounters = PathRequests ? PathRequests->GetCounters() : FPathRequestCounters();
+	FBenchmark_Metrics::SetEnabled(true);
+
+	// 기록과 같은 델타 타임으로 스트림 끝까지 돌린다
+	for (int32 Frame = 0; !Replay->IsReplayFinished(); ++Frame)
+	{
+		const float DeltaTime = Replay->GetReplayDeltaTime();
+		FApp::SetFixedDeltaTime(DeltaTime);
+
+		FBenchmark_Metrics::ResetFrame();
+		const double StartTime = FPlatformTime::Seconds();
+		TickWorld(World, DeltaTime);
+		const double GameThreadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		AddSample(Samples, Replay->GetNumLiveAgents(), Frame, GameThreadMs, PathRequests, PreviousCounters);
+	}
+
+	FBenchmark_Metrics::SetEnabled(false);
+	LogSummary(Samples.Num() > 0 ? Samples.Last().NumAgents : 0, Samples, 0);
+	WriteCsv(OutputPath, Samples);
+
+	Replay->StopReplay();
+	return Replay->GetDivergence().NumDivergedFrames == 0;
+}
+
+bool UBenchmark_AIStudyCommandlet::RunRangeEventsCheck(const FString& MapPath, int32 NumAgents, const FAgentMix& Mix, int32 Frames, int32 Seed, float DeltaTime, float HalfExtent)
+{
+	TArray<TArray<FStateTransition>> Polled;
+	TArray<TArray<FStateTransition>> Events;
+	if (!CollectChaserTransitions(MapPath, false, NumAgents, Mix, Frames, Seed, DeltaTime, HalfExtent, Polled)
+		|| !CollectChaserTransitions(MapPath, true, NumAgents, Mix, Frames, Seed, DeltaTime, HalfExtent, Events))
+	{
+		return false;
+	}
+
+	if (Polled.Num() != Events.Num())
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: range events check spawned %d chasers polled but %d with range events"), Polled.Num(), Events.Num());
+		return false;
+	}
+
+	int32 NumTransitions = 0;
+	int32 NumMismatched = 0;
+	for (int32 Index = 0; Index < Polled.Num(); ++Index)
+	{
+		NumTransitions += Polled[Index].Num();
+		if (Polled[Index] == Events[Index])
+		{
+			continue;
+		}
+
+		// 처음 어긋난 전환만 보여 준다
+		int32 First = 0;
+		while (Polled[Index].IsValidIndex(First) && Events[Index].IsValidIndex(First) && Polled[Index][First] == Events[Index][First])
+		{
+			++First;
+		}
+		const auto Describe = [](const TArray<FStateTransition>& Transitions, int32 TransitionIndex)
+		{
+			return Transitions.IsValidIndex(TransitionIndex)
+				? FString::Printf(TEXT("%s at frame %d"), *UEnum::GetValueAsString(Transitions[TransitionIndex].State), Transitions[TransitionIndex].Frame)
+				: FString(TEXT("none"));
+		};
+		if (NumMismatched++ < 10)
+		{
+			UE_LOG(LogAIStudy, Error, TEXT("Benchmark: chaser %d transition %d differs, polled %s, range events %s"),
+				Index, First, *Describe(Polled[Index], First), *Describe(Events[Index], First));
+		}
+	}
+
+	if (NumMismatched > 0)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: range events check failed, %d / %d chasers differ from polling"), NumMismatched, Polled.Num());
+		return false;
+	}
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: range events check passed, %d chasers, %d transitions identical to polling over %d frames"),
+		Polled.Num(), NumTransitions, Frames);
+	return true;
+}
+
+bool UBenchmark_AIStudyCommandlet::CollectChaserTransitions(const FString& MapPath, bool bRangeEvents, int32 NumAgents, const FAgentMix& Mix, int32 Frames, int32 Seed,
+	float DeltaTime, float HalfExtent, TArray<TArray<FStateTransition>>& OutTransitions)
+{
+	// 추적자는 BeginPlay에서 모드를 읽으므로 월드를 띄우기 전에 바꾼다
+	ApplyCVars(bRangeEvents ? TEXT("AIStudy.Chaser.RangeEvents=1") : TEXT("AIStudy.Chaser.RangeEvents=0"));
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	UWorld* World = LoadWorld(MapPath);
+	if (!World)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: failed to load map %s"), *MapPath);
+		return false;
+	}
+	WaitForNavigation(World, DeltaTime);
+
+	// 기록 중에는 경로 요청과 시야가 동기로 처리되어 두 실행이 같은 입력에서 같은 결과를 낸다 (스트림은 버린다)
+	UReplay_AISubsystem* Recorder = World->GetSubsystem<UReplay_AISubsystem>();
+	if (Recorder)
+	{
+		Recorder->StartRecording(Seed);
+	}
+
+	PatrolGroups.Reset();
+	Waypoints.Reset();
+	FRandomStream WaypointRandom(Seed);
+	SpawnWaypoints(World, WaypointRandom, HalfExtent);
+
+	FRandomStream Random(Seed + NumAgents);
+	TArray<APawn*> Pawns;
+	SpawnAgents(World, NumAgents, Mix, Random, HalfExtent, Pawns);
+
+	// 두 실행의 배치가 같으므로 스폰 순서로 추적자를 맞춘다
+	TArray<TWeakObjectPtr<AChaser_AIController>> Chasers;
+	for (const APawn* Pawn : Pawns)
+	{
+		if (AChaser_AIController* Chaser = Pawn ? Cast<AChaser_AIController>(Pawn->GetController()) : nullptr)
+		{
+			Chasers.Add(Chaser);
+		}
+	}
+
+	OutTransitions.SetNum(Chasers.Num());
+	TArray<EAIState> States;
+	States.Init(EAIState::Idle, Chasers.Num());
+	for (int32 Frame = 0; Frame < Frames; ++Frame)
+	{
+		TickWorld(World, DeltaTime);
+		for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+		{
+			const AChaser_AIController* Chaser = Chasers[Index].Get();
+			if (Chaser && Chaser->GetAIState() != States[Index])
+			{
+				States[Index] = Chaser->GetAIState();
+				OutTransitions[Index].Add({ Frame, States[Index] });
+			}
+		}
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: %s run, %d chasers over %d frames"), bRangeEvents ? TEXT("range events") : TEXT("polled"), Chasers.Num(), Frames);
+	if (Recorder)
+	{
+		Recorder->StopRecording(FString());
+	}
+	DestroyWorld(World);
+	return true;
+}
+
+UBenchmark_AIStudyCommandlet::FFrameSample& UBenchmark_AIStudyCommandlet::AddSample(TArray<FFrameSample>& Samples, int32 NumAgents, int32 Frame, double GameThreadMs,
+	const UPath_RequestSubsystem* PathRequests, FPathRequestCounters& PreviousCounters)
+{
+	FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.NumAgents = NumAgents;
+	Sample.Frame = Frame;
+	Sample.GameThreadMs = GameThreadMs;
+	Sample.PathfindingMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::Pathfinding);
+	Sample.AvoidanceMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::Avoidance);
+	Sample.PerceptionMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::Perception);
+	Sample.BrainMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::Brain);
+	Sample.BehaviorTreeMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::BehaviorTree);
+	Sample.AnimationMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::Animation);
+	Sample.MovementMs = FBenchmark_Metrics::GetMilliseconds(EBenchmarkMetric::Movement);
+	Sample.UsedMemoryMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+
+	if (PathRequests)
+	{
+		const FPathRequestCounters& Counters = PathRequests->GetCounters();
+		Sample.PathQueued = Counters.Queued - PreviousCounters.Queued;
+		Sample.PathServed = Counters.Served - PreviousCounters.Served;
+		Sample.PathDropped = Counters.Dropped - PreviousCounters.Dropped;
+		Sample.PathDeduped = Counters.Deduped - PreviousCounters.Deduped;
+		Sample.PathInFlight = PathRequests->GetNumInFlight();
+		PreviousCounters = Counters;
+	}
+	return Sample;
+}
+
+UWorld* UBenchmark_AIStudyCommandlet::LoadWorld(const FString& MapPath) const
+{
+	const FString PackageName = FPackageName::ObjectPathToPackageName(MapPath);
+	UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.RequiresHitProxies(false)
+			.CreatePhysicsScene(true)
+			.CreateNavigation(true)
+			.CreateAISystem(true)
+			.ShouldSimulatePhysics(true)
+			.SetTransactional(false));
+	}
+	World->UpdateWorldComponents(true, false);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+	return World;
+}
+
+void UBenchmark_AIStudyCommandlet::DestroyWorld(UWorld* World) const
+{
+	World->BeginTearingDown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void UBenchmark_AIStudyCommandlet::TickWorld(UWorld* World, float DeltaTime) const
+{
+	FApp::SetDeltaTime(DeltaTime);
+	FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaTime);
+
+	World->Tick(LEVELTICK_All, DeltaTime);
+
+	// 비동기 경로 탐색 결과 등 게임 스레드로 넘어오는 작업 처리
+	FTSTicker::GetCoreTicker().Tick(DeltaTime);
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	++GFrameCounter;
+}
+
+void UBenchmark_AIStudyCommandlet::WaitForNavigation(UWorld* World, float DeltaTime) const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Benchmark: world has no navigation system"));
+		return;
+	}
+
+	// 동적 생성 내비메시가 다 만들어질 때까지 틱
+	const int32 MaxFrames = 3000;
+	int32 Frame = 0;
+	do
+	{
+		TickWorld(World, DeltaTime);
+	}
+	while (NavSys->IsNavigationBuildInProgress() && ++Frame < MaxFrames);
+
+	if (Frame >= MaxFrames)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Benchmark: navigation build did not finish within %d frames"), MaxFrames);
+	}
+}
+
+FVector UBenchmark_AIStudyCommandlet::FindSpawnLocation(UWorld* World, FRandomStream& Random, float HalfExtent, const FVector& Center) const
+{
+	const FVector Candidate = Center + FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+
+	// 내비메시 위로 투영해야 경로 탐색이 바로 가능하다
+	FNavLocation Projected;
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (NavSys && NavSys->ProjectPointToNavigation(Candidate, Projected, FVector(500.0f, 500.0f, 5000.0f)))
+	{
+		return Projected.Location + FVector(0.0f, 0.0f, 100.0f);
+	}
+	return Candidate + FVector(0.0f, 0.0f, 100.0f);
+}
+
+void UBenchmark_AIStudyCommandlet::SpawnWaypoints(UWorld* World, FRandomStream& Random, float HalfExtent)
+{
+	// 두 개씩 짝지은 순찰 그룹. RVO 에이전트도 같은 웨이포인트를 목표로 쓴다.
+	const int32 NumGroups = 4;
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		const FName Group(*FString::Printf(TEXT("Benchmark_%d"), GroupIndex));
+		PatrolGroups.Add(Group);
+
+		for (int32 PointIndex = 0; PointIndex < 2; ++PointIndex)
+		{
+			ATargetPoint* Waypoint = World->SpawnActorDeferred<ATargetPoint>(ATargetPoint::StaticClass(), FTransform(FindSpawnLocation(World, Random, HalfExtent * 0.8f)),
+				nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			Waypoint->Tags.Add(Group);
+			Waypoint->FinishSpawning(Waypoint->GetActorTransform());
+			Waypoints.Add(Waypoint);
+		}
+	}
+}
+
+APawn* UBenchmark_AIStudyCommandlet::SpawnAgent(UWorld* World, UClass* PawnClass, UClass* ControllerClass, const FVector& Location, TFunctionRef<void(APawn*)> Configure) const
+{
+	if (UAgent_PoolSubsystem* Pool = bUsePool ? World->GetSubsystem<UAgent_PoolSubsystem>() : nullptr)
+	{
+		return Pool->Acquire(PawnClass, ControllerClass, FTransform(Location), Configure);
+	}
+
+	// BeginPlay 전에 컨트롤러가 빙의되도록 지연 스폰
+	APawn* Pawn = World->SpawnActorDeferred<APawn>(PawnClass, FTransform(Location), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Pawn)
+	{
+		return nullptr;
+	}
+
+	Pawn->AutoPossessAI = EAutoPossessAI::Spawned;
+	if (ControllerClass)
+	{
+		Pawn->AIControllerClass = ControllerClass;
+	}
+	Configure(Pawn);
+	Pawn->FinishSpawning(FTransform(Location));
+	return Pawn;
+}
+
+APawn* UBenchmark_AIStudyCommandlet::SpawnRVOAgent(UWorld* World, FRandomStream& Random, float HalfExtent, FName SquadName) const
+{
+	// 분대원은 리더 주변에 모여 리더와 같은 목표로 출발한다
+	const URVO_SquadSubsystem* Squads = SquadName.IsNone() ? nullptr : World->GetSubsystem<URVO_SquadSubsystem>();
+	const ARVO_Character* SquadLeader = Squads ? Squads->GetLeader(SquadName) : nullptr;
+	AActor* Goal = SquadLeader ? SquadLeader->TargetActor : nullptr;
+	if (!SquadLeader && Waypoints.Num() > 0)
+	{
+		Goal = Waypoints[Random.RandHelper(Waypoints.Num())];
+	}
+	const FVector Location = SquadLeader ? FindSpawnLocation(World, Random, 400.0f, SquadLeader->GetActorLocation()) : FindSpawnLocation(World, Random, HalfExtent);
+
+	// 추적자가 쫓을 수 있도록 RVO 에이전트와 순찰자에 추적 대상 태그를 단다 (풀에서 꺼낸 에이전트는 이미 달려 있다)
+	return SpawnAgent(World, RVOClass, nullptr, Location, [this, Goal, SquadName](APawn* NewPawn)
+	{
+		ARVO_Character* Agent = CastChecked<ARVO_Character>(NewPawn);
+		Agent->TargetActor = Goal;
+		Agent->SquadName = SquadName;
+		Agent->bUseFlowField = bUseFlowField;
+		Agent->bUseORCAAvoidance = bUseORCA;
+		Agent->Tags.AddUnique(USpatial_HashSubsystem::ChaserTargetTag);
+	});
+}
+
+APawn* UBenchmark_AIStudyCommandlet::SpawnChaserAgent(UWorld* World, FRandomStream& Random, float HalfExtent) const
+{
+	return SpawnAgent(World, ChaserPawnClass, AChaser_AIController::StaticClass(), FindSpawnLocation(World, Random, HalfExtent), [](APawn*) {});
+}
+
+APawn* UBenchmark_AIStudyCommandlet::SpawnNPCAgent(UWorld* World, FRandomStream& Random, float HalfExtent) const
+{
+	// 폰은 추적자와 같고 컨트롤러가 행동 트리를 돌린다
+	return SpawnAgent(World, ChaserPawnClass, NPCControllerClass, FindSpawnLocation(World, Random, HalfExtent), [](APawn*) {});
+}
+
+APawn* UBenchmark_AIStudyCommandlet::SpawnPatrolAgent(UWorld* World, FRandomStream& Random, float HalfExtent, FName Group) const
+{
+	return SpawnAgent(World, PatrolClass, AAIController::StaticClass(), FindSpawnLocation(World, Random, HalfExtent), [this, Group](APawn* NewPawn)
+	{
+		AAIStudyCharacter* Agent = CastChecked<AAIStudyCharacter>(NewPawn);
+		Agent->PatrolGroup = Group;
+		Agent->bUsePredictiveNavInvoker = bUsePredictiveInvoker;
+		Agent->Tags.AddUnique(USpatial_HashSubsystem::ChaserTargetTag);
+	});
+}
+
+void UBenchmark_AIStudyCommandlet::SpawnAgents(UWorld* World, int32 NumAgents, const FAgentMix& Mix, FRandomStream& Random, float HalfExtent, TArray<APawn*>& OutPawns) const
+{
+	int32 NumRVO = 0;
+	int32 NumChasers = 0;
+	int32 NumPatrol = 0;
+	int32 NumNPC = 0;
+	SplitMix(NumAgents, Mix, NumRVO, NumChasers, NumPatrol, NumNPC);
+	OutPawns.Reserve(NumAgents);
+
+	for (int32 Index = 0; Index < NumRVO; ++Index)
+	{
+		// -Squad: 연속한 SquadSize명이 한 분대 (첫 번째가 리더)
+		const FName SquadName = SquadSize > 1 ? FName(*FString::Printf(TEXT("Benchmark_Squad_%d"), Index / SquadSize)) : NAME_None;
+		if (APawn* Pawn = SpawnRVOAgent(World, Random, HalfExtent, SquadName))
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+
+	for (int32 Index = 0; Index < NumChasers; ++Index)
+	{
+		if (APawn* Pawn = SpawnChaserAgent(World, Random, HalfExtent))
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+
+	for (int32 Index = 0; Index < NumPatrol; ++Index)
+	{
+		const FName Group = PatrolGroups.Num() > 0 ? PatrolGroups[Index % PatrolGroups.Num()] : NAME_None;
+		if (APawn* Pawn = SpawnPatrolAgent(World, Random, HalfExtent, Group))
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+
+	for (int32 Index = 0; Index < NumNPC; ++Index)
+	{
+		if (APawn* Pawn = SpawnNPCAgent(World, Random, HalfExtent))
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: spawned %d agents (RVO %d, chasers %d, patrol %d, NPC %d)"), OutPawns.Num(), NumRVO, NumChasers, NumPatrol, NumNPC);
+}
+
+void UBenchmark_AIStudyCommandlet::SpawnMassAgents(UWorld* World, int32 NumAgents, const FAgentMix& Mix, FRandomStream& Random, float HalfExtent, TArray<FMassEntityHandle>& OutEntities) const
+{
+	UMass_AgentSubsystem* MassAgents = World->GetSubsystem<UMass_AgentSubsystem>();
+	if (!MassAgents)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: Mass agent subsystem is not available (is the MassGameplay plugin enabled?)"));
+		return;
+	}
+
+	// 승격되는 액터도 액터 모드와 같은 클래스를 쓴다
+	MassAgents->RVOActorClass = RVOClass;
+	MassAgents->ChaserPawnClass = ChaserPawnClass;
+	MassAgents->PatrolActorClass = PatrolClass;
+
+	int32 NumRVO = 0;
+	int32 NumChasers = 0;
+	int32 NumPatrol = 0;
+	int32 NumNPC = 0;
+	SplitMix(NumAgents, Mix, NumRVO, NumChasers, NumPatrol, NumNPC);
+	if (NumNPC > 0)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Benchmark: %d behavior tree NPCs have no Mass representation and are skipped"), NumNPC);
+	}
+
+	// 액터 모드와 같은 순서로 난수를 써서 배치가 같게 나오도록 한다
+	TArray<FMassAgentSpawnParams> Params;
+	Params.Reserve(NumAgents);
+	for (int32 Index = 0; Index < NumRVO; ++Index)
+	{
+		FMassAgentSpawnParams& Param = Params.AddDefaulted_GetRef();
+		Param.Type = EMassAgentType::RVO;
+		Param.Goal = Waypoints.Num() > 0 ? Waypoints[Random.RandHelper(Waypoints.Num())] : nullptr;
+		Param.Location = FindSpawnLocation(World, Random, HalfExtent);
+	}
+	for (int32 Index = 0; Index < NumChasers; ++Index)
+	{
+		FMassAgentSpawnParams& Param = Params.AddDefaulted_GetRef();
+		Param.Type = EMassAgentType::Chaser;
+		Param.Location = FindSpawnLocation(World, Random, HalfExtent);
+	}
+	for (int32 Index = 0; Index < NumPatrol; ++Index)
+	{
+		// 순찰 그룹은 두 웨이포인트씩 순서대로 생성되어 있다
+		const int32 GroupIndex = PatrolGroups.Num() > 0 ? Index % PatrolGroups.Num() : INDEX_NONE;
+		FMassAgentSpawnParams& Param = Params.AddDefaulted_GetRef();
+		Param.Type = EMassAgentType::Patrol;
+		Param.PatrolA = Waypoints.IsValidIndex(GroupIndex * 2 + 1) ? Waypoints[GroupIndex * 2] : nullptr;
+		Param.PatrolB = Waypoints.IsValidIndex(GroupIndex * 2 + 1) ? Waypoints[GroupIndex * 2 + 1] : nullptr;
+		Param.Location = FindSpawnLocation(World, Random, HalfExtent);
+	}
+
+	MassAgents->SpawnAgents(Params, OutEntities);
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark: spawned %d Mass agents (RVO %d, chasers %d, patrol %d)"), OutEntities.Num(), NumRVO, NumChasers, NumPatrol);
+}
+
+void UBenchmark_AIStudyCommandlet::ReleaseAgent(UWorld* World, APawn* Pawn) const
+{
+	if (!IsValid(Pawn))
+	{
+		return;
+	}
+	if (UAgent_PoolSubsystem* Pool = bUsePool ? World->GetSubsystem<UAgent_PoolSubsystem>() : nullptr)
+	{
+		Pool->Release(Pawn);
+		return;
+	}
+	if (AController* Controller = Pawn->GetController())
+	{
+		Controller->Destroy();
+	}
+	Pawn->Destroy();
+}
+
+void UBenchmark_AIStudyCommandlet::DestroyAgents(UWorld* World, TArray<APawn*>& Pawns) const
+{
+	for (APawn* Pawn : Pawns)
+	{
+		ReleaseAgent(World, Pawn);
+	}
+	Pawns.Reset();
+
+	// 다음 단계 측정에 이전 단계의 정리 비용이 섞이지 않도록 한 프레임 돌리고 GC
+	TickWorld(World, FApp::GetFixedDeltaTime());
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void UBenchmark_AIStudyCommandlet::ChurnAgents(UWorld* World, TArray<APawn*>& Pawns, int32 Count, FRandomStream& Random, float HalfExtent) const
+{
+	if (Pawns.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 Churned = 0; Churned < Count; ++Churned)
+	{
+		const int32 Index = Random.RandHelper(Pawns.Num());
+		APawn* Pawn = Pawns[Index];
+		if (!IsValid(Pawn))
+		{
+			continue;
+		}
+
+		// 같은 종류로 다시 스폰해 구성 비율을 유지한다
+		const bool bRVO = Pawn->IsA<ARVO_Character>();
+		const bool bPatrol = !bRVO && Pawn->IsA<AAIStudyCharacter>();
+		const bool bNPC = Pawn->GetController() && Pawn->GetController()->IsA(NPCControllerClass);
+		const FName SquadName = bRVO ? CastChecked<ARVO_Character>(Pawn)->GetSquadName() : NAME_None;
+		ReleaseAgent(World, Pawn);
+		if (bNPC)
+		{
+			Pawns[Index] = SpawnNPCAgent(World, Random, HalfExtent);
+		}
+		else if (bRVO)
+		{
+			Pawns[Index] = SpawnRVOAgent(World, Random, HalfExtent, SquadName);
+		}
+		else if (bPatrol)
+		{
+			const FName Group = PatrolGroups.Num() > 0 ? PatrolGroups[Random.RandHelper(PatrolGroups.Num())] : NAME_None;
+			Pawns[Index] = SpawnPatrolAgent(World, Random, HalfExtent, Group);
+		}
+		else
+		{
+			Pawns[Index] = SpawnChaserAgent(World, Random, HalfExtent);
+		}
+	}
+
+	// 엔진 루프처럼 파괴된 액터가 쌓이면 GC를 돌린다 (주기는 gc.TimeBetweenPurgingPendingKillObjects)
+	GEngine->ConditionalCollectGarbage();
+}
+
+void UBenchmark_AIStudyCommandlet::RunPathQueryBenchmark(UWorld* World, int32 NumQueries, FRandomStream& Random, float HalfExtent, float DeltaTime, const FString& OutputPath) const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	UNav_HierarchicalSubsystem* Hierarchical = World->GetSubsystem<UNav_HierarchicalSubsystem>();
+	if (!NavData || !Hierarchical)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: path query benchmark needs a navmesh"));
+		return;
+	}
+
+	// 그래프 빌드는 프레임 예산으로 나뉘어 있으므로 다 만들어질 때까지 월드를 돌린다
+	Hierarchical->RequestGraph();
+	for (int32 Frame = 0; Frame < 100000; ++Frame)
+	{
+		TickWorld(World, DeltaTime);
+		if (Frame > 0 && Hierarchical->GetNumClusters() > 0 && Hierarchical->GetNumDirtyClusters() == 0)
+		{
+			break;
+		}
+	}
+	Hierarchical->LogReport();
+
+	const FSharedConstNavQueryFilter Filter = NavData->GetDefaultQueryFilter();
+	FString Csv = TEXT("Query,StraightDistance,VanillaLength,VanillaMs,HierarchicalLength,HierarchicalMs,UsedHierarchical\n");
+	int32 NumCompared = 0;
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		const FVector Start = FindSpawnLocation(World, Random, HalfExtent);
+		const FVector End = FindSpawnLocation(World, Random, HalfExtent);
+
+		FPathFindingQuery Query(nullptr, *NavData, Start, End, Filter);
+		double StartTime = FPlatformTime::Seconds();
+		const FPathFindingResult Vanilla = NavData->FindPath(NavData->GetConfig(), Query);
+		const double VanillaMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		if (!Vanilla.IsSuccessful() || Vanilla.IsPartial())
+		{
+			continue;
+		}
+
+		// 계층 탐색이 거절하면 일반 탐색으로 대체되므로 그 시간까지 포함해 비교한다
+		StartTime = FPlatformTime::Seconds();
+		FNavPathSharedPtr Path = Hierarchical->ShouldUseHierarchical(*NavData, Start, End) ? Hierarchical->FindPath(*NavData, Start, End, Filter) : nullptr;
+		const bool bUsedHierarchical = Path.IsValid();
+		if (!bUsedHierarchical)
+		{
+			const FPathFindingResult Fallback = NavData->FindPath(NavData->GetConfig(), Query);
+			Path = Fallback.Path;
+		}
+		const double HierarchicalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Csv += FString::Printf(TEXT("%d,%.0f,%.0f,%.4f,%.0f,%.4f,%d\n"), Index, FVector::Dist(Start, End), Vanilla.Path->GetLength(), VanillaMs,
+			Path.IsValid() ? Path->GetLength() : -1.0, HierarchicalMs, bUsedHierarchical ? 1 : 0);
+		++NumCompared;
+	}
+
+	Hierarchical->LogReport();
+	if (FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogAIStudy, Display, TEXT("Benchmark: wrote %d path queries to %s"), NumCompared, *OutputPath);
+	}
+	else
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: failed to write %s"), *OutputPath);
+	}
+}
+
+void UBenchmark_AIStudyCommandlet::ApplyCVars(const FString& CVarList)
+{
+	TArray<FString> Entries;
+	CVarList.ParseIntoArray(Entries, TEXT(","));
+	for (const FString& Entry : Entries)
+	{
+		FString Name;
+		FString Value;
+		if (!Entry.Split(TEXT("="), &Name, &Value))
+		{
+			continue;
+		}
+
+		if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(*Name))
+		{
+			CVar->Set(*Value, ECVF_SetByCode);
+			UE_LOG(LogAIStudy, Display, TEXT("Benchmark: %s = %s"), *Name, *Value);
+		}
+		else
+		{
+			UE_LOG(LogAIStudy, Warning, TEXT("Benchmark: unknown console variable %s"), *Name);
+		}
+	}
+}
+
+UBenchmark_AIStudyCommandlet::FAgentMix UBenchmark_AIStudyCommandlet::ParseMix(const FString& MixString)
+{
+	FAgentMix Mix;
+	if (MixString.IsEmpty())
+	{
+		return Mix;
+	}
+
+	// 지정한 종류만 스폰
+	Mix.RVO = Mix.Chaser = Mix.Patrol = Mix.NPC = 0.0f;
+	TArray<FString> Entries;
+	MixString.ParseIntoArray(Entries, TEXT(","));
+	for (const FString& Entry : Entries)
+	{
+		FString Name;
+		FString Weight = TEXT("1");
+		if (!Entry.Split(TEXT(":"), &Name, &Weight))
+		{
+			Name = Entry;
+		}
+
+		const float Value = FMath::Max(FCString::Atof(*Weight), 0.0f);
+		if (Name.Equals(TEXT("RVO"), ESearchCase::IgnoreCase))
+		{
+			Mix.RVO = Value;
+		}
+		else if (Name.Equals(TEXT("Chaser"), ESearchCase::IgnoreCase))
+		{
+			Mix.Chaser = Value;
+		}
+		else if (Name.Equals(TEXT("Patrol"), ESearchCase::IgnoreCase))
+		{
+			Mix.Patrol = Value;
+		}
+		else if (Name.Equals(TEXT("NPC"), ESearchCase::IgnoreCase))
+		{
+			Mix.NPC = Value;
+		}
+	}
+	return Mix;
+}
+
+void UBenchmark_AIStudyCommandlet::SplitMix(int32 NumAgents, const FAgentMix& Mix, int32& OutNumRVO, int32& OutNumChasers, int32& OutNumPatrol, int32& OutNumNPC)
+{
+	const float TotalWeight = FMath::Max(Mix.RVO + Mix.Chaser + Mix.Patrol + Mix.NPC, UE_SMALL_NUMBER);
+	OutNumRVO = FMath::RoundToInt32(NumAgents * Mix.RVO / TotalWeight);
+	OutNumChasers = FMath::RoundToInt32(NumAgents * Mix.Chaser / TotalWeight);
+	OutNumNPC = FMath::RoundToInt32(NumAgents * Mix.NPC / TotalWeight);
+	OutNumPatrol = FMath::Max(NumAgents - OutNumRVO - OutNumChasers - OutNumNPC, 0);
+}
+
+void UBenchmark_AIStudyCommandlet::WriteCsv(const FString& Path, const TArray<FFrameSample>& Samples)
+{
+	FString Csv = TEXT("Agents,Frame,GameThreadMs,PathfindingMs,AvoidanceMs,PerceptionMs,BrainMs,BehaviorTreeMs,AnimationMs,MovementMs,UsedMemoryMB,PathQueued,PathServed,PathDropped,PathDeduped,PathInFlight,RVOHeadingChangeDeg\n");
+	for (const FFrameSample& Sample : Samples)
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f,%llu,%llu,%llu,%llu,%d,%.3f\n"),
+			Sample.NumAgents, Sample.Frame, Sample.GameThreadMs, Sample.PathfindingMs, Sample.AvoidanceMs, Sample.PerceptionMs, Sample.BrainMs, Sample.BehaviorTreeMs, Sample.AnimationMs, Sample.MovementMs,
+			Sample.UsedMemoryMB, Sample.PathQueued, Sample.PathServed, Sample.PathDropped, Sample.PathDeduped, Sample.PathInFlight, Sample.RVOHeadingChangeDeg);
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogAIStudy, Display, TEXT("Benchmark: wrote %d frames to %s"), Samples.Num(), *Path);
+	}
+	else
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Benchmark: failed to write %s"), *Path);
+	}
+}
+
+void UBenchmark_AIStudyCommandlet::LogSummary(int32 NumAgents, const TArray<FFrameSample>& Samples, int32 FirstSample)
+{
+	const int32 NumFrames = Samples.Num() - FirstSample;
+	if (NumFrames <= 0)
+	{
+		return;
+	}
+
+	TArray<double> GameThreadTimes;
+	GameThreadTimes.Reserve(NumFrames);
+	double PathfindingMs = 0.0;
+	double AvoidanceMs = 0.0;
+	double PerceptionMs = 0.0;
+	double BrainMs = 0.0;
+	double BehaviorTreeMs = 0.0;
+	double AnimationMs = 0.0;
+	double MovementMs = 0.0;
+	uint64 PathQueued = 0;
+	uint64 PathServed = 0;
+	double HeadingChangeDeg = 0.0;
+	for (int32 Index = FirstSample; Index < Samples.Num(); ++Index)
+	{
+		GameThreadTimes.Add(Samples[Index].GameThreadMs);
+		PathfindingMs += Samples[Index].PathfindingMs;
+		AvoidanceMs += Samples[Index].AvoidanceMs;
+		PerceptionMs += Samples[Index].PerceptionMs;
+		BrainMs += Samples[Index].BrainMs;
+		BehaviorTreeMs += Samples[Index].BehaviorTreeMs;
+		AnimationMs += Samples[Index].AnimationMs;
+		MovementMs += Samples[Index].MovementMs;
+		PathQueued += Samples[Index].PathQueued;
+		PathServed += Samples[Index].PathServed;
+		HeadingChangeDeg += Samples[Index].RVOHeadingChangeDeg;
+	}
+	GameThreadTimes.Sort();
+
+	double Total = 0.0;
+	for (const double Time : GameThreadTimes)
+	{
+		Total += Time;
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark N=%d: game thread avg %.3f ms, p95 %.3f ms, max %.3f ms | pathfinding %.3f, avoidance %.3f, perception %.3f, brain %.3f, behavior tree %.3f, animation %.3f, movement %.3f ms/frame (%.4f ms/agent)"),
+		NumAgents, Total / NumFrames, GameThreadTimes[FMath::Min(FMath::FloorToInt32(NumFrames * 0.95), NumFrames - 1)], GameThreadTimes.Last(),
+		PathfindingMs / NumFrames, AvoidanceMs / NumFrames, PerceptionMs / NumFrames, BrainMs / NumFrames, BehaviorTreeMs / NumFrames, AnimationMs / NumFrames,
+		MovementMs / NumFrames, NumAgents > 0 ? MovementMs / NumFrames / NumAgents : 0.0);
+	UE_LOG(LogAIStudy, Display, TEXT("Benchmark N=%d: path requests %.2f queued / %.2f served per frame, RVO heading change %.3f deg/frame"),
+		NumAgents, static_cast<double>(PathQueued) / NumFrames, static_cast<double>(PathServed) / NumFrames, HeadingChangeDeg / NumFrames);
+}
+
+double UBenchmark_AIStudyCommandlet::MeasureHeadingChange(const TArray<APawn*>& Pawns, TMap<const APawn*, FVector>& InOutHeadings)
+{
+	double TotalDegrees = 0.0;
+	int32 NumMeasured = 0;
+	for (const APawn* Pawn : Pawns)
+	{
+		// 서 있는 에이전트의 방향은 의미가 없으므로 뺀다
+		const FVector Velocity = IsValid(Pawn) && Pawn->IsA<ARVO_Character>() ? Pawn->GetVelocity() : FVector::ZeroVector;
+		if (Velocity.SizeSquared2D() < FMath::Square(10.0))
+		{
+			InOutHeadings.Remove(Pawn);
+			continue;
+		}
+
+		const FVector Heading = Velocity.GetSafeNormal2D();
+		if (const FVector* PreviousHeading = InOutHeadings.Find(Pawn))
+		{
+			TotalDegrees += FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(Heading | *PreviousHeading, -1.0, 1.0)));
+			++NumMeasured;
+		}
+		InOutHeadings.Add(Pawn, Heading);
+	}
+	return NumMeasured > 0 ? TotalDegrees / NumMeasured : 0.0;
+}
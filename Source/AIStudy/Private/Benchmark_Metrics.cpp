@@ -0,0 +1,18 @@
+#include "Benchmark_Metrics.h"
+
+bool FBenchmark_Metrics::bEnabled = false;
+double FBenchmark_Metrics::Seconds[static_cast<int32>(EBenchmarkMetric::MAX)] = {};
+
+void FBenchmark_Metrics::SetEnabled(bool bInEnabled)
+{
+	bEnabled = bInEnabled;
+	ResetFrame();
+}
+
+void FBenchmark_Metrics::ResetFrame()
+{
+	for (double& Value : Seconds)
+	{
+		Value = 0.0;
+	}
+}
@@ -1,5 +1,27 @@
 #include "Chaser_AIController.h"
+#include "Chaser_BrainSubsystem.h"
+#include "Chaser_RangeEventSubsystem.h"
+#include "Path_RequestSubsystem.h"
+#include "Spatial_HashSubsystem.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "Perception_BatchedSightSubsystem.h"
+#include "Replay_AISubsystem.h"
+#include "Benchmark_Metrics.h"
+#include "AIStudy.h"
 #include "GameFramework/Character.h"
+#include "Perception/AISense_Sight.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Chaser Tick"), STAT_Chaser_Tick, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser UpdateAIState"), STAT_Chaser_UpdateAIState, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser RefreshTarget"), STAT_Chaser_RefreshTarget, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser MoveTowardTarget"), STAT_Chaser_MoveTowardTarget, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser OnPerceptionUpdated"), STAT_Chaser_OnPerceptionUpdated, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarChaserRangeEvents(
+    TEXT("AIStudy.Chaser.RangeEvents"),
+    false,
+    TEXT("켜면 BeginPlay에서 모든 추적자를 폴링 대신 범위 이벤트 서브시스템에 등록 (bUseRangeEvents와 같음)"));
 
 AChaser_AIController::AChaser_AIController()
 {
@@ -41,16 +63,165 @@ void AChaser_AIController::BeginPlay()
     {
         TargetActor = PlayerCharacter;  // ACharacter*는 AActor*로 암시적으로 변환 가능
     }
+
+    RegisterWithSubsystems();
+}
+
+void AChaser_AIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UnregisterFromSubsystems();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AChaser_AIController::RegisterWithSubsystems()
+{
+    // 범위 이벤트 모드에서는 반경 경계를 넘을 때만 평가하므로 개별 Tick과 브레인 폴링을 모두 쓰지 않는다
+    UChaser_RangeEventSubsystem* RangeEvents = (bUseRangeEvents || CVarChaserRangeEvents.GetValueOnGameThread()) ? GetWorld()->GetSubsystem<UChaser_RangeEventSubsystem>() : nullptr;
+    if (RangeEvents)
+    {
+        RangeEvents->RegisterChaser(this);
+        SetActorTickEnabled(false);
+    }
+    // 브레인 서브시스템에 등록하면 상태 갱신은 서브시스템이 일괄 처리하므로 개별 Tick은 끈다
+    else if (bUseBrainSubsystem)
+    {
+        if (UChaser_BrainSubsystem* Brain = GetWorld()->GetSubsystem<UChaser_BrainSubsystem>())
+        {
+            Brain->RegisterChaser(this);
+            SetActorTickEnabled(false);
+        }
+    }
+
+    // 일괄 시야를 쓰면 엔진 시야 감각은 꺼서 같은 이벤트가 두 번 오지 않게 한다
+    if (bUseBatchedSight)
+    {
+        if (UPerception_BatchedSightSubsystem* Sight = GetWorld()->GetSubsystem<UPerception_BatchedSightSubsystem>())
+        {
+            Sight->RegisterObserver(this);
+            if (GetPerceptionComponent())
+            {
+                GetPerceptionComponent()->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
+            }
+        }
+    }
+}
+
+void AChaser_AIController::UnregisterFromSubsystems()
+{
+    if (BrainIndex != INDEX_NONE)
+    {
+        if (UChaser_BrainSubsystem* Brain = GetWorld()->GetSubsystem<UChaser_BrainSubsystem>())
+        {
+            Brain->UnregisterChaser(this);
+        }
+    }
+
+    if (RangeEventIndex != INDEX_NONE)
+    {
+        if (UChaser_RangeEventSubsystem* RangeEvents = GetWorld()->GetSubsystem<UChaser_RangeEventSubsystem>())
+        {
+            RangeEvents->UnregisterChaser(this);
+        }
+    }
+
+    if (SightIndex != INDEX_NONE)
+    {
+        if (UPerception_BatchedSightSubsystem* Sight = GetWorld()->GetSubsystem<UPerception_BatchedSightSubsystem>())
+        {
+            Sight->UnregisterObserver(this);
+        }
+    }
+}
+
+void AChaser_AIController::OnPoolAcquired()
+{
+    // BeginPlay와 같은 바인딩/등록을 다시 한다
+    if (UAIPerceptionComponent* Perception = GetPerceptionComponent())
+    {
+        Perception->OnTargetPerceptionUpdated.RemoveDynamic(this, &AChaser_AIController::OnPerceptionUpdated);
+        Perception->OnTargetPerceptionUpdated.AddDynamic(this, &AChaser_AIController::OnPerceptionUpdated);
+    }
+
+    if (ACharacter* PlayerCharacter = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0))
+    {
+        TargetActor = PlayerCharacter;
+    }
+
+    // 빙의는 풀에서도 유지되므로 OnPossess 대신 여기서 LOD 대상으로 다시 등록
+    if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+    {
+        Significance->RegisterAgent(GetPawn());
+    }
+
+    RegisterWithSubsystems();
+    WakeRangeEvents();
+}
+
+void AChaser_AIController::OnPoolReleased()
+{
+    UnregisterFromSubsystems();
+
+    if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+    {
+        Significance->UnregisterAgent(GetPawn());
+    }
+
+    // 이전 대상에 대한 감지 기록과 바인딩을 지워 다음 사용자에게 이벤트가 넘어가지 않게 한다
+    if (UAIPerceptionComponent* Perception = GetPerceptionComponent())
+    {
+        Perception->OnTargetPerceptionUpdated.RemoveDynamic(this, &AChaser_AIController::OnPerceptionUpdated);
+        Perception->ForgetAll();
+    }
+
+    if (UPath_RequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+    {
+        PathRequests->CancelRequest(this);
+    }
+    StopMovement();
+
+    // 클래스 기본값으로 되돌린다
+    const AChaser_AIController* Defaults = GetClass()->GetDefaultObject<AChaser_AIController>();
+    TargetActor = Defaults->TargetActor;
+    bIsChasing = false;
+    CurrentState = EAIState::Idle;
+    LastKnownLocation = FVector::ZeroVector;
+}
+
+void AChaser_AIController::OnPossess(APawn* InPawn)
+{
+    Super::OnPossess(InPawn);
+
+    // 조종하는 폰을 LOD 대상으로 등록
+    if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+    {
+        Significance->RegisterAgent(InPawn);
+    }
+
+    WakeRangeEvents();
+}
+
+void AChaser_AIController::OnUnPossess()
+{
+    if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+    {
+        Significance->UnregisterAgent(GetPawn());
+    }
+
+    Super::OnUnPossess();
 }
 
 
 // Tick 이벤트는 아래 코드로 변경해주세요. 기존 코드와 유사하지만 디버그 시각화를 추가했습니다.
 void AChaser_AIController::Tick(float DeltaTime)
 {
+    AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Chaser_Tick);
+
     Super::Tick(DeltaTime);
     
     // 상태 업데이트 추가
     UpdateAIState();
+    CountState();
     
 
     if (bIsChasing && TargetActor)
@@ -62,24 +233,7 @@ void AChaser_AIController::Tick(float DeltaTime)
             
             if (Distance <= ChaseRadius)
             {
-                MoveToActor(TargetActor, 100.0f);
-                
-                // 마지막 위치 갱신 추가
-                LastKnownLocation = TargetActor->GetActorLocation();
-                
-                // 디버그 시각화 추가
-                #if WITH_EDITOR
-                DrawDebugLine(
-                    GetWorld(),
-                    ControlledPawn->GetActorLocation(),
-                    TargetActor->GetActorLocation(),
-                    FColor::Red,
-                    false,
-                    -1.0f,
-                    0,
-                    2.0f
-                );
-                #endif
+                MoveTowardTarget(ControlledPawn);
             }
             else if (Distance > LoseInterestRadius)  // 확장된 조건
             {
@@ -89,6 +243,27 @@ void AChaser_AIController::Tick(float DeltaTime)
     }
 }
 
+// Tick과 브레인 서브시스템이 공유하는 추적 이동 처리
+void AChaser_AIController::MoveTowardTarget(APawn* ControlledPawn)
+{
+    AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Chaser_MoveTowardTarget);
+    AISTUDY_INC_COUNTER(MoveToCalls);
+
+    // 스케줄러는 목표가 임계 거리 이상 움직였을 때만 새 경로를 요청한다
+    UPath_RequestSubsystem* PathRequests = bUsePathRequestScheduler ? GetWorld()->GetSubsystem<UPath_RequestSubsystem>() : nullptr;
+    if (PathRequests)
+    {
+        PathRequests->RequestMoveToActor(this, TargetActor, 100.0f, EPathRequestPriority::Chase);
+    }
+    else
+    {
+        MoveToActor(TargetActor, 100.0f);
+    }
+    
+    // 마지막 위치 갱신 추가
+    LastKnownLocation = TargetActor->GetActorLocation();
+}
+
 // StartChasing과 StopChasing도 업데이트 해주세요
 void AChaser_AIController::StartChasing(AActor* Target)
 {
@@ -103,21 +278,34 @@ void AChaser_AIController::StartChasing(AActor* Target)
     
     // 상태 변경 추가
     CurrentState = EAIState::Chasing;
+    WakeRangeEvents();
 }
 
 void AChaser_AIController::StopChasing()
 {
     bIsChasing = false;
+
+    // 대기 중인 경로 요청이 도착해 다시 움직이지 않도록 취소
+    if (UPath_RequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+    {
+        PathRequests->CancelRequest(this);
+    }
     StopMovement();
     
     // 상태 변경 추가
     CurrentState = EAIState::Idle;
+    WakeRangeEvents();
 }
 
 
 // Status별 상태 전환 함수를 추가해줍니다.
 void AChaser_AIController::UpdateAIState()
 {
+    AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Chaser_UpdateAIState);
+
+    // 가장 가까운 추적 대상으로 타겟 갱신
+    RefreshTarget();
+
     if (!TargetActor) return;
     
     APawn* ControlledPawn = GetPawn();
@@ -154,13 +342,97 @@ void AChaser_AIController::UpdateAIState()
     }
 }
 
+void AChaser_AIController::RefreshTarget()
+{
+    AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Chaser_RefreshTarget);
+
+    if (!bUseSpatialTargetSelection)
+    {
+        return;
+    }
+
+    const APawn* ControlledPawn = GetPawn();
+    const USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>();
+    if (!ControlledPawn || !SpatialHash)
+    {
+        return;
+    }
+
+    // 가장 큰 반경(LoseInterestRadius) 안에서 찾고, 없으면 기존 타겟을 유지해 거리 판정으로 추적을 끝낸다
+    if (APawn* Nearest = SpatialHash->FindNearestTarget(ControlledPawn->GetActorLocation(), LoseInterestRadius, ControlledPawn))
+    {
+        TargetActor = Nearest;
+    }
+}
+
+void AChaser_AIController::CountState() const
+{
+    switch (CurrentState)
+    {
+        case EAIState::Idle:
+            AISTUDY_INC_COUNTER(ChasersIdle);
+            break;
+        case EAIState::Suspicious:
+            AISTUDY_INC_COUNTER(ChasersSuspicious);
+            break;
+        case EAIState::Chasing:
+            AISTUDY_INC_COUNTER(ChasersChasing);
+            break;
+    }
+}
+
+void AChaser_AIController::WakeRangeEvents()
+{
+    if (RangeEventIndex != INDEX_NONE)
+    {
+        if (UChaser_RangeEventSubsystem* RangeEvents = GetWorld()->GetSubsystem<UChaser_RangeEventSubsystem>())
+        {
+            RangeEvents->WakeChaser(this);
+        }
+    }
+}
+
+bool AChaser_AIController::IsChaseTarget(const AActor* Actor) const
+{
+    if (!Actor)
+    {
+        return false;
+    }
+
+    if (bUseSpatialTargetSelection && GetWorld()->GetSubsystem<USpatial_HashSubsystem>())
+    {
+        return USpatial_HashSubsystem::IsValidTarget(Actor);
+    }
+
+    // 플레이어 캐릭터인지 확인
+    return Actor == UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+}
+
 // 인지 시스템의 이벤트 발생시 처리하는 함수 추가.
 void AChaser_AIController::OnPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
-    // 플레이어 캐릭터인지 확인
-    ACharacter* PlayerCharacter = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
-    
-    if (Actor && PlayerCharacter && Actor == PlayerCharacter)
+    AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Chaser_OnPerceptionUpdated);
+    AISTUDY_BENCHMARK_SCOPE(Perception);
+
+    // 기록 중이면 이벤트를 남기고, 재생 중이면 기록된 이벤트만 받는다
+    if (UReplay_AISubsystem* Replay = GetWorld()->GetSubsystem<UReplay_AISubsystem>())
+    {
+        if (!Replay->FilterPerception(this, Actor, Stimulus))
+        {
+            return;
+        }
+    }
+
+    AISTUDY_INC_COUNTER(PerceptionEvents);
+
+    // 잠들 때 시야를 끄면서 생기는 감지 실패 이벤트는 무시한다
+    const UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>();
+    if (Significance && Significance->IsDormant(GetPawn()))
+    {
+        return;
+    }
+
+    if (IsChaseTarget(Actor))
     {
         if (Stimulus.WasSuccessfullySensed())
         {
@@ -189,11 +461,23 @@ void AChaser_AIController::OnPerceptionUpdated(AActor* Actor, FAIStimulus Stimul
             if (CurrentState == EAIState::Chasing)
             {
                 // 마지막으로 본 위치로 이동
-                MoveToLocation(LastKnownLocation, 50.0f);
+                UPath_RequestSubsystem* PathRequests = bUsePathRequestScheduler ? GetWorld()->GetSubsystem<UPath_RequestSubsystem>() : nullptr;
+                AISTUDY_INC_COUNTER(MoveToCalls);
+                if (PathRequests)
+                {
+                    PathRequests->RequestMoveToLocation(this, LastKnownLocation, 50.0f, EPathRequestPriority::Normal);
+                }
+                else
+                {
+                    MoveToLocation(LastKnownLocation, 50.0f);
+                }
                 
                 // 의심 상태로 전환
                 CurrentState = EAIState::Suspicious;
             }
         }
+
+        // 인지 이벤트로 바뀐 타겟/상태는 범위 경계와 무관하므로 다음 갱신에서 다시 평가
+        WakeRangeEvents();
     }
 }
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "Chaser_BrainSubsystem.h"
+#include "AIStudy.h"
+#include "Benchmark_Metrics.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Chaser Brain Tick"), STAT_ChaserBrain_Tick, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser Brain Gather"), STAT_ChaserBrain_Gather, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser Brain Evaluate"), STAT_ChaserBrain_Evaluate, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser Brain Apply"), STAT_ChaserBrain_Apply, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Registered Chasers"), STAT_ChaserBrain_NumChasers, STATGROUP_AIStudy);
+
+bool UChaser_BrainSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UChaser_BrainSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UChaser_BrainSubsystem, STATGROUP_Tickables);
+}
+
+void UChaser_BrainSubsystem::RegisterChaser(AChaser_AIController* Chaser)
+{
+	if (!Chaser || Chaser->BrainIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Chaser->BrainIndex = Controllers.Add(Chaser);
+
+	// SoA 배열은 항상 Controllers와 같은 길이를 유지
+	PawnLocations.AddZeroed();
+	TargetLocations.AddZeroed();
+	DistanceSquared.AddZeroed();
+	DetectionRadiusSq.AddZeroed();
+	ChaseRadiusSq.AddZeroed();
+	LoseInterestRadiusSq.AddZeroed();
+	States.Add(Chaser->CurrentState);
+	NewStates.Add(Chaser->CurrentState);
+	Chasing.AddZeroed();
+	Valid.AddZeroed();
+	Actions.AddZeroed();
+	NeedsControlRotation.AddZeroed();
+	UpdateIntervals.AddZeroed();
+	ElapsedTimes.AddZeroed();
+	Due.AddZeroed();
+}
+
+void UChaser_BrainSubsystem::UnregisterChaser(AChaser_AIController* Chaser)
+{
+	if (!Chaser || !Controllers.IsValidIndex(Chaser->BrainIndex) || Controllers[Chaser->BrainIndex] != Chaser)
+	{
+		return;
+	}
+
+	const int32 Index = Chaser->BrainIndex;
+	Chaser->BrainIndex = INDEX_NONE;
+
+	// 마지막 원소를 빈 자리로 옮겨 배열을 연속으로 유지
+	Controllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PawnLocations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TargetLocations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DistanceSquared.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DetectionRadiusSq.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ChaseRadiusSq.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LoseInterestRadiusSq.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	States.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	NewStates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Chasing.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Valid.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Actions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	NeedsControlRotation.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	UpdateIntervals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ElapsedTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Due.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (Controllers.IsValidIndex(Index) && Controllers[Index])
+	{
+		Controllers[Index]->BrainIndex = Index;
+	}
+}
+
+void UChaser_BrainSubsystem::SetUpdateInterval(AChaser_AIController* Chaser, float Interval)
+{
+	if (Chaser && Controllers.IsValidIndex(Chaser->BrainIndex) && Controllers[Chaser->BrainIndex] == Chaser)
+	{
+		const int32 Index = Chaser->BrainIndex;
+		// 깨어날 때는 잠든 시간을 넘기지 않고 간격 한 번만큼만 지난 것으로 보고 바로 평가한다
+		if (UpdateIntervals[Index] < 0.0f && Interval >= 0.0f)
+		{
+			ElapsedTimes[Index] = Interval;
+		}
+		UpdateIntervals[Index] = Interval;
+	}
+}
+
+void UChaser_BrainSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ChaserBrain_Tick);
+	AISTUDY_BENCHMARK_SCOPE(Brain);
+	SET_DWORD_STAT(STAT_ChaserBrain_NumChasers, Controllers.Num());
+
+	if (Controllers.Num() == 0)
+	{
+		return;
+	}
+
+	// LOD 간격이 지난 추적자만 평가. 건너뛴 시간은 누적해 회전 갱신에 그대로 넘긴다 (잠든 동안은 누적하지 않는다).
+	for (int32 Index = 0; Index < Controllers.Num(); ++Index)
+	{
+		if (UpdateIntervals[Index] < 0.0f)
+		{
+			Due[Index] = false;
+			continue;
+		}
+		ElapsedTimes[Index] += DeltaTime;
+		Due[Index] = ElapsedTimes[Index] >= UpdateIntervals[Index];
+	}
+
+	GatherAgents();
+	EvaluateTransitions();
+	ApplyResults();
+
+	for (const AChaser_AIController* Chaser : Controllers)
+	{
+		if (IsValid(Chaser))
+		{
+			Chaser->CountState();
+		}
+	}
+}
+
+void UChaser_BrainSubsystem::GatherAgents()
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ChaserBrain_Gather);
+
+	const int32 Num = Controllers.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		AChaser_AIController* Chaser = Controllers[Index];
+		if (!Due[Index])
+		{
+			Valid[Index] = false;
+			continue;
+		}
+
+		if (IsValid(Chaser))
+		{
+			// UpdateAIState와 같이 가장 가까운 추적 대상으로 먼저 갱신
+			Chaser->RefreshTarget();
+		}
+
+		const APawn* ControlledPawn = IsValid(Chaser) ? Chaser->GetPawn() : nullptr;
+		const AActor* Target = ControlledPawn ? Chaser->TargetActor : nullptr;
+
+		// UpdateAIState와 Tick의 조기 반환 조건(타겟 없음, 폰 없음)과 동일
+		Valid[Index] = Target != nullptr;
+		if (!Valid[Index])
+		{
+			continue;
+		}
+
+		PawnLocations[Index] = ControlledPawn->GetActorLocation();
+		TargetLocations[Index] = Target->GetActorLocation();
+
+		// 반경은 BP에서 바뀔 수 있으므로 매 프레임 읽는다
+		DetectionRadiusSq[Index] = FMath::Square(static_cast<double>(Chaser->DetectionRadius));
+		ChaseRadiusSq[Index] = FMath::Square(static_cast<double>(Chaser->ChaseRadius));
+		LoseInterestRadiusSq[Index] = FMath::Square(static_cast<double>(Chaser->LoseInterestRadius));
+
+		States[Index] = Chaser->CurrentState;
+		Chasing[Index] = Chaser->bIsChasing ? 1 : 0;
+		NeedsControlRotation[Index] = (ControlledPawn->bUseControllerRotationYaw || ControlledPawn->bUseControllerRotationPitch || ControlledPawn->bUseControllerRotationRoll) ? 1 : 0;
+	}
+}
+
+void UChaser_BrainSubsystem::EvaluateTransitions()
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ChaserBrain_Evaluate);
+
+	const int32 Num = Controllers.Num();
+
+	// 거리 제곱은 분기 없는 루프로 따로 계산해 컴파일러가 벡터화할 수 있게 한다
+	const FVector* RESTRICT PawnData = PawnLocations.GetData();
+	const FVector* RESTRICT TargetData = TargetLocations.GetData();
+	double* RESTRICT DistSqData = DistanceSquared.GetData();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const double DX = TargetData[Index].X - PawnData[Index].X;
+		const double DY = TargetData[Index].Y - PawnData[Index].Y;
+		const double DZ = TargetData[Index].Z - PawnData[Index].Z;
+		DistSqData[Index] = DX * DX + DY * DY + DZ * DZ;
+	}
+
+	// 상태 전환: UpdateAIState() 후 Tick()의 추적 블록 순서를 그대로 따른다
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		EAIState State = States[Index];
+		Actions[Index] = Valid[Index]
+			? EvaluateChaser(State, Chasing[Index] != 0, DistSqData[Index], DetectionRadiusSq[Index], ChaseRadiusSq[Index], LoseInterestRadiusSq[Index])
+			: Action_None;
+		NewStates[Index] = State;
+	}
+}
+
+uint8 UChaser_BrainSubsystem::EvaluateChaser(EAIState& State, bool bChasing, double DistSq, double DetectionSq, double ChaseSq, double LoseInterestSq)
+{
+	uint8 Action = Action_None;
+
+	switch (State)
+	{
+	case EAIState::Idle:
+		if (DistSq <= DetectionSq)
+		{
+			State = EAIState::Suspicious;
+		}
+		break;
+
+	case EAIState::Suspicious:
+		if (DistSq <= ChaseSq)
+		{
+			Action |= Action_StartChasing;
+			State = EAIState::Chasing;
+			bChasing = true;
+		}
+		else if (DistSq > DetectionSq)
+		{
+			State = EAIState::Idle;
+		}
+		break;
+
+	case EAIState::Chasing:
+		if (DistSq > LoseInterestSq)
+		{
+			Action |= Action_StopChasing;
+			State = EAIState::Idle;
+			bChasing = false;
+		}
+		break;
+	}
+
+	// 인지 이벤트로 Suspicious가 되어도 bIsChasing은 유지되므로 상태와 별도로 확인
+	if (bChasing)
+	{
+		if (DistSq <= ChaseSq)
+		{
+			Action |= Action_MoveToTarget;
+		}
+		else if (DistSq > LoseInterestSq)
+		{
+			Action |= Action_StopChasing;
+			State = EAIState::Idle;
+		}
+	}
+
+	return Action;
+}
+
+void UChaser_BrainSubsystem::ApplyChaserAction(AChaser_AIController& Chaser, uint8 Action, EAIState OldState, EAIState NewState)
+{
+	if (Action & Action_StartChasing)
+	{
+		Chaser.StartChasing(Chaser.TargetActor);
+	}
+	if (Action & Action_StopChasing)
+	{
+		Chaser.StopChasing();
+	}
+	else if (NewState != OldState)
+	{
+		Chaser.CurrentState = NewState;
+	}
+
+	if (Action & Action_MoveToTarget)
+	{
+		if (APawn* ControlledPawn = Chaser.GetPawn())
+		{
+			Chaser.MoveTowardTarget(ControlledPawn);
+		}
+	}
+}
+
+void UChaser_BrainSubsystem::ApplyResults()
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ChaserBrain_Apply);
+
+	// 적용 중 콜백에서 등록 해제가 일어나도 안전하도록 역순으로 순회
+	for (int32 Index = Controllers.Num() - 1; Index >= 0; --Index)
+	{
+		AChaser_AIController* Chaser = Controllers[Index];
+		if (!IsValid(Chaser) || !Due[Index])
+		{
+			continue;
+		}
+
+		const float ElapsedTime = ElapsedTimes[Index];
+		ElapsedTimes[Index] = 0.0f;
+
+		// 개별 Tick을 끄면 AAIController::Tick의 회전 갱신도 빠지므로 필요한 폰만 대신 호출
+		if (NeedsControlRotation[Index])
+		{
+			Chaser->UpdateControlRotation(ElapsedTime);
+		}
+
+		if (!Valid[Index])
+		{
+			continue;
+		}
+
+		ApplyChaserAction(*Chaser, Actions[Index], States[Index], NewStates[Index]);
+	}
+}
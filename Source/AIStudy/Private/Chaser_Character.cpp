@@ -0,0 +1,43 @@
+#include "Chaser_Character.h"
+#include "Chaser_AIController.h"
+#include "Agent_BudgetedMeshComponent.h"
+#include "Agent_MovementComponent.h"
+#include "Net_ChaserStateComponent.h"
+#include "Net/UnrealNetwork.h"
+
+AChaser_Character::AChaser_Character(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UAgent_MovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<UAgent_BudgetedMeshComponent>(ACharacter::MeshComponentName))
+{
+	AIControllerClass = AChaser_AIController::StaticClass();
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+
+	// 상태 컴포넌트를 COND_NetGroup으로 복제하려면 등록된 서브오브젝트 목록을 써야 한다
+	bReplicateUsingRegisteredSubObjectList = true;
+	ChaserState = CreateDefaultSubobject<UNet_ChaserStateComponent>(TEXT("ChaserState"));
+}
+
+void AChaser_Character::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	NetAIMovement::DisableDefaultMovementReplication(StaticClass(), OutLifetimeProps);
+	DOREPLIFETIME_CONDITION(AChaser_Character, AIMovement, COND_SimulatedOnly);
+}
+
+void AChaser_Character::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	AIMovement = NetAIMovement::Capture(*this);
+	if (const AChaser_AIController* Chaser = Cast<AChaser_AIController>(GetController()))
+	{
+		ChaserState->SetState(Chaser->GetAIState());
+	}
+}
+
+void AChaser_Character::OnRep_AIMovement()
+{
+	NetAIMovement::Apply(*this, AIMovement);
+}
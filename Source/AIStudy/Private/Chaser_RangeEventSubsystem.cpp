@@ -0,0 +1,393 @@
+#include "Chaser_RangeEventSubsystem.h"
+#include "Chaser_AIController.h"
+#include "Chaser_BrainSubsystem.h"
+#include "Spatial_HashSubsystem.h"
+#include "Benchmark_Metrics.h"
+#include "AIStudy.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Chaser Range Events Update"), STAT_ChaserRange_Update, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Chaser Range Events Verify"), STAT_ChaserRange_Verify, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Range Event Evaluations"), STAT_ChaserRange_NumEvaluations, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Range Event Sleeping Chasers"), STAT_ChaserRange_NumSleeping, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Range Event Missed Transitions"), STAT_ChaserRange_NumMissed, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarRangeEventsVerify(
+	TEXT("AIStudy.Chaser.RangeEvents.Verify"),
+	false,
+	TEXT("매 갱신마다 잠든 추적자를 폴링 규칙으로 다시 평가해 빠진 전환이 있으면 경고 (실행 중 검증용. 폴링과의 전환 순서 비교는 벤치마크 커맨들릿의 -CheckRangeEvents)"));
+
+namespace ChaserRange
+{
+	// 위치 오차로 경계를 늦게 넘지 않도록 여유 거리에서 빼는 값
+	constexpr double SafetyMargin = 1.0;
+	// MaxStep이 이 값 이상이면 추적 대상 집합이 바뀐 것으로 보고 모두 깨운다
+	constexpr float TeleportStep = UE_BIG_NUMBER * 0.5f;
+}
+
+bool UChaser_RangeEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UChaser_RangeEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (USpatial_HashSubsystem* SpatialHash = Collection.InitializeDependency<USpatial_HashSubsystem>())
+	{
+		HashUpdatedHandle = SpatialHash->OnUpdated.AddUObject(this, &UChaser_RangeEventSubsystem::OnSpatialHashUpdated);
+	}
+}
+
+void UChaser_RangeEventSubsystem::Deinitialize()
+{
+	if (USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>())
+	{
+		SpatialHash->OnUpdated.Remove(HashUpdatedHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+void UChaser_RangeEventSubsystem::RegisterChaser(AChaser_AIController* Chaser)
+{
+	if (!Chaser || Chaser->RangeEventIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	// 인덱스가 힙 노드와 컨트롤러에 저장되므로 해제 후에도 다른 항목의 인덱스가 바뀌지 않는 희소 배열을 쓴다
+	FRangeEntry Entry;
+	Entry.Controller = Chaser;
+	Entry.Serial = NextSerial++;
+	Entry.CountedState = Chaser->CurrentState;
+	Chaser->RangeEventIndex = Entries.Add(Entry);
+	++StateCounts[static_cast<int32>(Entry.CountedState)];
+
+	// 첫 갱신에서 평가해 재울지 정한다
+	SetActive(Chaser->RangeEventIndex);
+}
+
+void UChaser_RangeEventSubsystem::UnregisterChaser(AChaser_AIController* Chaser)
+{
+	if (!Chaser || !Entries.IsValidIndex(Chaser->RangeEventIndex) || Entries[Chaser->RangeEventIndex].Controller != Chaser)
+	{
+		return;
+	}
+
+	const int32 Index = Chaser->RangeEventIndex;
+	Chaser->RangeEventIndex = INDEX_NONE;
+
+	// 힙에 남은 노드는 항목이 사라졌으므로 꺼낼 때 버려진다
+	SetInactive(Index);
+	--StateCounts[static_cast<int32>(Entries[Index].CountedState)];
+	Entries.RemoveAt(Index);
+}
+
+void UChaser_RangeEventSubsystem::WakeChaser(AChaser_AIController* Chaser)
+{
+	if (!Chaser || !Entries.IsValidIndex(Chaser->RangeEventIndex) || Entries[Chaser->RangeEventIndex].Controller != Chaser)
+	{
+		return;
+	}
+
+	const int32 Index = Chaser->RangeEventIndex;
+	UpdateStateCount(Entries[Index], *Chaser);
+	if (!Entries[Index].bDormant)
+	{
+		SetActive(Index);
+	}
+}
+
+void UChaser_RangeEventSubsystem::SetDormant(AChaser_AIController* Chaser, bool bDormant)
+{
+	if (!Chaser || !Entries.IsValidIndex(Chaser->RangeEventIndex) || Entries[Chaser->RangeEventIndex].Controller != Chaser)
+	{
+		return;
+	}
+
+	const int32 Index = Chaser->RangeEventIndex;
+	if (Entries[Index].bDormant == bDormant)
+	{
+		return;
+	}
+
+	Entries[Index].bDormant = bDormant;
+	if (bDormant)
+	{
+		SetInactive(Index);
+	}
+	else
+	{
+		// 잠든 동안 움직인 거리는 알 수 없으므로 깨어난 직후 다시 평가
+		SetActive(Index);
+	}
+}
+
+void UChaser_RangeEventSubsystem::SetActive(int32 Index)
+{
+	FRangeEntry& Entry = Entries[Index];
+	if (Entry.bSleeping)
+	{
+		Entry.bSleeping = false;
+		Entry.Serial = NextSerial++;
+		--NumSleeping;
+	}
+	if (Entry.ActiveSlot == INDEX_NONE)
+	{
+		Entry.ActiveSlot = ActiveIndices.Add(Index);
+	}
+}
+
+void UChaser_RangeEventSubsystem::SetInactive(int32 Index)
+{
+	FRangeEntry& Entry = Entries[Index];
+	if (Entry.bSleeping)
+	{
+		Entry.bSleeping = false;
+		Entry.Serial = NextSerial++;
+		--NumSleeping;
+	}
+	if (Entry.ActiveSlot != INDEX_NONE)
+	{
+		const int32 Slot = Entry.ActiveSlot;
+		Entry.ActiveSlot = INDEX_NONE;
+		ActiveIndices.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+		if (ActiveIndices.IsValidIndex(Slot))
+		{
+			Entries[ActiveIndices[Slot]].ActiveSlot = Slot;
+		}
+	}
+}
+
+void UChaser_RangeEventSubsystem::Sleep(int32 Index, double Slack)
+{
+	SetInactive(Index);
+
+	FRangeEntry& Entry = Entries[Index];
+	Entry.bSleeping = true;
+	++NumSleeping;
+	WakeHeap.HeapPush(FWakeNode{ Travel + Slack, Index, Entry.Serial });
+}
+
+void UChaser_RangeEventSubsystem::UpdateStateCount(FRangeEntry& Entry, const AChaser_AIController& Chaser)
+{
+	if (Entry.CountedState != Chaser.CurrentState)
+	{
+		--StateCounts[static_cast<int32>(Entry.CountedState)];
+		++StateCounts[static_cast<int32>(Chaser.CurrentState)];
+		Entry.CountedState = Chaser.CurrentState;
+	}
+}
+
+void UChaser_RangeEventSubsystem::OnSpatialHashUpdated(float MaxStep)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ChaserRange_Update);
+	AISTUDY_BENCHMARK_SCOPE(Brain);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float DeltaTime = LastUpdateTime >= 0.0 ? static_cast<float>(Now - LastUpdateTime) : 0.0f;
+	LastUpdateTime = Now;
+
+	// 추적 대상이 생기거나 사라지면 가장 가까운 대상이 불연속으로 바뀌므로 잠든 추적자를 모두 깨운다
+	DueIndices.Reset();
+	if (MaxStep >= ChaserRange::TeleportStep)
+	{
+		for (const FWakeNode& Node : WakeHeap)
+		{
+			if (Entries.IsValidIndex(Node.Index) && Entries[Node.Index].Serial == Node.Serial)
+			{
+				DueIndices.Add(Node.Index);
+			}
+		}
+		WakeHeap.Reset();
+	}
+	else
+	{
+		// 두 폰 사이 거리는 각자 MaxStep까지 움직여 최대 2 * MaxStep 변한다
+		Travel += 2.0 * MaxStep;
+		while (WakeHeap.Num() > 0 && WakeHeap.HeapTop().Key <= Travel)
+		{
+			FWakeNode Node;
+			WakeHeap.HeapPop(Node, EAllowShrinking::No);
+			if (Entries.IsValidIndex(Node.Index) && Entries[Node.Index].Serial == Node.Serial)
+			{
+				DueIndices.Add(Node.Index);
+			}
+		}
+	}
+
+	for (const int32 Index : DueIndices)
+	{
+		FRangeEntry& Entry = Entries[Index];
+		Entry.bSleeping = false;
+		Entry.Serial = NextSerial++;
+		--NumSleeping;
+	}
+	DueIndices.Append(ActiveIndices);
+
+	// 평가 중 콜백으로 등록 해제나 깨우기가 일어날 수 있으므로 모은 목록을 따로 순회
+	for (const int32 Index : DueIndices)
+	{
+		if (Entries.IsValidIndex(Index))
+		{
+			EvaluateEntry(Index, DeltaTime);
+		}
+	}
+
+	if (CVarRangeEventsVerify.GetValueOnGameThread())
+	{
+		VerifySleepers();
+	}
+
+	SET_DWORD_STAT(STAT_ChaserRange_NumEvaluations, DueIndices.Num());
+	SET_DWORD_STAT(STAT_ChaserRange_NumSleeping, NumSleeping);
+
+	// 상태가 바뀔 때만 갱신한 개수를 프레임 카운터에 그대로 넘긴다
+	AISTUDY_INC_COUNTER_BY(ChasersIdle, StateCounts[static_cast<int32>(EAIState::Idle)]);
+	AISTUDY_INC_COUNTER_BY(ChasersSuspicious, StateCounts[static_cast<int32>(EAIState::Suspicious)]);
+	AISTUDY_INC_COUNTER_BY(ChasersChasing, StateCounts[static_cast<int32>(EAIState::Chasing)]);
+}
+
+void UChaser_RangeEventSubsystem::EvaluateEntry(int32 Index, float DeltaTime)
+{
+	AChaser_AIController* Chaser = Entries[Index].Controller.Get();
+	if (!IsValid(Chaser))
+	{
+		return;
+	}
+
+	// 폴링 방식(UChaser_BrainSubsystem)과 같은 순서: 타겟 갱신 → 전환 규칙 → 동작 반영
+	Chaser->RefreshTarget();
+
+	APawn* ControlledPawn = Chaser->GetPawn();
+	if (ControlledPawn && Chaser->TargetActor)
+	{
+		const double DistSq = FVector::DistSquared(ControlledPawn->GetActorLocation(), Chaser->TargetActor->GetActorLocation());
+		const EAIState OldState = Chaser->CurrentState;
+		EAIState NewState = OldState;
+		const uint8 Action = UChaser_BrainSubsystem::EvaluateChaser(NewState, Chaser->bIsChasing, DistSq,
+			FMath::Square(static_cast<double>(Chaser->DetectionRadius)),
+			FMath::Square(static_cast<double>(Chaser->ChaseRadius)),
+			FMath::Square(static_cast<double>(Chaser->LoseInterestRadius)));
+		UChaser_BrainSubsystem::ApplyChaserAction(*Chaser, Action, OldState, NewState);
+	}
+
+	// 동작 반영 중 등록이 해제되었을 수 있다
+	if (!Entries.IsValidIndex(Index) || Entries[Index].Controller != Chaser)
+	{
+		return;
+	}
+
+	FRangeEntry& Entry = Entries[Index];
+	UpdateStateCount(Entry, *Chaser);
+
+	// 깨어 있는 추적자만 개별 Tick 대신 회전을 갱신한다 (잠든 추적자는 제자리에 서 있다)
+	if (ControlledPawn && (ControlledPawn->bUseControllerRotationYaw || ControlledPawn->bUseControllerRotationPitch || ControlledPawn->bUseControllerRotationRoll))
+	{
+		Chaser->UpdateControlRotation(DeltaTime);
+	}
+
+	if (Entry.bDormant)
+	{
+		return;
+	}
+
+	const double Slack = Chaser->bIsChasing ? -1.0 : ComputeSlack(*Chaser);
+	if (Slack < 0.0)
+	{
+		SetActive(Index);
+	}
+	else
+	{
+		Sleep(Index, Slack);
+	}
+}
+
+double UChaser_RangeEventSubsystem::ComputeSlack(const AChaser_AIController& Chaser) const
+{
+	const APawn* ControlledPawn = Chaser.GetPawn();
+	if (!ControlledPawn)
+	{
+		// 폰이 없으면 평가할 것이 없다. 빙의하면 OnPossess에서 깨운다.
+		return UE_BIG_NUMBER;
+	}
+
+	// 타겟이 공간 해시 밖에 있으면 이동 거리를 제한할 수 없으므로 매 갱신 평가
+	const USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>();
+	if (!SpatialHash || !Chaser.bUseSpatialTargetSelection || (Chaser.TargetActor && !Chaser.TargetActor->IsA<APawn>()))
+	{
+		return -1.0;
+	}
+
+	const FVector Location = ControlledPawn->GetActorLocation();
+	const double LoseInterest = Chaser.LoseInterestRadius;
+	double Slack = UE_BIG_NUMBER;
+
+	// 지금 타겟까지의 거리가 세 반경 중 하나를 넘을 때까지
+	if (Chaser.TargetActor)
+	{
+		const double Distance = FVector::Dist(Location, Chaser.TargetActor->GetActorLocation());
+		Slack = FMath::Min3(FMath::Abs(Distance - Chaser.DetectionRadius), FMath::Abs(Distance - Chaser.ChaseRadius), FMath::Abs(Distance - LoseInterest));
+	}
+
+	// LoseInterestRadius 안에 추적 대상이 없으면 RefreshTarget이 타겟을 바꾸지 않는다.
+	// 이때는 바깥의 가장 가까운 대상이 안으로 들어와 타겟이 바뀔 때까지의 거리도 본다.
+	if (!SpatialHash->FindNearestTarget(Location, LoseInterest, ControlledPawn))
+	{
+		const APawn* Outer = SpatialHash->FindNearestTarget(Location, static_cast<float>(2.0 * LoseInterest), ControlledPawn);
+		Slack = FMath::Min(Slack, Outer ? FVector::Dist(Location, Outer->GetActorLocation()) - LoseInterest : LoseInterest);
+	}
+
+	return FMath::Max(0.0, Slack - ChaserRange::SafetyMargin);
+}
+
+void UChaser_RangeEventSubsystem::VerifySleepers()
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ChaserRange_Verify);
+
+	const USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>();
+	int32 NumMissed = 0;
+
+	for (const FRangeEntry& Entry : Entries)
+	{
+		const AChaser_AIController* Chaser = Entry.Controller.Get();
+		const APawn* ControlledPawn = IsValid(Chaser) ? Chaser->GetPawn() : nullptr;
+		if (!Entry.bSleeping || !ControlledPawn)
+		{
+			continue;
+		}
+
+		// 폴링 방식이라면 이번 프레임에 골랐을 타겟 (RefreshTarget과 같지만 컨트롤러는 건드리지 않는다)
+		const AActor* Target = Chaser->TargetActor;
+		if (SpatialHash && Chaser->bUseSpatialTargetSelection)
+		{
+			if (const APawn* Nearest = SpatialHash->FindNearestTarget(ControlledPawn->GetActorLocation(), Chaser->LoseInterestRadius, ControlledPawn))
+			{
+				Target = Nearest;
+			}
+		}
+		if (!Target)
+		{
+			continue;
+		}
+
+		EAIState State = Chaser->CurrentState;
+		const uint8 Action = UChaser_BrainSubsystem::EvaluateChaser(State, Chaser->bIsChasing,
+			FVector::DistSquared(ControlledPawn->GetActorLocation(), Target->GetActorLocation()),
+			FMath::Square(static_cast<double>(Chaser->DetectionRadius)),
+			FMath::Square(static_cast<double>(Chaser->ChaseRadius)),
+			FMath::Square(static_cast<double>(Chaser->LoseInterestRadius)));
+
+		if (Action != UChaser_BrainSubsystem::Action_None || State != Chaser->CurrentState)
+		{
+			++NumMissed;
+			UE_LOG(LogAIStudy, Warning, TEXT("RangeEvents: %s missed a transition (%d -> %d) while sleeping"),
+				*Chaser->GetName(), static_cast<int32>(Chaser->CurrentState), static_cast<int32>(State));
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ChaserRange_NumMissed, NumMissed);
+}
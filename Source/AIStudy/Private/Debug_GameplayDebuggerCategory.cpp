@@ -0,0 +1,193 @@
+#include "Debug_GameplayDebuggerCategory.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "AIStudyCharacter.h"
+#include "Chaser_AIController.h"
+#include "RVO_Character.h"
+#include "Spatial_HashSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarDebugRadius(
+	TEXT("AIStudy.Debug.Radius"),
+	3000.0f,
+	TEXT("Gameplay Debugger AIStudy 카테고리가 시점 주변에서 그릴 에이전트 반경."));
+
+static TAutoConsoleVariable<int32> CVarDebugMaxAgents(
+	TEXT("AIStudy.Debug.MaxAgents"),
+	64,
+	TEXT("Gameplay Debugger AIStudy 카테고리가 한 번에 그릴 최대 에이전트 수 (가까운 순)."));
+
+namespace AIStudyDebug
+{
+	static FColor GetStateColor(EAIState State)
+	{
+		switch (State)
+		{
+		case EAIState::Suspicious:
+			return FColor::Yellow;
+		case EAIState::Chasing:
+			return FColor::Red;
+		default:
+			return FColor::Green;
+		}
+	}
+
+	static const TCHAR* GetStateName(EAIState State)
+	{
+		switch (State)
+		{
+		case EAIState::Suspicious:
+			return TEXT("Suspicious");
+		case EAIState::Chasing:
+			return TEXT("Chasing");
+		default:
+			return TEXT("Idle");
+		}
+	}
+}
+
+FGameplayDebuggerCategory_AIStudy::FGameplayDebuggerCategory_AIStudy()
+{
+	// 켜져 있어도 매 프레임이 아니라 주기적으로만 모은다
+	CollectDataInterval = 0.1f;
+	SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_AIStudy::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_AIStudy());
+}
+
+void FGameplayDebuggerCategory_AIStudy::FRepData::Serialize(FArchive& Ar)
+{
+	Ar << NumNearby;
+	Ar << NumShown;
+	Ar << NumIdle;
+	Ar << NumSuspicious;
+	Ar << NumChasing;
+	Ar << NumPatrol;
+	Ar << NumRVO;
+	Ar << SelectedDescription;
+}
+
+void FGameplayDebuggerCategory_AIStudy::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	DataPack = FRepData();
+
+	UWorld* World = OwnerPC ? OwnerPC->GetWorld() : nullptr;
+	const USpatial_HashSubsystem* SpatialHash = World ? World->GetSubsystem<USpatial_HashSubsystem>() : nullptr;
+	if (!SpatialHash)
+	{
+		return;
+	}
+
+	// 서버에서 본 클라이언트 시점 기준으로 가까운 에이전트만 모은다
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	OwnerPC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	TArray<APawn*> Nearby;
+	SpatialHash->FindNearestPawns(ViewLocation, CVarDebugRadius.GetValueOnGameThread(), FMath::Max(CVarDebugMaxAgents.GetValueOnGameThread(), 0), Nearby);
+	DataPack.NumNearby = Nearby.Num();
+
+	const APawn* SelectedPawn = Cast<APawn>(DebugActor);
+	for (const APawn* Pawn : Nearby)
+	{
+		if (Pawn && Pawn != SelectedPawn && !Pawn->IsPlayerControlled())
+		{
+			CollectAgent(*Pawn, false);
+		}
+	}
+
+	// 선택한 에이전트는 반경 밖이어도 그리고 설명을 붙인다
+	if (SelectedPawn)
+	{
+		CollectAgent(*SelectedPawn, true);
+	}
+}
+
+void FGameplayDebuggerCategory_AIStudy::CollectAgent(const APawn& Pawn, bool bSelected)
+{
+	const FVector Location = Pawn.GetActorLocation();
+	++DataPack.NumShown;
+
+	if (const AChaser_AIController* Chaser = Cast<AChaser_AIController>(Pawn.GetController()))
+	{
+		const EAIState State = Chaser->GetAIState();
+		const FColor Color = AIStudyDebug::GetStateColor(State);
+		DataPack.NumIdle += State == EAIState::Idle ? 1 : 0;
+		DataPack.NumSuspicious += State == EAIState::Suspicious ? 1 : 0;
+		DataPack.NumChasing += State == EAIState::Chasing ? 1 : 0;
+
+		AddShape(FGameplayDebuggerShape::MakePoint(Location + FVector(0.0f, 0.0f, 100.0f), 12.0f, Color));
+		if (Chaser->IsChasing() && Chaser->TargetActor)
+		{
+			// MoveTowardTarget가 매 프레임 그리던 타겟 선
+			AddShape(FGameplayDebuggerShape::MakeSegment(Location, Chaser->TargetActor->GetActorLocation(), 2.0f, FColor::Red));
+		}
+		if (State != EAIState::Idle)
+		{
+			AddShape(FGameplayDebuggerShape::MakePoint(Chaser->GetLastKnownLocation(), 8.0f, FColor::Orange, bSelected ? TEXT("Last known") : FString()));
+		}
+		if (bSelected)
+		{
+			AddShape(FGameplayDebuggerShape::MakeCylinder(Location, Chaser->DetectionRadius, 5.0f, FColor::Yellow));
+			AddShape(FGameplayDebuggerShape::MakeCylinder(Location, Chaser->ChaseRadius, 5.0f, FColor::Red));
+			AddShape(FGameplayDebuggerShape::MakeCylinder(Location, Chaser->LoseInterestRadius, 5.0f, FColor::Silver));
+			DataPack.SelectedDescription = FString::Printf(TEXT("%s: chaser {yellow}%s{white}, target %s"),
+				*Pawn.GetName(), AIStudyDebug::GetStateName(State), Chaser->TargetActor ? *Chaser->TargetActor->GetName() : TEXT("none"));
+		}
+		return;
+	}
+
+	if (const AAIStudyCharacter* Patrol = Cast<AAIStudyCharacter>(&Pawn))
+	{
+		++DataPack.NumPatrol;
+
+		// bIsSucceeded면 A로, 아니면 B로 가는 중
+		const AActor* Current = Patrol->bIsSucceeded ? Patrol->Target : Patrol->Target2;
+		const AActor* Other = Patrol->bIsSucceeded ? Patrol->Target2 : Patrol->Target;
+		if (Current)
+		{
+			AddShape(FGameplayDebuggerShape::MakeArrow(Location, Current->GetActorLocation(), 30.0f, 2.0f, FColor::Cyan));
+		}
+		if (Current && Other)
+		{
+			AddShape(FGameplayDebuggerShape::MakeSegment(Current->GetActorLocation(), Other->GetActorLocation(), 1.0f, FColor::Blue));
+		}
+		if (bSelected)
+		{
+			DataPack.SelectedDescription = FString::Printf(TEXT("%s: patrol to {cyan}%s"), *Pawn.GetName(), Current ? *Current->GetName() : TEXT("none"));
+		}
+		return;
+	}
+
+	if (const ARVO_Character* Agent = Cast<ARVO_Character>(&Pawn))
+	{
+		++DataPack.NumRVO;
+		AddShape(FGameplayDebuggerShape::MakeCylinder(Location, Agent->AvoidanceRadius, 5.0f, Agent->bUseORCAAvoidance ? FColor::Magenta : FColor::Purple));
+		if (Agent->TargetActor)
+		{
+			AddShape(FGameplayDebuggerShape::MakeArrow(Location, Agent->TargetActor->GetActorLocation(), 30.0f, 1.0f, FColor::White));
+		}
+		if (bSelected)
+		{
+			DataPack.SelectedDescription = FString::Printf(TEXT("%s: RVO %s, radius %.0f"), *Pawn.GetName(),
+				Agent->bUseORCAAvoidance ? TEXT("ORCA") : TEXT("engine"), Agent->AvoidanceRadius);
+		}
+	}
+}
+
+void FGameplayDebuggerCategory_AIStudy::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+	// 도형은 카테고리가 복제된 버퍼를 그대로 그리므로 여기서는 요약만 출력
+	CanvasContext.Printf(TEXT("Agents nearby: {yellow}%d{white} (shown %d)"), DataPack.NumNearby, DataPack.NumShown);
+	CanvasContext.Printf(TEXT("Chasers: {green}%d idle{white}, {yellow}%d suspicious{white}, {red}%d chasing"), DataPack.NumIdle, DataPack.NumSuspicious, DataPack.NumChasing);
+	CanvasContext.Printf(TEXT("Patrol: %d  RVO: %d"), DataPack.NumPatrol, DataPack.NumRVO);
+	if (!DataPack.SelectedDescription.IsEmpty())
+	{
+		CanvasContext.Printf(TEXT("%s"), *DataPack.SelectedDescription);
+	}
+}
+#endif // WITH_GAMEPLAY_DEBUGGER
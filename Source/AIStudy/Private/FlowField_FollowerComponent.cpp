@@ -0,0 +1,116 @@
+#include "FlowField_FollowerComponent.h"
+#include "FlowField_Subsystem.h"
+#include "AIController.h"
+#include "GameFramework/Pawn.h"
+
+UFlowField_FollowerComponent::UFlowField_FollowerComponent()
+{
+	// 이동 컴포넌트보다 먼저 입력을 넣도록 PrePhysics에서 틱. 목표가 없으면 틱을 끈다.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UFlowField_FollowerComponent::SetGoal(AActor* InGoal, float InAcceptanceRadius)
+{
+	if (Goal.Get() == InGoal)
+	{
+		AcceptanceRadius = InAcceptanceRadius;
+		return;
+	}
+
+	ClearGoal();
+	if (!InGoal)
+	{
+		return;
+	}
+
+	UFlowField_Subsystem* FlowFields = GetWorld()->GetSubsystem<UFlowField_Subsystem>();
+	if (!FlowFields)
+	{
+		return;
+	}
+
+	Goal = InGoal;
+	AcceptanceRadius = InAcceptanceRadius;
+	FlowFields->AcquireField(InGoal);
+	SetComponentTickEnabled(true);
+}
+
+void UFlowField_FollowerComponent::ClearGoal()
+{
+	if (AActor* OldGoal = Goal.Get())
+	{
+		if (UFlowField_Subsystem* FlowFields = GetWorld()->GetSubsystem<UFlowField_Subsystem>())
+		{
+			FlowFields->ReleaseField(OldGoal);
+		}
+	}
+
+	SetFallbackActive(false);
+	Goal.Reset();
+	SetComponentTickEnabled(false);
+}
+
+void UFlowField_FollowerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearGoal();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UFlowField_FollowerComponent::SetFallbackActive(bool bActive)
+{
+	if (bFallbackActive == bActive)
+	{
+		return;
+	}
+	bFallbackActive = bActive;
+
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	AAIController* AIController = Pawn ? Cast<AAIController>(Pawn->GetController()) : nullptr;
+	if (!AIController)
+	{
+		return;
+	}
+
+	if (bActive && Goal.IsValid())
+	{
+		AIController->MoveToActor(Goal.Get(), AcceptanceRadius);
+	}
+	else
+	{
+		AIController->StopMovement();
+	}
+}
+
+void UFlowField_FollowerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	APawn* Pawn = Cast<APawn>(GetOwner());
+	const AActor* GoalActor = Goal.Get();
+	if (!Pawn || !GoalActor)
+	{
+		ClearGoal();
+		return;
+	}
+
+	const FVector Location = Pawn->GetActorLocation();
+	if (FVector::DistSquared2D(Location, GoalActor->GetActorLocation()) <= FMath::Square(AcceptanceRadius))
+	{
+		return;
+	}
+
+	const UFlowField_Subsystem* FlowFields = GetWorld()->GetSubsystem<UFlowField_Subsystem>();
+	FVector Direction;
+	if (FlowFields && FlowFields->SampleDirection(GoalActor, Location, Direction))
+	{
+		SetFallbackActive(false);
+		Pawn->AddMovementInput(Direction, 1.0f);
+	}
+	else
+	{
+		// 흐름장이 아직 없거나 범위 밖이면 일반 경로 탐색으로 이동
+		SetFallbackActive(true);
+	}
+}
@@ -0,0 +1,350 @@
+#include "FlowField_Subsystem.h"
+#include "AIStudy.h"
+#include "Benchmark_Metrics.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Tick"), STAT_FlowField_Tick, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Walkability"), STAT_FlowField_Walkability, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Integration"), STAT_FlowField_Integration, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Flow Fields"), STAT_FlowField_NumFields, STATGROUP_AIStudy);
+DECLARE_MEMORY_STAT(TEXT("Flow Field Memory"), STAT_FlowField_Memory, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarFlowFieldCellSize(
+	TEXT("AIStudy.FlowField.CellSize"),
+	100.0f,
+	TEXT("흐름장 격자 셀 크기."));
+
+static TAutoConsoleVariable<float> CVarFlowFieldHalfExtent(
+	TEXT("AIStudy.FlowField.HalfExtent"),
+	5000.0f,
+	TEXT("목표를 중심으로 한 흐름장의 반 너비. 목표가 가장자리에 가까워지면 다시 중심을 잡는다."));
+
+static TAutoConsoleVariable<float> CVarFlowFieldMaxStepHeight(
+	TEXT("AIStudy.FlowField.MaxStepHeight"),
+	60.0f,
+	TEXT("이웃 셀 바닥 높이 차이가 이보다 크면 연결하지 않는다."));
+
+namespace FlowField
+{
+	// 8방향 이웃 (인덱스가 곧 방향 코드)
+	static const FIntPoint Neighbors[8] = {
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+	static const float NeighborCosts[8] = { 1.0f, 1.0f, 1.0f, 1.0f, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2 };
+
+	// (CX, CY)에서 Dir 방향 이웃으로 건너갈 수 있으면 이웃 인덱스를 돌려준다. 적분과 방향 계산이 같은 판정을 쓴다
+	static bool GetStepTarget(const FFlowField& Field, int32 CX, int32 CY, int32 Dir, float MaxStepHeight, int32& OutIndex)
+	{
+		const int32 NX = CX + Neighbors[Dir].X;
+		const int32 NY = CY + Neighbors[Dir].Y;
+		if (!Field.IsValidCell(NX, NY))
+		{
+			return false;
+		}
+
+		OutIndex = Field.ToIndex(NX, NY);
+		if (!Field.Walkable[OutIndex] || FMath::Abs(Field.Heights[OutIndex] - Field.Heights[Field.ToIndex(CX, CY)]) > MaxStepHeight)
+		{
+			return false;
+		}
+
+		// 대각선은 양옆 셀이 모두 보행 가능할 때만 (모서리 끼임 방지)
+		return Dir < 4 || (Field.Walkable[Field.ToIndex(NX, CY)] && Field.Walkable[Field.ToIndex(CX, NY)]);
+	}
+}
+
+FIntPoint FFlowField::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32((Location.X - Origin.X) / CellSize), FMath::FloorToInt32((Location.Y - Origin.Y) / CellSize));
+}
+
+FVector FFlowField::GetCellCenter(int32 X, int32 Y) const
+{
+	const int32 Index = ToIndex(X, Y);
+	const float Z = Heights.IsValidIndex(Index) ? Heights[Index] : Origin.Z;
+	return FVector(Origin.X + (X + 0.5f) * CellSize, Origin.Y + (Y + 0.5f) * CellSize, Z);
+}
+
+SIZE_T FFlowField::GetAllocatedSize() const
+{
+	return Walkable.GetAllocatedSize() + Heights.GetAllocatedSize() + Integration.GetAllocatedSize() + Directions.GetAllocatedSize();
+}
+
+bool UFlowField_Subsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFlowField_Subsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlowField_Subsystem, STATGROUP_Tickables);
+}
+
+void UFlowField_Subsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 내비메시가 다시 빌드되면 보행 정보를 갱신.
+	// 서브시스템 초기화 때는 내비게이션 시스템이 아직 없을 수 있으므로 흐름장을 쓰는 액터의 BeginPlay 전인 여기서 연결한다
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavGenerationHandle = NavSys->OnNavigationGenerationFinishedDelegate.AddUObject(this, &UFlowField_Subsystem::OnNavigationGenerationFinished);
+	}
+	else
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("FlowField: %s has no navigation system, fields will not follow navmesh rebuilds"), *InWorld.GetName());
+	}
+}
+
+void UFlowField_Subsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.Remove(NavGenerationHandle);
+	}
+	Fields.Reset();
+	Super::Deinitialize();
+}
+
+void UFlowField_Subsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	for (TPair<TObjectKey<AActor>, FFlowField>& Pair : Fields)
+	{
+		Pair.Value.bWalkabilityDirty = true;
+	}
+}
+
+void UFlowField_Subsystem::AcquireField(AActor* Goal)
+{
+	if (Goal)
+	{
+		FFlowField& Field = Fields.FindOrAdd(Goal);
+		Field.Goal = Goal;
+		++Field.NumFollowers;
+	}
+}
+
+void UFlowField_Subsystem::ReleaseField(AActor* Goal)
+{
+	const TObjectKey<AActor> Key(Goal);
+	if (FFlowField* Field = Fields.Find(Key))
+	{
+		if (--Field->NumFollowers <= 0)
+		{
+			Fields.Remove(Key);
+		}
+	}
+}
+
+SIZE_T UFlowField_Subsystem::GetAllocatedSize() const
+{
+	SIZE_T Size = Fields.GetAllocatedSize();
+	for (const TPair<TObjectKey<AActor>, FFlowField>& Pair : Fields)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void UFlowField_Subsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_FlowField_Tick);
+	AISTUDY_BENCHMARK_SCOPE(Pathfinding);
+
+	for (auto It = Fields.CreateIterator(); It; ++It)
+	{
+		FFlowField& Field = It.Value();
+		const AActor* Goal = Field.Goal.Get();
+		if (!Goal)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const FVector GoalLocation = Goal->GetActorLocation();
+
+		// 목표가 격자 가장자리(1/4 이내)로 가면 목표를 중심으로 다시 잡는다
+		const FIntPoint GoalCell = Field.ToCell(GoalLocation);
+		const int32 Margin = FMath::Max(Field.SizeX / 4, 1);
+		const bool bNearEdge = Field.SizeX == 0
+			|| GoalCell.X < Margin || GoalCell.Y < Margin
+			|| GoalCell.X >= Field.SizeX - Margin || GoalCell.Y >= Field.SizeY - Margin;
+
+		if (bNearEdge || Field.bWalkabilityDirty)
+		{
+			BuildWalkability(Field, bNearEdge ? GoalLocation : Field.GetCellCenter(Field.SizeX / 2, Field.SizeY / 2));
+			Field.GoalCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+		}
+
+		// 목표가 같은 셀에 있으면 아무것도 하지 않는다
+		const FIntPoint NewGoalCell = Field.ToCell(GoalLocation);
+		if (NewGoalCell != Field.GoalCell)
+		{
+			Field.GoalCell = NewGoalCell;
+			BuildIntegration(Field);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_FlowField_NumFields, Fields.Num());
+	SET_MEMORY_STAT(STAT_FlowField_Memory, GetAllocatedSize());
+}
+
+void UFlowField_Subsystem::BuildWalkability(FFlowField& Field, const FVector& Center) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_FlowField_Walkability);
+
+	Field.CellSize = FMath::Max(CVarFlowFieldCellSize.GetValueOnGameThread(), 10.0f);
+	const float HalfExtent = CVarFlowFieldHalfExtent.GetValueOnGameThread();
+	Field.SizeX = Field.SizeY = FMath::Max(FMath::CeilToInt32(2.0f * HalfExtent / Field.CellSize), 4);
+	Field.Origin = FVector(Center.X - HalfExtent, Center.Y - HalfExtent, Center.Z);
+	Field.bWalkabilityDirty = false;
+
+	const int32 NumCells = Field.SizeX * Field.SizeY;
+	Field.Walkable.Init(0, NumCells);
+	Field.Heights.Init(Center.Z, NumCells);
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (!NavData)
+	{
+		return;
+	}
+
+	// 셀 중심을 한 번에 투영 (셀 절반 너비 안에 내비메시가 있으면 보행 가능)
+	TArray<FNavigationProjectionWork> Workload;
+	Workload.Reserve(NumCells);
+	for (int32 Y = 0; Y < Field.SizeY; ++Y)
+	{
+		for (int32 X = 0; X < Field.SizeX; ++X)
+		{
+			Workload.Emplace(FVector(Field.Origin.X + (X + 0.5f) * Field.CellSize, Field.Origin.Y + (Y + 0.5f) * Field.CellSize, Center.Z));
+		}
+	}
+
+	const FVector Extent(Field.CellSize * 0.5f, Field.CellSize * 0.5f, HalfExtent * 0.5f);
+	NavData->BatchProjectPoints(Workload, Extent);
+
+	for (int32 Index = 0; Index < NumCells; ++Index)
+	{
+		if (Workload[Index].bResult)
+		{
+			Field.Walkable[Index] = 1;
+			Field.Heights[Index] = Workload[Index].OutLocation.Location.Z;
+		}
+	}
+}
+
+void UFlowField_Subsystem::BuildIntegration(FFlowField& Field) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_FlowField_Integration);
+
+	const int32 NumCells = Field.SizeX * Field.SizeY;
+	Field.Integration.Init(TNumericLimits<float>::Max(), NumCells);
+	Field.Directions.Init(FFlowField::NoDirection, NumCells);
+
+	if (!Field.IsValidCell(Field.GoalCell.X, Field.GoalCell.Y) || !Field.Walkable[Field.ToIndex(Field.GoalCell.X, Field.GoalCell.Y)])
+	{
+		return;
+	}
+
+	const float MaxStepHeight = CVarFlowFieldMaxStepHeight.GetValueOnGameThread();
+
+	// (비용, 셀 인덱스) 최소 힙
+	struct FOpenCell
+	{
+		float Cost;
+		int32 Index;
+		bool operator<(const FOpenCell& Other) const { return Cost < Other.Cost; }
+	};
+	TArray<FOpenCell> Open;
+	Open.Reserve(NumCells / 4);
+
+	const int32 GoalIndex = Field.ToIndex(Field.GoalCell.X, Field.GoalCell.Y);
+	Field.Integration[GoalIndex] = 0.0f;
+	Open.HeapPush(FOpenCell{ 0.0f, GoalIndex });
+
+	while (Open.Num() > 0)
+	{
+		FOpenCell Current;
+		Open.HeapPop(Current, EAllowShrinking::No);
+		if (Current.Cost > Field.Integration[Current.Index])
+		{
+			continue;
+		}
+
+		const int32 CX = Current.Index % Field.SizeX;
+		const int32 CY = Current.Index / Field.SizeX;
+		for (int32 Dir = 0; Dir < 8; ++Dir)
+		{
+			int32 NIndex = INDEX_NONE;
+			if (!FlowField::GetStepTarget(Field, CX, CY, Dir, MaxStepHeight, NIndex))
+			{
+				continue;
+			}
+
+			const float NewCost = Current.Cost + FlowField::NeighborCosts[Dir];
+			if (NewCost < Field.Integration[NIndex])
+			{
+				Field.Integration[NIndex] = NewCost;
+				Open.HeapPush(FOpenCell{ NewCost, NIndex });
+			}
+		}
+	}
+
+	// 각 셀에서 누적 비용이 가장 낮은 이웃을 방향으로 저장 (막힌 모서리나 못 오르는 턱 너머는 보지 않는다)
+	for (int32 Index = 0; Index < NumCells; ++Index)
+	{
+		if (!Field.Walkable[Index] || Index == GoalIndex || Field.Integration[Index] == TNumericLimits<float>::Max())
+		{
+			continue;
+		}
+
+		const int32 CX = Index % Field.SizeX;
+		const int32 CY = Index / Field.SizeX;
+		float BestCost = Field.Integration[Index];
+		for (int32 Dir = 0; Dir < 8; ++Dir)
+		{
+			int32 NIndex = INDEX_NONE;
+			if (FlowField::GetStepTarget(Field, CX, CY, Dir, MaxStepHeight, NIndex) && Field.Integration[NIndex] < BestCost)
+			{
+				BestCost = Field.Integration[NIndex];
+				Field.Directions[Index] = static_cast<uint8>(Dir);
+			}
+		}
+	}
+}
+
+bool UFlowField_Subsystem::SampleDirection(const AActor* Goal, const FVector& Location, FVector& OutDirection) const
+{
+	const FFlowField* Field = Fields.Find(Goal);
+	if (!Field || Field->SizeX == 0 || !Goal)
+	{
+		return false;
+	}
+
+	const FIntPoint Cell = Field->ToCell(Location);
+	if (!Field->IsValidCell(Cell.X, Cell.Y))
+	{
+		return false;
+	}
+
+	// 목표 셀에서는 목표를 직접 향한다
+	if (Cell == Field->GoalCell)
+	{
+		OutDirection = (Goal->GetActorLocation() - Location).GetSafeNormal2D();
+		return true;
+	}
+
+	const uint8 Dir = Field->Directions[Field->ToIndex(Cell.X, Cell.Y)];
+	if (Dir == FFlowField::NoDirection)
+	{
+		return false;
+	}
+
+	const FIntPoint Next = Cell + FlowField::Neighbors[Dir];
+	OutDirection = (Field->GetCellCenter(Next.X, Next.Y) - Location).GetSafeNormal2D();
+	return true;
+}
@@ -0,0 +1,641 @@
+#include "Mass_AgentProcessors.h"
+#include "Mass_AgentFragments.h"
+#include "Mass_AgentSubsystem.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "AIStudy.h"
+#include "AIStudyCharacter.h"
+#include "Benchmark_Metrics.h"
+#include "Chaser_AIController.h"
+#include "RVO_Character.h"
+#include "Spatial_HashSubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+#include "MassEntityManager.h"
+#include "NavigationSystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+DECLARE_CYCLE_STAT(TEXT("Mass Agent Patrol"), STAT_MassAgent_Patrol, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Mass Agent Chase"), STAT_MassAgent_Chase, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Mass Agent Movement"), STAT_MassAgent_Movement, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Mass Agent NavProjection"), STAT_MassAgent_NavProjection, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Mass Agent Promotion"), STAT_MassAgent_Promotion, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mass Agents"), STAT_MassAgent_NumAgents, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mass Promoted Agents"), STAT_MassAgent_NumPromoted, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarMassAvoidance(
+	TEXT("AIStudy.Mass.Avoidance"),
+	true,
+	TEXT("Mass 에이전트 이동에 ORCA 회피를 적용한다."));
+
+static TAutoConsoleVariable<float> CVarMassPromoteRadius(
+	TEXT("AIStudy.Mass.PromoteRadius"),
+	2500.0f,
+	TEXT("관찰자와 이 거리 안에 들어온 Mass 에이전트를 액터로 승격한다."));
+
+static TAutoConsoleVariable<float> CVarMassDemoteRadius(
+	TEXT("AIStudy.Mass.DemoteRadius"),
+	3000.0f,
+	TEXT("승격된 액터가 관찰자와 이 거리보다 멀어지면 다시 엔티티로 되돌린다. PromoteRadius보다 커야 경계에서 반복하지 않는다."));
+
+static TAutoConsoleVariable<int32> CVarMassMaxPromotionsPerFrame(
+	TEXT("AIStudy.Mass.MaxPromotionsPerFrame"),
+	8,
+	TEXT("프레임당 최대 액터 승격 수 (스폰 비용 분산)."));
+
+static TAutoConsoleVariable<int32> CVarMassNavProjectionsPerFrame(
+	TEXT("AIStudy.Mass.NavProjectionsPerFrame"),
+	512,
+	TEXT("프레임당 내비메시로 투영하는 Mass 에이전트 수. 0이면 투영하지 않는다."));
+
+namespace MassAgent
+{
+	// 추적 대상 격자 셀 크기 (기본 ChaseRadius 근처)
+	static constexpr float TargetCellSize = 1000.0f;
+	// 도착 후 다음 이동까지 대기 (AAIStudyCharacter::OnMoveCompleted의 타이머와 같다)
+	static constexpr float PatrolWaitTime = 0.5f;
+
+	static double MinDistanceSquared(const FVector& Location, const TArray<UAgent_SignificanceSubsystem::FViewpoint>& Viewpoints)
+	{
+		double Result = TNumericLimits<double>::Max();
+		for (const UAgent_SignificanceSubsystem::FViewpoint& Viewpoint : Viewpoints)
+		{
+			Result = FMath::Min(Result, FVector::DistSquared(Location, Viewpoint.Location));
+		}
+		return Result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 순찰
+
+UMass_AgentPatrolProcessor::UMass_AgentPatrolProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::AllNetModes);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+}
+
+void UMass_AgentPatrolProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassPatrolFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FMassAgentMoveFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddTagRequirement<FMassAgentPromotedTag>(EMassFragmentPresence::None);
+}
+
+void UMass_AgentPatrolProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_MassAgent_Patrol);
+
+	const float DeltaTime = Context.GetDeltaTimeSeconds();
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [DeltaTime](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+		const TArrayView<FMassPatrolFragment> Patrols = Context.GetMutableFragmentView<FMassPatrolFragment>();
+		const TArrayView<FMassAgentMoveFragment> Moves = Context.GetMutableFragmentView<FMassAgentMoveFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			FMassPatrolFragment& Patrol = Patrols[Index];
+			FMassAgentMoveFragment& Move = Moves[Index];
+
+			if (Patrol.WaitTime > 0.0f)
+			{
+				Patrol.WaitTime -= DeltaTime;
+				Move.bHasGoal = false;
+				continue;
+			}
+
+			// bIsSucceeded에 따라 목표 선택, 도착하면 토글
+			const FVector& Goal = Patrol.bIsSucceeded ? Patrol.PointA : Patrol.PointB;
+			if (FVector::DistSquared2D(Transforms[Index].GetTransform().GetLocation(), Goal) <= FMath::Square(Move.AcceptanceRadius))
+			{
+				Patrol.bIsSucceeded = !Patrol.bIsSucceeded;
+				Patrol.WaitTime = MassAgent::PatrolWaitTime;
+				Move.bHasGoal = false;
+				continue;
+			}
+
+			Move.Goal = Goal;
+			Move.bHasGoal = true;
+		}
+	});
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 추적
+
+UMass_AgentChaseProcessor::UMass_AgentChaseProcessor()
+	: TargetQuery(*this)
+	, ChaserQuery(*this)
+	, TargetGrid(MassAgent::TargetCellSize)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::AllNetModes);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	// 플레이어 폰을 읽고 벤치마크 지표를 기록하므로 Execute는 게임 스레드, 청크 처리는 병렬
+	bRequiresGameThreadExecution = true;
+}
+
+void UMass_AgentChaseProcessor::ConfigureQueries()
+{
+	// 승격된 대상도 위치가 동기화되므로 포함
+	TargetQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	TargetQuery.AddTagRequirement<FMassChaseTargetTag>(EMassFragmentPresence::All);
+
+	ChaserQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	ChaserQuery.AddRequirement<FMassChaseFragment>(EMassFragmentAccess::ReadWrite);
+	ChaserQuery.AddRequirement<FMassAgentMoveFragment>(EMassFragmentAccess::ReadWrite);
+	ChaserQuery.AddTagRequirement<FMassAgentPromotedTag>(EMassFragmentPresence::None);
+}
+
+void UMass_AgentChaseProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_MassAgent_Chase);
+	AISTUDY_BENCHMARK_SCOPE(Brain);
+
+	TargetLocations.Reset();
+	TargetQuery.ForEachEntityChunk(EntityManager, Context, [this](FMassExecutionContext& Context)
+	{
+		for (const FTransformFragment& Transform : Context.GetFragmentView<FTransformFragment>())
+		{
+			TargetLocations.Add(Transform.GetTransform().GetLocation());
+		}
+	});
+
+	// 플레이어가 조종하는 폰도 추적 대상
+	if (const UWorld* World = EntityManager.GetWorld())
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			if (const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+			{
+				TargetLocations.Add(PlayerPawn->GetActorLocation());
+			}
+		}
+	}
+
+	TargetGrid.Build(TargetLocations);
+
+	std::atomic<int32> StateCounts[3] = {};
+	const FSpatial_HashGrid& Grid = TargetGrid;
+	ChaserQuery.ParallelForEachEntityChunk(EntityManager, Context, [&Grid, &StateCounts](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+		const TArrayView<FMassChaseFragment> Chases = Context.GetMutableFragmentView<FMassChaseFragment>();
+		const TArrayView<FMassAgentMoveFragment> Moves = Context.GetMutableFragmentView<FMassAgentMoveFragment>();
+		int32 LocalCounts[3] = {};
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			FMassChaseFragment& Chase = Chases[Index];
+			FMassAgentMoveFragment& Move = Moves[Index];
+			const FVector Location = Transforms[Index].GetTransform().GetLocation();
+
+			// LoseInterestRadius 밖의 대상은 어떤 상태에서도 전환을 일으키지 않으므로 반경 안만 찾는다
+			const int32 Nearest = Grid.FindNearest(Location, Chase.LoseInterestRadius);
+			const FVector TargetLocation = Nearest != INDEX_NONE ? Grid.GetLocation(Nearest) : FVector::ZeroVector;
+			const double DistSq = Nearest != INDEX_NONE ? FVector::DistSquared(Location, TargetLocation) : TNumericLimits<double>::Max();
+			const double DetectionRadiusSq = FMath::Square(static_cast<double>(Chase.DetectionRadius));
+			const double ChaseRadiusSq = FMath::Square(static_cast<double>(Chase.ChaseRadius));
+			const double LoseInterestRadiusSq = FMath::Square(static_cast<double>(Chase.LoseInterestRadius));
+
+			bool bStopChasing = false;
+			switch (Chase.State)
+			{
+			case EAIState::Idle:
+				if (DistSq <= DetectionRadiusSq)
+				{
+					Chase.State = EAIState::Suspicious;
+				}
+				break;
+
+			case EAIState::Suspicious:
+				if (DistSq <= ChaseRadiusSq)
+				{
+					Chase.State = EAIState::Chasing;
+					Chase.bIsChasing = true;
+					Chase.LastKnownLocation = TargetLocation;
+				}
+				else if (DistSq > DetectionRadiusSq)
+				{
+					Chase.State = EAIState::Idle;
+				}
+				break;
+
+			case EAIState::Chasing:
+				bStopChasing = DistSq > LoseInterestRadiusSq;
+				break;
+			}
+
+			if (Chase.bIsChasing)
+			{
+				if (DistSq <= ChaseRadiusSq)
+				{
+					Move.Goal = TargetLocation;
+					Move.bHasGoal = true;
+					Chase.LastKnownLocation = TargetLocation;
+				}
+				else if (DistSq > LoseInterestRadiusSq)
+				{
+					bStopChasing = true;
+				}
+			}
+
+			if (bStopChasing)
+			{
+				Chase.bIsChasing = false;
+				Chase.State = EAIState::Idle;
+				Move.bHasGoal = false;
+			}
+
+			++LocalCounts[static_cast<int32>(Chase.State)];
+		}
+
+		for (int32 StateIndex = 0; StateIndex < 3; ++StateIndex)
+		{
+			StateCounts[StateIndex] += LocalCounts[StateIndex];
+		}
+	});
+
+	AISTUDY_INC_COUNTER_BY(ChasersIdle, StateCounts[static_cast<int32>(EAIState::Idle)].load());
+	AISTUDY_INC_COUNTER_BY(ChasersSuspicious, StateCounts[static_cast<int32>(EAIState::Suspicious)].load());
+	AISTUDY_INC_COUNTER_BY(ChasersChasing, StateCounts[static_cast<int32>(EAIState::Chasing)].load());
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 이동
+
+UMass_AgentMovementProcessor::UMass_AgentMovementProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::AllNetModes);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionOrder.ExecuteAfter.Add(UMass_AgentPatrolProcessor::StaticClass()->GetFName());
+	ExecutionOrder.ExecuteAfter.Add(UMass_AgentChaseProcessor::StaticClass()->GetFName());
+	// ORCA 풀이가 내부에서 ParallelFor를 쓰고 벤치마크 지표를 기록하므로 게임 스레드에서 시작
+	bRequiresGameThreadExecution = true;
+}
+
+void UMass_AgentMovementProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FMassAgentFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassAgentMoveFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void UMass_AgentMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_MassAgent_Movement);
+	AISTUDY_BENCHMARK_SCOPE(Avoidance);
+
+	const float DeltaTime = Context.GetDeltaTimeSeconds();
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	// 승격된 액터도 이웃으로 넣어 엔티티가 피해 가게 한다 (결과는 쓰지 않는다)
+	Data.Reset(EntityQuery.GetNumMatchingEntities(EntityManager));
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, DeltaTime](FMassExecutionContext& Context)
+	{
+		const bool bPromoted = Context.DoesArchetypeHaveTag<FMassAgentPromotedTag>();
+		const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+		const TConstArrayView<FMassAgentFragment> Agents = Context.GetFragmentView<FMassAgentFragment>();
+		const TArrayView<FMassAgentMoveFragment> Moves = Context.GetMutableFragmentView<FMassAgentMoveFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			const FMassAgentFragment& Agent = Agents[Index];
+			FMassAgentMoveFragment& Move = Moves[Index];
+			const FVector Location = Transforms[Index].GetTransform().GetLocation();
+
+			FVector2f Preferred = FVector2f::ZeroVector;
+			if (!bPromoted && Move.bHasGoal)
+			{
+				const FVector2f ToGoal(Move.Goal - Location);
+				const float Distance = ToGoal.Size();
+				if (Distance <= Move.AcceptanceRadius)
+				{
+					Move.bHasGoal = false;
+				}
+				else
+				{
+					// 한 스텝에 목표를 지나치지 않도록 속도를 줄인다
+					Preferred = ToGoal / Distance * FMath::Min(Agent.MaxSpeed, Distance / DeltaTime);
+				}
+			}
+
+			Data.Add(Location - FVector(0.0f, 0.0f, Agent.HalfHeight), Move.Velocity, Preferred, Agent.Radius, Agent.MaxSpeed, Agent.NeighborDistance);
+		}
+	});
+
+	if (CVarMassAvoidance.GetValueOnGameThread())
+	{
+		URVO_ORCASubsystem::Solve(Data, URVO_ORCASubsystem::GetSettings(DeltaTime));
+	}
+	else
+	{
+		Data.NewVelocities = Data.PreferredVelocities;
+	}
+
+	// 모을 때와 같은 순서로 순회하며 결과 적용
+	int32 Offset = 0;
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, DeltaTime, &Offset](FMassExecutionContext& Context)
+	{
+		const int32 NumEntities = Context.GetNumEntities();
+		if (Context.DoesArchetypeHaveTag<FMassAgentPromotedTag>())
+		{
+			Offset += NumEntities;
+			return;
+		}
+
+		const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FMassAgentMoveFragment> Moves = Context.GetMutableFragmentView<FMassAgentMoveFragment>();
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			const FVector2f Velocity = Data.NewVelocities[Offset + Index];
+			Moves[Index].Velocity = Velocity;
+
+			FTransform& Transform = Transforms[Index].GetMutableTransform();
+			Transform.AddToTranslation(FVector(Velocity.X, Velocity.Y, 0.0f) * DeltaTime);
+			if (!Velocity.IsNearlyZero())
+			{
+				Transform.SetRotation(FRotator(0.0f, FMath::RadiansToDegrees(FMath::Atan2(Velocity.Y, Velocity.X)), 0.0f).Quaternion());
+			}
+		}
+		Offset += NumEntities;
+	});
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 내비메시 투영
+
+UMass_AgentNavProjectionProcessor::UMass_AgentNavProjectionProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::AllNetModes);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionOrder.ExecuteAfter.Add(UMass_AgentMovementProcessor::StaticClass()->GetFName());
+	bRequiresGameThreadExecution = true;
+}
+
+void UMass_AgentNavProjectionProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FMassAgentFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FMassAgentPromotedTag>(EMassFragmentPresence::None);
+}
+
+void UMass_AgentNavProjectionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_MassAgent_NavProjection);
+
+	const int32 Budget = CVarMassNavProjectionsPerFrame.GetValueOnGameThread();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(EntityManager.GetWorld());
+	const int32 NumEntities = EntityQuery.GetNumMatchingEntities(EntityManager);
+	if (!NavSys || Budget <= 0 || NumEntities == 0)
+	{
+		return;
+	}
+
+	// Stride 프레임마다 한 번씩 모든 엔티티가 투영된다
+	const uint32 Stride = static_cast<uint32>(FMath::DivideAndRoundUp(NumEntities, Budget));
+	const uint32 Phase = Cursor++ % Stride;
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [NavSys, Stride, Phase](FMassExecutionContext& Context)
+	{
+		const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+		const TConstArrayView<FMassAgentFragment> Agents = Context.GetFragmentView<FMassAgentFragment>();
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			if (static_cast<uint32>(Context.GetEntity(Index).Index) % Stride != Phase)
+			{
+				continue;
+			}
+
+			// 내비메시 밖으로 나간 경우 가장 가까운 지점으로 되돌리고 높이를 맞춘다
+			FTransform& Transform = Transforms[Index].GetMutableTransform();
+			const FVector Feet = Transform.GetLocation() - FVector(0.0f, 0.0f, Agents[Index].HalfHeight);
+			FNavLocation Projected;
+			if (NavSys->ProjectPointToNavigation(Feet, Projected, FVector(100.0f, 100.0f, 250.0f)))
+			{
+				Transform.SetLocation(Projected.Location + FVector(0.0f, 0.0f, Agents[Index].HalfHeight));
+			}
+		}
+	});
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 액터 승격
+
+UMass_AgentPromotionProcessor::UMass_AgentPromotionProcessor()
+	: SimulatedQuery(*this)
+	, PromotedQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::AllNetModes);
+	// 액터 이동이 끝난 뒤 위치를 가져온다
+	ProcessingPhase = EMassProcessingPhase::PostPhysics;
+	bRequiresGameThreadExecution = true;
+}
+
+void UMass_AgentPromotionProcessor::ConfigureQueries()
+{
+	for (FMassEntityQuery* Query : { &SimulatedQuery, &PromotedQuery })
+	{
+		Query->AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+		Query->AddRequirement<FMassAgentFragment>(EMassFragmentAccess::ReadOnly);
+		Query->AddRequirement<FMassAgentMoveFragment>(EMassFragmentAccess::ReadWrite);
+		Query->AddRequirement<FMassAgentActorFragment>(EMassFragmentAccess::ReadWrite);
+		Query->AddRequirement<FMassPatrolFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+		Query->AddRequirement<FMassChaseFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	}
+	SimulatedQuery.AddTagRequirement<FMassAgentPromotedTag>(EMassFragmentPresence::None);
+	PromotedQuery.AddTagRequirement<FMassAgentPromotedTag>(EMassFragmentPresence::All);
+}
+
+void UMass_AgentPromotionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_MassAgent_Promotion);
+
+	const int32 NumSimulated = SimulatedQuery.GetNumMatchingEntities(EntityManager);
+	const int32 NumPromoted = PromotedQuery.GetNumMatchingEntities(EntityManager);
+	SET_DWORD_STAT(STAT_MassAgent_NumAgents, NumSimulated + NumPromoted);
+	SET_DWORD_STAT(STAT_MassAgent_NumPromoted, NumPromoted);
+
+	UWorld* World = EntityManager.GetWorld();
+	const UAgent_SignificanceSubsystem* Significance = World ? World->GetSubsystem<UAgent_SignificanceSubsystem>() : nullptr;
+	if (!Significance)
+	{
+		return;
+	}
+
+	TArray<UAgent_SignificanceSubsystem::FViewpoint> Viewpoints;
+	Significance->GatherViewpoints(Viewpoints);
+
+	const double PromoteRadiusSq = FMath::Square(static_cast<double>(CVarMassPromoteRadius.GetValueOnGameThread()));
+	const double DemoteRadiusSq = FMath::Square(static_cast<double>(FMath::Max(CVarMassDemoteRadius.GetValueOnGameThread(), CVarMassPromoteRadius.GetValueOnGameThread())));
+
+	// 승격된 액터: 위치 동기화, 멀어지면 상태를 되돌리고 액터 제거
+	PromotedQuery.ForEachEntityChunk(EntityManager, Context, [&Viewpoints, DemoteRadiusSq](FMassExecutionContext& Context)
+	{
+		const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FMassAgentMoveFragment> Moves = Context.GetMutableFragmentView<FMassAgentMoveFragment>();
+		const TArrayView<FMassAgentActorFragment> Actors = Context.GetMutableFragmentView<FMassAgentActorFragment>();
+		const TArrayView<FMassPatrolFragment> Patrols = Context.GetMutableFragmentView<FMassPatrolFragment>();
+		const TArrayView<FMassChaseFragment> Chases = Context.GetMutableFragmentView<FMassChaseFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			const FMassEntityHandle Entity = Context.GetEntity(Index);
+			APawn* Pawn = Actors[Index].Actor.Get();
+			if (!Pawn)
+			{
+				// 게임 로직이 액터를 없앤 경우 엔티티도 함께 제거
+				Context.Defer().DestroyEntity(Entity);
+				continue;
+			}
+
+			Transforms[Index].SetTransform(Pawn->GetActorTransform());
+			Moves[Index].Velocity = FVector2f(Pawn->GetVelocity());
+
+			if (MassAgent::MinDistanceSquared(Pawn->GetActorLocation(), Viewpoints) <= DemoteRadiusSq)
+			{
+				continue;
+			}
+
+			AController* Controller = Pawn->GetController();
+			if (Patrols.Num() > 0)
+			{
+				if (const AAIStudyCharacter* Character = Cast<AAIStudyCharacter>(Pawn))
+				{
+					Patrols[Index].bIsSucceeded = Character->bIsSucceeded;
+					Patrols[Index].WaitTime = 0.0f;
+				}
+			}
+			if (Chases.Num() > 0)
+			{
+				if (const AChaser_AIController* Chaser = Cast<AChaser_AIController>(Controller))
+				{
+					Chases[Index].State = Chaser->CurrentState;
+					Chases[Index].bIsChasing = Chaser->bIsChasing;
+					Chases[Index].LastKnownLocation = Chaser->LastKnownLocation;
+				}
+			}
+
+			if (Controller)
+			{
+				Controller->Destroy();
+			}
+			Pawn->Destroy();
+			Actors[Index].Actor.Reset();
+			Context.Defer().RemoveTag<FMassAgentPromotedTag>(Entity);
+		}
+	});
+
+	// 시뮬레이션 중인 엔티티: 관찰자 근처면 예산 안에서 액터로 승격
+	int32 Budget = CVarMassMaxPromotionsPerFrame.GetValueOnGameThread();
+	if (Viewpoints.Num() == 0 || Budget <= 0)
+	{
+		return;
+	}
+
+	SimulatedQuery.ForEachEntityChunk(EntityManager, Context, [this, World, &Viewpoints, PromoteRadiusSq, &Budget](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+		const TConstArrayView<FMassAgentFragment> Agents = Context.GetFragmentView<FMassAgentFragment>();
+		const TConstArrayView<FMassAgentMoveFragment> Moves = Context.GetFragmentView<FMassAgentMoveFragment>();
+		const TArrayView<FMassAgentActorFragment> Actors = Context.GetMutableFragmentView<FMassAgentActorFragment>();
+		const TConstArrayView<FMassPatrolFragment> Patrols = Context.GetFragmentView<FMassPatrolFragment>();
+		const TConstArrayView<FMassChaseFragment> Chases = Context.GetFragmentView<FMassChaseFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities() && Budget > 0; ++Index)
+		{
+			const FTransform& Transform = Transforms[Index].GetTransform();
+			if (MassAgent::MinDistanceSquared(Transform.GetLocation(), Viewpoints) > PromoteRadiusSq)
+			{
+				continue;
+			}
+
+			APawn* Pawn = SpawnActorFor(World, Agents[Index], Transform, Moves[Index],
+				Patrols.Num() > 0 ? &Patrols[Index] : nullptr, Chases.Num() > 0 ? &Chases[Index] : nullptr);
+			if (Pawn)
+			{
+				Actors[Index].Actor = Pawn;
+				Context.Defer().AddTag<FMassAgentPromotedTag>(Context.GetEntity(Index));
+			}
+			--Budget;
+		}
+	});
+}
+
+APawn* UMass_AgentPromotionProcessor::SpawnActorFor(UWorld* World, const FMassAgentFragment& Agent, const FTransform& Transform, const FMassAgentMoveFragment& Move,
+	const FMassPatrolFragment* Patrol, const FMassChaseFragment* Chase) const
+{
+	const UMass_AgentSubsystem* MassAgents = World->GetSubsystem<UMass_AgentSubsystem>();
+	if (!MassAgents)
+	{
+		return nullptr;
+	}
+
+	UClass* PawnClass = nullptr;
+	switch (Agent.Type)
+	{
+	case EMassAgentType::RVO:
+		PawnClass = MassAgents->RVOActorClass;
+		break;
+	case EMassAgentType::Chaser:
+		PawnClass = MassAgents->ChaserPawnClass;
+		break;
+	case EMassAgentType::Patrol:
+		PawnClass = MassAgents->PatrolActorClass;
+		break;
+	}
+	if (!PawnClass)
+	{
+		return nullptr;
+	}
+
+	// BeginPlay 전에 컨트롤러가 빙의되고 목표가 정해지도록 지연 스폰
+	APawn* Pawn = World->SpawnActorDeferred<APawn>(PawnClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Pawn)
+	{
+		return nullptr;
+	}
+	Pawn->AutoPossessAI = EAutoPossessAI::Spawned;
+
+	if (ARVO_Character* RVOCharacter = Cast<ARVO_Character>(Pawn))
+	{
+		RVOCharacter->TargetActor = Move.bHasGoal ? Move.GoalActor.Get() : nullptr;
+	}
+	if (AAIStudyCharacter* PatrolCharacter = Cast<AAIStudyCharacter>(Pawn); PatrolCharacter && Patrol)
+	{
+		PatrolCharacter->Target = Patrol->ActorA.Get();
+		PatrolCharacter->Target2 = Patrol->ActorB.Get();
+		PatrolCharacter->bIsSucceeded = Patrol->bIsSucceeded;
+		Pawn->AIControllerClass = AAIController::StaticClass();
+	}
+	if (Chase)
+	{
+		Pawn->AIControllerClass = AChaser_AIController::StaticClass();
+	}
+	else
+	{
+		Pawn->Tags.Add(USpatial_HashSubsystem::ChaserTargetTag);
+	}
+	Pawn->FinishSpawning(Transform);
+
+	// 엔티티에서 쌓인 상태 이어받기
+	if (AChaser_AIController* Chaser = Chase ? Cast<AChaser_AIController>(Pawn->GetController()) : nullptr)
+	{
+		Chaser->CurrentState = Chase->State;
+		Chaser->bIsChasing = Chase->bIsChasing;
+		Chaser->LastKnownLocation = Chase->LastKnownLocation;
+	}
+	if (UCharacterMovementComponent* Movement = Pawn->FindComponentByClass<UCharacterMovementComponent>())
+	{
+		Movement->Velocity = FVector(Move.Velocity.X, Move.Velocity.Y, 0.0f);
+	}
+	return Pawn;
+}
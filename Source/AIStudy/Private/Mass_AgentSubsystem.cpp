@@ -0,0 +1,148 @@
+#include "Mass_AgentSubsystem.h"
+#include "AIStudy.h"
+#include "AIStudyCharacter.h"
+#include "RVO_Character.h"
+#include "Chaser_Character.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassCommonFragments.h"
+#include "GameFramework/Character.h"
+
+void UMass_AgentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<UMassEntitySubsystem>();
+
+	RVOActorClass = ARVO_Character::StaticClass();
+	ChaserPawnClass = AChaser_Character::StaticClass();
+	PatrolActorClass = AAIStudyCharacter::StaticClass();
+}
+
+bool UMass_AgentSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FMassEntityManager& UMass_AgentSubsystem::GetEntityManager() const
+{
+	return GetWorld()->GetSubsystem<UMassEntitySubsystem>()->GetMutableEntityManager();
+}
+
+const FMassArchetypeHandle& UMass_AgentSubsystem::GetArchetype(EMassAgentType Type)
+{
+	FMassArchetypeHandle& Archetype = Archetypes[static_cast<int32>(Type)];
+	if (Archetype.IsValid())
+	{
+		return Archetype;
+	}
+
+	// 공통 프래그먼트 + 종류별 행동 프래그먼트
+	TArray<const UScriptStruct*> Composition = {
+		FTransformFragment::StaticStruct(),
+		FMassAgentFragment::StaticStruct(),
+		FMassAgentMoveFragment::StaticStruct(),
+		FMassAgentActorFragment::StaticStruct()
+	};
+
+	switch (Type)
+	{
+	case EMassAgentType::RVO:
+		Composition.Add(FMassChaseTargetTag::StaticStruct());
+		break;
+	case EMassAgentType::Chaser:
+		Composition.Add(FMassChaseFragment::StaticStruct());
+		break;
+	case EMassAgentType::Patrol:
+		Composition.Add(FMassPatrolFragment::StaticStruct());
+		Composition.Add(FMassChaseTargetTag::StaticStruct());
+		break;
+	}
+
+	Archetype = GetEntityManager().CreateArchetype(Composition);
+	return Archetype;
+}
+
+void UMass_AgentSubsystem::SpawnAgents(TConstArrayView<FMassAgentSpawnParams> Params, TArray<FMassEntityHandle>& OutEntities)
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+
+	// 종류별로 모아 아키타입마다 한 번에 생성
+	for (int32 TypeIndex = 0; TypeIndex < UE_ARRAY_COUNT(Archetypes); ++TypeIndex)
+	{
+		const EMassAgentType Type = static_cast<EMassAgentType>(TypeIndex);
+
+		TArray<const FMassAgentSpawnParams*> TypeParams;
+		for (const FMassAgentSpawnParams& Param : Params)
+		{
+			if (Param.Type == Type)
+			{
+				TypeParams.Add(&Param);
+			}
+		}
+		if (TypeParams.Num() == 0)
+		{
+			continue;
+		}
+
+		TArray<FMassEntityHandle> Entities;
+		TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager.BatchCreateEntities(GetArchetype(Type), TypeParams.Num(), Entities);
+
+		for (int32 Index = 0; Index < Entities.Num(); ++Index)
+		{
+			const FMassAgentSpawnParams& Param = *TypeParams[Index];
+			const FMassEntityHandle Entity = Entities[Index];
+
+			EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).SetTransform(FTransform(Param.Location));
+			EntityManager.GetFragmentDataChecked<FMassAgentFragment>(Entity).Type = Type;
+
+			FMassAgentMoveFragment& Move = EntityManager.GetFragmentDataChecked<FMassAgentMoveFragment>(Entity);
+			if (Type == EMassAgentType::RVO && Param.Goal)
+			{
+				Move.Goal = Param.Goal->GetActorLocation();
+				Move.GoalActor = Param.Goal;
+				Move.bHasGoal = true;
+			}
+
+			if (Type == EMassAgentType::Patrol && Param.PatrolA && Param.PatrolB)
+			{
+				FMassPatrolFragment& Patrol = EntityManager.GetFragmentDataChecked<FMassPatrolFragment>(Entity);
+				Patrol.PointA = Param.PatrolA->GetActorLocation();
+				Patrol.PointB = Param.PatrolB->GetActorLocation();
+				Patrol.ActorA = Param.PatrolA;
+				Patrol.ActorB = Param.PatrolB;
+			}
+		}
+
+		OutEntities.Append(Entities);
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Mass: spawned %d agents"), Params.Num());
+}
+
+void UMass_AgentSubsystem::DestroyAgents(TConstArrayView<FMassEntityHandle> Entities)
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+
+	TArray<FMassEntityHandle> ValidEntities;
+	ValidEntities.Reserve(Entities.Num());
+	for (const FMassEntityHandle Entity : Entities)
+	{
+		if (!EntityManager.IsEntityValid(Entity))
+		{
+			continue;
+		}
+
+		// 승격된 액터는 컨트롤러와 함께 정리
+		if (APawn* Pawn = EntityManager.GetFragmentDataChecked<FMassAgentActorFragment>(Entity).Actor.Get())
+		{
+			if (AController* Controller = Pawn->GetController())
+			{
+				Controller->Destroy();
+			}
+			Pawn->Destroy();
+		}
+		ValidEntities.Add(Entity);
+	}
+
+	EntityManager.BatchDestroyEntities(ValidEntities);
+}
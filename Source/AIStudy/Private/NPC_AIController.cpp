@@ -2,4 +2,72 @@
 
 
 #include "AIStudy/Public/NPC_AIController.h"
+#include "BT_NPCNodes.h"
+#include "Benchmark_Metrics.h"
+#include "Path_RequestSubsystem.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "UObject/Package.h"
 
+void UNPC_BehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	AISTUDY_BENCHMARK_SCOPE(BehaviorTree);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+ANPC_AIController::ANPC_AIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// RunBehaviorTree는 BrainComponent가 행동 트리 컴포넌트면 새로 만들지 않고 그대로 쓴다
+	BrainComponent = CreateDefaultSubobject<UNPC_BehaviorTreeComponent>(TEXT("BTComponent"));
+}
+
+void ANPC_AIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+	StartBehavior();
+}
+
+void ANPC_AIController::OnPoolAcquired()
+{
+	// 빙의는 풀에서도 유지되므로 OnPossess 대신 여기서 트리를 다시 시작한다
+	StartBehavior();
+}
+
+void ANPC_AIController::OnPoolReleased()
+{
+	// 풀은 액터 틱만 끄므로 트리를 멈추지 않으면 서비스/이동 태스크가 계속 경로를 요청한다
+	if (BrainComponent)
+	{
+		BrainComponent->StopLogic(TEXT("Pooled"));
+	}
+
+	if (UPath_RequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+	{
+		PathRequests->CancelRequest(this);
+	}
+	StopMovement();
+
+	// 이전 대상과 상태가 다음 사용자에게 넘어가지 않게 블랙보드를 비운다
+	if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+	{
+		for (FBlackboard::FKey KeyID = 0; KeyID < BlackboardComp->GetNumKeys(); ++KeyID)
+		{
+			BlackboardComp->ClearValue(KeyID);
+		}
+	}
+}
+
+void ANPC_AIController::StartBehavior()
+{
+	// 네이티브 트리는 모든 NPC가 공유한다. 행동 트리 관리자가 템플릿으로 붙잡고 있는 동안 유지된다
+	static TWeakObjectPtr<UBehaviorTree> NativeTree;
+	UBehaviorTree* Tree = BehaviorTree && BehaviorTree->RootNode ? BehaviorTree : NativeTree.Get();
+	if (!Tree)
+	{
+		Tree = NPCBehavior::CreateTree(GetTransientPackage());
+		NativeTree = Tree;
+	}
+	RunBehaviorTree(Tree);
+}
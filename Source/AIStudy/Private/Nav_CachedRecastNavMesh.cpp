@@ -0,0 +1,169 @@
+#include "Nav_CachedRecastNavMesh.h"
+#include "Nav_RebuildGovernorSubsystem.h"
+#include "Nav_TileCacheSubsystem.h"
+#include "NavMesh/PImplRecastNavMesh.h"
+#include "NavMesh/RecastNavMeshGenerator.h"
+#include "NavMesh/RecastHelpers.h"
+#include "Detour/DetourNavMesh.h"
+
+namespace NavTileCache
+{
+	static UNav_TileCacheSubsystem* GetCache(const ARecastNavMesh* NavMesh)
+	{
+		const UWorld* World = NavMesh ? NavMesh->GetWorld() : nullptr;
+		return World ? World->GetSubsystem<UNav_TileCacheSubsystem>() : nullptr;
+	}
+
+	static UNav_RebuildGovernorSubsystem* GetGovernor(const ARecastNavMesh* NavMesh)
+	{
+		const UWorld* World = NavMesh ? NavMesh->GetWorld() : nullptr;
+		return World ? World->GetSubsystem<UNav_RebuildGovernorSubsystem>() : nullptr;
+	}
+}
+
+// 전체 재빌드와 더티 영역 처리 뒤에 캐시 복원 단계를 끼워 넣은 생성기
+class FNav_CachedNavMeshGenerator : public FRecastNavMeshGenerator
+{
+public:
+	explicit FNav_CachedNavMeshGenerator(ANav_CachedRecastNavMesh& InNavMesh)
+		: FRecastNavMeshGenerator(InNavMesh)
+	{
+	}
+
+	virtual bool RebuildAll() override
+	{
+		// 기반 재빌드가 Detour 메시를 새로 만들고 경계 안의 타일을 모두 더티로 표시한다 (RebuildDirtyAreas를 거친다)
+		bRebuildingAll = true;
+		const bool bResult = FRecastNavMeshGenerator::RebuildAll();
+		bRebuildingAll = false;
+
+		ANav_CachedRecastNavMesh* NavMesh = Cast<ANav_CachedRecastNavMesh>(GetOwner());
+		UNav_TileCacheSubsystem* Cache = NavTileCache::GetCache(NavMesh);
+		if (!bResult || !Cache)
+		{
+			return bResult;
+		}
+
+		TSet<FIntPoint> Columns;
+		Columns.Reserve(PendingDirtyTiles.Num());
+		for (const FPendingTileElement& Element : PendingDirtyTiles)
+		{
+			Columns.Add(Element.Coord);
+		}
+
+		TSet<FIntPoint> Restored;
+		Cache->RestoreTiles(*NavMesh, Columns, Restored);
+		if (Restored.Num() > 0)
+		{
+			PendingDirtyTiles.RemoveAll([&Restored](const FPendingTileElement& Element)
+			{
+				return Restored.Contains(Element.Coord);
+			});
+		}
+		Cache->OnBuildQueued(*NavMesh, PendingDirtyTiles.Num());
+		return bResult;
+	}
+
+	virtual void RebuildDirtyAreas(const TArray<FNavigationDirtyArea>& DirtyAreas) override
+	{
+		ANav_CachedRecastNavMesh* NavMesh = Cast<ANav_CachedRecastNavMesh>(GetOwner());
+		UNav_RebuildGovernorSubsystem* Governor = bRebuildingAll ? nullptr : NavTileCache::GetGovernor(NavMesh);
+		if (Governor && DirtyAreas.Num() > 1)
+		{
+			TArray<FNavigationDirtyArea> Coalesced = DirtyAreas;
+			Governor->CoalesceDirtyAreas(Coalesced);
+			FRecastNavMeshGenerator::RebuildDirtyAreas(Coalesced);
+		}
+		else
+		{
+			FRecastNavMeshGenerator::RebuildDirtyAreas(DirtyAreas);
+		}
+		if (bRebuildingAll)
+		{
+			return;
+		}
+
+		// 복원한 타일이 더티로 들어와도 입력 해시가 그대로면 (겹치기만 한 더티 영역 등) 빌드하지 않는다
+		UNav_TileCacheSubsystem* Cache = NavTileCache::GetCache(NavMesh);
+		if (Cache && Cache->HasRestoredTiles(*NavMesh))
+		{
+			PendingDirtyTiles.RemoveAll([Cache, NavMesh](const FPendingTileElement& Element)
+			{
+				return Cache->IsRestoredTileUnchanged(*NavMesh, Element.Coord);
+			});
+		}
+
+		if (Governor)
+		{
+			Governor->DeferPendingTiles(*NavMesh, PendingDirtyTiles);
+		}
+	}
+
+	virtual void TickAsyncBuild(float DeltaSeconds) override
+	{
+		// 완료된 타일을 Detour 메시에 붙이는 게임 스레드 작업을 거버너 예산 안에서만 돌린다
+		ANav_CachedRecastNavMesh* NavMesh = Cast<ANav_CachedRecastNavMesh>(GetOwner());
+		UNav_RebuildGovernorSubsystem* Governor = NavTileCache::GetGovernor(NavMesh);
+		if (Governor && !Governor->ShouldTickBuild())
+		{
+			return;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		FRecastNavMeshGenerator::TickAsyncBuild(DeltaSeconds);
+		if (Governor)
+		{
+			Governor->OnBuildTicked(*NavMesh, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+	}
+
+private:
+	bool bRebuildingAll = false;
+};
+
+FRecastNavMeshGenerator* ANav_CachedRecastNavMesh::CreateGeneratorInstance()
+{
+	return new FNav_CachedNavMeshGenerator(*this);
+}
+
+bool ANav_CachedRecastNavMesh::AttachCachedTile(uint8* TileData, int32 DataSize)
+{
+	FPImplRecastNavMesh* Impl = GetRecastNavMeshImpl();
+	dtNavMesh* DetourMesh = Impl ? Impl->DetourNavMesh : nullptr;
+	if (!DetourMesh || !TileData || DataSize <= 0)
+	{
+		return false;
+	}
+
+	// 매직/버전이 맞지 않거나 타일 슬롯이 모자라면 실패하고 소유권은 호출자에게 남는다
+	dtTileRef TileRef = 0;
+	return dtStatusSucceed(DetourMesh->addTile(TileData, DataSize, DT_TILE_FREE_DATA, 0, &TileRef));
+}
+
+void ANav_CachedRecastNavMesh::BroadcastGenerationFinished()
+{
+	RequestDrawingUpdate();
+	OnNavMeshGenerationFinished();
+}
+
+FBox NavTile::GetTileBounds(const ARecastNavMesh& NavMesh, const FIntPoint& Tile)
+{
+	const dtNavMesh* DetourMesh = NavMesh.GetRecastMesh();
+	if (!DetourMesh)
+	{
+		return FBox(ForceInit);
+	}
+
+	// Recast 좌표(Y 위)의 타일 사각형을 언리얼 좌표로 바꾼다
+	const dtNavMeshParams* Params = DetourMesh->getParams();
+	const FVector::FReal MinX = Params->orig[0] + Tile.X * Params->tileWidth;
+	const FVector::FReal MinZ = Params->orig[2] + Tile.Y * Params->tileHeight;
+	FBox Bounds(ForceInit);
+	Bounds += Recast2UnrealPoint(FVector(MinX, 0.0, MinZ));
+	Bounds += Recast2UnrealPoint(FVector(MinX + Params->tileWidth, 0.0, MinZ + Params->tileHeight));
+
+	constexpr FVector::FReal MaxHeight = 1.0e6;
+	Bounds.Min.Z = -MaxHeight;
+	Bounds.Max.Z = MaxHeight;
+	return Bounds;
+}
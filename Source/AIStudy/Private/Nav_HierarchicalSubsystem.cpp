@@ -0,0 +1,710 @@
+#include "Nav_HierarchicalSubsystem.h"
+#include "AIStudy.h"
+#include "Benchmark_Metrics.h"
+#include "Replay_AISubsystem.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/MinElement.h"
+#include "Algo/Reverse.h"
+
+DECLARE_CYCLE_STAT(TEXT("HPA Cluster Rebuild"), STAT_HPA_Rebuild, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("HPA Abstract Search"), STAT_HPA_Abstract, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("HPA Corridor Refine"), STAT_HPA_Refine, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HPA Clusters"), STAT_HPA_NumClusters, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HPA Portals"), STAT_HPA_NumPortals, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HPA Dirty Clusters"), STAT_HPA_NumDirty, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarHPAEnable(
+	TEXT("AIStudy.HPA.Enable"),
+	true,
+	TEXT("끄면 계층 경로 탐색을 쓰지 않고 모든 요청을 일반 Recast 탐색으로 보낸다."));
+
+static TAutoConsoleVariable<bool> CVarHPAAllRequests(
+	TEXT("AIStudy.HPA.AllRequests"),
+	false,
+	TEXT("켜면 UNav_HierarchicalQueryFilter를 쓰지 않는 컨트롤러의 먼 요청도 계층 탐색으로 보낸다."));
+
+static TAutoConsoleVariable<int32> CVarHPAClusterTiles(
+	TEXT("AIStudy.HPA.ClusterTiles"),
+	4,
+	TEXT("클러스터 한 변의 내비메시 타일 수. 바꾸면 그래프 전체를 다시 만든다."));
+
+static TAutoConsoleVariable<float> CVarHPAMinQueryDistance(
+	TEXT("AIStudy.HPA.MinQueryDistance"),
+	5000.0f,
+	TEXT("시작과 끝의 수평 거리가 이보다 가까우면 계층 탐색 없이 일반 탐색을 쓴다."));
+
+static TAutoConsoleVariable<float> CVarHPAPortalMergeDistance(
+	TEXT("AIStudy.HPA.PortalMergeDistance"),
+	800.0f,
+	TEXT("같은 클러스터 경계에서 이 거리 안의 폴리곤 변은 하나의 포털로 묶는다."));
+
+static TAutoConsoleVariable<int32> CVarHPAClustersPerFrame(
+	TEXT("AIStudy.HPA.ClustersPerFrame"),
+	4,
+	TEXT("프레임마다 포털을 다시 만들 최대 클러스터 수."));
+
+static TAutoConsoleVariable<float> CVarHPARebuildBudgetMs(
+	TEXT("AIStudy.HPA.RebuildBudgetMs"),
+	0.5f,
+	TEXT("클러스터 포털/비용 행렬 갱신에 쓰는 프레임당 시간 예산(ms). 남은 포털 쌍은 다음 프레임에 이어서 계산한다."));
+
+static FAutoConsoleCommandWithWorld GHPAReportCommand(
+	TEXT("AIStudy.HPA.Report"),
+	TEXT("계층 경로 그래프 크기와 쿼리 통계를 로그로 출력"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNav_HierarchicalSubsystem* Hierarchical = World ? World->GetSubsystem<UNav_HierarchicalSubsystem>() : nullptr)
+		{
+			Hierarchical->LogReport();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GHPARebuildCommand(
+	TEXT("AIStudy.HPA.Rebuild"),
+	TEXT("계층 경로 그래프의 모든 클러스터를 다시 빌드"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UNav_HierarchicalSubsystem* Hierarchical = World ? World->GetSubsystem<UNav_HierarchicalSubsystem>() : nullptr)
+		{
+			Hierarchical->MarkAllDirty();
+		}
+	}));
+
+namespace NavHierarchical
+{
+	static const FIntPoint Neighbors[4] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+	static const FIntPoint InvalidCluster(MAX_int32, MAX_int32);
+	// 클러스터 안 포털 사이 경로가 클러스터 폭의 이 배수보다 길면 클러스터 밖으로 돌아가는 것으로 보고 잇지 않는다
+	constexpr float MaxIntraDetour = 3.0f;
+	// 추상 그래프의 목표 노드
+	constexpr int32 GoalNode = -1;
+	constexpr int32 StartNode = -2;
+
+	struct FOpenNode
+	{
+		float F;
+		int32 Node;
+
+		bool operator<(const FOpenNode& Other) const { return F < Other.F; }
+	};
+}
+
+bool UNav_HierarchicalSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNav_HierarchicalSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNav_HierarchicalSubsystem, STATGROUP_Tickables);
+}
+
+void UNav_HierarchicalSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.Remove(NavGenerationHandle);
+	}
+
+	Clusters.Reset();
+	Portals.Reset();
+	DirtyClusters.Reset();
+	PendingCostClusters.Reset();
+	Super::Deinitialize();
+}
+
+void UNav_HierarchicalSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	bTilesDirty = true;
+
+	// 동적 내비메시 타일이 다시 빌드되면 지문을 비교해 바뀐 클러스터만 갱신.
+	// 서브시스템 초기화 때는 내비게이션 시스템이 아직 없을 수 있으므로 여기서 연결한다
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavGenerationHandle = NavSys->OnNavigationGenerationFinishedDelegate.AddUObject(this, &UNav_HierarchicalSubsystem::OnNavigationGenerationFinished);
+	}
+	else
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("HPA: %s has no navigation system, clusters will not follow navmesh rebuilds"), *InWorld.GetName());
+	}
+}
+
+void UNav_HierarchicalSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	if (NavData && NavData == BuiltNavMesh.Get())
+	{
+		bTilesDirty = true;
+	}
+}
+
+void UNav_HierarchicalSubsystem::MarkAllDirty()
+{
+	Clusters.Reset();
+	Portals.Reset();
+	DirtyClusters.Reset();
+	PendingCostClusters.Reset();
+	bTilesDirty = true;
+}
+
+ARecastNavMesh* UNav_HierarchicalSubsystem::GetNavMesh() const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	return NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance()) : nullptr;
+}
+
+void UNav_HierarchicalSubsystem::Tick(float DeltaTime)
+{
+	if (!bGraphRequested || !CVarHPAEnable.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	ARecastNavMesh* NavMesh = GetNavMesh();
+	if (!NavMesh)
+	{
+		return;
+	}
+
+	// 내비메시나 클러스터 크기가 바뀌면 처음부터 다시 만든다
+	const int32 DesiredClusterTiles = FMath::Max(CVarHPAClusterTiles.GetValueOnGameThread(), 1);
+	if (NavMesh != BuiltNavMesh.Get() || DesiredClusterTiles != ClusterTiles)
+	{
+		MarkAllDirty();
+		BuiltNavMesh = NavMesh;
+		ClusterTiles = DesiredClusterTiles;
+	}
+
+	if (bTilesDirty)
+	{
+		bTilesDirty = false;
+		RefreshTiles(*NavMesh);
+	}
+
+	AISTUDY_BENCHMARK_SCOPE(Pathfinding);
+	// AI 기록/재생 중에는 탐색에 쓰이는 비용이 벽시계에 따라 달라지지 않도록 밀린 비용을 한 번에 끝낸다
+	const double Deadline = UReplay_AISubsystem::IsDeterministic(GetWorld())
+		? UE_DOUBLE_BIG_NUMBER
+		: FPlatformTime::Seconds() + CVarHPARebuildBudgetMs.GetValueOnGameThread() / 1000.0;
+
+	// 밀린 비용 행렬부터 이어서 계산한다
+	while (PendingCostClusters.Num() > 0 && FPlatformTime::Seconds() < Deadline)
+	{
+		if (!ContinueCosts(*NavMesh, PendingCostClusters[0], Deadline))
+		{
+			break;
+		}
+		PendingCostClusters.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	const int32 MaxClusters = FMath::Max(CVarHPAClustersPerFrame.GetValueOnGameThread(), 1);
+	for (int32 Count = 0; Count < MaxClusters && DirtyClusters.Num() > 0 && FPlatformTime::Seconds() < Deadline; ++Count)
+	{
+		const FIntPoint ClusterKey = DirtyClusters.Pop(EAllowShrinking::No);
+		RebuildCluster(*NavMesh, ClusterKey);
+	}
+
+	SET_DWORD_STAT(STAT_HPA_NumClusters, Clusters.Num());
+	SET_DWORD_STAT(STAT_HPA_NumPortals, Portals.Num());
+	SET_DWORD_STAT(STAT_HPA_NumDirty, DirtyClusters.Num());
+}
+
+void UNav_HierarchicalSubsystem::RefreshTiles(const ARecastNavMesh& NavMesh)
+{
+	// 타일을 클러스터로 다시 묶는다. 타일 수만큼만 돌며 폴리곤 변은 보지 않는다.
+	TMap<FIntPoint, FCluster> NewClusters;
+	TArray<FNavPoly> Polys;
+	const int32 NumTiles = NavMesh.GetNavMeshTilesCount();
+	for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		int32 Layer = 0;
+		Polys.Reset();
+		if (!NavMesh.GetNavMeshTileXY(TileIndex, X, Y, Layer) || !NavMesh.GetPolysInTile(TileIndex, Polys) || Polys.Num() == 0)
+		{
+			continue;
+		}
+
+		const FIntPoint Key(FMath::FloorToInt32(static_cast<float>(X) / ClusterTiles), FMath::FloorToInt32(static_cast<float>(Y) / ClusterTiles));
+		FCluster& Cluster = NewClusters.FindOrAdd(Key);
+		Cluster.Tiles.Add(TileIndex);
+		Cluster.TileFingerprints.Emplace(Polys[0].Ref, Polys.Num());
+	}
+
+	// 없어진 클러스터는 포털을 떼어 내고 이웃의 비용을 다시 계산하게 한다
+	TArray<FIntPoint> Removed;
+	for (const TPair<FIntPoint, FCluster>& Pair : Clusters)
+	{
+		if (!NewClusters.Contains(Pair.Key))
+		{
+			Removed.Add(Pair.Key);
+		}
+	}
+	for (const FIntPoint& Key : Removed)
+	{
+		for (const FIntPoint& Offset : NavHierarchical::Neighbors)
+		{
+			RemovePortalsBetween(Key, Key + Offset);
+			if (NewClusters.Contains(Key + Offset))
+			{
+				DirtyClusters.AddUnique(Key + Offset);
+			}
+		}
+		Clusters.Remove(Key);
+		DirtyClusters.Remove(Key);
+	}
+
+	// 타일 구성이나 지문이 바뀐 클러스터만 더럽힘 표시. 포털과 비용은 다시 빌드할 때까지 이전 값을 쓴다.
+	for (TPair<FIntPoint, FCluster>& Pair : NewClusters)
+	{
+		FCluster* Existing = Clusters.Find(Pair.Key);
+		if (!Existing)
+		{
+			Clusters.Add(Pair.Key, MoveTemp(Pair.Value));
+			DirtyClusters.AddUnique(Pair.Key);
+			continue;
+		}
+
+		if (Existing->Tiles != Pair.Value.Tiles || Existing->TileFingerprints != Pair.Value.TileFingerprints)
+		{
+			Existing->Tiles = MoveTemp(Pair.Value.Tiles);
+			Existing->TileFingerprints = MoveTemp(Pair.Value.TileFingerprints);
+			DirtyClusters.AddUnique(Pair.Key);
+		}
+	}
+}
+
+FIntPoint UNav_HierarchicalSubsystem::GetClusterForPoly(const ARecastNavMesh& NavMesh, NavNodeRef PolyRef) const
+{
+	uint32 PolyIndex = 0;
+	uint32 TileIndex = 0;
+	int32 X = 0;
+	int32 Y = 0;
+	int32 Layer = 0;
+	if (!NavMesh.GetPolyTileIndex(PolyRef, PolyIndex, TileIndex) || !NavMesh.GetNavMeshTileXY(static_cast<int32>(TileIndex), X, Y, Layer))
+	{
+		return NavHierarchical::InvalidCluster;
+	}
+	return FIntPoint(FMath::FloorToInt32(static_cast<float>(X) / ClusterTiles), FMath::FloorToInt32(static_cast<float>(Y) / ClusterTiles));
+}
+
+void UNav_HierarchicalSubsystem::DetachPortal(int32 PortalIndex)
+{
+	const FPortal Portal = Portals[PortalIndex];
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		FCluster* Cluster = Clusters.Find(Portal.Clusters[Side]);
+		const int32 Slot = Portal.Slots[Side];
+		if (!Cluster || !Cluster->Portals.IsValidIndex(Slot))
+		{
+			continue;
+		}
+
+		// 마지막 포털을 빈 자리로 옮기고 그 포털의 슬롯을 고친다. 비용 행렬은 다시 계산할 때까지 쓰지 않는다.
+		Cluster->Portals.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+		Cluster->Costs.Reset();
+		Cluster->PendingCosts.Reset();
+		if (Cluster->Portals.IsValidIndex(Slot))
+		{
+			FPortal& Moved = Portals[Cluster->Portals[Slot]];
+			Moved.Slots[Moved.Clusters[0] == Portal.Clusters[Side] ? 0 : 1] = Slot;
+		}
+	}
+	Portals.RemoveAt(PortalIndex);
+}
+
+void UNav_HierarchicalSubsystem::RemovePortalsBetween(const FIntPoint& A, const FIntPoint& B)
+{
+	const FCluster* Cluster = Clusters.Find(A);
+	if (!Cluster)
+	{
+		return;
+	}
+
+	const TArray<int32> PortalIndices = Cluster->Portals;
+	for (const int32 PortalIndex : PortalIndices)
+	{
+		const FPortal& Portal = Portals[PortalIndex];
+		if (Portal.Clusters[0] == B || Portal.Clusters[1] == B)
+		{
+			DetachPortal(PortalIndex);
+		}
+	}
+}
+
+void UNav_HierarchicalSubsystem::RebuildCluster(const ARecastNavMesh& NavMesh, const FIntPoint& ClusterKey)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_HPA_Rebuild);
+
+	const FCluster* Cluster = Clusters.Find(ClusterKey);
+	if (!Cluster)
+	{
+		return;
+	}
+
+	// 이웃 클러스터로 넘어가는 폴리곤 변의 중점을 이웃별로 모은다
+	TMap<FIntPoint, TArray<FVector>> Crossings;
+	TArray<FNavPoly> Polys;
+	TArray<FNavigationPortalEdge> Edges;
+	for (const int32 TileIndex : Cluster->Tiles)
+	{
+		Polys.Reset();
+		NavMesh.GetPolysInTile(TileIndex, Polys);
+		for (const FNavPoly& Poly : Polys)
+		{
+			Edges.Reset();
+			NavMesh.GetPolyNeighbors(Poly.Ref, Edges);
+			for (const FNavigationPortalEdge& Edge : Edges)
+			{
+				const FIntPoint Other = GetClusterForPoly(NavMesh, Edge.ToRef);
+				if (Other != ClusterKey && FMath::Abs(Other.X - ClusterKey.X) + FMath::Abs(Other.Y - ClusterKey.Y) == 1 && Clusters.Contains(Other))
+				{
+					Crossings.FindOrAdd(Other).Add((Edge.Left + Edge.Right) * 0.5);
+				}
+			}
+		}
+	}
+
+	// 경계 양쪽의 포털은 이쪽에서 다시 만든다
+	for (const FIntPoint& Offset : NavHierarchical::Neighbors)
+	{
+		RemovePortalsBetween(ClusterKey, ClusterKey + Offset);
+	}
+
+	// 가까운 변끼리 묶어 묶음마다 평균에 가장 가까운 변의 중점을 포털로 둔다
+	const double MergeDistanceSq = FMath::Square(static_cast<double>(CVarHPAPortalMergeDistance.GetValueOnGameThread()));
+	for (const TPair<FIntPoint, TArray<FVector>>& Pair : Crossings)
+	{
+		TArray<TArray<FVector>> Groups;
+		for (const FVector& Midpoint : Pair.Value)
+		{
+			TArray<FVector>* Group = Groups.FindByPredicate([&Midpoint, MergeDistanceSq](const TArray<FVector>& Members)
+			{
+				return FVector::DistSquared(Members[0], Midpoint) <= MergeDistanceSq;
+			});
+			if (Group)
+			{
+				Group->Add(Midpoint);
+			}
+			else
+			{
+				Groups.AddDefaulted_GetRef().Add(Midpoint);
+			}
+		}
+
+		for (const TArray<FVector>& Members : Groups)
+		{
+			FVector Mean = FVector::ZeroVector;
+			for (const FVector& Member : Members)
+			{
+				Mean += Member;
+			}
+			Mean /= Members.Num();
+
+			FPortal Portal;
+			Portal.Location = *Algo::MinElementBy(Members, [&Mean](const FVector& Member) { return FVector::DistSquared(Member, Mean); });
+			Portal.Clusters[0] = ClusterKey;
+			Portal.Clusters[1] = Pair.Key;
+			const int32 PortalIndex = Portals.Add(Portal);
+			for (int32 Side = 0; Side < 2; ++Side)
+			{
+				Portals[PortalIndex].Slots[Side] = Clusters[Portal.Clusters[Side]].Portals.Add(PortalIndex);
+			}
+		}
+	}
+
+	// 포털 집합이 바뀐 이 클러스터와 이웃의 비용 행렬을 다시 계산 (Num² 번의 A*라 예산으로 나눠 한다)
+	QueueCostRebuild(ClusterKey);
+	for (const FIntPoint& Offset : NavHierarchical::Neighbors)
+	{
+		QueueCostRebuild(ClusterKey + Offset);
+	}
+	++Stats.NumClusterRebuilds;
+}
+
+void UNav_HierarchicalSubsystem::QueueCostRebuild(const FIntPoint& ClusterKey)
+{
+	FCluster* Cluster = Clusters.Find(ClusterKey);
+	if (!Cluster)
+	{
+		return;
+	}
+
+	// 이전 행렬은 포털 슬롯이 바뀌었으므로 버리고, 계산 중이던 행렬도 처음부터 다시 한다
+	Cluster->Costs.Reset();
+	Cluster->PendingCosts.Reset();
+	PendingCostClusters.AddUnique(ClusterKey);
+}
+
+bool UNav_HierarchicalSubsystem::ContinueCosts(const ARecastNavMesh& NavMesh, const FIntPoint& ClusterKey, double Deadline)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_HPA_Rebuild);
+
+	FCluster* Cluster = Clusters.Find(ClusterKey);
+	if (!Cluster)
+	{
+		return true;
+	}
+
+	const int32 Num = Cluster->Portals.Num();
+	if (Cluster->PendingCosts.Num() != Num * Num || Num == 0)
+	{
+		Cluster->PendingCosts.Init(-1.0f, Num * Num);
+		Cluster->NextCostI = 0;
+		Cluster->NextCostJ = 1;
+	}
+
+	const FSharedConstNavQueryFilter Filter = NavMesh.GetDefaultQueryFilter();
+	const float MaxLength = NavHierarchical::MaxIntraDetour * ClusterTiles * NavMesh.GetTileSizeUU();
+	for (int32& I = Cluster->NextCostI; I < Num; ++I, Cluster->NextCostJ = I + 1)
+	{
+		Cluster->PendingCosts[I * Num + I] = 0.0f;
+		for (int32& J = Cluster->NextCostJ; J < Num; ++J)
+		{
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+
+			const float Length = CalcPathLength(NavMesh, Portals[Cluster->Portals[I]].Location, Portals[Cluster->Portals[J]].Location, Filter);
+			if (Length >= 0.0f && Length <= MaxLength)
+			{
+				Cluster->PendingCosts[I * Num + J] = Length;
+				Cluster->PendingCosts[J * Num + I] = Length;
+			}
+		}
+	}
+
+	Cluster->Costs = MoveTemp(Cluster->PendingCosts);
+	Cluster->PendingCosts.Reset();
+	return true;
+}
+
+float UNav_HierarchicalSubsystem::CalcPathLength(const ANavigationData& NavData, const FVector& From, const FVector& To, FSharedConstNavQueryFilter Filter) const
+{
+	FVector::FReal Length = 0.0;
+	const ENavigationQueryResult::Type Result = NavData.CalcPathLength(From, To, Length, Filter);
+	return Result == ENavigationQueryResult::Success ? static_cast<float>(Length) : -1.0f;
+}
+
+bool UNav_HierarchicalSubsystem::ShouldUseHierarchical(const ANavigationData& NavData, const FVector& Start, const FVector& End)
+{
+	RequestGraph();
+	return CVarHPAEnable.GetValueOnGameThread()
+		&& &NavData == BuiltNavMesh.Get()
+		&& Clusters.Num() > 0
+		&& FVector::DistSquared2D(Start, End) >= FMath::Square(CVarHPAMinQueryDistance.GetValueOnGameThread());
+}
+
+bool UNav_HierarchicalSubsystem::WantsHierarchical(TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	return CVarHPAAllRequests.GetValueOnGameThread() || (FilterClass && FilterClass->IsChildOf<UNav_HierarchicalQueryFilter>());
+}
+
+FNavPathSharedPtr UNav_HierarchicalSubsystem::FindPath(const ANavigationData& NavData, const FVector& Start, const FVector& End, FSharedConstNavQueryFilter Filter, const UObject* Querier)
+{
+	const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(&NavData);
+	if (!NavMesh || NavMesh != BuiltNavMesh.Get() || Clusters.Num() == 0)
+	{
+		return nullptr;
+	}
+	if (!Filter.IsValid())
+	{
+		Filter = NavData.GetDefaultQueryFilter();
+	}
+
+	// 시작/끝 클러스터. 같거나 이웃한 클러스터면 일반 탐색이 더 싸다.
+	const FVector Extent = NavData.GetDefaultQueryExtent();
+	const NavNodeRef StartRef = NavMesh->FindNearestPoly(Start, Extent, Filter, Querier);
+	const NavNodeRef EndRef = NavMesh->FindNearestPoly(End, Extent, Filter, Querier);
+	const FIntPoint StartKey = StartRef != INVALID_NAVNODEREF ? GetClusterForPoly(*NavMesh, StartRef) : NavHierarchical::InvalidCluster;
+	const FIntPoint EndKey = EndRef != INVALID_NAVNODEREF ? GetClusterForPoly(*NavMesh, EndRef) : NavHierarchical::InvalidCluster;
+	const FCluster* StartCluster = Clusters.Find(StartKey);
+	const FCluster* EndCluster = Clusters.Find(EndKey);
+	if (!StartCluster || !EndCluster || FMath::Abs(StartKey.X - EndKey.X) + FMath::Abs(StartKey.Y - EndKey.Y) <= 1)
+	{
+		++Stats.NumFallbacks;
+		return nullptr;
+	}
+
+	// 1단계: 추상 그래프 A*. 시작/끝은 임시 노드로, 각자 클러스터의 포털과만 잇는다.
+	const double AbstractStartTime = FPlatformTime::Seconds();
+	TArray<int32> PortalSequence;
+	{
+		AISTUDY_SCOPE_CYCLE_COUNTER(STAT_HPA_Abstract);
+
+		TMap<int32, float> GoalCosts;
+		for (const int32 PortalIndex : EndCluster->Portals)
+		{
+			const float Length = CalcPathLength(NavData, Portals[PortalIndex].Location, End, Filter);
+			if (Length >= 0.0f)
+			{
+				GoalCosts.Add(PortalIndex, Length);
+			}
+		}
+
+		TMap<int32, float> CostSoFar;
+		TMap<int32, int32> CameFrom;
+		TArray<NavHierarchical::FOpenNode> Open;
+		auto Relax = [&](int32 Node, int32 From, float Cost)
+		{
+			const float* Existing = CostSoFar.Find(Node);
+			if (!Existing || Cost < *Existing)
+			{
+				CostSoFar.Add(Node, Cost);
+				CameFrom.Add(Node, From);
+				const float Heuristic = Node == NavHierarchical::GoalNode ? 0.0f : static_cast<float>(FVector::Dist(Portals[Node].Location, End));
+				Open.HeapPush({ Cost + Heuristic, Node });
+			}
+		};
+
+		for (const int32 PortalIndex : StartCluster->Portals)
+		{
+			const float Length = CalcPathLength(NavData, Start, Portals[PortalIndex].Location, Filter);
+			if (Length >= 0.0f)
+			{
+				Relax(PortalIndex, NavHierarchical::StartNode, Length);
+			}
+		}
+
+		TSet<int32> Closed;
+		bool bFound = false;
+		while (Open.Num() > 0)
+		{
+			NavHierarchical::FOpenNode Current;
+			Open.HeapPop(Current, EAllowShrinking::No);
+			if (Current.Node == NavHierarchical::GoalNode)
+			{
+				bFound = true;
+				break;
+			}
+
+			bool bAlreadyClosed = false;
+			Closed.Add(Current.Node, &bAlreadyClosed);
+			if (bAlreadyClosed)
+			{
+				continue;
+			}
+
+			const float CurrentCost = CostSoFar[Current.Node];
+			if (const float* GoalCost = GoalCosts.Find(Current.Node))
+			{
+				Relax(NavHierarchical::GoalNode, Current.Node, CurrentCost + *GoalCost);
+			}
+
+			// 포털은 양쪽 클러스터 모두에서 이웃 포털로 이어진다
+			const FPortal& Portal = Portals[Current.Node];
+			for (int32 Side = 0; Side < 2; ++Side)
+			{
+				const FCluster* Cluster = Clusters.Find(Portal.Clusters[Side]);
+				const int32 Num = Cluster ? Cluster->Portals.Num() : 0;
+				if (Num == 0 || Cluster->Costs.Num() != Num * Num)
+				{
+					continue;
+				}
+
+				const float* Row = &Cluster->Costs[Portal.Slots[Side] * Num];
+				for (int32 Slot = 0; Slot < Num; ++Slot)
+				{
+					if (Row[Slot] > 0.0f && !Closed.Contains(Cluster->Portals[Slot]))
+					{
+						Relax(Cluster->Portals[Slot], Current.Node, CurrentCost + Row[Slot]);
+					}
+				}
+			}
+		}
+
+		if (bFound)
+		{
+			for (int32 Node = CameFrom[NavHierarchical::GoalNode]; Node != NavHierarchical::StartNode; Node = CameFrom[Node])
+			{
+				PortalSequence.Add(Node);
+			}
+			Algo::Reverse(PortalSequence);
+		}
+	}
+	Stats.TotalAbstractSeconds += FPlatformTime::Seconds() - AbstractStartTime;
+
+	if (PortalSequence.Num() == 0)
+	{
+		++Stats.NumFallbacks;
+		return nullptr;
+	}
+
+	// 2단계: 이웃한 경유점 사이 구간만 내비메시에서 탐색해 하나의 경로로 이어 붙인다
+	const double RefineStartTime = FPlatformTime::Seconds();
+	TSharedRef<FNavMeshPath> Path = MakeShared<FNavMeshPath>();
+	{
+		AISTUDY_SCOPE_CYCLE_COUNTER(STAT_HPA_Refine);
+
+		TArray<FVector> Waypoints;
+		Waypoints.Reserve(PortalSequence.Num() + 2);
+		Waypoints.Add(Start);
+		for (const int32 PortalIndex : PortalSequence)
+		{
+			Waypoints.Add(Portals[PortalIndex].Location);
+		}
+		Waypoints.Add(End);
+
+		TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+		for (int32 Index = 0; Index + 1 < Waypoints.Num(); ++Index)
+		{
+			FPathFindingQuery Query(Querier, NavData, Waypoints[Index], Waypoints[Index + 1], Filter);
+			Query.SetAllowPartialPaths(false);
+			const FPathFindingResult Result = NavData.FindPath(NavData.GetConfig(), Query);
+			const FNavMeshPath* Segment = Result.IsSuccessful() && !Result.IsPartial() && Result.Path.IsValid() ? Result.Path->CastPath<FNavMeshPath>() : nullptr;
+			if (!Segment || Segment->GetPathPoints().Num() == 0)
+			{
+				Stats.TotalRefineSeconds += FPlatformTime::Seconds() - RefineStartTime;
+				++Stats.NumFallbacks;
+				return nullptr;
+			}
+
+			// 앞 구간의 끝점과 겹치는 첫 점/첫 폴리곤은 건너뛴다
+			const int32 FirstPoint = Points.Num() > 0 ? 1 : 0;
+			for (int32 PointIndex = FirstPoint; PointIndex < Segment->GetPathPoints().Num(); ++PointIndex)
+			{
+				Points.Add(Segment->GetPathPoints()[PointIndex]);
+			}
+			const int32 FirstPoly = Path->PathCorridor.Num() > 0 && Segment->PathCorridor.Num() > 0 && Path->PathCorridor.Last() == Segment->PathCorridor[0] ? 1 : 0;
+			for (int32 PolyIndex = FirstPoly; PolyIndex < Segment->PathCorridor.Num(); ++PolyIndex)
+			{
+				Path->PathCorridor.Add(Segment->PathCorridor[PolyIndex]);
+				Path->PathCorridorCost.Add(Segment->PathCorridorCost.IsValidIndex(PolyIndex) ? Segment->PathCorridorCost[PolyIndex] : 0.0f);
+			}
+		}
+	}
+	Stats.TotalRefineSeconds += FPlatformTime::Seconds() - RefineStartTime;
+	++Stats.NumQueries;
+
+	Path->SetNavigationDataUsed(const_cast<ANavigationData*>(&NavData));
+	Path->SetQuerier(Querier);
+	Path->SetTimeStamp(NavData.GetWorldTimeStamp());
+	Path->SetFilter(Filter);
+	Path->MarkReady();
+
+	// 통로 타일이 다시 빌드되면 일반 경로처럼 무효화되도록 활성 경로로 등록
+	const_cast<ANavigationData&>(NavData).RegisterActivePath(Path);
+	return Path;
+}
+
+double UNav_HierarchicalSubsystem::GetAverageQuerySeconds() const
+{
+	const uint64 Total = Stats.NumQueries + Stats.NumFallbacks;
+	return Total > 0 ? (Stats.TotalAbstractSeconds + Stats.TotalRefineSeconds) / Total : 0.0;
+}
+
+void UNav_HierarchicalSubsystem::LogReport() const
+{
+	const uint64 Total = Stats.NumQueries + Stats.NumFallbacks;
+	UE_LOG(LogAIStudy, Display, TEXT("HPA: %d clusters (%d tiles each side), %d portals, %d dirty, %d pending costs, %llu rebuilds"),
+		Clusters.Num(), ClusterTiles, Portals.Num(), DirtyClusters.Num(), PendingCostClusters.Num(), Stats.NumClusterRebuilds);
+	UE_LOG(LogAIStudy, Display, TEXT("HPA: %llu queries, %llu fallbacks (%.1f%%), abstract %.3f ms avg, refine %.3f ms avg"),
+		Stats.NumQueries, Stats.NumFallbacks, Total > 0 ? 100.0 * Stats.NumFallbacks / Total : 0.0,
+		Total > 0 ? Stats.TotalAbstractSeconds * 1000.0 / Total : 0.0,
+		Stats.NumQueries > 0 ? Stats.TotalRefineSeconds * 1000.0 / Stats.NumQueries : 0.0);
+}
@@ -0,0 +1,12 @@
+#include "Nav_InvokerProxy.h"
+#include "Components/SceneComponent.h"
+
+ANav_InvokerProxy::ANav_InvokerProxy()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetCanBeDamaged(false);
+	SetHidden(true);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent->SetMobility(EComponentMobility::Movable);
+}
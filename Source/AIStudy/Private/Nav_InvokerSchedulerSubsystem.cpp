@@ -0,0 +1,321 @@
+#include "Nav_InvokerSchedulerSubsystem.h"
+#include "AIStudy.h"
+#include "Nav_InvokerProxy.h"
+#include "Nav_PredictiveInvokerComponent.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "AI/Navigation/NavigationInvokerPriority.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Nav Invoker Scheduler Update"), STAT_NavInvoker_Update, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Invoker Proxies In Use"), STAT_NavInvoker_NumProxies, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Invoker Pending Tiles"), STAT_NavInvoker_NumPending, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Nav Invoker Dropped Samples"), STAT_NavInvoker_NumDropped, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Nav Invoker Late Tiles"), STAT_NavInvoker_NumLate, STATGROUP_AIStudy);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Nav Invoker Last Tile Latency (ms)"), STAT_NavInvoker_LastLatency, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarNavInvokerUpdateInterval(
+	TEXT("AIStudy.NavInvoker.UpdateInterval"),
+	0.25f,
+	TEXT("예측 위치를 다시 모아 프록시를 배정하는 간격(초)."));
+
+static TAutoConsoleVariable<int32> CVarNavInvokerMaxProxies(
+	TEXT("AIStudy.NavInvoker.MaxProxies"),
+	128,
+	TEXT("동시에 사용할 수 있는 프록시 인보커 수. 넘치는 예측 위치는 도착이 먼 것부터 버린다."));
+
+static TAutoConsoleVariable<int32> CVarNavInvokerSaturation(
+	TEXT("AIStudy.NavInvoker.SaturationTasks"),
+	32,
+	TEXT("남은 타일 빌드 작업이 이 값 이상이면 재빌드 대기열이 포화된 것으로 본다."));
+
+static TAutoConsoleVariable<float> CVarNavInvokerSaturatedHorizon(
+	TEXT("AIStudy.NavInvoker.SaturatedHorizon"),
+	1.0f,
+	TEXT("포화 상태에서는 도착 예상 시간이 이보다 먼 예측 위치를 버린다."));
+
+static TAutoConsoleVariable<float> CVarNavInvokerPendingTimeout(
+	TEXT("AIStudy.NavInvoker.PendingTimeout"),
+	10.0f,
+	TEXT("요청한 타일이 이 시간 안에 준비되지 않으면 (걸을 수 있는 지형이 없는 타일 등) 추적을 멈춘다."));
+
+namespace NavInvoker
+{
+	// 도착 예상 시간이 가까울수록 높은 우선순위
+	static ENavigationInvokerPriority GetPriority(float TimeToArrival)
+	{
+		if (TimeToArrival < 0.5f)
+		{
+			return ENavigationInvokerPriority::VeryHigh;
+		}
+		if (TimeToArrival < 1.0f)
+		{
+			return ENavigationInvokerPriority::High;
+		}
+		if (TimeToArrival < 2.0f)
+		{
+			return ENavigationInvokerPriority::Default;
+		}
+		if (TimeToArrival < 4.0f)
+		{
+			return ENavigationInvokerPriority::Low;
+		}
+		return ENavigationInvokerPriority::VeryLow;
+	}
+}
+
+bool UNav_InvokerSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNav_InvokerSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNav_InvokerSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UNav_InvokerSchedulerSubsystem::Deinitialize()
+{
+	ReleaseProxies(0);
+	for (ANav_InvokerProxy* Proxy : Proxies)
+	{
+		if (IsValid(Proxy))
+		{
+			Proxy->Destroy();
+		}
+	}
+	Proxies.Reset();
+	PendingTiles.Reset();
+	Invokers.Reset();
+
+	Super::Deinitialize();
+}
+
+void UNav_InvokerSchedulerSubsystem::RegisterInvoker(UNav_PredictiveInvokerComponent* Invoker)
+{
+	if (Invoker)
+	{
+		Invokers.AddUnique(Invoker);
+	}
+}
+
+void UNav_InvokerSchedulerSubsystem::UnregisterInvoker(UNav_PredictiveInvokerComponent* Invoker)
+{
+	Invokers.RemoveSwap(Invoker);
+}
+
+FIntPoint UNav_InvokerSchedulerSubsystem::ToTileKey(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / TileSize), FMath::FloorToInt32(Location.Y / TileSize));
+}
+
+ANav_InvokerProxy* UNav_InvokerSchedulerSubsystem::GetOrSpawnProxy(int32 Index, const FVector& Location)
+{
+	if (Proxies.IsValidIndex(Index) && IsValid(Proxies[Index]))
+	{
+		Proxies[Index]->SetActorLocation(Location);
+		return Proxies[Index];
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	ANav_InvokerProxy* Proxy = GetWorld()->SpawnActor<ANav_InvokerProxy>(Location, FRotator::ZeroRotator, SpawnParams);
+
+	if (Proxies.IsValidIndex(Index))
+	{
+		Proxies[Index] = Proxy;
+	}
+	else
+	{
+		Proxies.Add(Proxy);
+	}
+	return Proxy;
+}
+
+void UNav_InvokerSchedulerSubsystem::ReleaseProxies(int32 FirstUnused)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	for (int32 Index = FirstUnused; Index < NumProxiesInUse; ++Index)
+	{
+		if (NavSys && Proxies.IsValidIndex(Index) && IsValid(Proxies[Index]))
+		{
+			NavSys->UnregisterInvoker(*Proxies[Index]);
+		}
+	}
+	NumProxiesInUse = FMath::Min(NumProxiesInUse, FirstUnused);
+}
+
+void UNav_InvokerSchedulerSubsystem::Tick(float DeltaTime)
+{
+	SET_DWORD_STAT(STAT_NavInvoker_NumProxies, NumProxiesInUse);
+	SET_DWORD_STAT(STAT_NavInvoker_NumPending, PendingTiles.Num());
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate > 0.0f)
+	{
+		return;
+	}
+	TimeUntilUpdate = CVarNavInvokerUpdateInterval.GetValueOnGameThread();
+
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NavInvoker_Update);
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr;
+	if (!NavMesh)
+	{
+		return;
+	}
+
+	TileSize = FMath::Max(NavMesh->GetTileSizeUU(), 100.0f);
+	UpdatePendingTiles(*NavMesh, GetWorld()->GetTimeSeconds());
+	UpdateAssignments(*NavMesh);
+}
+
+void UNav_InvokerSchedulerSubsystem::UpdateAssignments(ARecastNavMesh& NavMesh)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	// 모든 인보커의 예측 위치 수집
+	TArray<FNavInvokerSample> Samples;
+	for (int32 Index = Invokers.Num() - 1; Index >= 0; --Index)
+	{
+		if (UNav_PredictiveInvokerComponent* Invoker = Invokers[Index].Get())
+		{
+			Invoker->GatherSamples(Samples, TileSize);
+		}
+		else
+		{
+			Invokers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	// 같은 타일은 도착이 가장 빠른 요청 하나만 남긴다
+	TMap<FIntPoint, int32> BestSampleByTile;
+	BestSampleByTile.Reserve(Samples.Num());
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		int32& Best = BestSampleByTile.FindOrAdd(ToTileKey(Samples[Index].Location), INDEX_NONE);
+		if (Best == INDEX_NONE || Samples[Index].TimeToArrival < Samples[Best].TimeToArrival)
+		{
+			Best = Index;
+		}
+	}
+
+	TArray<FNavInvokerSample> Ordered;
+	Ordered.Reserve(BestSampleByTile.Num());
+	for (const TPair<FIntPoint, int32>& Pair : BestSampleByTile)
+	{
+		Ordered.Add(Samples[Pair.Value]);
+	}
+	Ordered.Sort([](const FNavInvokerSample& A, const FNavInvokerSample& B) { return A.TimeToArrival < B.TimeToArrival; });
+
+	// 재빌드 대기열이 밀려 있으면 가까운 미래의 타일만 요청
+	const bool bSaturated = NavMesh.GetNumRemaningBuildTasks() >= CVarNavInvokerSaturation.GetValueOnGameThread();
+	const float SaturatedHorizon = CVarNavInvokerSaturatedHorizon.GetValueOnGameThread();
+	const int32 MaxProxies = FMath::Max(CVarNavInvokerMaxProxies.GetValueOnGameThread(), 0);
+	const float GenerationRadius = TileSize * 0.5f;
+	const float RemovalRadius = TileSize * 1.5f;
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	int32 NumUsed = 0;
+	for (const FNavInvokerSample& Sample : Ordered)
+	{
+		if (NumUsed >= MaxProxies || (bSaturated && Sample.TimeToArrival > SaturatedHorizon))
+		{
+			++Sample.Owner->LatencyStats.NumDropped;
+			INC_DWORD_STAT(STAT_NavInvoker_NumDropped);
+			continue;
+		}
+
+		ANav_InvokerProxy* Proxy = GetOrSpawnProxy(NumUsed, Sample.Location);
+		if (!Proxy)
+		{
+			continue;
+		}
+		++NumUsed;
+
+		// 이미 준비된 타일도 도착 전에 제거되지 않도록 계속 인보커를 유지한다
+		NavSys->RegisterInvoker(*Proxy, GenerationRadius, RemovalRadius, FNavAgentSelector(), NavInvoker::GetPriority(Sample.TimeToArrival));
+
+		const FIntPoint TileKey = ToTileKey(Sample.Location);
+		if (!PendingTiles.Contains(TileKey) && !NavMesh.HasCompleteDataInRadius(Sample.Location, GenerationRadius))
+		{
+			FPendingTile& Pending = PendingTiles.Add(TileKey);
+			Pending.Location = Sample.Location;
+			Pending.RequestTime = Now;
+			Pending.Owner = Sample.Owner;
+		}
+	}
+
+	ReleaseProxies(NumUsed);
+	NumProxiesInUse = NumUsed;
+}
+
+void UNav_InvokerSchedulerSubsystem::UpdatePendingTiles(const ARecastNavMesh& NavMesh, double Now)
+{
+	const float Timeout = CVarNavInvokerPendingTimeout.GetValueOnGameThread();
+	const float CheckRadius = TileSize * 0.5f;
+
+	for (auto It = PendingTiles.CreateIterator(); It; ++It)
+	{
+		FPendingTile& Pending = It.Value();
+		UNav_PredictiveInvokerComponent* Owner = Pending.Owner.Get();
+		const float Latency = static_cast<float>(Now - Pending.RequestTime);
+
+		if (NavMesh.HasCompleteDataInRadius(Pending.Location, CheckRadius))
+		{
+			if (Owner)
+			{
+				FNavInvokerLatencyStats& Stats = Owner->LatencyStats;
+				++Stats.NumTilesReady;
+				Stats.TotalLatency += Latency;
+				Stats.MaxLatency = FMath::Max(Stats.MaxLatency, Latency);
+			}
+			SET_FLOAT_STAT(STAT_NavInvoker_LastLatency, Latency * 1000.0f);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (!Owner || Latency > Timeout)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// 타일이 준비되기 전에 에이전트가 먼저 도착함
+		const APawn* Pawn = Cast<APawn>(Owner->GetOwner());
+		if (!Pending.bLate && Pawn && ToTileKey(Pawn->GetActorLocation()) == It.Key())
+		{
+			Pending.bLate = true;
+			++Owner->LatencyStats.NumLateTiles;
+			INC_DWORD_STAT(STAT_NavInvoker_NumLate);
+		}
+	}
+}
+
+void UNav_InvokerSchedulerSubsystem::LogLatencyReport() const
+{
+	UE_LOG(LogAIStudy, Display, TEXT("NavInvoker: %d invokers, %d proxies, %d pending tiles"), Invokers.Num(), NumProxiesInUse, PendingTiles.Num());
+	for (const TWeakObjectPtr<UNav_PredictiveInvokerComponent>& Invoker : Invokers)
+	{
+		if (const UNav_PredictiveInvokerComponent* Component = Invoker.Get())
+		{
+			const FNavInvokerLatencyStats& Stats = Component->GetLatencyStats();
+			UE_LOG(LogAIStudy, Display, TEXT("  %s: ready %d, avg %.1f ms, max %.1f ms, late %d, dropped %d"),
+				*GetNameSafe(Component->GetOwner()), Stats.NumTilesReady, Stats.GetAverageLatencyMs(), Stats.MaxLatency * 1000.0f, Stats.NumLateTiles, Stats.NumDropped);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorld NavInvokerReportCommand(
+	TEXT("AIStudy.NavInvoker.Report"),
+	TEXT("예측 인보커별 타일 생성 지연, 늦게 준비된 타일 수, 버려진 예측 위치 수를 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNav_InvokerSchedulerSubsystem* Scheduler = World ? World->GetSubsystem<UNav_InvokerSchedulerSubsystem>() : nullptr)
+		{
+			Scheduler->LogLatencyReport();
+		}
+	}));
@@ -0,0 +1,106 @@
+#include "Nav_PredictiveInvokerComponent.h"
+#include "Nav_InvokerSchedulerSubsystem.h"
+#include "AIController.h"
+#include "GameFramework/Pawn.h"
+#include "Navigation/PathFollowingComponent.h"
+
+UNav_PredictiveInvokerComponent::UNav_PredictiveInvokerComponent()
+{
+	// 스케줄러가 주기적으로 예측 위치를 가져가므로 직접 틱하지 않는다
+	PrimaryComponentTick.bCanEverTick = false;
+	bAutoActivate = false;
+}
+
+void UNav_PredictiveInvokerComponent::Activate(bool bReset)
+{
+	Super::Activate(bReset);
+
+	if (UNav_InvokerSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UNav_InvokerSchedulerSubsystem>() : nullptr)
+	{
+		Scheduler->RegisterInvoker(this);
+	}
+}
+
+void UNav_PredictiveInvokerComponent::Deactivate()
+{
+	if (UNav_InvokerSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UNav_InvokerSchedulerSubsystem>() : nullptr)
+	{
+		Scheduler->UnregisterInvoker(this);
+	}
+
+	Super::Deactivate();
+}
+
+void UNav_PredictiveInvokerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNav_InvokerSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UNav_InvokerSchedulerSubsystem>() : nullptr)
+	{
+		Scheduler->UnregisterInvoker(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UNav_PredictiveInvokerComponent::GatherSamples(TArray<FNavInvokerSample>& OutSamples, float DefaultSpacing)
+{
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	if (!Pawn)
+	{
+		return;
+	}
+
+	const float Speed = Pawn->GetVelocity().Size2D();
+	if (Speed < MinSpeed)
+	{
+		return;
+	}
+
+	const float Spacing = FMath::Max(SampleSpacing > 0.0f ? SampleSpacing : DefaultSpacing, 100.0f);
+	const float MaxDistance = Speed * LookaheadTime;
+	const FVector Location = Pawn->GetActorLocation();
+
+	auto AddSample = [&OutSamples, this, Speed](const FVector& SampleLocation, float Distance)
+	{
+		FNavInvokerSample& Sample = OutSamples.AddDefaulted_GetRef();
+		Sample.Location = SampleLocation;
+		Sample.TimeToArrival = Distance / Speed;
+		Sample.Owner = this;
+	};
+
+	// 따라가는 경로가 있으면 남은 경로 통로를 따라 일정 간격으로 예측
+	const AAIController* AIController = Cast<AAIController>(Pawn->GetController());
+	const UPathFollowingComponent* PathFollowing = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	const FNavPathSharedPtr Path = PathFollowing ? PathFollowing->GetPath() : nullptr;
+	if (Path.IsValid() && Path->IsValid() && PathFollowing->GetStatus() == EPathFollowingStatus::Moving)
+	{
+		const TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+		FVector SegmentStart = Location;
+		float Travelled = 0.0f;
+		float NextSampleDistance = Spacing;
+
+		for (int32 Index = FMath::Max(int32(PathFollowing->GetNextPathIndex()), 0); Index < Points.Num() && NextSampleDistance <= MaxDistance; ++Index)
+		{
+			const FVector SegmentEnd = Points[Index].Location;
+			const float SegmentLength = FVector::Dist(SegmentStart, SegmentEnd);
+			if (SegmentLength > UE_KINDA_SMALL_NUMBER)
+			{
+				while (NextSampleDistance <= Travelled + SegmentLength && NextSampleDistance <= MaxDistance)
+				{
+					const float Alpha = (NextSampleDistance - Travelled) / SegmentLength;
+					AddSample(FMath::Lerp(SegmentStart, SegmentEnd, Alpha), NextSampleDistance);
+					NextSampleDistance += Spacing;
+				}
+			}
+			Travelled += SegmentLength;
+			SegmentStart = SegmentEnd;
+		}
+		return;
+	}
+
+	// 경로가 없으면 현재 속도 방향으로 직선 예측
+	const FVector Direction = Pawn->GetVelocity().GetSafeNormal2D();
+	for (float Distance = Spacing; Distance <= MaxDistance; Distance += Spacing)
+	{
+		AddSample(Location + Direction * Distance, Distance);
+	}
+}
@@ -0,0 +1,448 @@
+#include "Nav_RebuildGovernorSubsystem.h"
+#include "AIStudy.h"
+#include "Nav_CachedRecastNavMesh.h"
+#include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "NavMesh/RecastNavMeshGenerator.h"
+#include "AI/NavDataGenerator.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Templates/UnrealTemplate.h"
+
+DECLARE_CYCLE_STAT(TEXT("Nav Governor Update"), STAT_NavGovernor_Update, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Governor Queue Depth"), STAT_NavGovernor_QueueDepth, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Governor Deferred Tiles"), STAT_NavGovernor_NumDeferred, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Governor Concurrency"), STAT_NavGovernor_Concurrency, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Nav Governor Hitches"), STAT_NavGovernor_NumHitches, STATGROUP_AIStudy);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Nav Governor Slice Budget (ms)"), STAT_NavGovernor_SliceBudget, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarNavGovernorEnable(
+	TEXT("AIStudy.NavGovernor.Enable"),
+	true,
+	TEXT("끄면 미룬 타일을 모두 다시 넣고 내비메시 기본 동시 작업 수로 빌드한다."));
+
+static TAutoConsoleVariable<float> CVarNavGovernorTargetFrameMs(
+	TEXT("AIStudy.NavGovernor.TargetFrameMs"),
+	33.3f,
+	TEXT("평균 프레임 시간이 이 값을 넘으면 동시 타일 작업 수를 줄인다. 게임 스레드 예산도 이 값에서 다른 작업 시간을 뺀 만큼이다."));
+
+static TAutoConsoleVariable<float> CVarNavGovernorHitchMs(
+	TEXT("AIStudy.NavGovernor.HitchMs"),
+	50.0f,
+	TEXT("이보다 긴 프레임은 히치로 세고 바로 동시 작업 수를 줄인다."));
+
+static TAutoConsoleVariable<int32> CVarNavGovernorMaxTasks(
+	TEXT("AIStudy.NavGovernor.MaxTasks"),
+	0,
+	TEXT("동시 타일 작업 수 상한. 0이면 태스크 그래프 워커 수."));
+
+static TAutoConsoleVariable<float> CVarNavGovernorWorkerShare(
+	TEXT("AIStudy.NavGovernor.WorkerShare"),
+	0.5f,
+	TEXT("타일 작업이 차지해도 되는 워커 시간 비율. 비동기 경로 탐색/애니메이션 몫을 남긴다."));
+
+static TAutoConsoleVariable<float> CVarNavGovernorMaxSliceMs(
+	TEXT("AIStudy.NavGovernor.MaxSliceMs"),
+	4.0f,
+	TEXT("프레임마다 생성기 게임 스레드 작업에 주는 예산 상한(ms)."));
+
+static TAutoConsoleVariable<bool> CVarNavGovernorDefer(
+	TEXT("AIStudy.NavGovernor.DeferTiles"),
+	true,
+	TEXT("에이전트가 없고 경로도 지나지 않는 더티 타일을 미뤄 둔다."));
+
+static TAutoConsoleVariable<float> CVarNavGovernorMaxDeferSeconds(
+	TEXT("AIStudy.NavGovernor.MaxDeferSeconds"),
+	5.0f,
+	TEXT("미룬 타일은 급해지지 않아도 이 시간이 지나면 다시 넣는다."));
+
+static TAutoConsoleVariable<float> CVarNavGovernorCoalesceSlack(
+	TEXT("AIStudy.NavGovernor.CoalesceSlack"),
+	1.5f,
+	TEXT("두 더티 영역을 합친 경계의 면적이 두 면적 합의 이 배수 이하일 때만 합친다."));
+
+namespace NavGovernor
+{
+	// 최근 5프레임 남짓을 보는 지수 평균
+	static constexpr double AverageAlpha = 0.2;
+	static constexpr double MinSliceMs = 0.25;
+	// 예산이 계속 모자라도 완료된 타일이 쌓이기만 하지 않도록 이만큼 건너뛰면 한 번은 틱한다
+	static constexpr int32 MaxConsecutiveSkips = 8;
+	static constexpr float UrgentUpdateInterval = 0.25f;
+	// 합치기 비교는 영역 수의 제곱이므로 많으면 그대로 넘긴다
+	static constexpr int32 MaxCoalesceAreas = 256;
+
+	static double GetAreaXY(const FBox& Box)
+	{
+		const FVector Size = Box.GetSize();
+		return Size.X * Size.Y;
+	}
+}
+
+bool UNav_RebuildGovernorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNav_RebuildGovernorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNav_RebuildGovernorSubsystem, STATGROUP_Tickables);
+}
+
+void UNav_RebuildGovernorSubsystem::Deinitialize()
+{
+	States.Reset();
+	Super::Deinitialize();
+}
+
+void UNav_RebuildGovernorSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NavGovernor_Update);
+
+	const double Now = FPlatformTime::Seconds();
+	const double FrameMs = LastTickTime > 0.0 ? (Now - LastTickTime) * 1000.0 : 0.0;
+	LastTickTime = Now;
+
+	QueueDepth = 0;
+	NumRunningTasks = 0;
+	int32 NumDeferred = 0;
+	for (auto It = States.CreateIterator(); It; ++It)
+	{
+		const ARecastNavMesh* NavMesh = It.Value().NavMesh.Get();
+		const FNavDataGenerator* Generator = NavMesh ? NavMesh->GetGenerator() : nullptr;
+		if (!Generator)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		QueueDepth += Generator->GetNumRemaningBuildTasks();
+		NumRunningTasks += Generator->GetNumRunningBuildTasks();
+		NumDeferred += It.Value().Deferred.Num();
+	}
+	Stats.MaxQueueDepth = FMath::Max(Stats.MaxQueueDepth, QueueDepth);
+
+	if (FrameMs > 0.0)
+	{
+		UpdateBudget(FrameMs);
+	}
+	NavMsThisFrame = 0.0;
+
+	const bool bEnabled = CVarNavGovernorEnable.GetValueOnGameThread();
+	for (TPair<TObjectKey<ARecastNavMesh>, FNavMeshState>& Pair : States)
+	{
+		FNavMeshState& State = Pair.Value;
+		ARecastNavMesh* NavMesh = State.NavMesh.Get();
+
+		if (bEnabled && State.AppliedConcurrency != Concurrency)
+		{
+			// 처음 덮어쓸 때 인스턴스 값을 저장한다 (레벨에서 바꾼 값일 수 있어 클래스 기본값과 다를 수 있다)
+			if (State.AppliedConcurrency == INDEX_NONE)
+			{
+				State.OriginalConcurrency = NavMesh->GetMaxSimultaneousTileGenerationJobsCount();
+			}
+			NavMesh->SetMaxSimultaneousTileGenerationJobsCount(Concurrency);
+			State.AppliedConcurrency = Concurrency;
+		}
+		else if (!bEnabled && State.AppliedConcurrency != INDEX_NONE)
+		{
+			// 꺼지면 덮어쓰기 전 값으로 되돌린다
+			NavMesh->SetMaxSimultaneousTileGenerationJobsCount(State.OriginalConcurrency);
+			State.AppliedConcurrency = INDEX_NONE;
+		}
+
+		if (State.Deferred.Num() > 0)
+		{
+			ReleaseDeferredTiles(State, Now);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_NavGovernor_QueueDepth, QueueDepth);
+	SET_DWORD_STAT(STAT_NavGovernor_NumDeferred, NumDeferred);
+	SET_DWORD_STAT(STAT_NavGovernor_Concurrency, Concurrency);
+	SET_FLOAT_STAT(STAT_NavGovernor_SliceBudget, SliceBudgetMs);
+}
+
+void UNav_RebuildGovernorSubsystem::UpdateBudget(double FrameMs)
+{
+	const double Alpha = FrameMsAverage > 0.0 ? NavGovernor::AverageAlpha : 1.0;
+	FrameMsAverage = FMath::Lerp(FrameMsAverage, FrameMs, Alpha);
+	NavMsAverage = FMath::Lerp(NavMsAverage, NavMsThisFrame, Alpha);
+	// 워커에서 도는 타일 작업은 프레임 내내 워커 하나를 잡고 있는 것으로 본다
+	WorkerMsAverage = FMath::Lerp(WorkerMsAverage, NumRunningTasks * FrameMs, Alpha);
+
+	const bool bHitch = FrameMs > CVarNavGovernorHitchMs.GetValueOnGameThread();
+	if (bHitch)
+	{
+		++Stats.NumHitches;
+		INC_DWORD_STAT(STAT_NavGovernor_NumHitches);
+	}
+
+	const int32 NumWorkers = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+	const int32 MaxTasksSetting = CVarNavGovernorMaxTasks.GetValueOnGameThread();
+	const int32 MaxTasks = MaxTasksSetting > 0 ? MaxTasksSetting : NumWorkers;
+	const double TargetMs = CVarNavGovernorTargetFrameMs.GetValueOnGameThread();
+	const double WorkerCapacityMs = NumWorkers * FrameMsAverage * CVarNavGovernorWorkerShare.GetValueOnGameThread();
+
+	// 넘치면 반으로, 대기열이 밀려 있고 여유가 있으면 하나씩 늘린다
+	if (Concurrency <= 0)
+	{
+		Concurrency = MaxTasks;
+	}
+	const bool bBusy = QueueDepth > 0 || NumRunningTasks > 0;
+	if (bBusy && (bHitch || FrameMsAverage > TargetMs || WorkerMsAverage > WorkerCapacityMs))
+	{
+		Concurrency = FMath::Max(Concurrency / 2, 1);
+	}
+	else if (QueueDepth > Concurrency && FrameMsAverage < TargetMs * 0.85)
+	{
+		Concurrency = FMath::Min(Concurrency + 1, MaxTasks);
+	}
+	Concurrency = FMath::Clamp(Concurrency, 1, MaxTasks);
+
+	// AI와 나머지 게임 스레드 작업이 쓰고 남은 시간만 생성기에 준다. 남은 예산은 두 프레임치까지만 쌓는다
+	const double OtherMs = FMath::Max(FrameMsAverage - NavMsAverage, 0.0);
+	SliceBudgetMs = FMath::Clamp(TargetMs - OtherMs, NavGovernor::MinSliceMs, FMath::Max<double>(CVarNavGovernorMaxSliceMs.GetValueOnGameThread(), NavGovernor::MinSliceMs));
+	BudgetTokensMs = FMath::Min(BudgetTokensMs + SliceBudgetMs, SliceBudgetMs * 2.0);
+}
+
+bool UNav_RebuildGovernorSubsystem::ShouldTickBuild()
+{
+	// 첫 프레임 시간을 재기 전에는 예산이 없으므로 막지 않는다
+	if (!CVarNavGovernorEnable.GetValueOnGameThread() || SliceBudgetMs <= 0.0 || BudgetTokensMs > 0.0 || NumConsecutiveSkips >= NavGovernor::MaxConsecutiveSkips)
+	{
+		NumConsecutiveSkips = 0;
+		return true;
+	}
+
+	++NumConsecutiveSkips;
+	++Stats.NumSkippedBuildTicks;
+	return false;
+}
+
+void UNav_RebuildGovernorSubsystem::OnBuildTicked(ARecastNavMesh& NavMesh, double ElapsedMs)
+{
+	BudgetTokensMs -= ElapsedMs;
+	NavMsThisFrame += ElapsedMs;
+	States.FindOrAdd(&NavMesh).NavMesh = &NavMesh;
+}
+
+void UNav_RebuildGovernorSubsystem::CoalesceDirtyAreas(TArray<FNavigationDirtyArea>& DirtyAreas)
+{
+	if (!CVarNavGovernorEnable.GetValueOnGameThread() || DirtyAreas.Num() < 2 || DirtyAreas.Num() > NavGovernor::MaxCoalesceAreas)
+	{
+		return;
+	}
+
+	const int32 NumBefore = DirtyAreas.Num();
+	const double Slack = CVarNavGovernorCoalesceSlack.GetValueOnGameThread();
+
+	// 합친 영역이 다시 다른 영역과 겹칠 수 있으므로 더 합칠 것이 없을 때까지 반복한다
+	bool bMerged = true;
+	while (bMerged)
+	{
+		bMerged = false;
+		for (int32 Index = 0; Index < DirtyAreas.Num(); ++Index)
+		{
+			for (int32 Other = DirtyAreas.Num() - 1; Other > Index; --Other)
+			{
+				FNavigationDirtyArea& Area = DirtyAreas[Index];
+				const FNavigationDirtyArea& OtherArea = DirtyAreas[Other];
+				if (Area.Flags != OtherArea.Flags || !Area.Bounds.Intersect(OtherArea.Bounds))
+				{
+					continue;
+				}
+
+				// 합친 경계가 너무 커지면 (L자로 겹친 경우 등) 오히려 더 많은 타일을 더럽히므로 둔다
+				const FBox Union = Area.Bounds + OtherArea.Bounds;
+				if (NavGovernor::GetAreaXY(Union) > (NavGovernor::GetAreaXY(Area.Bounds) + NavGovernor::GetAreaXY(OtherArea.Bounds)) * Slack)
+				{
+					continue;
+				}
+
+				Area.Bounds = Union;
+				DirtyAreas.RemoveAtSwap(Other);
+				bMerged = true;
+			}
+		}
+	}
+
+	Stats.NumCoalescedAreas += NumBefore - DirtyAreas.Num();
+}
+
+void UNav_RebuildGovernorSubsystem::DeferPendingTiles(const ARecastNavMesh& NavMesh, TArray<FPendingTileElement>& PendingTiles)
+{
+	if (bReleasing || !CVarNavGovernorEnable.GetValueOnGameThread() || !CVarNavGovernorDefer.GetValueOnGameThread() || PendingTiles.Num() == 0)
+	{
+		return;
+	}
+
+	FNavMeshState& State = States.FindOrAdd(&NavMesh);
+	State.NavMesh = const_cast<ARecastNavMesh*>(&NavMesh);
+	const double Now = FPlatformTime::Seconds();
+	UpdateUrgentTiles(State, Now);
+
+	// 에이전트가 없으면 프레임을 다툴 AI도 없으므로 미루지 않는다
+	if (State.UrgentTiles.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 NumBefore = PendingTiles.Num();
+	PendingTiles.RemoveAll([&State, Now](const FPendingTileElement& Element)
+	{
+		if (State.UrgentTiles.Contains(Element.Coord))
+		{
+			return false;
+		}
+
+		// 이미 미룬 타일이면 처음 미룬 시각을 유지해 MaxDeferSeconds가 밀리지 않게 한다
+		FDeferredTile& Deferred = State.Deferred.FindOrAdd(Element.Coord);
+		if (Deferred.DeferTime == 0.0)
+		{
+			Deferred.DeferTime = Now;
+		}
+		Deferred.bRebuildGeometry |= Element.bRebuildGeometry;
+		return true;
+	});
+	Stats.NumDeferredTiles += NumBefore - PendingTiles.Num();
+}
+
+void UNav_RebuildGovernorSubsystem::UpdateUrgentTiles(FNavMeshState& State, double Now)
+{
+	if (State.UrgentUpdateTime >= 0.0 && Now - State.UrgentUpdateTime < NavGovernor::UrgentUpdateInterval)
+	{
+		return;
+	}
+	State.UrgentUpdateTime = Now;
+	State.UrgentTiles.Reset();
+
+	const ARecastNavMesh* NavMesh = State.NavMesh.Get();
+	UWorld* World = GetWorld();
+	if (!NavMesh || !World)
+	{
+		return;
+	}
+
+	auto AddTile = [&State, NavMesh](const FVector& Location)
+	{
+		int32 TileX = 0;
+		int32 TileY = 0;
+		if (NavMesh->GetNavMeshTileXY(Location, TileX, TileY))
+		{
+			State.UrgentTiles.Add(FIntPoint(TileX, TileY));
+		}
+	};
+
+	// 서 있는 타일과 남은 경로가 지나는 타일. 타일 절반 간격으로 선분을 따라가며 찍는다
+	const double Step = FMath::Max(NavMesh->GetTileSizeUU() * 0.5, 100.0);
+	for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
+	{
+		const AAIController* Controller = Cast<AAIController>(It->Get());
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			continue;
+		}
+		AddTile(Pawn->GetActorLocation());
+
+		const UPathFollowingComponent* PathFollowing = Controller->GetPathFollowingComponent();
+		if (!PathFollowing || PathFollowing->GetStatus() == EPathFollowingStatus::Idle)
+		{
+			continue;
+		}
+		const FNavPathSharedPtr Path = PathFollowing->GetPath();
+		if (!Path.IsValid() || !Path->IsValid())
+		{
+			continue;
+		}
+
+		const TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+		for (int32 Index = FMath::Max(PathFollowing->GetCurrentPathIndex(), 0); Index + 1 < Points.Num(); ++Index)
+		{
+			const FVector Start = Points[Index].Location;
+			const FVector End = Points[Index + 1].Location;
+			const int32 NumSteps = FMath::Max(FMath::CeilToInt(FVector::Dist(Start, End) / Step), 1);
+			for (int32 StepIndex = 0; StepIndex <= NumSteps; ++StepIndex)
+			{
+				AddTile(FMath::Lerp(Start, End, static_cast<double>(StepIndex) / NumSteps));
+			}
+		}
+	}
+}
+
+void UNav_RebuildGovernorSubsystem::ReleaseDeferredTiles(FNavMeshState& State, double Now)
+{
+	ARecastNavMesh* NavMesh = State.NavMesh.Get();
+	FNavDataGenerator* Generator = NavMesh ? NavMesh->GetGenerator() : nullptr;
+	if (!Generator)
+	{
+		return;
+	}
+	UpdateUrgentTiles(State, Now);
+
+	const bool bKeepDeferring = CVarNavGovernorEnable.GetValueOnGameThread() && CVarNavGovernorDefer.GetValueOnGameThread();
+	const double MaxDeferSeconds = CVarNavGovernorMaxDeferSeconds.GetValueOnGameThread();
+	// 생성기가 비어 있고 프레임에 여유가 있으면 급하지 않은 타일도 동시 작업 수만큼 넣는다
+	const bool bHasHeadroom = Generator->GetNumRemaningBuildTasks() == 0 && FrameMsAverage < CVarNavGovernorTargetFrameMs.GetValueOnGameThread() * 0.85;
+	int32 NumIdleSlots = bHasHeadroom ? Concurrency : 0;
+
+	// 다시 넣을 때 이웃 타일까지 더럽히지 않도록 타일 경계를 침식 반경만큼 안쪽으로 줄인다
+	const FVector::FReal Inset = FMath::Min<FVector::FReal>(NavMesh->AgentRadius + NavMesh->GetCellSize(ENavigationDataResolution::Default) * 3.0, NavMesh->GetTileSizeUU() * 0.25);
+
+	TArray<FNavigationDirtyArea> Areas;
+	for (auto It = State.Deferred.CreateIterator(); It; ++It)
+	{
+		const bool bUrgent = !bKeepDeferring || State.UrgentTiles.Contains(It.Key()) || Now - It.Value().DeferTime >= MaxDeferSeconds;
+		if (!bUrgent)
+		{
+			if (NumIdleSlots <= 0)
+			{
+				continue;
+			}
+			--NumIdleSlots;
+		}
+
+		FBox Bounds = NavTile::GetTileBounds(*NavMesh, It.Key());
+		Bounds.Min.X += Inset;
+		Bounds.Min.Y += Inset;
+		Bounds.Max.X -= Inset;
+		Bounds.Max.Y -= Inset;
+		Areas.Emplace(Bounds, It.Value().bRebuildGeometry ? ENavigationDirtyFlag::All : ENavigationDirtyFlag::DynamicModifier);
+		It.RemoveCurrent();
+	}
+
+	if (Areas.Num() > 0)
+	{
+		TGuardValue<bool> ReleasingGuard(bReleasing, true);
+		Generator->RebuildDirtyAreas(Areas);
+		Stats.NumReleasedTiles += Areas.Num();
+	}
+}
+
+int32 UNav_RebuildGovernorSubsystem::GetNumDeferredTiles(const ARecastNavMesh& NavMesh) const
+{
+	const FNavMeshState* State = States.Find(&NavMesh);
+	return State ? State->Deferred.Num() : 0;
+}
+
+void UNav_RebuildGovernorSubsystem::LogReport() const
+{
+	UE_LOG(LogAIStudy, Display, TEXT("Nav governor: concurrency %d, slice budget %.2f ms, frame avg %.2f ms (nav %.2f ms game thread, %.2f ms worker), queue %d (max %d)"),
+		Concurrency, SliceBudgetMs, FrameMsAverage, NavMsAverage, WorkerMsAverage, QueueDepth, Stats.MaxQueueDepth);
+	UE_LOG(LogAIStudy, Display, TEXT("Nav governor: %llu hitches, %llu skipped build ticks, %llu dirty areas coalesced, %llu tiles deferred / %llu released"),
+		Stats.NumHitches, Stats.NumSkippedBuildTicks, Stats.NumCoalescedAreas, Stats.NumDeferredTiles, Stats.NumReleasedTiles);
+}
+
+static FAutoConsoleCommandWithWorld NavGovernorReportCommand(
+	TEXT("AIStudy.NavGovernor.Report"),
+	TEXT("내비메시 재빌드 거버너의 동시 작업 수, 예산, 대기열, 미룬 타일, 히치 수를 로그로 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNav_RebuildGovernorSubsystem* Governor = World ? World->GetSubsystem<UNav_RebuildGovernorSubsystem>() : nullptr)
+		{
+			Governor->LogReport();
+		}
+	}));
@@ -0,0 +1,584 @@
+#include "Nav_TileCacheSubsystem.h"
+#include "AIStudy.h"
+#include "Nav_CachedRecastNavMesh.h"
+#include "Nav_RebuildGovernorSubsystem.h"
+#include "NavigationSystem.h"
+#include "NavigationOctree.h"
+#include "Detour/DetourAlloc.h"
+#include "Detour/DetourNavMesh.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UnrealType.h"
+
+DECLARE_CYCLE_STAT(TEXT("Nav Tile Cache Restore"), STAT_NavTileCache_Restore, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Nav Tile Cache Save"), STAT_NavTileCache_Save, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Nav Tile Cache Input Hash"), STAT_NavTileCache_Hash, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarNavCacheEnable(
+	TEXT("AIStudy.NavCache.Enable"),
+	true,
+	TEXT("끄면 타일 캐시를 읽지도 쓰지도 않고 모든 타일을 빌드한다."));
+
+static TAutoConsoleVariable<float> CVarNavCacheSaveInterval(
+	TEXT("AIStudy.NavCache.SaveInterval"),
+	5.0f,
+	TEXT("생성이 끝난 뒤 캐시 파일을 다시 쓰는 최소 간격(초). 동적 장애물로 타일이 자주 다시 빌드될 때 쓰기 비용을 줄인다."));
+
+namespace NavTileCache
+{
+	static constexpr uint32 Magic = 0x4E544331; // 'NTC1'
+	static constexpr uint32 Version = 1;
+	// Detour 타일 헤더를 바로 읽을 수 있게 타일 데이터 정렬
+	static constexpr int32 TileAlignment = 16;
+
+	// 파일 헤더 뒤의 항목 표. Layer가 INDEX_NONE이면 타일이 없는 빈 열
+	struct FEntry
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		int32 Layer = INDEX_NONE;
+		uint32 InputHash = 0;
+		int32 Offset = 0;
+		int32 Size = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+		{
+			return Ar << Entry.X << Entry.Y << Entry.Layer << Entry.InputHash << Entry.Offset << Entry.Size;
+		}
+	};
+
+	static uint32 HashBox(const FBox& Box)
+	{
+		// 부동소수 오차로 해시가 흔들리지 않도록 cm 단위로 양자화
+		const FIntVector Min(FMath::RoundToInt(Box.Min.X), FMath::RoundToInt(Box.Min.Y), FMath::RoundToInt(Box.Min.Z));
+		const FIntVector Max(FMath::RoundToInt(Box.Max.X), FMath::RoundToInt(Box.Max.Y), FMath::RoundToInt(Box.Max.Z));
+		return HashCombine(GetTypeHash(Min), GetTypeHash(Max));
+	}
+
+	static void WriteFile(TArray<uint8>& OutFile, uint32 ParamsHash, TArray<FEntry>& Entries)
+	{
+		FMemoryWriter Writer(OutFile);
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = Version;
+		Writer << FileMagic << FileVersion << ParamsHash << Entries;
+	}
+}
+
+bool UNav_TileCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNav_TileCacheSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNav_TileCacheSubsystem, STATGROUP_Tickables);
+}
+
+void UNav_TileCacheSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 서브시스템 초기화 때는 월드의 내비게이션 시스템이 아직 없을 수 있으므로 여기서 연결한다
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld);
+	if (!NavSys)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Nav tile cache: %s has no navigation system, the cache will not be saved"), *InWorld.GetName());
+		return;
+	}
+	NavGenerationHandle = NavSys->OnNavigationGenerationFinishedDelegate.AddUObject(this, &UNav_TileCacheSubsystem::OnNavigationGenerationFinished);
+
+	// BeginPlay 전에 이미 끝난 생성은 알림을 놓쳤으므로 지금 처리한다
+	for (ANavigationData* NavData : NavSys->NavDataSet)
+	{
+		const FNavDataGenerator* Generator = NavData ? NavData->GetGenerator() : nullptr;
+		if (NavData && !(Generator && Generator->IsBuildInProgressCheckDirty()))
+		{
+			OnNavigationGenerationFinished(NavData);
+		}
+	}
+}
+
+void UNav_TileCacheSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.Remove(NavGenerationHandle);
+	}
+
+	// 간격 때문에 미뤄 둔 저장을 마저 쓴다
+	for (TPair<TObjectKey<ARecastNavMesh>, FNavMeshState>& Pair : States)
+	{
+		const ARecastNavMesh* NavMesh = Pair.Value.NavMesh.Get();
+		if (Pair.Value.bSaveRequested && NavMesh && CanSave(*NavMesh))
+		{
+			SaveCache(*NavMesh);
+		}
+	}
+
+	States.Reset();
+	PendingFinished.Reset();
+	Super::Deinitialize();
+}
+
+void UNav_TileCacheSubsystem::Tick(float DeltaTime)
+{
+	// 재빌드 호출 안에서 생성 완료를 알리면 아직 등록 중인 구독자가 놓치므로 한 틱 미룬다
+	if (PendingFinished.Num() > 0)
+	{
+		TArray<TWeakObjectPtr<ANav_CachedRecastNavMesh>> Finished = MoveTemp(PendingFinished);
+		PendingFinished.Reset();
+		for (const TWeakObjectPtr<ANav_CachedRecastNavMesh>& WeakNavMesh : Finished)
+		{
+			ANav_CachedRecastNavMesh* NavMesh = WeakNavMesh.Get();
+			const FNavDataGenerator* Generator = NavMesh ? NavMesh->GetGenerator() : nullptr;
+			// 그 사이 더티 영역이 들어와 빌드가 시작됐으면 생성기가 끝날 때 알린다
+			if (NavMesh && !(Generator && Generator->IsBuildInProgressCheckDirty()))
+			{
+				NavMesh->BroadcastGenerationFinished();
+			}
+		}
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double SaveInterval = FMath::Max(CVarNavCacheSaveInterval.GetValueOnGameThread(), 0.0f);
+	for (TPair<TObjectKey<ARecastNavMesh>, FNavMeshState>& Pair : States)
+	{
+		FNavMeshState& State = Pair.Value;
+		const ARecastNavMesh* NavMesh = State.NavMesh.Get();
+		if (State.bSaveRequested && NavMesh && Now - State.LastSaveTime >= SaveInterval && CanSave(*NavMesh))
+		{
+			SaveCache(*NavMesh);
+		}
+	}
+}
+
+void UNav_TileCacheSubsystem::RestoreTiles(ANav_CachedRecastNavMesh& NavMesh, const TSet<FIntPoint>& Columns, TSet<FIntPoint>& OutRestored)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NavTileCache_Restore);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FNavMeshState& State = States.FindOrAdd(&NavMesh);
+	State.NavMesh = &NavMesh;
+	State.Restored.Reset();
+	State.BuildColumns = Columns;
+	State.BuildStartTime = StartTime;
+	State.bWaitingForPathable = true;
+	State.bRestoredOnly = false;
+	State.bSaveRequested = false;
+	Stats = FNavTileCacheStats();
+
+	if (!CVarNavCacheEnable.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	// 타일 데이터는 Detour가 소유할 버퍼로 한 번만 복사하면 되므로 파일 전체를 읽어 들이지 않고 매핑해서 본다.
+	// 매핑은 이 함수 안에서만 잡고 있으므로 저장할 때 파일을 바꿔치기할 수 있다.
+	const FString Path = GetCachePath(NavMesh);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Path))
+	{
+		UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache: no cache for %s, building %d columns"), *NavMesh.GetName(), Columns.Num());
+		return;
+	}
+
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Path));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion(0, MappedFile->GetFileSize()) : nullptr);
+	TArray<uint8> FallbackData;
+	TArrayView<const uint8> Data;
+	if (MappedRegion && MappedRegion->GetMappedSize() <= MAX_int32)
+	{
+		Data = TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	}
+	else if (FFileHelper::LoadFileToArray(FallbackData, *Path))
+	{
+		// 매핑을 지원하지 않는 플랫폼
+		Data = FallbackData;
+	}
+	else
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Nav tile cache: failed to read %s"), *Path);
+		return;
+	}
+
+	FMemoryReaderView Reader(Data);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	uint32 ParamsHash = 0;
+	Reader << FileMagic << FileVersion << ParamsHash;
+	if (Reader.IsError() || FileMagic != NavTileCache::Magic || FileVersion != NavTileCache::Version)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Nav tile cache: %s is not a version %u tile cache"), *Path, NavTileCache::Version);
+		return;
+	}
+	if (ParamsHash != ComputeParamsHash(NavMesh))
+	{
+		UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache: generation parameters of %s changed, rebuilding all tiles"), *NavMesh.GetName());
+		return;
+	}
+
+	TArray<NavTileCache::FEntry> Entries;
+	Reader << Entries;
+	if (Reader.IsError())
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Nav tile cache: %s is truncated"), *Path);
+		return;
+	}
+
+	// 이번 재빌드가 다루는 열만 열 단위로 모은다. 한 열의 레이어는 같은 입력 해시를 쓴다
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> EntriesByColumn;
+	EntriesByColumn.Reserve(Entries.Num());
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FIntPoint Column(Entries[Index].X, Entries[Index].Y);
+		if (Columns.Contains(Column))
+		{
+			EntriesByColumn.FindOrAdd(Column).Add(Index);
+		}
+	}
+
+	for (const TPair<FIntPoint, TArray<int32, TInlineAllocator<4>>>& Pair : EntriesByColumn)
+	{
+		const uint32 InputHash = ComputeColumnHash(NavMesh, Pair.Key);
+		if (Entries[Pair.Value[0]].InputHash != InputHash)
+		{
+			++Stats.NumRejectedColumns;
+			continue;
+		}
+
+		// 일부 레이어만 붙고 실패하면 열 전체를 다시 빌드한다 (생성기가 열의 기존 레이어를 지우고 새로 붙인다)
+		bool bAttached = true;
+		for (const int32 Index : Pair.Value)
+		{
+			const NavTileCache::FEntry& Entry = Entries[Index];
+			if (Entry.Size <= 0)
+			{
+				continue;
+			}
+			if (Entry.Offset < 0 || Entry.Size > Data.Num() - Entry.Offset)
+			{
+				bAttached = false;
+				break;
+			}
+
+			uint8* TileData = static_cast<uint8*>(dtAlloc(Entry.Size, DT_ALLOC_PERM_TILE_DATA));
+			FMemory::Memcpy(TileData, Data.GetData() + Entry.Offset, Entry.Size);
+			if (!NavMesh.AttachCachedTile(TileData, Entry.Size))
+			{
+				dtFree(TileData, DT_ALLOC_PERM_TILE_DATA);
+				bAttached = false;
+				break;
+			}
+			++Stats.NumRestoredTiles;
+		}
+
+		if (bAttached)
+		{
+			State.Restored.Add(Pair.Key, InputHash);
+			OutRestored.Add(Pair.Key);
+		}
+		else
+		{
+			++Stats.NumRejectedColumns;
+		}
+	}
+
+	Stats.NumRestoredColumns = OutRestored.Num();
+	Stats.bWarm = OutRestored.Num() > 0;
+	Stats.LoadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache: restored %d tiles in %d / %d columns of %s (%d rejected) in %.2f ms"),
+		Stats.NumRestoredTiles, Stats.NumRestoredColumns, Columns.Num(), *NavMesh.GetName(), Stats.NumRejectedColumns, Stats.LoadMs);
+}
+
+void UNav_TileCacheSubsystem::OnBuildQueued(ANav_CachedRecastNavMesh& NavMesh, int32 NumQueuedColumns)
+{
+	Stats.NumQueuedColumns = NumQueuedColumns;
+	if (NumQueuedColumns == 0)
+	{
+		if (FNavMeshState* State = States.Find(&NavMesh))
+		{
+			State->bRestoredOnly = true;
+		}
+		PendingFinished.AddUnique(&NavMesh);
+	}
+}
+
+bool UNav_TileCacheSubsystem::HasRestoredTiles(const ARecastNavMesh& NavMesh) const
+{
+	const FNavMeshState* State = States.Find(&NavMesh);
+	return State && State->Restored.Num() > 0;
+}
+
+bool UNav_TileCacheSubsystem::IsRestoredTileUnchanged(const ARecastNavMesh& NavMesh, const FIntPoint& Column)
+{
+	FNavMeshState* State = States.Find(&NavMesh);
+	const uint32* CachedHash = State ? State->Restored.Find(Column) : nullptr;
+	if (!CachedHash)
+	{
+		return false;
+	}
+
+	if (*CachedHash == ComputeColumnHash(NavMesh, Column))
+	{
+		++Stats.NumSkippedDirtyColumns;
+		return true;
+	}
+
+	// 이제 생성기가 빌드하므로 다음 저장에서 새 해시로 기록된다
+	State->Restored.Remove(Column);
+	return false;
+}
+
+void UNav_TileCacheSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	ARecastNavMesh* NavMesh = Cast<ANav_CachedRecastNavMesh>(NavData);
+	FNavMeshState* State = NavMesh ? States.Find(NavMesh) : nullptr;
+	if (!State)
+	{
+		return;
+	}
+
+	if (State->bWaitingForPathable)
+	{
+		State->bWaitingForPathable = false;
+		Stats.TimeToPathableMs = (FPlatformTime::Seconds() - State->BuildStartTime) * 1000.0;
+	}
+
+	if (State->bRestoredOnly)
+	{
+		State->bRestoredOnly = false;
+		return;
+	}
+	State->bSaveRequested = CVarNavCacheEnable.GetValueOnGameThread();
+}
+
+bool UNav_TileCacheSubsystem::CanSave(const ARecastNavMesh& NavMesh) const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const FNavDataGenerator* Generator = NavMesh.GetGenerator();
+	const UNav_RebuildGovernorSubsystem* Governor = GetWorld()->GetSubsystem<UNav_RebuildGovernorSubsystem>();
+	return NavSys && !NavSys->HasDirtyAreasQueued() && !(Generator && Generator->IsBuildInProgressCheckDirty())
+		&& !(Governor && Governor->GetNumDeferredTiles(NavMesh) > 0);
+}
+
+bool UNav_TileCacheSubsystem::SaveCache(const ARecastNavMesh& NavMesh)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NavTileCache_Save);
+	const dtNavMesh* DetourMesh = NavMesh.GetRecastMesh();
+	if (!DetourMesh)
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FNavMeshState& State = States.FindOrAdd(&NavMesh);
+	State.NavMesh = const_cast<ARecastNavMesh*>(&NavMesh);
+	State.bSaveRequested = false;
+	State.LastSaveTime = StartTime;
+
+	// 복원한 열은 기록된 해시를 그대로 쓰고 빌드한 열만 다시 해시한다
+	TArray<NavTileCache::FEntry> Entries;
+	TArray<const dtMeshTile*> Tiles;
+	TMap<FIntPoint, uint32> ColumnHashes;
+	for (int32 TileIndex = 0; TileIndex < DetourMesh->getMaxTiles(); ++TileIndex)
+	{
+		const dtMeshTile* Tile = DetourMesh->getTile(TileIndex);
+		if (!Tile || !Tile->header || !Tile->data || Tile->dataSize <= 0)
+		{
+			continue;
+		}
+
+		const FIntPoint Column(Tile->header->x, Tile->header->y);
+		uint32 InputHash = 0;
+		if (const uint32* Found = ColumnHashes.Find(Column))
+		{
+			InputHash = *Found;
+		}
+		else
+		{
+			const uint32* Restored = State.Restored.Find(Column);
+			InputHash = ColumnHashes.Add(Column, Restored ? *Restored : ComputeColumnHash(NavMesh, Column));
+		}
+
+		NavTileCache::FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.X = Column.X;
+		Entry.Y = Column.Y;
+		Entry.Layer = Tile->header->layer;
+		Entry.InputHash = InputHash;
+		Entry.Size = Tile->dataSize;
+		Tiles.Add(Tile);
+	}
+
+	// 걸을 수 있는 지형이 없는 열도 남겨 두면 다음 시작에서 지오메트리 수집까지 건너뛴다
+	for (const FIntPoint& Column : State.BuildColumns)
+	{
+		if (!ColumnHashes.Contains(Column))
+		{
+			NavTileCache::FEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.X = Column.X;
+			Entry.Y = Column.Y;
+			Entry.InputHash = ComputeColumnHash(NavMesh, Column);
+		}
+	}
+
+	// 헤더 크기는 항목 수로 정해지므로 한 번 써 보고 오프셋을 채운 뒤 다시 쓴다
+	const uint32 ParamsHash = ComputeParamsHash(NavMesh);
+	TArray<uint8> File;
+	NavTileCache::WriteFile(File, ParamsHash, Entries);
+	int64 Offset = File.Num();
+	for (int32 Index = 0; Index < Tiles.Num(); ++Index)
+	{
+		Offset = Align(Offset, NavTileCache::TileAlignment);
+		Entries[Index].Offset = static_cast<int32>(Offset);
+		Offset += Entries[Index].Size;
+	}
+	if (Offset > MAX_int32)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Nav tile cache: %s has too many tiles to cache (%lld bytes)"), *NavMesh.GetName(), Offset);
+		return false;
+	}
+
+	File.Reset();
+	NavTileCache::WriteFile(File, ParamsHash, Entries);
+	File.SetNumZeroed(static_cast<int32>(Offset));
+	for (int32 Index = 0; Index < Tiles.Num(); ++Index)
+	{
+		FMemory::Memcpy(File.GetData() + Entries[Index].Offset, Tiles[Index]->data, Entries[Index].Size);
+	}
+
+	// 다른 PIE 인스턴스가 읽는 중일 수 있으므로 임시 파일에 쓰고 바꿔치기한다
+	const FString Path = GetCachePath(NavMesh);
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(File, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Nav tile cache: failed to write %s"), *Path);
+		return false;
+	}
+
+	Stats.NumSavedTiles = Tiles.Num();
+	Stats.SavedBytes = File.Num();
+	Stats.SaveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache: wrote %d tiles in %d columns to %s (%.1f KB) in %.2f ms"),
+		Stats.NumSavedTiles, ColumnHashes.Num(), *Path, Stats.SavedBytes / 1024.0, Stats.SaveMs);
+	return true;
+}
+
+FString UNav_TileCacheSubsystem::GetCachePath(const ARecastNavMesh& NavMesh) const
+{
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(GetWorld()->GetPackage()));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("NavTileCache"), FString::Printf(TEXT("%s_%s.navtiles"), *MapName, *NavMesh.GetName()));
+}
+
+void UNav_TileCacheSubsystem::ClearCache()
+{
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("NavTileCache"));
+	if (IFileManager::Get().DirectoryExists(*Directory))
+	{
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache: cleared %s"), *Directory);
+	}
+}
+
+uint32 UNav_TileCacheSubsystem::ComputeParamsHash(const ARecastNavMesh& NavMesh) const
+{
+	uint32 Hash = HashCombine(GetTypeHash(NAVMESHVER_LATEST), GetTypeHash(DT_NAVMESH_VERSION));
+	Hash = HashCombine(Hash, GetTypeHash(FEngineVersion::Current().ToString()));
+	Hash = HashCombine(Hash, GetTypeHash(NavMesh.NavMeshOriginOffset));
+
+	// 에이전트 크기, 셀/타일 크기, 영역 병합 설정 등 타일 생성에 쓰이는 값은 모두 config 속성이다.
+	// 디버그 그리기 같은 표시용 속성은 config가 아니므로 바꿔도 캐시가 유지된다.
+	FString Value;
+	for (TFieldIterator<FProperty> It(ARecastNavMesh::StaticClass(), EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_Config))
+		{
+			Value.Reset();
+			It->ExportTextItem_InContainer(Value, &NavMesh, nullptr, nullptr, PPF_None);
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(It->GetFName()), GetTypeHash(Value)));
+		}
+	}
+	return Hash;
+}
+
+FBox UNav_TileCacheSubsystem::GetColumnBounds(const ARecastNavMesh& NavMesh, const FIntPoint& Column) const
+{
+	FBox Bounds = NavTile::GetTileBounds(NavMesh, Column);
+	if (!Bounds.IsValid)
+	{
+		return Bounds;
+	}
+
+	// 타일 테두리 밖의 지오메트리도 침식 반경만큼 타일에 영향을 준다
+	const FVector::FReal Border = NavMesh.AgentRadius + NavMesh.GetCellSize(ENavigationDataResolution::Default) * 3.0;
+	Bounds.Min.X -= Border;
+	Bounds.Min.Y -= Border;
+	Bounds.Max.X += Border;
+	Bounds.Max.Y += Border;
+	return Bounds;
+}
+
+uint32 UNav_TileCacheSubsystem::ComputeColumnHash(const ARecastNavMesh& NavMesh, const FIntPoint& Column) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_NavTileCache_Hash);
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const FNavigationOctree* NavOctree = NavSys ? NavSys->GetNavOctree() : nullptr;
+	if (!NavOctree)
+	{
+		return 0;
+	}
+
+	// 옥트리 순회 순서는 등록 순서에 따라 달라지므로 요소 해시를 정렬해서 합친다
+	TArray<uint32, TInlineAllocator<64>> ElementHashes;
+	NavOctree->FindElementsWithBoundsTest(FBoxCenterAndExtent(GetColumnBounds(NavMesh, Column)), [&ElementHashes](const FNavigationOctreeElement& Element)
+	{
+		const FNavigationRelevantData& Data = *Element.Data;
+		uint32 ElementHash = NavTileCache::HashBox(Element.Bounds.GetBox());
+
+		// 지연 수집 모드에서 아직 모으지 않은 지오메트리는 경계만 본다
+		if (!Data.IsPendingLazyGeometryGathering() && Data.CollisionData.Num() > 0)
+		{
+			ElementHash = HashCombine(ElementHash, FCrc::MemCrc32(Data.CollisionData.GetData(), Data.CollisionData.Num()));
+		}
+		for (const FAreaNavModifier& Area : Data.Modifiers.GetAreas())
+		{
+			const UClass* AreaClass = Area.GetAreaClass();
+			ElementHash = HashCombine(ElementHash, HashCombine(NavTileCache::HashBox(Area.GetBounds()), GetTypeHash(AreaClass ? AreaClass->GetFName() : NAME_None)));
+		}
+		ElementHashes.Add(ElementHash);
+	});
+
+	ElementHashes.Sort();
+	return FCrc::MemCrc32(ElementHashes.GetData(), ElementHashes.Num() * sizeof(uint32), GetTypeHash(Column));
+}
+
+void UNav_TileCacheSubsystem::LogReport() const
+{
+	UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache (%s): restored %d tiles in %d columns, %d rejected, built %d columns, %d dirty columns skipped, load %.2f ms, pathable after %.1f ms"),
+		Stats.bWarm ? TEXT("warm") : TEXT("cold"), Stats.NumRestoredTiles, Stats.NumRestoredColumns, Stats.NumRejectedColumns,
+		Stats.NumQueuedColumns, Stats.NumSkippedDirtyColumns, Stats.LoadMs, Stats.TimeToPathableMs);
+	UE_LOG(LogAIStudy, Display, TEXT("Nav tile cache: last save %d tiles (%.1f KB) in %.2f ms"), Stats.NumSavedTiles, Stats.SavedBytes / 1024.0, Stats.SaveMs);
+}
+
+static FAutoConsoleCommandWithWorld NavCacheReportCommand(
+	TEXT("AIStudy.NavCache.Report"),
+	TEXT("내비메시 타일 캐시의 복원/빌드 타일 수와 경로 탐색 가능까지 걸린 시간을 로그로 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNav_TileCacheSubsystem* Cache = World ? World->GetSubsystem<UNav_TileCacheSubsystem>() : nullptr)
+		{
+			Cache->LogReport();
+		}
+	}));
+
+static FAutoConsoleCommand NavCacheClearCommand(
+	TEXT("AIStudy.NavCache.Clear"),
+	TEXT("디스크의 내비메시 타일 캐시를 모두 지운다. 다음 전체 재빌드부터 모든 타일을 다시 빌드한다."),
+	FConsoleCommandDelegate::CreateStatic(&UNav_TileCacheSubsystem::ClearCache));
@@ -0,0 +1,63 @@
+#include "Net_AIMovement.h"
+#include "GameFramework/Character.h"
+#include "Net/UnrealNetwork.h"
+
+bool FNet_AIMovement::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// 위치는 성분당 최대 24비트, 수평 이동 속도는 16비트면 충분하다
+	bOutSuccess = SerializePackedVector<1, 24>(Location, Ar);
+	bOutSuccess &= SerializePackedVector<1, 16>(Velocity, Ar);
+
+	uint8 CompressedYaw = FRotator::CompressAxisToByte(Yaw);
+	Ar << CompressedYaw;
+	if (Ar.IsLoading())
+	{
+		Yaw = FRotator::DecompressAxisFromByte(CompressedYaw);
+	}
+	return true;
+}
+
+namespace NetAIMovement
+{
+	void DisableDefaultMovementReplication(const UClass* ThisClass, TArray<FLifetimeProperty>& OutLifetimeProps)
+	{
+		DisableReplicatedLifetimeProperty(ThisClass, AActor::StaticClass(), TEXT("ReplicatedMovement"), OutLifetimeProps);
+
+		static const FName CharacterProperties[] =
+		{
+			TEXT("ReplicatedBasedMovement"),
+			TEXT("ReplicatedServerLastTransformUpdateTimeStamp"),
+			TEXT("ReplicatedMovementMode"),
+			TEXT("bProxyIsJumpForceApplied"),
+			TEXT("AnimRootMotionTranslationScale"),
+			TEXT("RepRootMotion"),
+		};
+		for (const FName& PropertyName : CharacterProperties)
+		{
+			DisableReplicatedLifetimeProperty(ThisClass, ACharacter::StaticClass(), PropertyName, OutLifetimeProps);
+		}
+	}
+
+	FNet_AIMovement Capture(const ACharacter& Character)
+	{
+		FNet_AIMovement Movement;
+		Movement.Location = Character.GetActorLocation().RoundToVector();
+		Movement.Velocity = Character.GetVelocity().RoundToVector();
+		Movement.Yaw = FRotator::DecompressAxisFromByte(FRotator::CompressAxisToByte(Character.GetActorRotation().Yaw));
+		return Movement;
+	}
+
+	void Apply(ACharacter& Character, const FNet_AIMovement& Movement)
+	{
+		FRepMovement& RepMovement = Character.GetReplicatedMovement_Mutable();
+		RepMovement.Location = Movement.Location;
+		RepMovement.Rotation = FRotator(0.0f, Movement.Yaw, 0.0f);
+		RepMovement.LinearVelocity = Movement.Velocity;
+		RepMovement.AngularVelocity = FVector::ZeroVector;
+		RepMovement.bRepPhysics = false;
+		RepMovement.bSimulatedPhysicSleep = false;
+
+		// bReplicateMovement는 켜 둔 채 속성 복제만 껐으므로 기본 경로(PostNetReceiveVelocity, SmoothCorrection)가 그대로 동작한다
+		Character.OnRep_ReplicatedMovement();
+	}
+}
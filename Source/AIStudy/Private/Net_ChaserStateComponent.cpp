@@ -0,0 +1,71 @@
+#include "Net_ChaserStateComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
+
+UNet_ChaserStateComponent::UNet_ChaserStateComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UNet_ChaserStateComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UNet_ChaserStateComponent, State);
+}
+
+void UNet_ChaserStateComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AActor* Owner = GetOwner();
+	if (!Owner || !Owner->HasAuthority())
+	{
+		return;
+	}
+
+	// 소유 액터가 등록된 서브오브젝트 목록으로 복제해야 COND_NetGroup이 적용된다
+	NetGroup = FName(TEXT("AIStudy.ChaserState"), static_cast<int32>(GetUniqueID()));
+	FNetConditionGroupManager::RegisterSubObjectInGroup(this, NetGroup);
+	Owner->SetReplicatedComponentNetCondition(this, COND_NetGroup);
+}
+
+void UNet_ChaserStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (!NetGroup.IsNone())
+	{
+		// 플레이어 컨트롤러에 그룹 이름이 쌓이지 않도록 정리
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			SetRelevantTo(It->Get(), false);
+		}
+		FNetConditionGroupManager::UnregisterSubObjectFromGroup(this, NetGroup);
+		NetGroup = NAME_None;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UNet_ChaserStateComponent::SetRelevantTo(APlayerController* PlayerController, bool bRelevant) const
+{
+	if (!PlayerController || NetGroup.IsNone() || PlayerController->IsMemberOfNetConditionGroup(NetGroup) == bRelevant)
+	{
+		return;
+	}
+
+	if (bRelevant)
+	{
+		PlayerController->IncludeInNetConditionGroup(NetGroup);
+	}
+	else
+	{
+		PlayerController->RemoveFromNetConditionGroup(NetGroup);
+	}
+}
+
+void UNet_ChaserStateComponent::OnRep_State()
+{
+	OnStateReplicated.Broadcast(State);
+}
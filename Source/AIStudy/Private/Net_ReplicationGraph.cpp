@@ -0,0 +1,279 @@
+#include "Net_ReplicationGraph.h"
+#include "Net_ChaserStateComponent.h"
+#include "AIStudyCharacter.h"
+#include "RVO_Character.h"
+#include "Chaser_Character.h"
+#include "AIStudy.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "NavigationSystem.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("Net AI Buckets"), STAT_Net_AIBuckets, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarNetCellSize(
+	TEXT("AIStudy.Net.CellSize"),
+	10000.0f,
+	TEXT("복제 그래프 공간화 격자 셀 크기(cm). 서버 시작 시 읽는다."));
+
+static TAutoConsoleVariable<float> CVarNetAICullDistance(
+	TEXT("AIStudy.Net.AICullDistance"),
+	15000.0f,
+	TEXT("AI 폰을 복제하는 최대 거리(cm). 서버 시작 시 읽는다."));
+
+static TAutoConsoleVariable<FString> CVarNetBucketDistances(
+	TEXT("AIStudy.Net.BucketDistances"),
+	TEXT("3000,8000"),
+	TEXT("근/중 버킷의 최대 거리(cm). 더 멀면 원 버킷."));
+
+static TAutoConsoleVariable<FString> CVarNetBucketPeriods(
+	TEXT("AIStudy.Net.BucketPeriods"),
+	TEXT("1,3,6"),
+	TEXT("근/중/원 버킷의 복제 주기(복제 프레임 수)."));
+
+static TAutoConsoleVariable<float> CVarNetBucketUpdateInterval(
+	TEXT("AIStudy.Net.BucketUpdateInterval"),
+	0.2f,
+	TEXT("연결별 거리 버킷을 다시 계산하는 간격(초)."));
+
+static TAutoConsoleVariable<float> CVarNetStateRadius(
+	TEXT("AIStudy.Net.StateRadius"),
+	3000.0f,
+	TEXT("추적자 상태를 복제하는 최대 거리(cm)."));
+
+static TAutoConsoleVariable<float> CVarNetReportInterval(
+	TEXT("AIStudy.Net.ReportInterval"),
+	0.0f,
+	TEXT("서버 프레임/복제 시간과 연결별 송신량을 로그로 남기는 간격(초). 0이면 끈다."));
+
+static FAutoConsoleCommandWithWorld NetReportCommand(
+	TEXT("AIStudy.Net.Report"),
+	TEXT("복제 그래프의 서버 프레임/복제 시간, 버킷 분포, 연결별 송신량 출력"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		if (const UNet_ReplicationGraph* Graph = NetDriver ? Cast<UNet_ReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr)
+		{
+			Graph->LogReport();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs NetSpawnTestAgentsCommand(
+	TEXT("AIStudy.Net.SpawnTestAgents"),
+	TEXT("서버에서 내비메시 위 임의 위치에 추적자를 스폰 (인자: 수 [반경 cm])"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+		if (!NavSys || World->GetNetMode() == NM_Client)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+		const float Radius = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 5000.0f;
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		int32 NumSpawned = 0;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			FNavLocation Location;
+			if (NavSys->GetRandomReachablePointInRadius(FVector::ZeroVector, Radius, Location)
+				&& World->SpawnActor<AChaser_Character>(Location.Location + FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator, SpawnParams))
+			{
+				++NumSpawned;
+			}
+		}
+		UE_LOG(LogAIStudy, Display, TEXT("Net: spawned %d/%d test chasers"), NumSpawned, Count);
+	}));
+
+namespace NetAI
+{
+	template<typename T, int32 N>
+	static void ParseValues(const FString& String, T (&OutValues)[N])
+	{
+		TArray<FString> Tokens;
+		String.ParseIntoArray(Tokens, TEXT(","));
+		for (int32 Index = 0; Index < N && Index < Tokens.Num(); ++Index)
+		{
+			OutValues[Index] = FMath::Max(static_cast<T>(FCString::Atof(*Tokens[Index])), static_cast<T>(0));
+		}
+	}
+}
+
+bool UNet_ReplicationGraph::IsAIPawnClass(const UClass* Class)
+{
+	return IsAIOnlyPawnClass(Class) || Class->IsChildOf<AAIStudyCharacter>();
+}
+
+bool UNet_ReplicationGraph::IsAIOnlyPawnClass(const UClass* Class)
+{
+	return Class->IsChildOf<ARVO_Character>() || Class->IsChildOf<AChaser_Character>();
+}
+
+void UNet_ReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// AI 폰은 격자 노드에서 거리로 컬링한다. 기본 주기는 매 프레임이고 실제 주기는 연결별 거리 버킷이 정한다.
+	// Super가 로드된 모든 복제 클래스(블루프린트 하위 클래스 포함)를 CDO 값으로 이미 등록했으므로 네이티브 부모만 바꾸면
+	// 하위 클래스에는 적용되지 않는다. 로드된 AI 클래스를 모두 덮어쓰고, 나중에 로드되는 클래스는 부모 설정을 물려받는다.
+	// 플레이어 템플릿(AAIStudyCharacter)은 클래스 단위로 바꾸지 않고 AI가 조종하는 폰만 버킷 갱신에서 바꾼다.
+	FClassReplicationInfo AIPawnInfo;
+	AIPawnInfo.SetCullDistanceSquared(FMath::Square(CVarNetAICullDistance.GetValueOnGameThread()));
+	AIPawnInfo.ReplicationPeriodFrame = 1;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const FString ClassName = Class->GetName();
+		if (IsAIOnlyPawnClass(Class) && !ClassName.StartsWith(TEXT("SKEL_")) && !ClassName.StartsWith(TEXT("REINST_")))
+		{
+			GlobalActorReplicationInfoMap.SetClassInfo(Class, AIPawnInfo);
+		}
+	}
+}
+
+void UNet_ReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	GridNode->CellSize = CVarNetCellSize.GetValueOnGameThread();
+}
+
+void UNet_ReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+
+	APawn* Pawn = Cast<APawn>(ActorInfo.Actor);
+	if (Pawn && IsAIPawnClass(Pawn->GetClass()))
+	{
+		AIPawns.Add({ Pawn, Pawn->FindComponentByClass<UNet_ChaserStateComponent>() });
+	}
+}
+
+void UNet_ReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+
+	const AActor* Actor = ActorInfo.Actor;
+	const int32 Index = AIPawns.IndexOfByPredicate([Actor](const FAIPawnEntry& Entry) { return Entry.Pawn.Get() == Actor; });
+	if (Index != INDEX_NONE)
+	{
+		AIPawns.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+int32 UNet_ReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TimeUntilBucketUpdate -= DeltaSeconds;
+	if (TimeUntilBucketUpdate <= 0.0f)
+	{
+		TimeUntilBucketUpdate = CVarNetBucketUpdateInterval.GetValueOnGameThread();
+		UpdateAIBuckets();
+	}
+
+	const int32 Result = Super::ServerReplicateActors(DeltaSeconds);
+
+	ReplicateSeconds += FPlatformTime::Seconds() - StartTime;
+	FrameMilliseconds += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	++NumReportFrames;
+
+	const float ReportInterval = CVarNetReportInterval.GetValueOnGameThread();
+	TimeUntilReport -= DeltaSeconds;
+	if (ReportInterval > 0.0f && TimeUntilReport <= 0.0f)
+	{
+		TimeUntilReport = ReportInterval;
+		LogReport();
+		ReplicateSeconds = 0.0;
+		FrameMilliseconds = 0.0;
+		NumReportFrames = 0;
+	}
+	return Result;
+}
+
+void UNet_ReplicationGraph::UpdateAIBuckets()
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Net_AIBuckets);
+
+	float Distances[2] = { 3000.0f, 8000.0f };
+	int32 Periods[3] = { 1, 3, 6 };
+	NetAI::ParseValues(CVarNetBucketDistances.GetValueOnGameThread(), Distances);
+	NetAI::ParseValues(CVarNetBucketPeriods.GetValueOnGameThread(), Periods);
+	const float StateRadiusSquared = FMath::Square(CVarNetStateRadius.GetValueOnGameThread());
+	const float AICullDistanceSquared = FMath::Square(CVarNetAICullDistance.GetValueOnGameThread());
+
+	// 파괴된 폰 정리
+	AIPawns.RemoveAllSwap([](const FAIPawnEntry& Entry) { return !Entry.Pawn.IsValid(); }, EAllowShrinking::No);
+	FMemory::Memzero(BucketPopulation);
+
+	// 순찰자는 플레이어와 같은 클래스라 클래스 설정으로는 구분할 수 없으므로, AI가 조종하는 폰에만 AI 컬링 거리를 준다
+	for (const FAIPawnEntry& Entry : AIPawns)
+	{
+		APawn* Pawn = Entry.Pawn.Get();
+		if (!Pawn->IsPlayerControlled() && !IsAIOnlyPawnClass(Pawn->GetClass()))
+		{
+			GlobalActorReplicationInfoMap.Get(Pawn).Settings.SetCullDistanceSquared(AICullDistanceSquared);
+		}
+	}
+
+	for (UNetReplicationGraphConnection* Connection : Connections)
+	{
+		UNetConnection* NetConnection = Connection ? Connection->NetConnection : nullptr;
+		if (!NetConnection || !NetConnection->ViewTarget)
+		{
+			continue;
+		}
+
+		const FVector ViewLocation = FNetViewer(NetConnection, 0.0f).ViewLocation;
+		APlayerController* PlayerController = NetConnection->PlayerController;
+		for (const FAIPawnEntry& Entry : AIPawns)
+		{
+			APawn* Pawn = Entry.Pawn.Get();
+			if (Pawn->IsPlayerControlled())
+			{
+				continue;
+			}
+
+			const float DistanceSquared = FVector::DistSquared(ViewLocation, Pawn->GetActorLocation());
+			const int32 Bucket = DistanceSquared <= FMath::Square(Distances[0]) ? 0 : (DistanceSquared <= FMath::Square(Distances[1]) ? 1 : 2);
+			FConnectionReplicationActorInfo& ConnectionInfo = Connection->ActorInfoMap.FindOrAdd(Pawn);
+			ConnectionInfo.ReplicationPeriodFrame = FMath::Max(Periods[Bucket], 1);
+			ConnectionInfo.SetCullDistanceSquared(AICullDistanceSquared);
+			++BucketPopulation[Bucket];
+
+			if (const UNet_ChaserStateComponent* ChaserState = Entry.ChaserState.Get())
+			{
+				ChaserState->SetRelevantTo(PlayerController, DistanceSquared <= StateRadiusSquared);
+			}
+		}
+	}
+}
+
+void UNet_ReplicationGraph::LogReport() const
+{
+	const int32 NumFrames = FMath::Max(NumReportFrames, 1);
+	int64 TotalBytesPerSecond = 0;
+	int32 MaxBytesPerSecond = 0;
+	int32 NumClients = 0;
+	for (const UNetReplicationGraphConnection* Connection : Connections)
+	{
+		const UNetConnection* NetConnection = Connection ? Connection->NetConnection : nullptr;
+		if (!NetConnection)
+		{
+			continue;
+		}
+
+		++NumClients;
+		TotalBytesPerSecond += NetConnection->OutBytesPerSecond;
+		MaxBytesPerSecond = FMath::Max(MaxBytesPerSecond, NetConnection->OutBytesPerSecond);
+		UE_LOG(LogAIStudy, Verbose, TEXT("Net: %s out %d bytes/s, in %d bytes/s"), *NetConnection->LowLevelGetRemoteAddress(true), NetConnection->OutBytesPerSecond, NetConnection->InBytesPerSecond);
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Net: server frame %.2f ms, replicate %.3f ms | %d clients, out avg %lld / max %d bytes/s per client | %d AI pawns, buckets near %d / mid %d / far %d"),
+		FrameMilliseconds / NumFrames, ReplicateSeconds * 1000.0 / NumFrames,
+		NumClients, NumClients > 0 ? TotalBytesPerSecond / NumClients : 0, MaxBytesPerSecond,
+		AIPawns.Num(), BucketPopulation[0], BucketPopulation[1], BucketPopulation[2]);
+}
@@ -0,0 +1,170 @@
+#include "Path_CacheSubsystem.h"
+#include "AIStudy.h"
+#include "NavigationData.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cache Hits"), STAT_PathCache_Hits, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cache Misses"), STAT_PathCache_Misses, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cache Invalidations"), STAT_PathCache_Invalidations, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Path Cache Entries"), STAT_PathCache_Entries, STATGROUP_AIStudy);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Path Cache Hit Rate"), STAT_PathCache_HitRate, STATGROUP_AIStudy);
+DECLARE_MEMORY_STAT(TEXT("Path Cache Memory"), STAT_PathCache_Memory, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarPathCacheQuantization(
+	TEXT("AIStudy.PathCache.Quantization"),
+	200.0f,
+	TEXT("경로 캐시 키를 만들 때 시작/끝 위치를 묶는 격자 크기."));
+
+static TAutoConsoleVariable<int32> CVarPathCacheMaxEntries(
+	TEXT("AIStudy.PathCache.MaxEntries"),
+	4096,
+	TEXT("경로 캐시 최대 항목 수. 넘치면 가장 오래된 항목부터 버린다."));
+
+bool UPath_CacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPath_CacheSubsystem::Deinitialize()
+{
+	Flush();
+	Super::Deinitialize();
+}
+
+FPathCacheKey UPath_CacheSubsystem::MakeKey(const ANavigationData& NavData, const FVector& Start, const FVector& End, TSubclassOf<UNavigationQueryFilter> FilterClass) const
+{
+	const double Quantization = FMath::Max(CVarPathCacheQuantization.GetValueOnGameThread(), 1.0f);
+
+	FPathCacheKey Key;
+	Key.Start = FIntVector(FMath::RoundToInt32(Start.X / Quantization), FMath::RoundToInt32(Start.Y / Quantization), FMath::RoundToInt32(Start.Z / Quantization));
+	Key.End = FIntVector(FMath::RoundToInt32(End.X / Quantization), FMath::RoundToInt32(End.Y / Quantization), FMath::RoundToInt32(End.Z / Quantization));
+	Key.FilterClass = FilterClass.Get();
+	Key.NavData = &NavData;
+	return Key;
+}
+
+FNavPathSharedPtr UPath_CacheSubsystem::FindPath(const ANavigationData& NavData, const FVector& Start, const FVector& End, TSubclassOf<UNavigationQueryFilter> FilterClass)
+{
+	const FPathCacheKey Key = MakeKey(NavData, Start, End, FilterClass);
+	const FEntry* Entry = Entries.Find(Key);
+
+	// 무효화 이벤트를 놓친 경우를 대비해 유효성도 확인
+	if (Entry && Entry->Path.IsValid() && Entry->Path->IsValid())
+	{
+		++NumHits;
+		INC_DWORD_STAT(STAT_PathCache_Hits);
+		UpdateStats();
+		return Entry->Path;
+	}
+
+	if (Entry)
+	{
+		RemoveEntry(Key);
+	}
+
+	++NumMisses;
+	INC_DWORD_STAT(STAT_PathCache_Misses);
+	UpdateStats();
+	return nullptr;
+}
+
+void UPath_CacheSubsystem::AddPath(const ANavigationData& NavData, const FVector& Start, const FVector& End, TSubclassOf<UNavigationQueryFilter> FilterClass, FNavPathSharedPtr Path)
+{
+	// 부분 경로는 목적지가 바뀌면 의미가 없으므로 캐시하지 않는다
+	if (!Path.IsValid() || !Path->IsValid() || Path->IsPartial())
+	{
+		return;
+	}
+
+	const FPathCacheKey Key = MakeKey(NavData, Start, End, FilterClass);
+	RemoveEntry(Key);
+
+	const int32 MaxEntries = FMath::Max(CVarPathCacheMaxEntries.GetValueOnGameThread(), 1);
+	while (Entries.Num() >= MaxEntries && InsertionOrder.Num() > 0)
+	{
+		RemoveEntry(InsertionOrder[0]);
+	}
+
+	// 여러 에이전트가 같은 객체를 공유하므로 무효화 시 제자리 재탐색은 끈다.
+	// 무효화된 경로를 따르던 에이전트는 이동이 중단되고, 다음 요청은 캐시 미스로 새로 탐색한다.
+	Path->EnableRecalculationOnInvalidation(false);
+
+	// 통로 타일이 다시 빌드되면 ARecastNavMesh::InvalidateAffectedPaths가 이 경로를 무효화하도록 등록
+	const_cast<ANavigationData&>(NavData).RegisterActivePath(Path);
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Path = Path;
+	Entry.ObserverHandle = Path->AddObserver(FNavigationPath::FPathObserverDelegate::FDelegate::CreateUObject(this, &UPath_CacheSubsystem::OnPathEvent));
+	Entry.Bytes = sizeof(FNavMeshPath) + Path->GetPathPoints().GetAllocatedSize();
+	if (const FNavMeshPath* NavMeshPath = Path->CastPath<FNavMeshPath>())
+	{
+		Entry.Bytes += NavMeshPath->PathCorridor.GetAllocatedSize() + NavMeshPath->PathCorridorCost.GetAllocatedSize();
+	}
+
+	AllocatedBytes += Entry.Bytes;
+	PathToKey.Add(Path.Get(), Key);
+	InsertionOrder.Add(Key);
+	UpdateStats();
+}
+
+void UPath_CacheSubsystem::RemoveEntry(const FPathCacheKey& Key)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	AllocatedBytes -= Entry.Bytes;
+	InsertionOrder.Remove(Key);
+	if (Entry.Path.IsValid())
+	{
+		PathToKey.Remove(Entry.Path.Get());
+		Entry.Path->RemoveObserver(Entry.ObserverHandle);
+	}
+	UpdateStats();
+}
+
+void UPath_CacheSubsystem::OnPathEvent(FNavigationPath* Path, ENavPathEvent::Type Event)
+{
+	if (Event != ENavPathEvent::Invalidated && Event != ENavPathEvent::Cleared && Event != ENavPathEvent::RePathFailed)
+	{
+		return;
+	}
+
+	if (const FPathCacheKey* Key = PathToKey.Find(Path))
+	{
+		INC_DWORD_STAT(STAT_PathCache_Invalidations);
+		// RemoveEntry가 PathToKey를 수정하므로 복사본을 넘긴다
+		RemoveEntry(FPathCacheKey(*Key));
+	}
+}
+
+void UPath_CacheSubsystem::Flush()
+{
+	while (InsertionOrder.Num() > 0)
+	{
+		RemoveEntry(InsertionOrder[0]);
+	}
+}
+
+void UPath_CacheSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_PathCache_Entries, Entries.Num());
+	SET_FLOAT_STAT(STAT_PathCache_HitRate, GetHitRate());
+	SET_MEMORY_STAT(STAT_PathCache_Memory, AllocatedBytes);
+}
+
+static FAutoConsoleCommandWithWorld PathCacheFlushCommand(
+	TEXT("AIStudy.PathCache.Flush"),
+	TEXT("순찰 경로 캐시를 비운다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UPath_CacheSubsystem* PathCache = World ? World->GetSubsystem<UPath_CacheSubsystem>() : nullptr)
+		{
+			UE_LOG(LogAIStudy, Display, TEXT("PathCache: flushing %d entries (hit rate %.1f%%, %llu bytes)"),
+				PathCache->GetNumEntries(), PathCache->GetHitRate() * 100.0f, static_cast<uint64>(PathCache->GetAllocatedSize()));
+			PathCache->Flush();
+		}
+	}));
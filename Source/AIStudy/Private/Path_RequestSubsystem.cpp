@@ -0,0 +1,501 @@
+#include "Path_RequestSubsystem.h"
+#include "Path_CacheSubsystem.h"
+#include "Nav_HierarchicalSubsystem.h"
+#include "AIStudy.h"
+#include "Benchmark_Metrics.h"
+#include "Replay_AISubsystem.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Path Request Dispatch"), STAT_PathRequest_Dispatch, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Path Request Complete"), STAT_PathRequest_Complete, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Queued"), STAT_PathRequest_Queued, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Served"), STAT_PathRequest_Served, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Dropped"), STAT_PathRequest_Dropped, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Deduped"), STAT_PathRequest_Deduped, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Path Requests Pending"), STAT_PathRequest_Pending, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Path Requests In Flight"), STAT_PathRequest_InFlight, STATGROUP_AIStudy);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Path Request Avg Latency (ms)"), STAT_PathRequest_AvgLatency, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarPathRequestBudgetMs(
+	TEXT("AIStudy.PathRequest.BudgetMs"),
+	0.5f,
+	TEXT("경로 요청 발송에 쓰는 프레임당 예산(ms). 발송 시간에 보낸 비동기 쿼리의 추정 비용(QueryCostMs)을 더해 센다."));
+
+static TAutoConsoleVariable<float> CVarPathRequestQueryCostMs(
+	TEXT("AIStudy.PathRequest.QueryCostMs"),
+	0.05f,
+	TEXT("비동기 경로 쿼리 하나를 예산에서 차감하는 추정 비용(ms). 워커에서 도는 탐색은 발송 시간에 잡히지 않는다."));
+
+static TAutoConsoleVariable<int32> CVarPathRequestDeterministicPerFrame(
+	TEXT("AIStudy.PathRequest.DeterministicPerFrame"),
+	16,
+	TEXT("AI 기록/재생 중 프레임당 처리하는 요청 수. 이때는 시간 예산 대신 이 수만큼 동기로 탐색한다."));
+
+static TAutoConsoleVariable<float> CVarPathRequestRepathThreshold(
+	TEXT("AIStudy.PathRequest.RepathThreshold"),
+	100.0f,
+	TEXT("목표가 이 거리 이상 움직였을 때만 경로를 다시 요청한다."));
+
+static TAutoConsoleVariable<int32> CVarPathRequestMaxQueued(
+	TEXT("AIStudy.PathRequest.MaxQueued"),
+	1024,
+	TEXT("대기열 최대 길이. 넘치면 가장 낮은 우선순위의 오래된 요청을 버린다."));
+
+static TAutoConsoleVariable<int32> CVarPathRequestMaxInFlight(
+	TEXT("AIStudy.PathRequest.MaxInFlight"),
+	64,
+	TEXT("동시에 진행할 수 있는 비동기 경로 쿼리 수."));
+
+bool UPath_RequestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPath_RequestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPath_RequestSubsystem, STATGROUP_Tickables);
+}
+
+int32 UPath_RequestSubsystem::GetNumQueued() const
+{
+	int32 Num = 0;
+	for (const TArray<TWeakObjectPtr<AAIController>>& Queue : Queues)
+	{
+		Num += Queue.Num();
+	}
+	return Num;
+}
+
+bool UPath_RequestSubsystem::RequestMoveToActor(AAIController* Controller, AActor* GoalActor, float AcceptanceRadius, EPathRequestPriority Priority,
+	bool bObserveGoal, FOnPathRequestFinished OnFinished, bool bAllowPartialPath)
+{
+	if (!GoalActor)
+	{
+		return false;
+	}
+	return RequestMoveInternal(Controller, GoalActor, GoalActor->GetActorLocation(), AcceptanceRadius, Priority, bObserveGoal, false, bAllowPartialPath, MoveTemp(OnFinished));
+}
+
+bool UPath_RequestSubsystem::RequestMoveToLocation(AAIController* Controller, const FVector& GoalLocation, float AcceptanceRadius, EPathRequestPriority Priority,
+	FOnPathRequestFinished OnFinished, bool bUsePathCache, bool bAllowPartialPath)
+{
+	return RequestMoveInternal(Controller, nullptr, GoalLocation, AcceptanceRadius, Priority, false, bUsePathCache, bAllowPartialPath, MoveTemp(OnFinished));
+}
+
+bool UPath_RequestSubsystem::RequestMoveInternal(AAIController* Controller, AActor* GoalActor, const FVector& GoalLocation, float AcceptanceRadius,
+	EPathRequestPriority Priority, bool bObserveGoal, bool bUsePathCache, bool bAllowPartialPath, FOnPathRequestFinished&& OnFinished)
+{
+	if (!Controller || !Controller->GetPawn())
+	{
+		return false;
+	}
+
+	FRequesterState& State = Requesters.FindOrAdd(Controller);
+
+	// 같은 목표(임계 거리 이내)를 이미 기다리거나 따라가는 중이면 새 쿼리를 만들지 않는다
+	const double Threshold = CVarPathRequestRepathThreshold.GetValueOnGameThread();
+	const bool bSameGoal = State.bHasRequested
+		&& State.bAllowPartialPath == bAllowPartialPath
+		&& State.GoalActor.Get() == GoalActor
+		&& FVector::DistSquared(State.LastRequestedGoal, GoalLocation) < FMath::Square(Threshold);
+	const bool bPending = State.bQueued || State.InFlightQueryId != 0;
+	const bool bBusy = bPending || Controller->GetMoveStatus() != EPathFollowingStatus::Idle;
+	if (bSameGoal && bBusy)
+	{
+		++Counters.Deduped;
+		INC_DWORD_STAT(STAT_PathRequest_Deduped);
+
+		// 새 콜백도 결과를 받아야 한다. 이미 따라가는 중이면 바로 성공을 알리고, 대기 중이면 콜백만 교체한다 (교체된 콜백은 부르지 않는다)
+		if (OnFinished.IsBound())
+		{
+			if (bPending)
+			{
+				State.OnFinished = MoveTemp(OnFinished);
+			}
+			else
+			{
+				OnFinished.Execute(EPathFollowingRequestResult::RequestSuccessful);
+			}
+		}
+		return true;
+	}
+
+	// 이미 도착해 서 있으면 MoveToActor/MoveToLocation처럼 쿼리 없이 AlreadyAtGoal로 끝낸다
+	const UPathFollowingComponent* PathFollowing = Controller->GetPathFollowingComponent();
+	const bool bAtGoal = PathFollowing && (GoalActor
+		? PathFollowing->HasReached(*GoalActor, EPathFollowingReachMode::OverlapAgentAndGoal, AcceptanceRadius)
+		: PathFollowing->HasReached(GoalLocation, EPathFollowingReachMode::OverlapAgent, AcceptanceRadius));
+	if (!bBusy && bAtGoal)
+	{
+		++Counters.Deduped;
+		INC_DWORD_STAT(STAT_PathRequest_Deduped);
+		OnFinished.ExecuteIfBound(EPathFollowingRequestResult::AlreadyAtGoal);
+		return true;
+	}
+
+	State.GoalActor = GoalActor;
+	State.GoalLocation = GoalLocation;
+	State.LastRequestedGoal = GoalLocation;
+	State.AcceptanceRadius = AcceptanceRadius;
+	State.bObserveGoal = bObserveGoal;
+	State.bUsePathCache = bUsePathCache;
+	State.bAllowPartialPath = bAllowPartialPath;
+	State.bHasRequested = true;
+
+	// 이전 요청의 콜백은 부르지 않는다. 실패로 알리면 호출자가 새 요청이 대기 중인데도 이동을 끝난 것으로 본다
+	State.OnFinished = MoveTemp(OnFinished);
+
+	if (State.bQueued)
+	{
+		// 대기열에 있는 요청은 목표만 갱신되고, 더 높은 우선순위면 해당 큐로 옮긴다
+		if (Priority > State.Priority)
+		{
+			Queues[static_cast<int32>(State.Priority)].RemoveSingle(Controller);
+			Queues[static_cast<int32>(Priority)].Add(Controller);
+			State.Priority = Priority;
+		}
+	}
+	else
+	{
+		State.Priority = Priority;
+		State.bQueued = true;
+		State.QueuedTime = FPlatformTime::Seconds();
+		Queues[static_cast<int32>(Priority)].Add(Controller);
+
+		++Counters.Queued;
+		INC_DWORD_STAT(STAT_PathRequest_Queued);
+
+		if (GetNumQueued() > CVarPathRequestMaxQueued.GetValueOnGameThread())
+		{
+			DropLowestPriority();
+		}
+	}
+	return true;
+}
+
+void UPath_RequestSubsystem::CancelRequest(AAIController* Controller)
+{
+	FRequesterState* State = Requesters.Find(Controller);
+	if (!State)
+	{
+		return;
+	}
+
+	if (State->bQueued)
+	{
+		Queues[static_cast<int32>(State->Priority)].RemoveSingle(Controller);
+	}
+	if (State->InFlightQueryId != 0)
+	{
+		// 진행 중인 쿼리는 결과가 도착해도 무시된다
+		InFlight.Remove(State->InFlightQueryId);
+	}
+	Requesters.Remove(Controller);
+}
+
+void UPath_RequestSubsystem::DropLowestPriority()
+{
+	for (TArray<TWeakObjectPtr<AAIController>>& Queue : Queues)
+	{
+		if (Queue.Num() > 0)
+		{
+			const TWeakObjectPtr<AAIController> Dropped = Queue[0];
+			Queue.RemoveAt(0, 1, EAllowShrinking::No);
+
+			++Counters.Dropped;
+			INC_DWORD_STAT(STAT_PathRequest_Dropped);
+
+			if (FRequesterState* State = Requesters.Find(Dropped))
+			{
+				State->bQueued = false;
+				State->bHasRequested = false;
+				FinishRequest(*State, EPathFollowingRequestResult::Failed);
+			}
+			return;
+		}
+	}
+}
+
+void UPath_RequestSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_PathRequest_Dispatch);
+	AISTUDY_BENCHMARK_SCOPE(Pathfinding);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = CVarPathRequestBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double QueryCostSeconds = CVarPathRequestQueryCostMs.GetValueOnGameThread() / 1000.0;
+	// 보낸 비동기 쿼리의 추정 비용. 발송 자체는 싸므로 시간만 재면 예산이 쿼리 수를 제한하지 못한다
+	double QueryCostSecondsSpent = 0.0;
+	const int32 MaxInFlight = CVarPathRequestMaxInFlight.GetValueOnGameThread();
+
+	// 기록/재생 중에는 처리량이 벽시계에 좌우되지 않도록 요청 수로 자른다
+	const bool bDeterministic = UReplay_AISubsystem::IsDeterministic(GetWorld());
+	const int32 MaxDeterministic = FMath::Max(CVarPathRequestDeterministicPerFrame.GetValueOnGameThread(), 1);
+	int32 NumDispatched = 0;
+
+	// 높은 우선순위부터, 예산과 동시 진행 수 한도 안에서 발송
+	bool bBudgetLeft = true;
+	bool bDispatchedAny = false;
+	for (int32 PriorityIndex = static_cast<int32>(EPathRequestPriority::MAX) - 1; PriorityIndex >= 0 && bBudgetLeft; --PriorityIndex)
+	{
+		TArray<TWeakObjectPtr<AAIController>>& Queue = Queues[PriorityIndex];
+		while (Queue.Num() > 0 && InFlight.Num() < MaxInFlight)
+		{
+			const double SpentSeconds = FPlatformTime::Seconds() - StartTime + QueryCostSecondsSpent;
+			if (bDeterministic ? NumDispatched >= MaxDeterministic : SpentSeconds > BudgetSeconds)
+			{
+				bBudgetLeft = false;
+				break;
+			}
+
+			// 발송 중 콜백이 큐를 건드릴 수 있으므로 먼저 꺼낸다
+			const TWeakObjectPtr<AAIController> Requester = Queue[0];
+			Queue.RemoveAt(0, 1, EAllowShrinking::No);
+
+			// 이번 프레임 첫 요청은 남은 예산과 상관없이 계층 탐색을 허용해 비싼 요청이 계속 밀리지 않게 한다
+			const double RemainingSeconds = bDispatchedAny && !bDeterministic ? BudgetSeconds - SpentSeconds : UE_DOUBLE_BIG_NUMBER;
+			const EDispatchResult Result = DispatchRequest(Requester, RemainingSeconds, bDeterministic);
+			++NumDispatched;
+			if (Result == EDispatchResult::Deferred)
+			{
+				// 우선순위 순서를 지키도록 맨 앞에 되돌리고 이번 프레임 발송을 끝낸다
+				Queue.Insert(Requester, 0);
+				bBudgetLeft = false;
+				break;
+			}
+			if (Result == EDispatchResult::QuerySent)
+			{
+				QueryCostSecondsSpent += QueryCostSeconds;
+			}
+			bDispatchedAny = true;
+		}
+	}
+
+	// 파괴된 컨트롤러의 상태를 주기적으로 정리
+	const double Now = FPlatformTime::Seconds();
+	if (Now >= NextCleanupTime)
+	{
+		NextCleanupTime = Now + 5.0;
+		for (auto It = Requesters.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid() && !It.Value().bQueued && It.Value().InFlightQueryId == 0)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_PathRequest_Pending, GetNumQueued());
+	SET_DWORD_STAT(STAT_PathRequest_InFlight, InFlight.Num());
+	SET_FLOAT_STAT(STAT_PathRequest_AvgLatency, static_cast<float>(Counters.GetAverageLatencyMs()));
+}
+
+UPath_RequestSubsystem::EDispatchResult UPath_RequestSubsystem::DispatchRequest(const TWeakObjectPtr<AAIController>& Requester, double RemainingSeconds, bool bSynchronous)
+{
+	FRequesterState* State = Requesters.Find(Requester);
+	if (!State)
+	{
+		return EDispatchResult::Completed;
+	}
+	State->bQueued = false;
+
+	AAIController* Controller = Requester.Get();
+	APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!Pawn || !NavSys)
+	{
+		++Counters.Dropped;
+		INC_DWORD_STAT(STAT_PathRequest_Dropped);
+		FinishRequest(*State, EPathFollowingRequestResult::Failed);
+		return EDispatchResult::Completed;
+	}
+
+	// 액터 목표는 발송 시점의 위치를 사용
+	if (const AActor* GoalActor = State->GoalActor.Get())
+	{
+		State->GoalLocation = GoalActor->GetActorLocation();
+	}
+
+	const FNavAgentProperties& AgentProps = Controller->GetNavAgentPropertiesRef();
+	const FVector StartLocation = Controller->GetNavAgentLocation();
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProps, StartLocation);
+	if (!NavData)
+	{
+		++Counters.Dropped;
+		INC_DWORD_STAT(STAT_PathRequest_Dropped);
+		FinishRequest(*State, EPathFollowingRequestResult::Failed);
+		return EDispatchResult::Completed;
+	}
+
+	const TSubclassOf<UNavigationQueryFilter> FilterClass = Controller->GetDefaultNavigationFilterClass();
+
+	// 캐시에 같은 구간의 경로가 있으면 쿼리 없이 바로 이동
+	if (State->bUsePathCache)
+	{
+		if (UPath_CacheSubsystem* PathCache = GetWorld()->GetSubsystem<UPath_CacheSubsystem>())
+		{
+			if (FNavPathSharedPtr CachedPath = PathCache->FindPath(*NavData, StartLocation, State->GoalLocation, FilterClass))
+			{
+				++Counters.Served;
+				INC_DWORD_STAT(STAT_PathRequest_Served);
+				Counters.TotalLatencySeconds += FPlatformTime::Seconds() - State->QueuedTime;
+				StartMove(Controller, *State, CachedPath);
+				return EDispatchResult::Completed;
+			}
+		}
+	}
+
+	State->QueryNavData = NavData;
+	State->QueryFilterClass = FilterClass;
+	State->QueryStart = StartLocation;
+
+	// 먼 요청은 계층 그래프에서 포털 순서를 먼저 찾고 통로만 다시 탐색한다. 실패하면 아래 일반 비동기 탐색으로 넘어간다.
+	UNav_HierarchicalSubsystem* Hierarchical = UNav_HierarchicalSubsystem::WantsHierarchical(FilterClass) ? GetWorld()->GetSubsystem<UNav_HierarchicalSubsystem>() : nullptr;
+	if (Hierarchical && Hierarchical->ShouldUseHierarchical(*NavData, StartLocation, State->GoalLocation))
+	{
+		// 계층 탐색은 여러 번의 A*를 게임 스레드에서 바로 돌리므로 평균 비용만큼 예산이 남아 있어야 한다
+		if (Hierarchical->GetAverageQuerySeconds() > RemainingSeconds)
+		{
+			State->bQueued = true;
+			return EDispatchResult::Deferred;
+		}
+
+		FNavPathSharedPtr Path = Hierarchical->FindPath(*NavData, StartLocation, State->GoalLocation,
+			UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, FilterClass), Controller);
+		if (Path.IsValid())
+		{
+			++Counters.Served;
+			INC_DWORD_STAT(STAT_PathRequest_Served);
+			Counters.TotalLatencySeconds += FPlatformTime::Seconds() - State->QueuedTime;
+			if (State->bUsePathCache)
+			{
+				if (UPath_CacheSubsystem* PathCache = GetWorld()->GetSubsystem<UPath_CacheSubsystem>())
+				{
+					PathCache->AddPath(*NavData, StartLocation, State->GoalLocation, FilterClass, Path);
+				}
+			}
+			StartMove(Controller, *State, Path);
+			return EDispatchResult::Completed;
+		}
+	}
+
+	FPathFindingQuery Query(Controller, *NavData, StartLocation, State->GoalLocation,
+		UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, FilterClass));
+	Query.SetAllowPartialPaths(State->bAllowPartialPath);
+
+	// 이전 쿼리가 아직 진행 중이면 그 결과는 버려진다
+	if (State->InFlightQueryId != 0)
+	{
+		InFlight.Remove(State->InFlightQueryId);
+		State->InFlightQueryId = 0;
+	}
+
+	// 동기 탐색은 결과를 워커 완료 시점이 아니라 발송한 이 자리에서 바로 쓴다
+	if (bSynchronous)
+	{
+		const FPathFindingResult PathResult = NavSys->FindPathSync(AgentProps, Query, EPathFindingMode::Regular);
+		CompletePath(Requester, *State, PathResult.Result, PathResult.Path);
+		return EDispatchResult::Completed;
+	}
+
+	const uint32 QueryId = NavSys->FindPathAsync(AgentProps, Query,
+		FNavPathQueryDelegate::CreateUObject(this, &UPath_RequestSubsystem::OnPathFound), EPathFindingMode::Regular);
+	if (QueryId == INVALID_NAVQUERYID)
+	{
+		++Counters.Dropped;
+		INC_DWORD_STAT(STAT_PathRequest_Dropped);
+		FinishRequest(*State, EPathFollowingRequestResult::Failed);
+		return EDispatchResult::Completed;
+	}
+
+	State->InFlightQueryId = QueryId;
+	InFlight.Add(QueryId, Requester);
+	return EDispatchResult::QuerySent;
+}
+
+void UPath_RequestSubsystem::OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_PathRequest_Complete);
+
+	TWeakObjectPtr<AAIController> Requester;
+	if (!InFlight.RemoveAndCopyValue(QueryId, Requester))
+	{
+		// 취소되었거나 새 요청으로 대체된 쿼리
+		return;
+	}
+
+	FRequesterState* State = Requesters.Find(Requester);
+	if (!State || State->InFlightQueryId != QueryId)
+	{
+		return;
+	}
+	State->InFlightQueryId = 0;
+	CompletePath(Requester, *State, Result, Path);
+}
+
+void UPath_RequestSubsystem::CompletePath(const TWeakObjectPtr<AAIController>& Requester, FRequesterState& State, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	++Counters.Served;
+	INC_DWORD_STAT(STAT_PathRequest_Served);
+	Counters.TotalLatencySeconds += FPlatformTime::Seconds() - State.QueuedTime;
+
+	AAIController* Controller = Requester.Get();
+	if (!Controller || Result != ENavigationQueryResult::Success || !Path.IsValid())
+	{
+		FinishRequest(State, EPathFollowingRequestResult::Failed);
+		return;
+	}
+
+	if (State.bUsePathCache)
+	{
+		UPath_CacheSubsystem* PathCache = GetWorld()->GetSubsystem<UPath_CacheSubsystem>();
+		const ANavigationData* NavData = State.QueryNavData.Get();
+		if (PathCache && NavData)
+		{
+			PathCache->AddPath(*NavData, State.QueryStart, State.GoalLocation, State.QueryFilterClass, Path);
+		}
+	}
+
+	StartMove(Controller, State, Path);
+}
+
+void UPath_RequestSubsystem::StartMove(AAIController* Controller, FRequesterState& State, FNavPathSharedPtr Path)
+{
+	// MoveToLocation/MoveToActor와 같은 도착 판정 옵션으로 경로 추종 시작
+	FAIMoveRequest MoveRequest;
+	MoveRequest.SetAcceptanceRadius(State.AcceptanceRadius);
+	MoveRequest.SetReachTestIncludesAgentRadius(true);
+	MoveRequest.SetUsePathfinding(true);
+	MoveRequest.SetAllowPartialPath(State.bAllowPartialPath);
+
+	AActor* GoalActor = State.GoalActor.Get();
+	if (State.bObserveGoal && GoalActor)
+	{
+		MoveRequest.SetGoalActor(GoalActor);
+		Path->SetGoalActorObservation(*GoalActor, CVarPathRequestRepathThreshold.GetValueOnGameThread());
+	}
+	else
+	{
+		MoveRequest.SetGoalLocation(State.GoalLocation);
+	}
+
+	const FAIRequestID RequestId = Controller->RequestMove(MoveRequest, Path);
+	FinishRequest(State, RequestId.IsValid() ? EPathFollowingRequestResult::RequestSuccessful : EPathFollowingRequestResult::Failed);
+}
+
+void UPath_RequestSubsystem::FinishRequest(FRequesterState& State, EPathFollowingRequestResult::Type Result)
+{
+	// 콜백 안에서 새 요청이 들어와 State가 바뀔 수 있으므로 먼저 꺼낸다
+	if (Result == EPathFollowingRequestResult::Failed)
+	{
+		AISTUDY_INC_COUNTER(FailedMoves);
+	}
+
+	FOnPathRequestFinished OnFinished = MoveTemp(State.OnFinished);
+	State.OnFinished.Unbind();
+	OnFinished.ExecuteIfBound(Result);
+}
@@ -0,0 +1,360 @@
+#include "Perception_BatchedSightSubsystem.h"
+#include "AIStudy.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "Benchmark_Metrics.h"
+#include "Chaser_AIController.h"
+#include "Replay_AISubsystem.h"
+#include "Spatial_HashSubsystem.h"
+#include "Perception/AISense_Sight.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched Sight Tick"), STAT_BatchedSight_Tick, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Batched Sight Gather"), STAT_BatchedSight_Gather, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Batched Sight Dispatch"), STAT_BatchedSight_Dispatch, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sight Traces"), STAT_BatchedSight_Traces, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sight Budget Overrun"), STAT_BatchedSight_Overrun, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sight Candidates"), STAT_BatchedSight_Candidates, STATGROUP_AIStudy);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sight Max Detection Latency (ms)"), STAT_BatchedSight_Latency, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<int32> CVarSightTraceBudget(
+	TEXT("AIStudy.Sight.TraceBudget"),
+	128,
+	TEXT("프레임당 보내는 시야 트레이스 최대 수. 넘치는 쌍은 다음 프레임으로 미룬다."));
+
+static TAutoConsoleVariable<float> CVarSightMinRecheckInterval(
+	TEXT("AIStudy.Sight.MinRecheckInterval"),
+	0.2f,
+	TEXT("같은 관찰자-대상 쌍을 다시 트레이스하기 전 최소 간격(초)."));
+
+namespace BatchedSight
+{
+	// 아주 가까운 쌍의 점수가 무한대로 커지지 않도록 하는 최소 거리
+	static constexpr float MinScoreDistance = 100.0f;
+	// 한 번도 확인하지 않은 쌍이 받는 경과 시간
+	static constexpr double FirstCheckAge = 1.0;
+}
+
+bool UPerception_BatchedSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPerception_BatchedSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPerception_BatchedSightSubsystem, STATGROUP_Tickables);
+}
+
+void UPerception_BatchedSightSubsystem::RegisterObserver(AChaser_AIController* Observer)
+{
+	if (!Observer || Observer->SightIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	FSightObserver& Entry = Observers.AddDefaulted_GetRef();
+	Entry.Controller = Observer;
+	Observer->SightIndex = Observers.Num() - 1;
+}
+
+void UPerception_BatchedSightSubsystem::UnregisterObserver(AChaser_AIController* Observer)
+{
+	if (!Observer || !Observers.IsValidIndex(Observer->SightIndex) || Observers[Observer->SightIndex].Controller != Observer)
+	{
+		return;
+	}
+
+	const int32 Index = Observer->SightIndex;
+	Observer->SightIndex = INDEX_NONE;
+
+	// 마지막 원소를 빈 자리로 옮겨 배열을 연속으로 유지 (진행 중인 트레이스 결과는 컨트롤러로 다시 찾는다)
+	Observers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Observers.IsValidIndex(Index))
+	{
+		if (AChaser_AIController* Moved = Observers[Index].Controller.Get())
+		{
+			Moved->SightIndex = Index;
+		}
+	}
+}
+
+void UPerception_BatchedSightSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_BatchedSight_Tick);
+	AISTUDY_BENCHMARK_SCOPE(Perception);
+
+	// 지난 프레임 트레이스 결과는 월드 틱 초반에 OnTraceCompleted로 이미 도착해 있다
+	DispatchEvents();
+	SET_FLOAT_STAT(STAT_BatchedSight_Latency, FrameMaxLatency * 1000.0);
+	FrameMaxLatency = 0.0;
+
+	TArray<FSightCandidate> Candidates;
+	GatherCandidates(GetWorld()->GetTimeSeconds(), Candidates);
+	IssueTraces(Candidates);
+
+	// 시야각 밖으로 나가 바로 판정된 이벤트
+	DispatchEvents();
+}
+
+void UPerception_BatchedSightSubsystem::GatherCandidates(double Now, TArray<FSightCandidate>& OutCandidates)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_BatchedSight_Gather);
+
+	const USpatial_HashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatial_HashSubsystem>();
+	const UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>();
+	if (!SpatialHash)
+	{
+		return;
+	}
+
+	const double MinRecheckInterval = CVarSightMinRecheckInterval.GetValueOnGameThread();
+	TArray<APawn*> Nearby;
+
+	for (int32 ObserverIndex = 0; ObserverIndex < Observers.Num(); ++ObserverIndex)
+	{
+		FSightObserver& Observer = Observers[ObserverIndex];
+		const AChaser_AIController* Controller = Observer.Controller.Get();
+		const APawn* ObserverPawn = Controller ? Controller->GetPawn() : nullptr;
+		if (!ObserverPawn || (Significance && Significance->IsDormant(ObserverPawn)))
+		{
+			continue;
+		}
+
+		// 엔진 시야 감각과 같은 설정을 쓴다
+		const UAISenseConfig_Sight* SightConfig = Controller->SightConfig;
+		const float SightRadius = SightConfig ? SightConfig->SightRadius : Controller->DetectionRadius;
+		const float LoseSightRadius = SightConfig ? SightConfig->LoseSightRadius : Controller->LoseInterestRadius;
+		const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(SightConfig ? SightConfig->PeripheralVisionAngleDegrees : 90.0f));
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		ObserverPawn->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+		const FVector Forward = EyeRotation.Vector();
+
+		SpatialHash->QueryPawnsInRadius(EyeLocation, LoseSightRadius, Nearby, true);
+		const uint64 Frame = GFrameCounter;
+
+		for (APawn* Target : Nearby)
+		{
+			if (Target == ObserverPawn)
+			{
+				continue;
+			}
+
+			FSightPair& Pair = Observer.Pairs.FindOrAdd(Target);
+			Pair.Target = Target;
+			Pair.LastGatherFrame = Frame;
+
+			// 보이는 중에는 LoseSightRadius, 아니면 SightRadius로 거리/시야각 검사
+			const FVector ToTarget = Target->GetActorLocation() - EyeLocation;
+			const float Distance = ToTarget.Size();
+			const float Radius = Pair.bVisible ? LoseSightRadius : SightRadius;
+			const bool bInCone = Distance <= Radius && (Distance <= UE_KINDA_SMALL_NUMBER || (ToTarget / Distance | Forward) >= CosHalfAngle);
+
+			if (!bInCone)
+			{
+				// 트레이스 없이 바로 시야에서 사라짐
+				if (Pair.bVisible)
+				{
+					Pair.bVisible = false;
+					PendingEvents.Add({ Observer.Controller, Target, EyeLocation, Target->GetActorLocation(), false });
+				}
+				Pair.CandidateSince = -1.0;
+				continue;
+			}
+
+			if (!Pair.bVisible && Pair.CandidateSince < 0.0)
+			{
+				Pair.CandidateSince = Now;
+			}
+			if (Pair.bTraceInFlight || Now - Pair.LastCheckTime < MinRecheckInterval)
+			{
+				continue;
+			}
+
+			// 가까울수록, 오래 확인하지 않았을수록 먼저
+			const double Age = Pair.LastCheckTime < 0.0 ? BatchedSight::FirstCheckAge : Now - Pair.LastCheckTime;
+			const float Score = static_cast<float>(Age) * SightRadius / FMath::Max(Distance, BatchedSight::MinScoreDistance);
+			OutCandidates.Add({ ObserverIndex, Target, Target, EyeLocation, Score });
+		}
+
+		// 범위 밖으로 나갔거나 사라진 대상 정리
+		for (auto It = Observer.Pairs.CreateIterator(); It; ++It)
+		{
+			FSightPair& Pair = It.Value();
+			if (Pair.LastGatherFrame == Frame || Pair.bTraceInFlight)
+			{
+				continue;
+			}
+			if (Pair.bVisible)
+			{
+				AActor* Target = Pair.Target.Get();
+				PendingEvents.Add({ Observer.Controller, Target, EyeLocation, Target ? Target->GetActorLocation() : EyeLocation, false });
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UPerception_BatchedSightSubsystem::IssueTraces(TArray<FSightCandidate>& Candidates)
+{
+	const int32 Budget = FMath::Max(CVarSightTraceBudget.GetValueOnGameThread(), 0);
+	const int32 NumTraces = FMath::Min(Candidates.Num(), Budget);
+	const int32 NumOverrun = Candidates.Num() - NumTraces;
+
+	SET_DWORD_STAT(STAT_BatchedSight_Candidates, Candidates.Num());
+	SET_DWORD_STAT(STAT_BatchedSight_Traces, NumTraces);
+	SET_DWORD_STAT(STAT_BatchedSight_Overrun, NumOverrun);
+	Stats.NumTraces += NumTraces;
+	Stats.NumOverruns += NumOverrun;
+
+	if (NumTraces == 0)
+	{
+		return;
+	}
+
+	// 예산을 넘으면 점수 순으로 앞쪽만 보낸다
+	if (NumOverrun > 0)
+	{
+		Candidates.Sort([](const FSightCandidate& A, const FSightCandidate& B) { return A.Score > B.Score; });
+	}
+
+	if (!TraceDelegate.IsBound())
+	{
+		TraceDelegate.BindUObject(this, &UPerception_BatchedSightSubsystem::OnTraceCompleted);
+	}
+
+	// AI 기록/재생 중에는 결과가 도착하는 프레임이 흔들리지 않도록 바로 트레이스한다
+	UWorld* World = GetWorld();
+	const bool bSynchronous = UReplay_AISubsystem::IsDeterministic(World);
+	for (int32 Index = 0; Index < NumTraces; ++Index)
+	{
+		const FSightCandidate& Candidate = Candidates[Index];
+		FSightObserver& Observer = Observers[Candidate.ObserverIndex];
+		FSightPair& Pair = Observer.Pairs.FindChecked(Candidate.TargetKey);
+
+		// 관찰자와 대상은 무시하므로 무엇이든 막으면 보이지 않는 것
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BatchedSight), false, Observer.Controller->GetPawn());
+		QueryParams.AddIgnoredActor(Candidate.Target);
+
+		const FVector TargetLocation = Candidate.Target->GetActorLocation();
+		Pair.bTraceInFlight = true;
+		if (bSynchronous)
+		{
+			const bool bBlocked = World->LineTraceTestByChannel(Candidate.EyeLocation, TargetLocation, ECC_Visibility, QueryParams);
+			HandleTraceResult({ Observer.Controller, Candidate.TargetKey, Candidate.EyeLocation, TargetLocation }, !bBlocked);
+			continue;
+		}
+
+		const uint32 TraceId = NextTraceId++;
+		InFlight.Add(TraceId, { Observer.Controller, Candidate.TargetKey, Candidate.EyeLocation, TargetLocation });
+
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Candidate.EyeLocation, TargetLocation, ECC_Visibility,
+			QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+	}
+}
+
+void UPerception_BatchedSightSubsystem::OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FInFlightTrace Trace;
+	if (InFlight.RemoveAndCopyValue(Datum.UserData, Trace))
+	{
+		HandleTraceResult(Trace, !Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; }));
+	}
+}
+
+void UPerception_BatchedSightSubsystem::HandleTraceResult(const FInFlightTrace& Trace, bool bVisible)
+{
+	// 기다리는 동안 등록 해제된 관찰자는 버린다
+	AChaser_AIController* Controller = Trace.Controller.Get();
+	if (!Controller || !Observers.IsValidIndex(Controller->SightIndex))
+	{
+		return;
+	}
+
+	FSightPair* Pair = Observers[Controller->SightIndex].Pairs.Find(Trace.TargetKey);
+	if (!Pair)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	Pair->bTraceInFlight = false;
+	Pair->LastCheckTime = Now;
+
+	if (bVisible == Pair->bVisible)
+	{
+		return;
+	}
+
+	Pair->bVisible = bVisible;
+	if (bVisible && Pair->CandidateSince >= 0.0)
+	{
+		// 시야각에 들어온 뒤 실제로 감지되기까지 걸린 시간
+		const double Latency = Now - Pair->CandidateSince;
+		Stats.NumDetections++;
+		Stats.TotalLatency += Latency;
+		Stats.MaxLatency = FMath::Max(Stats.MaxLatency, Latency);
+		FrameMaxLatency = FMath::Max(FrameMaxLatency, Latency);
+		Pair->CandidateSince = -1.0;
+	}
+
+	PendingEvents.Add({ Trace.Controller, Pair->Target, Trace.EyeLocation, Trace.TargetLocation, bVisible });
+}
+
+void UPerception_BatchedSightSubsystem::DispatchEvents()
+{
+	if (PendingEvents.Num() == 0)
+	{
+		return;
+	}
+
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_BatchedSight_Dispatch);
+
+	// 콜백에서 새 이벤트가 쌓여도 안전하도록 복사본을 돌린다
+	TArray<FSightEvent> Events = MoveTemp(PendingEvents);
+	PendingEvents.Reset();
+
+	const UAISense& SightSense = *GetDefault<UAISense_Sight>();
+	for (const FSightEvent& Event : Events)
+	{
+		AChaser_AIController* Controller = Event.Controller.Get();
+		AActor* Target = Event.Target.Get();
+		if (!Controller || !Target)
+		{
+			continue;
+		}
+
+		const FAIStimulus Stimulus(SightSense, 1.0f, Event.TargetLocation, Event.EyeLocation,
+			Event.bSensed ? FAIStimulus::SensingSucceeded : FAIStimulus::SensingFailed);
+
+		// 인지 컴포넌트가 있으면 엔진 시야와 같은 델리게이트로 전달
+		UAIPerceptionComponent* Perception = Controller->GetPerceptionComponent();
+		if (Perception && Perception->OnTargetPerceptionUpdated.IsBound())
+		{
+			Perception->OnTargetPerceptionUpdated.Broadcast(Target, Stimulus);
+		}
+		else
+		{
+			Controller->OnPerceptionUpdated(Target, Stimulus);
+		}
+	}
+}
+
+void UPerception_BatchedSightSubsystem::LogReport() const
+{
+	const double AverageLatency = Stats.NumDetections > 0 ? Stats.TotalLatency / Stats.NumDetections : 0.0;
+	UE_LOG(LogAIStudy, Display, TEXT("Batched sight: %d observers, %llu traces, %llu deferred by budget, %llu detections, latency avg %.1f ms / max %.1f ms, %d traces in flight"),
+		Observers.Num(), Stats.NumTraces, Stats.NumOverruns, Stats.NumDetections, AverageLatency * 1000.0, Stats.MaxLatency * 1000.0, InFlight.Num());
+}
+
+static FAutoConsoleCommandWithWorld BatchedSightReportCommand(
+	TEXT("AIStudy.Sight.Report"),
+	TEXT("일괄 시야 판정의 누적 트레이스 수, 예산 초과로 미뤄진 쌍 수, 감지 지연을 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UPerception_BatchedSightSubsystem* Sight = World ? World->GetSubsystem<UPerception_BatchedSightSubsystem>() : nullptr)
+		{
+			Sight->LogReport();
+		}
+	}));
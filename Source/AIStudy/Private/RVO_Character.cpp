@@ -1,9 +1,22 @@
 #include "RVO_Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
+#include "Path_RequestSubsystem.h"
+#include "FlowField_FollowerComponent.h"
+#include "RVO_SquadSubsystem.h"
+#include "Agent_MovementComponent.h"
+#include "Agent_BudgetedMeshComponent.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "AIStudy.h"
+#include "Net/UnrealNetwork.h"
+
+DECLARE_CYCLE_STAT(TEXT("RVO Character MoveToTarget"), STAT_RVOCharacter_MoveToTarget, STATGROUP_AIStudy);
 
 // Sets default values
-ARVO_Character::ARVO_Character()
+ARVO_Character::ARVO_Character(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UAgent_MovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<UAgent_BudgetedMeshComponent>(ACharacter::MeshComponentName))
 {
 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -16,6 +29,9 @@ ARVO_Character::ARVO_Character()
 		MovementComponent->AvoidanceConsiderationRadius = AvoidanceRadius;
 		MovementComponent->AvoidanceWeight = 0.5f;
 	}
+
+	// 흐름장 이동 컴포넌트 (bUseFlowField일 때만 사용)
+	FlowFieldFollower = CreateDefaultSubobject<UFlowField_FollowerComponent>(TEXT("FlowFieldFollower"));
 }
 
 // Called when the game starts or when spawned
@@ -23,9 +39,46 @@ void ARVO_Character::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// ORCA를 쓰도록 설정되어 있으면 시작할 때 회피 방식을 전환
+	if (bUseORCAAvoidance)
+	{
+		SetRVOAvoidanceEnabled(GetCharacterMovement()->bUseRVOAvoidance);
+	}
+
+	StartAgent();
+}
+
+void ARVO_Character::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (URVO_SquadSubsystem* Squads = GetWorld()->GetSubsystem<URVO_SquadSubsystem>())
+	{
+		Squads->RemoveMember(this);
+	}
+	if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+	{
+		Significance->UnregisterAgent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARVO_Character::StartAgent()
+{
+	// 관찰자와의 거리에 따라 틱 간격을 조절하도록 LOD 대상으로 등록
+	if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+	{
+		Significance->RegisterAgent(this);
+	}
+
 	// AI 컨트롤러 참조 얻기
 	AIController = Cast<AAIController>(GetController());
 
+	// 분대원이면 아래 MoveToTarget에서 경로를 찾지 않고 리더 경로를 따른다
+	if (!SquadName.IsNone())
+	{
+		JoinSquad(SquadName);
+	}
+
 	// AI 컨트롤러가 없으면 로그 출력
 	if (!AIController)
 	{
@@ -38,6 +91,50 @@ void ARVO_Character::BeginPlay()
 	}
 }
 
+void ARVO_Character::OnPoolAcquired()
+{
+	// 풀이 회피를 클래스 기본값으로 되돌려 두었으므로 Configure에서 바뀐 설정대로 방식만 다시 고른다
+	SetRVOAvoidanceEnabled(GetCharacterMovement()->bUseRVOAvoidance);
+	StartAgent();
+}
+
+void ARVO_Character::OnPoolReleased()
+{
+	if (AIController)
+	{
+		if (UPath_RequestSubsystem* PathRequests = GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+		{
+			PathRequests->CancelRequest(AIController);
+		}
+		AIController->StopMovement();
+	}
+	if (FlowFieldFollower)
+	{
+		FlowFieldFollower->ClearGoal();
+	}
+
+	// ORCA 서브시스템 등록도 여기서 풀린다
+	SetRVOAvoidanceEnabled(false);
+
+	if (URVO_SquadSubsystem* Squads = GetWorld()->GetSubsystem<URVO_SquadSubsystem>())
+	{
+		Squads->RemoveMember(this);
+	}
+
+	if (UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>())
+	{
+		Significance->UnregisterAgent(this);
+	}
+
+	// 클래스 기본값으로 되돌린다
+	const ARVO_Character* Defaults = GetClass()->GetDefaultObject<ARVO_Character>();
+	TargetActor = Defaults->TargetActor;
+	bUseFlowField = Defaults->bUseFlowField;
+	bUseORCAAvoidance = Defaults->bUseORCAAvoidance;
+	bUsePathRequestScheduler = Defaults->bUsePathRequestScheduler;
+	SquadName = Defaults->SquadName;
+}
+
 // Called every frame
 void ARVO_Character::Tick(float DeltaTime)
 {
@@ -52,6 +149,8 @@ void ARVO_Character::SetupPlayerInputComponent(UInputComponent* PlayerInputCompo
 
 void ARVO_Character::MoveToTarget()
 {
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_RVOCharacter_MoveToTarget);
+
 	if (!AIController)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("MoveToTarget failed: No AI Controller for %s"), *GetName());
@@ -64,24 +163,117 @@ void ARVO_Character::MoveToTarget()
 		return;
 	}
 
-	// 타겟 액터를 향해 이동
-	AIController->MoveToActor(
-		TargetActor,    // 목표 액터
-		50.0f,          // 도착 판정 반경
-		true,           // 충돌 영역이 겹치면 도착으로 간주
-		true,           // 경로 탐색 사용
-		false           // 목적지를 네비게이션 메시에 투영(Projection)하지 않음
-	);
+	// 흐름장 모드에서는 경로 탐색 없이 공유 흐름장을 따라간다
+	if (bUseFlowField && FlowFieldFollower)
+	{
+		FlowFieldFollower->SetGoal(TargetActor, 50.0f);
+		UE_LOG(LogTemp, Display, TEXT("%s following flow field to target: %s"),
+			*GetName(), *TargetActor->GetName());
+		return;
+	}
+
+	// 분대원은 리더 경로 위 슬롯을 따라가므로 경로를 찾지 않는다 (리더와 막혀서 혼자 가는 분대원만 찾는다)
+	const URVO_SquadSubsystem* Squads = SquadName.IsNone() ? nullptr : GetWorld()->GetSubsystem<URVO_SquadSubsystem>();
+	if (Squads && Squads->IsFollowingSquad(this))
+	{
+		return;
+	}
+
+	AISTUDY_INC_COUNTER(MoveToCalls);
+
+	// 스케줄러를 쓰면 MoveToActor처럼 목표 이동을 따라가는 경로를 비동기로 요청
+	UPath_RequestSubsystem* PathRequests = bUsePathRequestScheduler ? GetWorld()->GetSubsystem<UPath_RequestSubsystem>() : nullptr;
+	if (PathRequests)
+	{
+		PathRequests->RequestMoveToActor(AIController, TargetActor, 50.0f, EPathRequestPriority::Normal, true);
+	}
+	else
+	{
+		// 타겟 액터를 향해 이동
+		AIController->MoveToActor(
+			TargetActor,    // 목표 액터
+			50.0f,          // 도착 판정 반경
+			true,           // 충돌 영역이 겹치면 도착으로 간주
+			true,           // 경로 탐색 사용
+			false           // 목적지를 네비게이션 메시에 투영(Projection)하지 않음
+		);
+	}
 
 	UE_LOG(LogTemp, Display, TEXT("%s moving to target: %s"),
 		*GetName(), *TargetActor->GetName());
 }
 
+void ARVO_Character::JoinSquad(FName InSquadName)
+{
+	if (InSquadName.IsNone())
+	{
+		LeaveSquad();
+		return;
+	}
+
+	URVO_SquadSubsystem* Squads = GetWorld()->GetSubsystem<URVO_SquadSubsystem>();
+	SquadName = Squads && Squads->AddMember(this, InSquadName) ? InSquadName : NAME_None;
+}
+
+void ARVO_Character::LeaveSquad()
+{
+	if (SquadName.IsNone())
+	{
+		return;
+	}
+
+	URVO_SquadSubsystem* Squads = GetWorld()->GetSubsystem<URVO_SquadSubsystem>();
+	const bool bWasFollowing = Squads && Squads->IsFollowingSquad(this);
+	if (Squads)
+	{
+		Squads->RemoveMember(this);
+	}
+	SquadName = NAME_None;
+
+	// 대형만 따라가던 중이었으면 이제 혼자 경로를 찾는다
+	if (bWasFollowing && AIController && TargetActor)
+	{
+		MoveToTarget();
+	}
+}
+
 void ARVO_Character::SetRVOAvoidanceEnabled(bool bEnable)
 {
 	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
 	if (MovementComponent)
 	{
+		// 에이전트 이동 컴포넌트면 엔진 RVO와 ORCA 중 하나만 켠다
+		if (UAgent_MovementComponent* AgentMovement = Cast<UAgent_MovementComponent>(MovementComponent))
+		{
+			if (bEnable && bUseORCAAvoidance)
+			{
+				AgentMovement->SetAvoidanceMode(EAgentAvoidanceMode::ORCA);
+				return;
+			}
+			AgentMovement->SetAvoidanceMode(EAgentAvoidanceMode::Engine);
+			AgentMovement->SetAvoidanceEnabled(bEnable);
+			return;
+		}
 		MovementComponent->bUseRVOAvoidance = bEnable;
 	}
-}
\ No newline at end of file
+}
+
+void ARVO_Character::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	NetAIMovement::DisableDefaultMovementReplication(StaticClass(), OutLifetimeProps);
+	DOREPLIFETIME_CONDITION(ARVO_Character, AIMovement, COND_SimulatedOnly);
+}
+
+void ARVO_Character::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	AIMovement = NetAIMovement::Capture(*this);
+}
+
+void ARVO_Character::OnRep_AIMovement()
+{
+	NetAIMovement::Apply(*this, AIMovement);
+}
@@ -0,0 +1,485 @@
+#include "RVO_ORCASubsystem.h"
+#include "AIStudy.h"
+#include "Benchmark_Metrics.h"
+#include "Agent_MovementComponent.h"
+#include "Spatial_HashGrid.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("ORCA Tick"), STAT_ORCA_Tick, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("ORCA Gather"), STAT_ORCA_Gather, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("ORCA Solve"), STAT_ORCA_Solve, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("ORCA Apply"), STAT_ORCA_Apply, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ORCA Agents"), STAT_ORCA_NumAgents, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ORCA Constrained Agents"), STAT_ORCA_NumConstrained, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarORCATimeHorizon(
+	TEXT("AIStudy.ORCA.TimeHorizon"),
+	1.5f,
+	TEXT("다른 에이전트와의 충돌을 고려하는 시간(초). 길수록 일찍 피하지만 움직임이 보수적이 된다."));
+
+static TAutoConsoleVariable<int32> CVarORCAMaxNeighbors(
+	TEXT("AIStudy.ORCA.MaxNeighbors"),
+	10,
+	TEXT("에이전트마다 고려할 최대 이웃 수."));
+
+static TAutoConsoleVariable<float> CVarORCACellSize(
+	TEXT("AIStudy.ORCA.CellSize"),
+	300.0f,
+	TEXT("이웃 탐색용 공간 해시 셀 크기."));
+
+static TAutoConsoleVariable<bool> CVarORCAParallel(
+	TEXT("AIStudy.ORCA.Parallel"),
+	true,
+	TEXT("ORCA 풀이를 ParallelFor로 나눠 실행한다."));
+
+namespace ORCA
+{
+	static constexpr float Epsilon = 0.00001f;
+
+	// 반평면 경계선. Direction의 왼쪽이 허용 영역.
+	struct FLine
+	{
+		FVector2f Point;
+		FVector2f Direction;
+	};
+
+	using FLineArray = TArray<FLine, TInlineAllocator<16>>;
+
+	static float Det(const FVector2f& A, const FVector2f& B)
+	{
+		return A.X * B.Y - A.Y * B.X;
+	}
+
+	// 원(Radius) 안에서 LineIndex 선 위의 최적점을 찾는다 (앞선 선들의 제약 포함)
+	static bool LinearProgram1(const FLineArray& Lines, int32 LineIndex, float Radius, const FVector2f& OptVelocity, bool bDirectionOpt, FVector2f& Result)
+	{
+		const FLine& Line = Lines[LineIndex];
+		const float DotProduct = Line.Point | Line.Direction;
+		const float Discriminant = FMath::Square(DotProduct) + FMath::Square(Radius) - Line.Point.SizeSquared();
+		if (Discriminant < 0.0f)
+		{
+			// 최대 속도 원이 이 선의 허용 영역과 만나지 않음
+			return false;
+		}
+
+		const float SqrtDiscriminant = FMath::Sqrt(Discriminant);
+		float TLeft = -DotProduct - SqrtDiscriminant;
+		float TRight = -DotProduct + SqrtDiscriminant;
+
+		for (int32 Index = 0; Index < LineIndex; ++Index)
+		{
+			const float Denominator = Det(Line.Direction, Lines[Index].Direction);
+			const float Numerator = Det(Lines[Index].Direction, Line.Point - Lines[Index].Point);
+
+			if (FMath::Abs(Denominator) <= Epsilon)
+			{
+				// 평행한 선
+				if (Numerator < 0.0f)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const float T = Numerator / Denominator;
+			if (Denominator >= 0.0f)
+			{
+				TRight = FMath::Min(TRight, T);
+			}
+			else
+			{
+				TLeft = FMath::Max(TLeft, T);
+			}
+
+			if (TLeft > TRight)
+			{
+				return false;
+			}
+		}
+
+		if (bDirectionOpt)
+		{
+			Result = Line.Point + ((OptVelocity | Line.Direction) > 0.0f ? TRight : TLeft) * Line.Direction;
+		}
+		else
+		{
+			const float T = Line.Direction | (OptVelocity - Line.Point);
+			Result = Line.Point + FMath::Clamp(T, TLeft, TRight) * Line.Direction;
+		}
+		return true;
+	}
+
+	// 모든 반평면을 만족하면서 OptVelocity에 가장 가까운 속도. 실패한 선 인덱스를 반환 (성공이면 Lines.Num()).
+	static int32 LinearProgram2(const FLineArray& Lines, float Radius, const FVector2f& OptVelocity, bool bDirectionOpt, FVector2f& Result)
+	{
+		if (bDirectionOpt)
+		{
+			Result = OptVelocity * Radius;
+		}
+		else if (OptVelocity.SizeSquared() > FMath::Square(Radius))
+		{
+			Result = OptVelocity.GetSafeNormal() * Radius;
+		}
+		else
+		{
+			Result = OptVelocity;
+		}
+
+		for (int32 Index = 0; Index < Lines.Num(); ++Index)
+		{
+			if (Det(Lines[Index].Direction, Lines[Index].Point - Result) > 0.0f)
+			{
+				const FVector2f TempResult = Result;
+				if (!LinearProgram1(Lines, Index, Radius, OptVelocity, bDirectionOpt, Result))
+				{
+					Result = TempResult;
+					return Index;
+				}
+			}
+		}
+		return Lines.Num();
+	}
+
+	// 실현 가능한 해가 없을 때 제약 위반 거리를 최소화하는 속도
+	static void LinearProgram3(const FLineArray& Lines, int32 BeginLine, float Radius, FVector2f& Result)
+	{
+		float Distance = 0.0f;
+		FLineArray ProjectedLines;
+
+		for (int32 Index = BeginLine; Index < Lines.Num(); ++Index)
+		{
+			if (Det(Lines[Index].Direction, Lines[Index].Point - Result) <= Distance)
+			{
+				continue;
+			}
+
+			ProjectedLines.Reset();
+			for (int32 Other = 0; Other < Index; ++Other)
+			{
+				FLine Line;
+				const float Determinant = Det(Lines[Index].Direction, Lines[Other].Direction);
+				if (FMath::Abs(Determinant) <= Epsilon)
+				{
+					if ((Lines[Index].Direction | Lines[Other].Direction) > 0.0f)
+					{
+						// 같은 방향의 평행선
+						continue;
+					}
+					Line.Point = 0.5f * (Lines[Index].Point + Lines[Other].Point);
+				}
+				else
+				{
+					Line.Point = Lines[Index].Point + (Det(Lines[Other].Direction, Lines[Index].Point - Lines[Other].Point) / Determinant) * Lines[Index].Direction;
+				}
+				Line.Direction = (Lines[Other].Direction - Lines[Index].Direction).GetSafeNormal();
+				ProjectedLines.Add(Line);
+			}
+
+			const FVector2f TempResult = Result;
+			const FVector2f OptDirection(-Lines[Index].Direction.Y, Lines[Index].Direction.X);
+			if (LinearProgram2(ProjectedLines, Radius, OptDirection, true, Result) < ProjectedLines.Num())
+			{
+				// 수치 오차로만 실패할 수 있으므로 이전 결과 유지
+				Result = TempResult;
+			}
+			Distance = Det(Lines[Index].Direction, Lines[Index].Point - Result);
+		}
+	}
+
+	// 한 에이전트의 ORCA 선을 만들고 새 속도를 계산
+	static void SolveAgent(const FORCAAgentData& Data, const FSpatial_HashGrid& Grid, const FORCASolverSettings& Settings, int32 AgentIndex, FVector2f& OutVelocity, uint8& bOutConstrained)
+	{
+		const FVector& Position3D = Data.Positions[AgentIndex];
+		const FVector2f Position(Position3D.X, Position3D.Y);
+		const FVector2f& Velocity = Data.Velocities[AgentIndex];
+		const FVector2f& PreferredVelocity = Data.PreferredVelocities[AgentIndex];
+		const float Radius = Data.Radii[AgentIndex];
+		const float InvTimeHorizon = 1.0f / Settings.TimeHorizon;
+		const float InvTimeStep = 1.0f / FMath::Max(Settings.TimeStep, UE_KINDA_SMALL_NUMBER);
+
+		TArray<int32> Neighbors;
+		Grid.FindNearest(Position3D, Data.NeighborDistances[AgentIndex], Settings.MaxNeighbors, Neighbors, [&Data, &Position3D, AgentIndex, &Settings](int32 Handle)
+		{
+			return Handle != AgentIndex && FMath::Abs(Data.Positions[Handle].Z - Position3D.Z) <= Settings.MaxHeightDifference;
+		});
+
+		FLineArray Lines;
+		for (const int32 Other : Neighbors)
+		{
+			const FVector2f RelativePosition = FVector2f(Data.Positions[Other].X, Data.Positions[Other].Y) - Position;
+			const FVector2f RelativeVelocity = Velocity - Data.Velocities[Other];
+			const float DistSq = RelativePosition.SizeSquared();
+			const float CombinedRadius = Radius + Data.Radii[Other];
+			const float CombinedRadiusSq = FMath::Square(CombinedRadius);
+
+			FLine Line;
+			FVector2f U;
+
+			if (DistSq > CombinedRadiusSq)
+			{
+				// 아직 겹치지 않음: 시간 지평 안의 충돌 원뿔(VO)에서 가장 가까운 경계로 투영
+				const FVector2f W = RelativeVelocity - InvTimeHorizon * RelativePosition;
+				const float WLengthSq = W.SizeSquared();
+				const float DotProduct1 = W | RelativePosition;
+
+				if (DotProduct1 < 0.0f && FMath::Square(DotProduct1) > CombinedRadiusSq * WLengthSq)
+				{
+					// 잘린 원 부분에 투영
+					const float WLength = FMath::Sqrt(WLengthSq);
+					const FVector2f UnitW = W / WLength;
+					Line.Direction = FVector2f(UnitW.Y, -UnitW.X);
+					U = (CombinedRadius * InvTimeHorizon - WLength) * UnitW;
+				}
+				else
+				{
+					// 원뿔 다리에 투영
+					const float Leg = FMath::Sqrt(DistSq - CombinedRadiusSq);
+					if (Det(RelativePosition, W) > 0.0f)
+					{
+						Line.Direction = FVector2f(RelativePosition.X * Leg - RelativePosition.Y * CombinedRadius, RelativePosition.X * CombinedRadius + RelativePosition.Y * Leg) / DistSq;
+					}
+					else
+					{
+						Line.Direction = -FVector2f(RelativePosition.X * Leg + RelativePosition.Y * CombinedRadius, -RelativePosition.X * CombinedRadius + RelativePosition.Y * Leg) / DistSq;
+					}
+					U = (RelativeVelocity | Line.Direction) * Line.Direction - RelativeVelocity;
+				}
+			}
+			else
+			{
+				// 이미 겹침: 이번 스텝 안에 벗어나도록 투영
+				const FVector2f W = RelativeVelocity - InvTimeStep * RelativePosition;
+				const float WLength = W.Size();
+				const FVector2f UnitW = WLength > Epsilon ? W / WLength : FVector2f(1.0f, 0.0f);
+				Line.Direction = FVector2f(UnitW.Y, -UnitW.X);
+				U = (CombinedRadius * InvTimeStep - WLength) * UnitW;
+			}
+
+			// 상호 회피: 양쪽이 절반씩 책임진다
+			Line.Point = Velocity + 0.5f * U;
+			Lines.Add(Line);
+		}
+
+		const float MaxSpeed = Data.MaxSpeeds[AgentIndex];
+		FVector2f NewVelocity;
+		const int32 LineFail = LinearProgram2(Lines, MaxSpeed, PreferredVelocity, false, NewVelocity);
+		if (LineFail < Lines.Num())
+		{
+			LinearProgram3(Lines, LineFail, MaxSpeed, NewVelocity);
+		}
+
+		OutVelocity = NewVelocity;
+		bOutConstrained = Lines.Num() > 0 && !NewVelocity.Equals(PreferredVelocity, 1.0f);
+	}
+}
+
+void FORCAAgentData::Reset(int32 NumAgents)
+{
+	Positions.Reset(NumAgents);
+	Velocities.Reset(NumAgents);
+	PreferredVelocities.Reset(NumAgents);
+	Radii.Reset(NumAgents);
+	MaxSpeeds.Reset(NumAgents);
+	NeighborDistances.Reset(NumAgents);
+	NewVelocities.Reset(NumAgents);
+	Constrained.Reset(NumAgents);
+}
+
+void FORCAAgentData::Add(const FVector& Position, const FVector2f& Velocity, const FVector2f& PreferredVelocity, float Radius, float MaxSpeed, float NeighborDistance)
+{
+	Positions.Add(Position);
+	Velocities.Add(Velocity);
+	PreferredVelocities.Add(PreferredVelocity);
+	Radii.Add(Radius);
+	MaxSpeeds.Add(MaxSpeed);
+	NeighborDistances.Add(NeighborDistance);
+}
+
+bool URVO_ORCASubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URVO_ORCASubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URVO_ORCASubsystem, STATGROUP_Tickables);
+}
+
+void URVO_ORCASubsystem::RegisterAgent(UAgent_MovementComponent* Agent)
+{
+	if (!Agent || Agent->ORCAIndex != INDEX_NONE)
+	{
+		return;
+	}
+	Agent->ORCAIndex = Agents.Add(Agent);
+}
+
+void URVO_ORCASubsystem::UnregisterAgent(UAgent_MovementComponent* Agent)
+{
+	if (!Agent || !Agents.IsValidIndex(Agent->ORCAIndex) || Agents[Agent->ORCAIndex] != Agent)
+	{
+		return;
+	}
+
+	const int32 Index = Agent->ORCAIndex;
+	Agent->ORCAIndex = INDEX_NONE;
+
+	// 마지막 원소를 빈 자리로 옮겨 배열을 연속으로 유지
+	Agents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Agents.IsValidIndex(Index) && Agents[Index])
+	{
+		Agents[Index]->ORCAIndex = Index;
+	}
+}
+
+FORCASolverSettings URVO_ORCASubsystem::GetSettings(float DeltaTime)
+{
+	FORCASolverSettings Settings;
+	Settings.TimeHorizon = FMath::Max(CVarORCATimeHorizon.GetValueOnGameThread(), 0.1f);
+	Settings.TimeStep = DeltaTime;
+	Settings.MaxNeighbors = FMath::Max(CVarORCAMaxNeighbors.GetValueOnGameThread(), 1);
+	Settings.CellSize = FMath::Max(CVarORCACellSize.GetValueOnGameThread(), 50.0f);
+	Settings.bParallel = CVarORCAParallel.GetValueOnGameThread();
+	return Settings;
+}
+
+void URVO_ORCASubsystem::Solve(FORCAAgentData& Data, const FORCASolverSettings& Settings)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ORCA_Solve);
+
+	const int32 NumAgents = Data.Num();
+	Data.NewVelocities.SetNumUninitialized(NumAgents);
+	Data.Constrained.SetNumUninitialized(NumAgents);
+
+	FSpatial_HashGrid Grid(Settings.CellSize);
+	Grid.Build(Data.Positions);
+
+	// 에이전트마다 독립적으로 읽기만 하므로 그대로 병렬화할 수 있다
+	const EParallelForFlags Flags = Settings.bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+	ParallelFor(TEXT("ORCA.Solve"), NumAgents, 32, [&Data, &Grid, &Settings](int32 Index)
+	{
+		ORCA::SolveAgent(Data, Grid, Settings, Index, Data.NewVelocities[Index], Data.Constrained[Index]);
+	}, Flags);
+}
+
+void URVO_ORCASubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ORCA_Tick);
+	AISTUDY_BENCHMARK_SCOPE(Avoidance);
+	SET_DWORD_STAT(STAT_ORCA_NumAgents, Agents.Num());
+
+	if (Agents.Num() == 0 || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	{
+		AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ORCA_Gather);
+
+		// 파괴된 컴포넌트 정리
+		for (int32 Index = Agents.Num() - 1; Index >= 0; --Index)
+		{
+			if (!IsValid(Agents[Index]))
+			{
+				Agents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+				if (Agents.IsValidIndex(Index) && Agents[Index])
+				{
+					Agents[Index]->ORCAIndex = Index;
+				}
+			}
+		}
+
+		Data.Reset(Agents.Num());
+		for (const UAgent_MovementComponent* Agent : Agents)
+		{
+			const ACharacter* Character = Agent->GetCharacterOwner();
+			const float Radius = Character ? Character->GetCapsuleComponent()->GetScaledCapsuleRadius() : 34.0f;
+			Data.Add(Agent->GetActorFeetLocation(),
+				FVector2f(Agent->Velocity.X, Agent->Velocity.Y),
+				FVector2f(Agent->GetPreferredVelocity().X, Agent->GetPreferredVelocity().Y),
+				Radius,
+				Agent->GetMaxSpeed(),
+				Agent->AvoidanceConsiderationRadius);
+		}
+	}
+
+	Solve(Data, GetSettings(DeltaTime));
+
+	{
+		AISTUDY_SCOPE_CYCLE_COUNTER(STAT_ORCA_Apply);
+
+		int32 NumConstrained = 0;
+		for (int32 Index = 0; Index < Agents.Num(); ++Index)
+		{
+			UAgent_MovementComponent* Agent = Agents[Index];
+			Agent->ORCAVelocity = Data.NewVelocities[Index];
+			Agent->bHasORCAVelocity = Data.Constrained[Index] != 0;
+			NumConstrained += Data.Constrained[Index];
+		}
+		SET_DWORD_STAT(STAT_ORCA_NumConstrained, NumConstrained);
+	}
+}
+
+// ORCA 풀이 비용 측정 (AIStudy.ORCA.Benchmark [TimeHorizon])
+// 실제 캐릭터 없이 같은 밀도로 흩뿌린 에이전트가 서로 교차하도록 희망 속도를 준다.
+
+static void RunORCABenchmark(const TArray<FString>& Args)
+{
+	const int32 AgentCounts[] = { 1000, 5000 };
+	const int32 NumFrames = 60;
+
+	for (const int32 NumAgents : AgentCounts)
+	{
+		FRandomStream Random(12345);
+		const float HalfExtent = FMath::Sqrt(static_cast<float>(NumAgents)) * 150.0f;
+
+		FORCAAgentData Data;
+		Data.Reset(NumAgents);
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			const FVector Position(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+			// 원점 반대편으로 가려는 속도
+			const FVector2f Preferred = FVector2f(-Position.X, -Position.Y).GetSafeNormal() * 600.0f;
+			Data.Add(Position, Preferred, Preferred, 34.0f, 600.0f, 300.0f);
+		}
+
+		for (const bool bParallel : { false, true })
+		{
+			FORCASolverSettings Settings = URVO_ORCASubsystem::GetSettings(1.0f / 60.0f);
+			Settings.bParallel = bParallel;
+			if (Args.Num() > 0)
+			{
+				Settings.TimeHorizon = FMath::Max(FCString::Atof(*Args[0]), 0.1f);
+			}
+
+			FORCAAgentData FrameData = Data;
+			int32 NumConstrained = 0;
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				URVO_ORCASubsystem::Solve(FrameData, Settings);
+
+				// 결과로 한 스텝 이동시켜 다음 프레임 입력으로 사용
+				NumConstrained = 0;
+				for (int32 Index = 0; Index < NumAgents; ++Index)
+				{
+					FrameData.Velocities[Index] = FrameData.NewVelocities[Index];
+					FrameData.Positions[Index] += FVector(FrameData.NewVelocities[Index].X, FrameData.NewVelocities[Index].Y, 0.0f) * Settings.TimeStep;
+					NumConstrained += FrameData.Constrained[Index];
+				}
+			}
+			const double AverageMs = (FPlatformTime::Seconds() - Start) * 1000.0 / NumFrames;
+
+			UE_LOG(LogAIStudy, Display, TEXT("ORCA N=%d %s: %.3f ms/frame, constrained %d"),
+				NumAgents, bParallel ? TEXT("parallel") : TEXT("single"), AverageMs, NumConstrained);
+		}
+	}
+}
+
+static FAutoConsoleCommand ORCABenchmarkCommand(
+	TEXT("AIStudy.ORCA.Benchmark"),
+	TEXT("1k/5k 에이전트에서 ORCA 풀이의 프레임당 비용을 단일 스레드와 ParallelFor로 비교한다. 인자: [TimeHorizon]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunORCABenchmark));
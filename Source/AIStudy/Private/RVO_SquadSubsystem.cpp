@@ -0,0 +1,632 @@
+#include "RVO_SquadSubsystem.h"
+#include "AIStudy.h"
+#include "Benchmark_Metrics.h"
+#include "RVO_Character.h"
+#include "Agent_SignificanceSubsystem.h"
+#include "Path_RequestSubsystem.h"
+#include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/BinarySearch.h"
+
+DECLARE_CYCLE_STAT(TEXT("RVO Squad Update"), STAT_RVOSquad_Update, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RVO Squads"), STAT_RVOSquad_NumSquads, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RVO Squad Followers"), STAT_RVOSquad_NumFollowers, STATGROUP_AIStudy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RVO Squad Individual Paths"), STAT_RVOSquad_NumIndividual, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<bool> CVarSquadEnable(
+	TEXT("AIStudy.Squad.Enable"),
+	true,
+	TEXT("끄면 분대원도 각자 경로를 찾는다 (같은 배치에서 개별 경로와 비교용)."));
+
+static TAutoConsoleVariable<float> CVarSquadSpacing(
+	TEXT("AIStudy.Squad.Spacing"),
+	200.0f,
+	TEXT("대형 슬롯 간격(cm)."));
+
+static TAutoConsoleVariable<int32> CVarSquadColumns(
+	TEXT("AIStudy.Squad.Columns"),
+	3,
+	TEXT("리더 뒤 한 줄에 서는 분대원 수."));
+
+static TAutoConsoleVariable<float> CVarSquadBlockedSeconds(
+	TEXT("AIStudy.Squad.BlockedSeconds"),
+	2.0f,
+	TEXT("슬롯보다 뒤처진 분대원이 이 시간 동안 통로를 따라 전진하지 못하면 개별 경로로 돌린다."));
+
+static TAutoConsoleVariable<float> CVarSquadMaxCorridorDistance(
+	TEXT("AIStudy.Squad.MaxCorridorDistance"),
+	800.0f,
+	TEXT("리더 통로에서 이보다 멀어진 분대원은 개별 경로로 돌리고, 절반 안으로 돌아오면 다시 대형에 넣는다."));
+
+static TAutoConsoleVariable<bool> CVarSquadLeaderWait(
+	TEXT("AIStudy.Squad.LeaderWait"),
+	true,
+	TEXT("분대원이 슬롯보다 많이 뒤처지면 리더 경로 추종을 잠시 멈춘다."));
+
+namespace RVOSquad
+{
+	// 뒤처진 분대원이 통로를 따라 바라보는 앞쪽 거리
+	static constexpr float LookAhead = 300.0f;
+	// 이만큼 진행해야 전진으로 본다
+	static constexpr float MinProgress = 50.0f;
+	static constexpr float ArriveRadius = 30.0f;
+	static constexpr float MinInputScale = 0.25f;
+	static constexpr float SlotCheckInterval = 0.5f;
+	// 개별 경로로 돌린 뒤 이 시간은 다시 넣지 않는다 (경계에서 왔다 갔다 하지 않도록)
+	static constexpr float RejoinSeconds = 2.0f;
+	// 막혀서 돌린 분대원은 막힌 곳보다 통로를 따라 이만큼 더 나가야 다시 넣는다
+	static constexpr float RejoinProgress = 200.0f;
+	// 슬롯 간격의 이 배수보다 뒤처지면 리더가 기다린다
+	static constexpr float LeaderWaitLagSlots = 3.0f;
+	static constexpr float MaxLeaderWaitSeconds = 3.0f;
+	static constexpr float LeaderWaitCooldown = 1.0f;
+
+	static AAIController* GetAIController(const ARVO_Character& Character)
+	{
+		return Cast<AAIController>(Character.GetController());
+	}
+
+	// 개별 경로 요청과 진행 중인 이동을 멈춘다 (대형 입력과 경로 추종이 겹치지 않도록)
+	static void StopIndividualMove(ARVO_Character& Character)
+	{
+		AAIController* AIController = GetAIController(Character);
+		if (!AIController)
+		{
+			return;
+		}
+		if (UPath_RequestSubsystem* PathRequests = Character.GetWorld()->GetSubsystem<UPath_RequestSubsystem>())
+		{
+			PathRequests->CancelRequest(AIController);
+		}
+		AIController->StopMovement();
+	}
+}
+
+bool URVO_SquadSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URVO_SquadSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URVO_SquadSubsystem, STATGROUP_Tickables);
+}
+
+bool URVO_SquadSubsystem::AddMember(ARVO_Character* Character, FName SquadName)
+{
+	// 흐름장 모드는 경로를 찾지 않으므로 나눌 통로가 없다
+	if (!Character || SquadName.IsNone() || Character->bUseFlowField)
+	{
+		return false;
+	}
+
+	if (const FName* CurrentSquad = MemberSquads.Find(Character))
+	{
+		if (*CurrentSquad == SquadName)
+		{
+			return true;
+		}
+		RemoveMember(Character);
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	FSquad& Squad = Squads.FindOrAdd(SquadName);
+	FMember& Member = Squad.Members.AddDefaulted_GetRef();
+	Member.Character = Character;
+	Member.ProgressTime = Now;
+	MemberSquads.Add(Character, SquadName);
+	AssignSlots(Squad);
+
+	// 혼자 가던 캐릭터가 분대원이 되면 그 경로는 버리고 리더 통로를 따른다
+	if (IsFollowingSquad(Character))
+	{
+		RVOSquad::StopIndividualMove(*Character);
+	}
+	return true;
+}
+
+void URVO_SquadSubsystem::RemoveMember(ARVO_Character* Character)
+{
+	FName SquadName;
+	if (!MemberSquads.RemoveAndCopyValue(Character, SquadName))
+	{
+		return;
+	}
+
+	FSquad* Squad = Squads.Find(SquadName);
+	const int32 Index = Squad ? Squad->Members.IndexOfByPredicate([Character](const FMember& Member) { return Member.Character == Character; }) : INDEX_NONE;
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Index == 0)
+	{
+		// 기다리게 해 둔 리더가 멈춘 채로 남지 않도록 먼저 풀어 준다
+		SetLeaderWaiting(*Squad, false, Now);
+	}
+	Squad->Members.RemoveAt(Index);
+
+	if (Squad->Members.Num() == 0)
+	{
+		Squads.Remove(SquadName);
+	}
+	else if (Index == 0)
+	{
+		OnLeaderChanged(*Squad);
+	}
+	else
+	{
+		AssignSlots(*Squad);
+	}
+}
+
+bool URVO_SquadSubsystem::IsFollowingSquad(const ARVO_Character* Character) const
+{
+	if (!CVarSquadEnable.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	const FName* SquadName = MemberSquads.Find(Character);
+	const FSquad* Squad = SquadName ? Squads.Find(*SquadName) : nullptr;
+	if (!Squad)
+	{
+		return false;
+	}
+
+	// 리더는 직접 경로를 찾는다
+	for (int32 Index = 1; Index < Squad->Members.Num(); ++Index)
+	{
+		if (Squad->Members[Index].Character == Character)
+		{
+			return !Squad->Members[Index].bIndividual;
+		}
+	}
+	return false;
+}
+
+ARVO_Character* URVO_SquadSubsystem::GetLeader(FName SquadName) const
+{
+	const FSquad* Squad = Squads.Find(SquadName);
+	return Squad && Squad->Members.Num() > 0 ? Squad->Members[0].Character.Get() : nullptr;
+}
+
+void URVO_SquadSubsystem::AssignSlots(FSquad& Squad) const
+{
+	// 리더 바로 뒤 줄부터 Columns명씩 가운데 정렬로 선다
+	const float Spacing = CVarSquadSpacing.GetValueOnGameThread();
+	const int32 Columns = FMath::Max(CVarSquadColumns.GetValueOnGameThread(), 1);
+	for (int32 Index = 0; Index < Squad.Members.Num(); ++Index)
+	{
+		FMember& Member = Squad.Members[Index];
+		if (Index == 0)
+		{
+			Member.SlotOffset = FVector2D::ZeroVector;
+			continue;
+		}
+
+		const int32 SlotIndex = Index - 1;
+		const int32 Row = SlotIndex / Columns + 1;
+		const int32 NumInRow = FMath::Min(Columns, Squad.Members.Num() - 1 - (Row - 1) * Columns);
+		const float Column = SlotIndex % Columns - (NumInRow - 1) * 0.5f;
+		Member.SlotOffset = FVector2D(Row * Spacing, Column * Spacing);
+		Member.LateralScale = 1.0f;
+		Member.NextSlotCheckTime = 0.0;
+	}
+}
+
+void URVO_SquadSubsystem::OnLeaderChanged(FSquad& Squad)
+{
+	++Stats.NumLeaderChanges;
+	Squad.bLeaderWaiting = false;
+	AssignSlots(Squad);
+
+	// 대형을 따르던 분대원이 리더가 되면 분대 경로를 요청한다. 개별 경로로 가던 중이면 그 경로가 그대로 통로가 된다
+	FMember& Leader = Squad.Members[0];
+	const bool bWasIndividual = Leader.bIndividual;
+	Leader.bIndividual = false;
+	ARVO_Character* Character = Leader.Character.Get();
+	if (Character && !bWasIndividual && CVarSquadEnable.GetValueOnGameThread())
+	{
+		Character->MoveToTarget();
+	}
+}
+
+void URVO_SquadSubsystem::SetIndividual(FMember& Member, bool bIndividual, double Now)
+{
+	if (Member.bIndividual == bIndividual)
+	{
+		return;
+	}
+	Member.bIndividual = bIndividual;
+	Member.IndividualTime = Now;
+	Member.ProgressMark = -1.0f;
+	Member.bBlocked = false;
+
+	ARVO_Character* Character = Member.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+	if (bIndividual)
+	{
+		// 이제 대형을 따르지 않으므로 MoveToTarget이 평소대로 경로를 요청한다
+		Character->MoveToTarget();
+	}
+	else
+	{
+		RVOSquad::StopIndividualMove(*Character);
+	}
+}
+
+void URVO_SquadSubsystem::SetLeaderWaiting(FSquad& Squad, bool bWaiting, double Now)
+{
+	if (Squad.bLeaderWaiting == bWaiting)
+	{
+		return;
+	}
+	Squad.bLeaderWaiting = bWaiting;
+	Squad.LeaderWaitTime = Now;
+
+	const ARVO_Character* Leader = Squad.Members.Num() > 0 ? Squad.Members[0].Character.Get() : nullptr;
+	const AAIController* AIController = Leader ? RVOSquad::GetAIController(*Leader) : nullptr;
+	UPathFollowingComponent* PathFollowing = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	if (!PathFollowing)
+	{
+		return;
+	}
+
+	if (bWaiting)
+	{
+		if (PathFollowing->GetStatus() == EPathFollowingStatus::Moving)
+		{
+			PathFollowing->PauseMove();
+			++Stats.NumLeaderWaits;
+		}
+		return;
+	}
+
+	// 잠든 리더는 LOD가 멈춰 둔 것이므로 깨어날 때 LOD가 다시 움직인다
+	const UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>();
+	if (PathFollowing->GetStatus() == EPathFollowingStatus::Paused && !(Significance && Significance->IsDormant(Leader)))
+	{
+		PathFollowing->ResumeMove();
+	}
+}
+
+void URVO_SquadSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_RVOSquad_Update);
+	AISTUDY_BENCHMARK_SCOPE(Pathfinding);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const bool bEnabled = CVarSquadEnable.GetValueOnGameThread();
+	bool bRemovedMembers = false;
+	int32 NumFollowers = 0;
+	int32 NumIndividual = 0;
+
+	for (auto It = Squads.CreateIterator(); It; ++It)
+	{
+		FSquad& Squad = It.Value();
+
+		// EndPlay 없이 사라진 캐릭터 정리
+		const bool bLeaderLost = !Squad.Members[0].Character.IsValid();
+		const int32 NumRemoved = Squad.Members.RemoveAll([](const FMember& Member) { return !Member.Character.IsValid(); });
+		bRemovedMembers |= NumRemoved > 0;
+		if (Squad.Members.Num() == 0)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		if (bLeaderLost)
+		{
+			OnLeaderChanged(Squad);
+		}
+		else if (NumRemoved > 0)
+		{
+			AssignSlots(Squad);
+		}
+
+		// 꺼져 있으면 모두 혼자 간다. 다시 켜면 통로 근처의 분대원부터 대형으로 돌아온다
+		if (!bEnabled)
+		{
+			SetLeaderWaiting(Squad, false, Now);
+			for (int32 Index = 1; Index < Squad.Members.Num(); ++Index)
+			{
+				SetIndividual(Squad.Members[Index], true, Now);
+			}
+			NumIndividual += Squad.Members.Num() - 1;
+			continue;
+		}
+
+		TickSquad(Squad, Now);
+		for (int32 Index = 1; Index < Squad.Members.Num(); ++Index)
+		{
+			if (Squad.Members[Index].bIndividual)
+			{
+				++NumIndividual;
+			}
+			else
+			{
+				++NumFollowers;
+			}
+		}
+	}
+
+	if (bRemovedMembers)
+	{
+		for (auto It = MemberSquads.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_RVOSquad_NumSquads, Squads.Num());
+	SET_DWORD_STAT(STAT_RVOSquad_NumFollowers, NumFollowers);
+	SET_DWORD_STAT(STAT_RVOSquad_NumIndividual, NumIndividual);
+}
+
+void URVO_SquadSubsystem::TickSquad(FSquad& Squad, double Now)
+{
+	UpdateCorridor(Squad);
+	if (Squad.Corridor.Num() < 2)
+	{
+		// 리더 경로가 아직 없으면 분대원은 제자리에서 기다린다
+		for (FMember& Member : Squad.Members)
+		{
+			Member.ProgressMark = -1.0f;
+		}
+		return;
+	}
+
+	const ARVO_Character* Leader = Squad.Members[0].Character.Get();
+	float LeaderDistanceToCorridor = 0.0f;
+	const float LeaderDistance = ProjectOntoCorridor(Squad, Leader->GetActorLocation(), LeaderDistanceToCorridor);
+
+	const UAgent_SignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UAgent_SignificanceSubsystem>();
+	float MaxLag = 0.0f;
+	for (int32 Index = 1; Index < Squad.Members.Num(); ++Index)
+	{
+		FMember& Member = Squad.Members[Index];
+		// 잠든 분대원은 이동하지 않으므로 입력도, 막힘 판정도 하지 않는다
+		if (Significance && Significance->IsDormant(Member.Character.Get()))
+		{
+			Member.ProgressMark = -1.0f;
+			continue;
+		}
+		MaxLag = FMath::Max(MaxLag, SteerMember(Squad, Member, LeaderDistance, Now));
+	}
+
+	if (!CVarSquadLeaderWait.GetValueOnGameThread())
+	{
+		SetLeaderWaiting(Squad, false, Now);
+		return;
+	}
+
+	const float Spacing = CVarSquadSpacing.GetValueOnGameThread();
+	if (Squad.bLeaderWaiting)
+	{
+		// 막힌 분대원은 개별 경로로 빠지므로 오래 기다리지 않는다
+		if (MaxLag < Spacing || Now - Squad.LeaderWaitTime > RVOSquad::MaxLeaderWaitSeconds)
+		{
+			SetLeaderWaiting(Squad, false, Now);
+		}
+	}
+	else if (MaxLag > Spacing * RVOSquad::LeaderWaitLagSlots && Now - Squad.LeaderWaitTime > RVOSquad::LeaderWaitCooldown)
+	{
+		SetLeaderWaiting(Squad, true, Now);
+	}
+}
+
+void URVO_SquadSubsystem::UpdateCorridor(FSquad& Squad)
+{
+	const ARVO_Character* Leader = Squad.Members[0].Character.Get();
+	const AAIController* AIController = Leader ? RVOSquad::GetAIController(*Leader) : nullptr;
+	const UPathFollowingComponent* PathFollowing = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	const FNavPathSharedPtr Path = PathFollowing ? PathFollowing->GetPath() : nullptr;
+	// 리더가 경로를 놓으면 (도착, 재탐색 대기) 마지막 통로를 그대로 쓴다
+	if (!Path.IsValid() || !Path->IsValid() || Path->GetPathPoints().Num() < 2)
+	{
+		return;
+	}
+	if (Squad.CorridorSource.HasSameObject(Path.Get()) && Path->GetTimeStamp() == Squad.CorridorTimeStamp)
+	{
+		return;
+	}
+
+	const TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+	Squad.Corridor.Reset(Points.Num());
+	Squad.CorridorDistances.Reset(Points.Num());
+	float TotalDistance = 0.0f;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			TotalDistance += FVector::Dist(Points[Index - 1].Location, Points[Index].Location);
+		}
+		Squad.Corridor.Add(Points[Index].Location);
+		Squad.CorridorDistances.Add(TotalDistance);
+	}
+	Squad.CorridorSource = Path;
+	Squad.CorridorTimeStamp = Path->GetTimeStamp();
+	++Stats.NumCorridorUpdates;
+
+	// 진행 거리의 기준이 바뀌었으므로 막힘 판정을 새로 시작한다
+	for (FMember& Member : Squad.Members)
+	{
+		Member.ProgressMark = -1.0f;
+	}
+}
+
+float URVO_SquadSubsystem::SteerMember(FSquad& Squad, FMember& Member, float LeaderDistance, double Now)
+{
+	ARVO_Character* Character = Member.Character.Get();
+	const FVector Location = Character->GetActorLocation();
+	float DistanceToCorridor = 0.0f;
+	const float Progress = ProjectOntoCorridor(Squad, Location, DistanceToCorridor);
+	const float MaxCorridorDistance = CVarSquadMaxCorridorDistance.GetValueOnGameThread();
+
+	if (Member.bIndividual)
+	{
+		// 통로 근처로 돌아왔으면 다시 대형에 넣는다. 막혀서 돌렸다면 장애물이 그대로일 수 있으므로
+		// 막힌 곳을 지나 전진한 뒤에만 넣는다 (통로가 바뀌었을 수 있어 위치를 다시 투영한다)
+		bool bPastBlock = true;
+		if (Member.bBlocked)
+		{
+			float BlockedDistanceToCorridor = 0.0f;
+			bPastBlock = Progress > ProjectOntoCorridor(Squad, Member.BlockedLocation, BlockedDistanceToCorridor) + RVOSquad::RejoinProgress;
+		}
+		if (bPastBlock && Now - Member.IndividualTime >= RVOSquad::RejoinSeconds && DistanceToCorridor < MaxCorridorDistance * 0.5f)
+		{
+			SetIndividual(Member, false, Now);
+			++Stats.NumRejoins;
+		}
+		return 0.0f;
+	}
+
+	if (DistanceToCorridor > MaxCorridorDistance)
+	{
+		SetIndividual(Member, true, Now);
+		++Stats.NumFallbacks;
+		return 0.0f;
+	}
+
+	const float Spacing = CVarSquadSpacing.GetValueOnGameThread();
+	const float SlotDistance = FMath::Max(LeaderDistance - static_cast<float>(Member.SlotOffset.X), 0.0f);
+	const float Lag = SlotDistance - Progress;
+
+	// 슬롯보다 한참 뒤면 전진하고 있는지 본다. 슬롯 근처에서는 서 있어도 막힌 것이 아니다
+	if (Lag <= Spacing || Member.ProgressMark < 0.0f || Progress > Member.ProgressMark + RVOSquad::MinProgress)
+	{
+		Member.ProgressMark = Progress;
+		Member.ProgressTime = Now;
+	}
+	else if (Now - Member.ProgressTime > CVarSquadBlockedSeconds.GetValueOnGameThread())
+	{
+		SetIndividual(Member, true, Now);
+		Member.bBlocked = true;
+		Member.BlockedLocation = Location;
+		++Stats.NumFallbacks;
+		return 0.0f;
+	}
+
+	FVector SlotDirection;
+	const FVector SlotCenter = GetCorridorPoint(Squad, SlotDistance, SlotDirection);
+	const FVector SlotRight(-SlotDirection.Y, SlotDirection.X, 0.0);
+
+	// 옆 오프셋이 벽 너머로 나가지 않도록 통로 점에서 슬롯 쪽으로 가끔 레이캐스트한다
+	if (Now >= Member.NextSlotCheckTime && !FMath::IsNearlyZero(Member.SlotOffset.Y))
+	{
+		Member.NextSlotCheckTime = Now + RVOSquad::SlotCheckInterval;
+		Member.LateralScale = 1.0f;
+		FVector HitLocation;
+		if (UNavigationSystemV1::NavigationRaycast(GetWorld(), SlotCenter, SlotCenter + SlotRight * Member.SlotOffset.Y, HitLocation, nullptr, Character->GetController()))
+		{
+			const float Clearance = FVector::Dist2D(SlotCenter, HitLocation) - Character->GetSimpleCollisionRadius();
+			Member.LateralScale = FMath::Clamp(Clearance / FMath::Abs(static_cast<float>(Member.SlotOffset.Y)), 0.0f, 1.0f);
+		}
+		++Stats.NumSlotRaycasts;
+	}
+	const float Lateral = static_cast<float>(Member.SlotOffset.Y) * Member.LateralScale;
+
+	// 뒤처졌으면 슬롯으로 곧장 가지 않고 통로 앞쪽 점을 따라 모퉁이를 돈다
+	FVector Target;
+	if (Lag > Spacing)
+	{
+		FVector AheadDirection;
+		const FVector AheadCenter = GetCorridorPoint(Squad, FMath::Min(Progress + RVOSquad::LookAhead, SlotDistance), AheadDirection);
+		Target = AheadCenter + FVector(-AheadDirection.Y, AheadDirection.X, 0.0) * Lateral;
+	}
+	else
+	{
+		Target = SlotCenter + SlotRight * Lateral;
+	}
+
+	// 이동 입력은 CharacterMovementComponent를 거치므로 RVO/ORCA 회피가 그대로 적용된다
+	FVector ToTarget = Target - Location;
+	ToTarget.Z = 0.0;
+	const float Distance = ToTarget.Size();
+	if (Distance > RVOSquad::ArriveRadius)
+	{
+		const float SlowRadius = Spacing * 0.5f;
+		Character->AddMovementInput(ToTarget / Distance, FMath::Clamp(Distance / SlowRadius, RVOSquad::MinInputScale, 1.0f));
+	}
+	return FMath::Max(Lag, 0.0f);
+}
+
+float URVO_SquadSubsystem::ProjectOntoCorridor(const FSquad& Squad, const FVector& Location, float& OutDistanceToCorridor)
+{
+	float BestDistanceSquared = TNumericLimits<float>::Max();
+	float BestProgress = 0.0f;
+	for (int32 Index = 0; Index + 1 < Squad.Corridor.Num(); ++Index)
+	{
+		const FVector& Start = Squad.Corridor[Index];
+		const FVector Closest = FMath::ClosestPointOnSegment(Location, Start, Squad.Corridor[Index + 1]);
+		const float DistanceSquared = FVector::DistSquared(Location, Closest);
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestProgress = Squad.CorridorDistances[Index] + FVector::Dist(Start, Closest);
+		}
+	}
+	OutDistanceToCorridor = FMath::Sqrt(BestDistanceSquared);
+	return BestProgress;
+}
+
+FVector URVO_SquadSubsystem::GetCorridorPoint(const FSquad& Squad, float Distance, FVector& OutDirection)
+{
+	const int32 NumPoints = Squad.Corridor.Num();
+	const float ClampedDistance = FMath::Clamp(Distance, 0.0f, Squad.CorridorDistances.Last());
+	const int32 Segment = FMath::Clamp(static_cast<int32>(Algo::UpperBound(Squad.CorridorDistances, ClampedDistance)) - 1, 0, NumPoints - 2);
+
+	const FVector& Start = Squad.Corridor[Segment];
+	const FVector& End = Squad.Corridor[Segment + 1];
+	const float SegmentLength = Squad.CorridorDistances[Segment + 1] - Squad.CorridorDistances[Segment];
+	const float Alpha = SegmentLength > UE_KINDA_SMALL_NUMBER ? (ClampedDistance - Squad.CorridorDistances[Segment]) / SegmentLength : 0.0f;
+
+	OutDirection = (End - Start).GetSafeNormal2D();
+	if (OutDirection.IsZero())
+	{
+		OutDirection = (Squad.Corridor.Last() - Squad.Corridor[0]).GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	}
+	return FMath::Lerp(Start, End, Alpha);
+}
+
+void URVO_SquadSubsystem::LogReport() const
+{
+	int32 NumMembers = 0;
+	int32 NumIndividual = 0;
+	for (const TPair<FName, FSquad>& Pair : Squads)
+	{
+		NumMembers += Pair.Value.Members.Num();
+		for (const FMember& Member : Pair.Value.Members)
+		{
+			NumIndividual += Member.bIndividual ? 1 : 0;
+		}
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("RVO squads: %d squads, %d members (%d leaders, %d on individual paths), %llu corridor updates, %llu leader changes, %llu leader waits"),
+		Squads.Num(), NumMembers, Squads.Num(), NumIndividual, Stats.NumCorridorUpdates, Stats.NumLeaderChanges, Stats.NumLeaderWaits);
+	UE_LOG(LogAIStudy, Display, TEXT("RVO squads: %llu fallbacks to individual paths, %llu rejoins, %llu slot raycasts"),
+		Stats.NumFallbacks, Stats.NumRejoins, Stats.NumSlotRaycasts);
+}
+
+static FAutoConsoleCommandWithWorld SquadReportCommand(
+	TEXT("AIStudy.Squad.Report"),
+	TEXT("RVO 분대 수, 분대원/개별 경로 수, 통로 갱신, 개별 경로 전환/복귀 횟수를 로그로 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URVO_SquadSubsystem* Squads = World ? World->GetSubsystem<URVO_SquadSubsystem>() : nullptr)
+		{
+			Squads->LogReport();
+		}
+	}));
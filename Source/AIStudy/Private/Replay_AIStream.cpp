@@ -0,0 +1,234 @@
+#include "Replay_AIStream.h"
+#include "AIStudy.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace ReplayStream
+{
+	static void SerializePacked(FArchive& Ar, uint32& Value)
+	{
+		Ar.SerializeIntPacked(Value);
+	}
+
+	// 부호 있는 정수는 지그재그 인코딩 후 가변 길이로 쓴다
+	static void SerializePacked(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		if (Ar.IsLoading())
+		{
+			Value = static_cast<int32>(Encoded >> 1) ^ -static_cast<int32>(Encoded & 1);
+		}
+	}
+
+	// 배열 길이를 가변 길이로 쓰고 요소는 Serialize로 처리
+	template <typename ElementType, typename FunctionType>
+	static void SerializeArray(FArchive& Ar, TArray<ElementType>& Array, FunctionType Serialize)
+	{
+		uint32 Num = Array.Num();
+		SerializePacked(Ar, Num);
+		if (Ar.IsLoading())
+		{
+			Array.SetNum(Num);
+		}
+		for (ElementType& Element : Array)
+		{
+			Serialize(Ar, Element);
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FReplaySpawnEvent& Event)
+{
+	using namespace ReplayStream;
+
+	uint8 Type = static_cast<uint8>(Event.Type);
+	SerializePacked(Ar, Event.Id);
+	Ar << Type;
+	Event.Type = static_cast<EReplayActorType>(Type);
+	SerializePacked(Ar, Event.ClassIndex);
+	SerializePacked(Ar, Event.ControllerClassIndex);
+	Ar << Event.PlacedName;
+	Ar << Event.Location;
+	Ar << Event.Rotation;
+	Ar << Event.Tags;
+	SerializePacked(Ar, Event.Refs[0]);
+	SerializePacked(Ar, Event.Refs[1]);
+	Ar << Event.Group;
+	Ar << Event.Flags;
+	Ar << Event.Radius;
+	Ar << Event.Weight;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FReplayPerceptionEvent& Event)
+{
+	using namespace ReplayStream;
+
+	SerializePacked(Ar, Event.ChaserId);
+	SerializePacked(Ar, Event.TargetId);
+	Ar << Event.bSensed;
+	Ar << Event.StimulusLocation;
+	Ar << Event.ReceiverLocation;
+	SerializePacked(Ar, Event.CallIndex);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FReplayPose& Pose)
+{
+	ReplayStream::SerializePacked(Ar, Pose.Id);
+	Ar << Pose.Location;
+	Ar << Pose.Rotation;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FReplayFrame& Frame)
+{
+	using namespace ReplayStream;
+
+	Ar << Frame.DeltaTime;
+	SerializeArray(Ar, Frame.Spawns, [](FArchive& InAr, FReplaySpawnEvent& Event) { InAr << Event; });
+	SerializeArray(Ar, Frame.Despawns, [](FArchive& InAr, uint32& Id) { SerializePacked(InAr, Id); });
+	SerializeArray(Ar, Frame.Poses, [](FArchive& InAr, FReplayPose& Pose) { InAr << Pose; });
+	SerializeArray(Ar, Frame.Perception, [](FArchive& InAr, FReplayPerceptionEvent& Event) { InAr << Event; });
+	Ar << Frame.Checksum;
+
+	// 스냅샷 위치는 직전 요소와의 차이로 써서 대부분 1~2바이트에 들어간다
+	FIntVector Previous = FIntVector::ZeroValue;
+	SerializeArray(Ar, Frame.Snapshot, [&Previous](FArchive& InAr, TPair<uint32, FIntVector>& Entry)
+	{
+		FIntVector Delta = Entry.Value - Previous;
+		SerializePacked(InAr, Entry.Key);
+		SerializePacked(InAr, Delta.X);
+		SerializePacked(InAr, Delta.Y);
+		SerializePacked(InAr, Delta.Z);
+		if (InAr.IsLoading())
+		{
+			Entry.Value = Previous + Delta;
+		}
+		Previous = Entry.Value;
+	});
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FReplay_AIStream& Stream)
+{
+	using namespace ReplayStream;
+
+	Ar << Stream.MapName;
+	SerializePacked(Ar, Stream.Seed);
+	SerializePacked(Ar, Stream.SnapshotInterval);
+	SerializeArray(Ar, Stream.CVars, [](FArchive& InAr, TPair<FString, FString>& CVar) { InAr << CVar.Key << CVar.Value; });
+	Ar << Stream.Classes;
+	SerializeArray(Ar, Stream.Frames, [](FArchive& InAr, FReplayFrame& Frame) { InAr << Frame; });
+	return Ar;
+}
+
+void FReplay_AIStream::ApplyCVars() const
+{
+	for (const TPair<FString, FString>& CVar : CVars)
+	{
+		IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*CVar.Key);
+		if (!Variable)
+		{
+			UE_LOG(LogAIStudy, Warning, TEXT("Replay: recorded console variable %s no longer exists"), *CVar.Key);
+			continue;
+		}
+		if (Variable->GetString() != CVar.Value)
+		{
+			Variable->Set(*CVar.Value, ECVF_SetByCode);
+		}
+	}
+}
+
+int32 FReplay_AIStream::FindOrAddClass(const UClass* Class)
+{
+	return Class ? Classes.AddUnique(Class->GetPathName()) : INDEX_NONE;
+}
+
+UClass* FReplay_AIStream::LoadClass(int32 ClassIndex) const
+{
+	return Classes.IsValidIndex(ClassIndex) ? StaticLoadClass(UObject::StaticClass(), nullptr, *Classes[ClassIndex]) : nullptr;
+}
+
+FIntVector FReplay_AIStream::Quantize(const FVector& Location)
+{
+	return FIntVector(FMath::RoundToInt32(Location.X), FMath::RoundToInt32(Location.Y), FMath::RoundToInt32(Location.Z));
+}
+
+bool FReplay_AIStream::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	Writer << const_cast<FReplay_AIStream&>(*this);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Payload.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num()))
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Replay: failed to compress %d bytes"), Payload.Num());
+		return false;
+	}
+	Compressed.SetNum(CompressedSize);
+
+	TArray<uint8> File;
+	FMemoryWriter FileWriter(File);
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	int32 UncompressedSize = Payload.Num();
+	FileWriter << FileMagic << FileVersion << UncompressedSize;
+	File.Append(Compressed);
+
+	if (!FFileHelper::SaveArrayToFile(File, *Path))
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Replay: failed to write %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogAIStudy, Display, TEXT("Replay: wrote %d frames to %s (%d bytes, %d uncompressed)"), Frames.Num(), *Path, File.Num(), Payload.Num());
+	return true;
+}
+
+bool FReplay_AIStream::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> File;
+	if (!FFileHelper::LoadFileToArray(File, *Path))
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Replay: failed to read %s"), *Path);
+		return false;
+	}
+
+	FMemoryReader FileReader(File);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	int32 UncompressedSize = 0;
+	FileReader << FileMagic << FileVersion << UncompressedSize;
+	if (FileReader.IsError() || FileMagic != Magic || FileVersion != Version || UncompressedSize < 0)
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Replay: %s is not a version %u AI replay"), *Path, Version);
+		return false;
+	}
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(UncompressedSize);
+	const int32 HeaderSize = FileReader.Tell();
+	if (!FCompression::UncompressMemory(NAME_Oodle, Payload.GetData(), UncompressedSize, File.GetData() + HeaderSize, File.Num() - HeaderSize))
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Replay: failed to decompress %s"), *Path);
+		return false;
+	}
+
+	*this = FReplay_AIStream();
+	FMemoryReader Reader(Payload);
+	Reader << *this;
+	if (Reader.IsError())
+	{
+		UE_LOG(LogAIStudy, Error, TEXT("Replay: %s is truncated"), *Path);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,687 @@
+#include "Replay_AISubsystem.h"
+#include "AIStudy.h"
+#include "AIStudyCharacter.h"
+#include "Chaser_AIController.h"
+#include "NPC_AIController.h"
+#include "RVO_Character.h"
+#include "EngineUtils.h"
+#include "Engine/TargetPoint.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Perception/AISense_Sight.h"
+
+DECLARE_CYCLE_STAT(TEXT("Replay Record Frame"), STAT_Replay_Record, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Replay Apply Frame"), STAT_Replay_Apply, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Replay Checksum"), STAT_Replay_Checksum, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<int32> CVarReplaySnapshotInterval(
+	TEXT("AIStudy.Replay.SnapshotInterval"),
+	30,
+	TEXT("기록 시 에이전트별 위치 스냅샷을 남기는 프레임 간격 (분기한 에이전트 확인용, 0이면 끔)."));
+
+namespace AIStudyReplay
+{
+	static FString MakeDefaultPath()
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Replays"), FString::Printf(TEXT("AIStudy_%s.aireplay"), *FDateTime::Now().ToString()));
+	}
+}
+
+bool UReplay_AISubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UReplay_AISubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UReplay_AISubsystem, STATGROUP_Tickables);
+}
+
+bool UReplay_AISubsystem::IsDeterministic(const UWorld* World)
+{
+	const UReplay_AISubsystem* Replay = World ? World->GetSubsystem<UReplay_AISubsystem>() : nullptr;
+	return Replay && Replay->Mode != EMode::None;
+}
+
+void UReplay_AISubsystem::Deinitialize()
+{
+	// 기록을 멈추지 않고 PIE를 끝내도 잃지 않도록 기본 경로에 저장
+	if (IsRecording())
+	{
+		StopRecording(AIStudyReplay::MakeDefaultPath());
+	}
+	Reset();
+	Super::Deinitialize();
+}
+
+void UReplay_AISubsystem::StartRecording(int32 Seed)
+{
+	UWorld* World = GetWorld();
+	if (Mode != EMode::None || !World)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Replay: already recording or replaying"));
+		return;
+	}
+
+	Reset();
+	Mode = EMode::Recording;
+	Stream.MapName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	Stream.Seed = Seed;
+	Stream.SnapshotInterval = FMath::Max(CVarReplaySnapshotInterval.GetValueOnGameThread(), 0);
+
+	// 결과에 영향을 주는 모듈 설정은 모두 AIStudy.* 콘솔 변수에 있다
+	IConsoleManager::Get().ForEachConsoleObjectThatStartsWith(FConsoleObjectVisitor::CreateLambda([this](const TCHAR* Name, IConsoleObject* Object)
+	{
+		if (IConsoleVariable* Variable = Object->AsVariable())
+		{
+			Stream.CVars.Emplace(Name, Variable->GetString());
+		}
+	}), TEXT("AIStudy."));
+
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	// 이미 있는 액터는 첫 프레임에 기록한다. 레벨에 배치된 액터는 재생 시 이름으로 찾는다
+	for (AActor* Actor : TActorRange<AActor>(World))
+	{
+		if (Actor->IsA<ATargetPoint>() || Actor->IsA<APawn>())
+		{
+			PendingSpawns.Add({ Actor, Actor->GetActorTransform(), Actor->HasAnyFlags(RF_WasLoaded) });
+		}
+	}
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UReplay_AISubsystem::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UReplay_AISubsystem::OnActorDestroyed));
+	UE_LOG(LogAIStudy, Display, TEXT("Replay: recording %s with seed %d"), *Stream.MapName, Seed);
+}
+
+bool UReplay_AISubsystem::StopRecording(const FString& Path)
+{
+	if (!IsRecording())
+	{
+		return false;
+	}
+
+	const bool bSaved = Path.IsEmpty() || Stream.SaveToFile(Path);
+	Reset();
+	return bSaved;
+}
+
+bool UReplay_AISubsystem::StartReplay(FReplay_AIStream&& InStream)
+{
+	UWorld* World = GetWorld();
+	if (Mode != EMode::None || !World)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Replay: already recording or replaying"));
+		return false;
+	}
+
+	Reset();
+	Stream = MoveTemp(InStream);
+	const FString MapName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	if (MapName != Stream.MapName)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Replay: recorded on %s but replaying on %s"), *Stream.MapName, *MapName);
+	}
+
+	Stream.ApplyCVars();
+	FMath::RandInit(Stream.Seed);
+	FMath::SRandInit(Stream.Seed);
+
+	Mode = EMode::Replaying;
+	Divergence = FReplayDivergence();
+	Divergence.NumFrames = Stream.Frames.Num();
+	if (Stream.Frames.Num() > 0)
+	{
+		ApplyFrameStart(Stream.Frames[0]);
+	}
+	return true;
+}
+
+void UReplay_AISubsystem::StopReplay()
+{
+	if (IsReplaying())
+	{
+		LogReport();
+		Reset();
+	}
+}
+
+void UReplay_AISubsystem::Reset()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	ActorDestroyedHandle.Reset();
+
+	Mode = EMode::None;
+	Stream = FReplay_AIStream();
+	CurrentFrame = 0;
+	Actors.Reset();
+	ActorIds.Reset();
+	DrivenPoses.Reset();
+	PendingSpawns.Reset();
+	PendingDespawns.Reset();
+	PendingPerception.Reset();
+	PerceptionCallIndex = 0;
+	NextPerceptionEvent = 0;
+}
+
+float UReplay_AISubsystem::GetReplayDeltaTime() const
+{
+	return Stream.Frames.IsValidIndex(CurrentFrame) ? Stream.Frames[CurrentFrame].DeltaTime : 0.0f;
+}
+
+int32 UReplay_AISubsystem::GetNumLiveAgents() const
+{
+	int32 Count = 0;
+	for (const TWeakObjectPtr<AActor>& Actor : Actors)
+	{
+		Count += Cast<APawn>(Actor.Get()) ? 1 : 0;
+	}
+	return Count;
+}
+
+uint32 UReplay_AISubsystem::GetId(const AActor* Actor) const
+{
+	const uint32* Id = Actor ? ActorIds.Find(Actor) : nullptr;
+	return Id ? *Id : 0;
+}
+
+AActor* UReplay_AISubsystem::GetActor(uint32 Id) const
+{
+	return Actors.IsValidIndex(static_cast<int32>(Id) - 1) ? Actors[Id - 1].Get() : nullptr;
+}
+
+void UReplay_AISubsystem::OnActorSpawned(AActor* Actor)
+{
+	// 분류는 지연 스폰 설정과 빙의가 끝난 뒤 프레임 기록 때 한다
+	if (IsRecording() && (Actor->IsA<ATargetPoint>() || Actor->IsA<APawn>()))
+	{
+		PendingSpawns.Add({ Actor, Actor->GetActorTransform(), false });
+	}
+}
+
+void UReplay_AISubsystem::OnActorDestroyed(AActor* Actor)
+{
+	uint32 Id = 0;
+	if (IsRecording() && ActorIds.RemoveAndCopyValue(Actor, Id))
+	{
+		PendingDespawns.Add(Id);
+		Actors[Id - 1].Reset();
+		DrivenPoses.Remove(Id);
+	}
+}
+
+bool UReplay_AISubsystem::FilterPerception(AChaser_AIController* Chaser, AActor* Actor, const FAIStimulus& Stimulus)
+{
+	if (IsRecording())
+	{
+		PendingPerception.Add({ Chaser, Actor, Stimulus.StimulusLocation, Stimulus.ReceiverLocation, Stimulus.WasSuccessfullySensed(), PerceptionCallIndex++ });
+		return true;
+	}
+	if (!IsReplaying() || bInjecting)
+	{
+		return true;
+	}
+
+	// 재생 중에는 시야 판정 비용은 그대로 두고, 기록 때 이 순번의 콜백에서 받은 이벤트로 결과를 바꾼다
+	if (Stream.Frames.IsValidIndex(CurrentFrame))
+	{
+		InjectPerception(Stream.Frames[CurrentFrame], PerceptionCallIndex++);
+	}
+	return false;
+}
+
+void UReplay_AISubsystem::Tick(float DeltaTime)
+{
+	if (IsRecording())
+	{
+		RecordFrame(DeltaTime);
+	}
+	else if (IsReplaying() && Stream.Frames.IsValidIndex(CurrentFrame))
+	{
+		const FReplayFrame& Frame = Stream.Frames[CurrentFrame];
+
+		// 같은 순번의 실시간 콜백이 오지 않은 이벤트는 여기서라도 적용한다 (이미 분기한 경우)
+		const int32 NumLate = Frame.Perception.Num() - NextPerceptionEvent;
+		if (NumLate > 0)
+		{
+			Divergence.NumLatePerception += NumLate;
+			InjectPerception(Frame, MAX_uint32);
+		}
+		CompareFrame(Frame);
+
+		// 프레임 경계는 이 틱이다. 기록도 여기서 콜백 순번을 다시 센다
+		PerceptionCallIndex = 0;
+		NextPerceptionEvent = 0;
+
+		// 다음 프레임 스폰/제거/자세는 다음 월드 틱 전에 적용한다
+		if (Stream.Frames.IsValidIndex(++CurrentFrame))
+		{
+			ApplyFrameStart(Stream.Frames[CurrentFrame]);
+		}
+	}
+}
+
+bool UReplay_AISubsystem::MakeSpawnEvent(AActor& Actor, const FTransform& Transform, bool bPlaced, FReplaySpawnEvent& OutEvent)
+{
+	APawn* Pawn = Cast<APawn>(&Actor);
+	AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+	if (Actor.IsA<ATargetPoint>())
+	{
+		OutEvent.Type = EReplayActorType::Waypoint;
+	}
+	else if (const ARVO_Character* Agent = Cast<ARVO_Character>(&Actor))
+	{
+		OutEvent.Type = EReplayActorType::RVO;
+		OutEvent.Refs[0] = GetId(Agent->TargetActor);
+		OutEvent.Group = Agent->SquadName;
+		OutEvent.Flags = (Agent->bUseFlowField ? ReplayFlags::FlowField : 0) | (Agent->bUseORCAAvoidance ? ReplayFlags::ORCA : 0)
+			| (Agent->bUsePathRequestScheduler ? ReplayFlags::PathScheduler : 0);
+		OutEvent.Radius = Agent->AvoidanceRadius;
+		OutEvent.Weight = Agent->AvoidanceWeight;
+	}
+	else if (const AAIStudyCharacter* Patrol = Cast<AAIStudyCharacter>(&Actor))
+	{
+		OutEvent.Type = EReplayActorType::Patrol;
+		OutEvent.Refs[0] = GetId(Patrol->Target);
+		OutEvent.Refs[1] = GetId(Patrol->Target2);
+		OutEvent.Group = Patrol->PatrolGroup;
+		OutEvent.Flags = (Patrol->bUsePredictiveNavInvoker ? ReplayFlags::PredictiveInvoker : 0) | (Patrol->bIsSucceeded ? ReplayFlags::Succeeded : 0);
+		OutEvent.Radius = Patrol->AcceptanceRadius;
+	}
+	else if (Cast<AChaser_AIController>(Controller))
+	{
+		OutEvent.Type = EReplayActorType::Chaser;
+	}
+	else if (Cast<ANPC_AIController>(Controller))
+	{
+		// 행동 트리와 블랙보드 기본값은 컨트롤러 클래스에 있으므로 클래스만 기록하면 된다
+		OutEvent.Type = EReplayActorType::NPC;
+	}
+	else if (Pawn && Pawn->IsPlayerControlled())
+	{
+		OutEvent.Type = EReplayActorType::Driven;
+	}
+	else
+	{
+		// 재생에서 빠지는 폰은 체크섬에도 들어가지 않으므로 알 수 있게 남긴다
+		if (Pawn)
+		{
+			UE_LOG(LogAIStudy, Warning, TEXT("Replay: %s is not recorded (controller %s is not supported)"),
+				*Pawn->GetName(), Controller ? *Controller->GetClass()->GetName() : TEXT("None"));
+		}
+		return false;
+	}
+
+	OutEvent.Id = Actors.Add(&Actor) + 1;
+	ActorIds.Add(&Actor, OutEvent.Id);
+	OutEvent.ClassIndex = Stream.FindOrAddClass(Actor.GetClass());
+	if (OutEvent.Type != EReplayActorType::Driven && Controller)
+	{
+		OutEvent.ControllerClassIndex = Stream.FindOrAddClass(Controller->GetClass());
+	}
+	if (bPlaced)
+	{
+		OutEvent.PlacedName = Actor.GetName();
+	}
+	OutEvent.Location = Transform.GetLocation();
+	OutEvent.Rotation = Transform.Rotator();
+	OutEvent.Tags = Actor.Tags;
+
+	if (OutEvent.Type == EReplayActorType::Driven)
+	{
+		DrivenPoses.Add(OutEvent.Id, Transform);
+	}
+	return true;
+}
+
+void UReplay_AISubsystem::FlushSpawns(FReplayFrame& Frame)
+{
+	// 다른 액터가 Id로 참조하므로 웨이포인트를 먼저 기록한다
+	for (const bool bWaypoints : { true, false })
+	{
+		for (const FPendingSpawn& Pending : PendingSpawns)
+		{
+			AActor* Actor = Pending.Actor.Get();
+			if (!Actor || Actor->IsA<ATargetPoint>() != bWaypoints || ActorIds.Contains(Actor))
+			{
+				continue;
+			}
+
+			FReplaySpawnEvent Event;
+			if (MakeSpawnEvent(*Actor, Pending.Transform, Pending.bPlaced, Event))
+			{
+				Frame.Spawns.Add(MoveTemp(Event));
+			}
+		}
+	}
+	PendingSpawns.Reset();
+}
+
+void UReplay_AISubsystem::RecordFrame(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Replay_Record);
+
+	const int32 FrameIndex = Stream.Frames.Num();
+	FReplayFrame& Frame = Stream.Frames.AddDefaulted_GetRef();
+	Frame.DeltaTime = DeltaTime;
+	FlushSpawns(Frame);
+	Frame.Despawns = MoveTemp(PendingDespawns);
+	PendingDespawns.Reset();
+
+	for (TPair<uint32, FTransform>& Pose : DrivenPoses)
+	{
+		const AActor* Actor = GetActor(Pose.Key);
+		if (Actor && !Actor->GetActorTransform().Equals(Pose.Value, 0.0))
+		{
+			Pose.Value = Actor->GetActorTransform();
+			Frame.Poses.Add({ Pose.Key, Pose.Value.GetLocation(), Pose.Value.Rotator() });
+		}
+	}
+
+	// 스폰을 먼저 기록했으므로 이번 프레임에 생긴 추적자의 이벤트도 Id를 얻는다
+	for (const FPendingPerception& Pending : PendingPerception)
+	{
+		const AChaser_AIController* Chaser = Pending.Chaser.Get();
+		const uint32 ChaserId = Chaser ? GetId(Chaser->GetPawn()) : 0;
+		const uint32 TargetId = GetId(Pending.Target.Get());
+		if (ChaserId != 0 && TargetId != 0)
+		{
+			Frame.Perception.Add({ ChaserId, TargetId, Pending.bSensed, Pending.StimulusLocation, Pending.ReceiverLocation, Pending.CallIndex });
+		}
+	}
+	PendingPerception.Reset();
+	PerceptionCallIndex = 0;
+
+	const bool bSnapshot = Stream.SnapshotInterval > 0 && FrameIndex % Stream.SnapshotInterval == 0;
+	Frame.Checksum = ComputeChecksum(bSnapshot ? &Frame.Snapshot : nullptr);
+}
+
+uint32 UReplay_AISubsystem::ComputeChecksum(TArray<TPair<uint32, FIntVector>>* OutSnapshot) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Replay_Checksum);
+
+	// 부동소수 잡음에 흔들리지 않도록 cm 단위로 양자화한 위치와 추적자 상태만 해시한다
+	uint32 Crc = 0;
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		const APawn* Pawn = Cast<APawn>(Actors[Index].Get());
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		const uint32 Id = Index + 1;
+		const FIntVector Location = FReplay_AIStream::Quantize(Pawn->GetActorLocation());
+		const AChaser_AIController* Chaser = Cast<AChaser_AIController>(Pawn->GetController());
+		const uint8 State = Chaser ? static_cast<uint8>(Chaser->GetAIState()) + 1 : 0;
+		Crc = FCrc::MemCrc32(&Id, sizeof(Id), Crc);
+		Crc = FCrc::MemCrc32(&Location.X, sizeof(Location.X), Crc);
+		Crc = FCrc::MemCrc32(&Location.Y, sizeof(Location.Y), Crc);
+		Crc = FCrc::MemCrc32(&Location.Z, sizeof(Location.Z), Crc);
+		Crc = FCrc::MemCrc32(&State, sizeof(State), Crc);
+
+		if (OutSnapshot)
+		{
+			OutSnapshot->Emplace(Id, Location);
+		}
+	}
+	return Crc;
+}
+
+AActor* UReplay_AISubsystem::SpawnFromEvent(const FReplaySpawnEvent& Event)
+{
+	UWorld* World = GetWorld();
+	const FTransform Transform(Event.Rotation, Event.Location);
+
+	if (!Event.PlacedName.IsEmpty())
+	{
+		AActor* Placed = FindObject<AActor>(World->PersistentLevel, *Event.PlacedName);
+		if (Placed)
+		{
+			Placed->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+		else
+		{
+			UE_LOG(LogAIStudy, Warning, TEXT("Replay: placed actor %s was not found"), *Event.PlacedName);
+		}
+		return Placed;
+	}
+
+	UClass* Class = Stream.LoadClass(Event.ClassIndex);
+	if (!Class)
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Replay: failed to load class for actor %u"), Event.Id);
+		return nullptr;
+	}
+
+	if (Event.Type == EReplayActorType::Waypoint)
+	{
+		AActor* Waypoint = World->SpawnActorDeferred<AActor>(Class, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Waypoint)
+		{
+			Waypoint->Tags = Event.Tags;
+			Waypoint->FinishSpawning(Transform);
+		}
+		return Waypoint;
+	}
+
+	// 벤치마크와 같이 BeginPlay 전에 설정과 빙의가 끝나도록 지연 스폰
+	APawn* Pawn = World->SpawnActorDeferred<APawn>(Class, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Pawn)
+	{
+		return nullptr;
+	}
+
+	Pawn->Tags = Event.Tags;
+	if (Event.Type == EReplayActorType::Driven)
+	{
+		Pawn->AutoPossessAI = EAutoPossessAI::Disabled;
+		Pawn->AutoPossessPlayer = EAutoReceiveInput::Disabled;
+	}
+	else
+	{
+		Pawn->AutoPossessAI = EAutoPossessAI::Spawned;
+		if (UClass* ControllerClass = Stream.LoadClass(Event.ControllerClassIndex))
+		{
+			Pawn->AIControllerClass = ControllerClass;
+		}
+	}
+
+	if (ARVO_Character* Agent = Event.Type == EReplayActorType::RVO ? Cast<ARVO_Character>(Pawn) : nullptr)
+	{
+		Agent->TargetActor = GetActor(Event.Refs[0]);
+		Agent->SquadName = Event.Group;
+		Agent->bUseFlowField = (Event.Flags & ReplayFlags::FlowField) != 0;
+		Agent->bUseORCAAvoidance = (Event.Flags & ReplayFlags::ORCA) != 0;
+		Agent->bUsePathRequestScheduler = (Event.Flags & ReplayFlags::PathScheduler) != 0;
+		Agent->AvoidanceRadius = Event.Radius;
+		Agent->AvoidanceWeight = Event.Weight;
+	}
+	else if (AAIStudyCharacter* Patrol = Event.Type == EReplayActorType::Patrol ? Cast<AAIStudyCharacter>(Pawn) : nullptr)
+	{
+		Patrol->Target = GetActor(Event.Refs[0]);
+		Patrol->Target2 = GetActor(Event.Refs[1]);
+		Patrol->PatrolGroup = Event.Group;
+		Patrol->bUsePredictiveNavInvoker = (Event.Flags & ReplayFlags::PredictiveInvoker) != 0;
+		Patrol->bIsSucceeded = (Event.Flags & ReplayFlags::Succeeded) != 0;
+		Patrol->AcceptanceRadius = Event.Radius;
+	}
+	Pawn->FinishSpawning(Transform);
+
+	// Driven 폰은 기록된 궤적만 따르도록 이동 컴포넌트를 끈다
+	if (Event.Type == EReplayActorType::Driven)
+	{
+		if (UPawnMovementComponent* Movement = Pawn->GetMovementComponent())
+		{
+			Movement->Deactivate();
+		}
+	}
+	return Pawn;
+}
+
+void UReplay_AISubsystem::ApplyFrameStart(const FReplayFrame& Frame)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_Replay_Apply);
+
+	for (const FReplaySpawnEvent& Event : Frame.Spawns)
+	{
+		if (Actors.Num() < static_cast<int32>(Event.Id))
+		{
+			Actors.SetNum(Event.Id);
+		}
+		AActor* Actor = SpawnFromEvent(Event);
+		Actors[Event.Id - 1] = Actor;
+		if (Actor)
+		{
+			ActorIds.Add(Actor, Event.Id);
+		}
+	}
+
+	for (const uint32 Id : Frame.Despawns)
+	{
+		AActor* Actor = GetActor(Id);
+		if (!Actor)
+		{
+			continue;
+		}
+		if (const APawn* Pawn = Cast<APawn>(Actor))
+		{
+			if (AController* Controller = Pawn->GetController())
+			{
+				Controller->Destroy();
+			}
+		}
+		ActorIds.Remove(Actor);
+		Actors[Id - 1].Reset();
+		Actor->Destroy();
+	}
+
+	for (const FReplayPose& Pose : Frame.Poses)
+	{
+		if (AActor* Actor = GetActor(Pose.Id))
+		{
+			Actor->SetActorLocationAndRotation(Pose.Location, Pose.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+}
+
+void UReplay_AISubsystem::InjectPerception(const FReplayFrame& Frame, uint32 LastCallIndex)
+{
+	// 기록된 이벤트는 모두 시야 자극이다 (엔진 시야와 일괄 시야 모두 Sight 감각으로 전달)
+	const UAISense& SightSense = *GetDefault<UAISense_Sight>();
+	TGuardValue<bool> InjectingGuard(bInjecting, true);
+	while (Frame.Perception.IsValidIndex(NextPerceptionEvent) && Frame.Perception[NextPerceptionEvent].CallIndex <= LastCallIndex)
+	{
+		const FReplayPerceptionEvent& Event = Frame.Perception[NextPerceptionEvent++];
+		const APawn* ChaserPawn = Cast<APawn>(GetActor(Event.ChaserId));
+		AChaser_AIController* Chaser = ChaserPawn ? Cast<AChaser_AIController>(ChaserPawn->GetController()) : nullptr;
+		AActor* Target = GetActor(Event.TargetId);
+		if (!Chaser || !Target)
+		{
+			continue;
+		}
+
+		const FAIStimulus Stimulus(SightSense, 1.0f, Event.StimulusLocation, Event.ReceiverLocation,
+			Event.bSensed ? FAIStimulus::SensingSucceeded : FAIStimulus::SensingFailed);
+		Chaser->OnPerceptionUpdated(Target, Stimulus);
+	}
+}
+
+void UReplay_AISubsystem::CompareFrame(const FReplayFrame& Frame)
+{
+	TArray<TPair<uint32, FIntVector>> Snapshot;
+	const uint32 Checksum = ComputeChecksum(Frame.Snapshot.Num() > 0 ? &Snapshot : nullptr);
+	++Divergence.NumReplayedFrames;
+	if (Checksum != Frame.Checksum)
+	{
+		if (Divergence.NumDivergedFrames++ == 0)
+		{
+			Divergence.FirstDivergedFrame = CurrentFrame;
+			UE_LOG(LogAIStudy, Warning, TEXT("Replay: diverged from the recording at frame %d"), CurrentFrame);
+		}
+	}
+
+	// 두 스냅샷 모두 Id 순서이므로 한 번에 맞춰 본다
+	int32 Replayed = 0;
+	for (const TPair<uint32, FIntVector>& Recorded : Frame.Snapshot)
+	{
+		while (Snapshot.IsValidIndex(Replayed) && Snapshot[Replayed].Key < Recorded.Key)
+		{
+			++Replayed;
+		}
+		if (!Snapshot.IsValidIndex(Replayed) || Snapshot[Replayed].Key != Recorded.Key)
+		{
+			++Divergence.NumMissingAgents;
+			continue;
+		}
+
+		const FIntVector Delta = Snapshot[Replayed].Value - Recorded.Value;
+		const int32 Error = FMath::Max3(FMath::Abs(Delta.X), FMath::Abs(Delta.Y), FMath::Abs(Delta.Z));
+		if (Error > Divergence.MaxSnapshotError)
+		{
+			Divergence.MaxSnapshotError = Error;
+			Divergence.MaxErrorAgent = Recorded.Key;
+		}
+	}
+}
+
+void UReplay_AISubsystem::LogReport() const
+{
+	if (IsRecording())
+	{
+		UE_LOG(LogAIStudy, Display, TEXT("Replay: recording frame %d, %d actors, %d classes"), Stream.Frames.Num(), ActorIds.Num(), Stream.Classes.Num());
+		return;
+	}
+
+	if (Divergence.NumDivergedFrames == 0)
+	{
+		UE_LOG(LogAIStudy, Display, TEXT("Replay: %d / %d frames replayed, identical to the recording"), Divergence.NumReplayedFrames, Divergence.NumFrames);
+	}
+	else
+	{
+		UE_LOG(LogAIStudy, Warning, TEXT("Replay: %d / %d frames replayed, %d diverged (first at frame %d), max snapshot error %d cm (actor %u), %d agents missing, %d perception events applied late"),
+			Divergence.NumReplayedFrames, Divergence.NumFrames, Divergence.NumDivergedFrames, Divergence.FirstDivergedFrame,
+			Divergence.MaxSnapshotError, Divergence.MaxErrorAgent, Divergence.NumMissingAgents, Divergence.NumLatePerception);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ReplayRecordCommand(
+	TEXT("AIStudy.Replay.Record"),
+	TEXT("AI 시뮬레이션 기록을 시작한다. 인자: [Seed]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UReplay_AISubsystem* Replay = World ? World->GetSubsystem<UReplay_AISubsystem>() : nullptr)
+		{
+			Replay->StartRecording(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : FMath::Rand());
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs ReplayStopCommand(
+	TEXT("AIStudy.Replay.Stop"),
+	TEXT("기록을 끝내고 저장한다. 인자: [경로] (기본은 Saved/Replays)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UReplay_AISubsystem* Replay = World ? World->GetSubsystem<UReplay_AISubsystem>() : nullptr)
+		{
+			Replay->StopRecording(Args.Num() > 0 ? Args[0] : AIStudyReplay::MakeDefaultPath());
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld ReplayReportCommand(
+	TEXT("AIStudy.Replay.Report"),
+	TEXT("기록 중이면 진행 상황을, 재생 후에는 분기 결과를 로그로 출력한다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UReplay_AISubsystem* Replay = World ? World->GetSubsystem<UReplay_AISubsystem>() : nullptr)
+		{
+			Replay->LogReport();
+		}
+	}));
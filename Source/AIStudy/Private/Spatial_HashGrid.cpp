@@ -0,0 +1,107 @@
+#include "Spatial_HashGrid.h"
+
+FSpatial_HashGrid::FSpatial_HashGrid(float InCellSize)
+{
+	Reset(InCellSize);
+}
+
+void FSpatial_HashGrid::Reset(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	InvCellSize = 1.0f / CellSize;
+	NumActive = 0;
+	Locations.Reset();
+	ItemCells.Reset();
+	bActive.Reset();
+	FreeHandles.Reset();
+	Cells.Reset();
+}
+
+void FSpatial_HashGrid::Build(TConstArrayView<FVector> InLocations)
+{
+	// 버킷 배열의 할당은 재사용하고 내용만 비운다
+	for (TPair<FIntPoint, TArray<int32>>& Pair : Cells)
+	{
+		Pair.Value.Reset();
+	}
+	FreeHandles.Reset();
+
+	Locations.Reset();
+	Locations.Append(InLocations.GetData(), InLocations.Num());
+	ItemCells.SetNumUninitialized(Locations.Num());
+	bActive.Init(true, Locations.Num());
+	NumActive = Locations.Num();
+
+	for (int32 Handle = 0; Handle < Locations.Num(); ++Handle)
+	{
+		ItemCells[Handle] = ToCell(Locations[Handle]);
+		Cells.FindOrAdd(ItemCells[Handle]).Add(Handle);
+	}
+}
+
+int32 FSpatial_HashGrid::AddItem(const FVector& Location)
+{
+	int32 Handle;
+	if (FreeHandles.Num() > 0)
+	{
+		Handle = FreeHandles.Pop(EAllowShrinking::No);
+		Locations[Handle] = Location;
+		bActive[Handle] = true;
+	}
+	else
+	{
+		Handle = Locations.Add(Location);
+		ItemCells.AddUninitialized();
+		bActive.Add(true);
+	}
+
+	ItemCells[Handle] = ToCell(Location);
+	AddToCell(ItemCells[Handle], Handle);
+	++NumActive;
+	return Handle;
+}
+
+void FSpatial_HashGrid::RemoveItem(int32 Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	RemoveFromCell(ItemCells[Handle], Handle);
+	bActive[Handle] = false;
+	FreeHandles.Add(Handle);
+	--NumActive;
+}
+
+void FSpatial_HashGrid::UpdateItem(int32 Handle, const FVector& Location)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	Locations[Handle] = Location;
+
+	// 셀이 바뀌었을 때만 버킷 이동
+	const FIntPoint NewCell = ToCell(Location);
+	if (NewCell != ItemCells[Handle])
+	{
+		RemoveFromCell(ItemCells[Handle], Handle);
+		AddToCell(NewCell, Handle);
+		ItemCells[Handle] = NewCell;
+	}
+}
+
+void FSpatial_HashGrid::AddToCell(const FIntPoint& Cell, int32 Handle)
+{
+	Cells.FindOrAdd(Cell).Add(Handle);
+}
+
+void FSpatial_HashGrid::RemoveFromCell(const FIntPoint& Cell, int32 Handle)
+{
+	if (TArray<int32>* Bucket = Cells.Find(Cell))
+	{
+		Bucket->RemoveSingleSwap(Handle, EAllowShrinking::No);
+	}
+}
@@ -0,0 +1,266 @@
+#include "Spatial_HashSubsystem.h"
+#include "AIStudy.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spatial Hash Update"), STAT_SpatialHash_Update, STATGROUP_AIStudy);
+DECLARE_CYCLE_STAT(TEXT("Spatial Hash Query"), STAT_SpatialHash_Query, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spatial Hash Pawns"), STAT_SpatialHash_NumPawns, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarSpatialHashCellSize(
+	TEXT("AIStudy.SpatialHash.CellSize"),
+	1000.0f,
+	TEXT("폰 공간 해시의 셀 크기. 월드 시작 시 적용된다."));
+
+const FName USpatial_HashSubsystem::ChaserTargetTag(TEXT("ChaserTarget"));
+
+bool USpatial_HashSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USpatial_HashSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpatial_HashSubsystem, STATGROUP_Tickables);
+}
+
+void USpatial_HashSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Grid.Reset(CVarSpatialHashCellSize.GetValueOnGameThread());
+}
+
+void USpatial_HashSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	Super::Deinitialize();
+}
+
+void USpatial_HashSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 레벨에 배치된 폰은 한 번만 훑고, 이후에는 스폰 이벤트로 증분 추가
+	for (APawn* Pawn : TActorRange<APawn>(&InWorld))
+	{
+		TrackPawn(Pawn);
+	}
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USpatial_HashSubsystem::OnActorSpawned));
+}
+
+void USpatial_HashSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		TrackPawn(Pawn);
+	}
+}
+
+void USpatial_HashSubsystem::TrackPawn(APawn* Pawn)
+{
+	if (!Pawn)
+	{
+		return;
+	}
+
+	const int32 Handle = Grid.AddItem(Pawn->GetActorLocation());
+	if (Handle >= Pawns.Num())
+	{
+		Pawns.SetNum(Handle + 1);
+		TargetFlags.SetNumZeroed(Handle + 1);
+	}
+	Pawns[Handle] = Pawn;
+	TargetFlags[Handle] = IsValidTarget(Pawn) ? 1 : 0;
+	bTargetsChanged |= TargetFlags[Handle] != 0;
+}
+
+void USpatial_HashSubsystem::UntrackPawn(const APawn* Pawn)
+{
+	// 드물게 불리므로 핸들 역참조 없이 훑는다
+	const int32 Handle = Pawns.IndexOfByKey(Pawn);
+	if (Handle != INDEX_NONE && Grid.IsValidHandle(Handle))
+	{
+		bTargetsChanged |= TargetFlags[Handle] != 0;
+		Grid.RemoveItem(Handle);
+		Pawns[Handle].Reset();
+		TargetFlags[Handle] = 0;
+	}
+}
+
+bool USpatial_HashSubsystem::IsValidTarget(const AActor* Actor)
+{
+	const APawn* Pawn = Cast<APawn>(Actor);
+	return Pawn && (Pawn->IsPlayerControlled() || Pawn->ActorHasTag(ChaserTargetTag));
+}
+
+void USpatial_HashSubsystem::Tick(float DeltaTime)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_SpatialHash_Update);
+
+	double MaxStepSq = 0.0;
+	bool bTargetSetChanged = bTargetsChanged;
+	bTargetsChanged = false;
+
+	for (int32 Handle = 0; Handle < Pawns.Num(); ++Handle)
+	{
+		if (!Grid.IsValidHandle(Handle))
+		{
+			continue;
+		}
+
+		// 파괴된 폰은 여기서 정리 (핸들은 재사용된다)
+		const APawn* Pawn = Pawns[Handle].Get();
+		if (!IsValid(Pawn))
+		{
+			bTargetSetChanged |= TargetFlags[Handle] != 0;
+			Grid.RemoveItem(Handle);
+			Pawns[Handle].Reset();
+			TargetFlags[Handle] = 0;
+			continue;
+		}
+
+		const FVector Location = Pawn->GetActorLocation();
+		MaxStepSq = FMath::Max(MaxStepSq, FVector::DistSquared(Grid.GetLocation(Handle), Location));
+		Grid.UpdateItem(Handle, Location);
+
+		// 빙의 상태는 바뀔 수 있으므로 매 프레임 갱신
+		const uint8 bIsTarget = IsValidTarget(Pawn) ? 1 : 0;
+		bTargetSetChanged |= TargetFlags[Handle] != bIsTarget;
+		TargetFlags[Handle] = bIsTarget;
+	}
+
+	SET_DWORD_STAT(STAT_SpatialHash_NumPawns, Grid.Num());
+
+	OnUpdated.Broadcast(bTargetSetChanged ? UE_BIG_NUMBER : static_cast<float>(FMath::Sqrt(MaxStepSq)));
+}
+
+APawn* USpatial_HashSubsystem::FindNearestTarget(const FVector& Origin, float MaxRadius, const AActor* Ignore) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_SpatialHash_Query);
+
+	TArray<int32> Result;
+	Grid.FindNearest(Origin, MaxRadius, 1, Result, [this, Ignore](int32 Handle)
+	{
+		const APawn* Pawn = Pawns[Handle].Get();
+		return TargetFlags[Handle] != 0 && Pawn && Pawn != Ignore;
+	});
+	return Result.Num() > 0 ? Pawns[Result[0]].Get() : nullptr;
+}
+
+void USpatial_HashSubsystem::QueryPawnsInRadius(const FVector& Origin, float Radius, TArray<APawn*>& OutPawns, bool bTargetsOnly) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_SpatialHash_Query);
+
+	TArray<int32> Result;
+	Grid.QueryRadius(Origin, Radius, Result, [this, bTargetsOnly](int32 Handle)
+	{
+		return !bTargetsOnly || TargetFlags[Handle] != 0;
+	});
+
+	OutPawns.Reset(Result.Num());
+	for (const int32 Handle : Result)
+	{
+		if (APawn* Pawn = Pawns[Handle].Get())
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+}
+
+void USpatial_HashSubsystem::FindNearestPawns(const FVector& Origin, float MaxRadius, int32 K, TArray<APawn*>& OutPawns, bool bTargetsOnly) const
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_SpatialHash_Query);
+
+	TArray<int32> Result;
+	Grid.FindNearest(Origin, MaxRadius, K, Result, [this, bTargetsOnly](int32 Handle)
+	{
+		return !bTargetsOnly || TargetFlags[Handle] != 0;
+	});
+
+	OutPawns.Reset(Result.Num());
+	for (const int32 Handle : Result)
+	{
+		if (APawn* Pawn = Pawns[Handle].Get())
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 격자 대 전수 비교 벤치마크 (AIStudy.SpatialHash.Benchmark [QueryRadius])
+
+static void RunSpatialHashBenchmark(const TArray<FString>& Args)
+{
+	const float QueryRadius = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 1500.0f;
+	const int32 AgentCounts[] = { 100, 1000, 10000 };
+
+	for (const int32 NumAgents : AgentCounts)
+	{
+		// 밀도를 일정하게 유지하도록 영역 크기를 에이전트 수에 맞춘다
+		FRandomStream Random(12345);
+		const float HalfExtent = FMath::Sqrt(static_cast<float>(NumAgents)) * 300.0f;
+		TArray<FVector> Locations;
+		Locations.SetNumUninitialized(NumAgents);
+		for (FVector& Location : Locations)
+		{
+			Location = FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+		}
+
+		const double BuildStart = FPlatformTime::Seconds();
+		FSpatial_HashGrid Grid(CVarSpatialHashCellSize.GetValueOnGameThread());
+		Grid.Build(Locations);
+		const double BuildMs = (FPlatformTime::Seconds() - BuildStart) * 1000.0;
+
+		// 격자 반경 쿼리
+		int64 GridHits = 0;
+		TArray<int32> Result;
+		const double GridStart = FPlatformTime::Seconds();
+		for (const FVector& Center : Locations)
+		{
+			Result.Reset();
+			Grid.QueryRadius(Center, QueryRadius, Result);
+			GridHits += Result.Num();
+		}
+		const double GridMs = (FPlatformTime::Seconds() - GridStart) * 1000.0;
+
+		// 격자 최근접 쿼리
+		int64 NearestChecksum = 0;
+		const double NearestStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			Grid.FindNearest(Locations[Index], QueryRadius, 1, Result, [Index](int32 Handle) { return Handle != Index; });
+			NearestChecksum += Result.Num() > 0 ? Result[0] : -1;
+		}
+		const double NearestMs = (FPlatformTime::Seconds() - NearestStart) * 1000.0;
+
+		// 전수 비교
+		int64 BruteHits = 0;
+		const double RadiusSq = FMath::Square(static_cast<double>(QueryRadius));
+		const double BruteStart = FPlatformTime::Seconds();
+		for (const FVector& Center : Locations)
+		{
+			for (const FVector& Other : Locations)
+			{
+				BruteHits += FVector::DistSquared(Center, Other) <= RadiusSq ? 1 : 0;
+			}
+		}
+		const double BruteMs = (FPlatformTime::Seconds() - BruteStart) * 1000.0;
+
+		UE_LOG(LogAIStudy, Display, TEXT("SpatialHash N=%d: build %.3f ms, grid radius %.3f ms, grid nearest %.3f ms, brute force %.3f ms (x%.1f), hits %lld/%lld, nearest checksum %lld"),
+			NumAgents, BuildMs, GridMs, NearestMs, BruteMs, GridMs > 0.0 ? BruteMs / GridMs : 0.0, GridHits, BruteHits, NearestChecksum);
+		if (GridHits != BruteHits)
+		{
+			UE_LOG(LogAIStudy, Error, TEXT("SpatialHash N=%d: grid and brute force disagree"), NumAgents);
+		}
+	}
+}
+
+static FAutoConsoleCommand SpatialHashBenchmarkCommand(
+	TEXT("AIStudy.SpatialHash.Benchmark"),
+	TEXT("100/1k/10k 에이전트에서 공간 해시와 전수 비교의 반경 쿼리 비용을 비교한다. 인자: [QueryRadius]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunSpatialHashBenchmark));
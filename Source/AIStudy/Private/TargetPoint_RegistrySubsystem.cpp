@@ -0,0 +1,315 @@
+#include "TargetPoint_RegistrySubsystem.h"
+#include "AIStudy.h"
+#include "Engine/Level.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("TargetPoint Registry Scan"), STAT_TargetPointRegistry_Scan, STATGROUP_AIStudy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered TargetPoints"), STAT_TargetPointRegistry_Num, STATGROUP_AIStudy);
+
+static TAutoConsoleVariable<float> CVarTargetPointCellSize(
+	TEXT("AIStudy.TargetPoints.CellSize"),
+	2000.0f,
+	TEXT("웨이포인트 공간 색인의 셀 크기. 월드 시작 시 적용된다."));
+
+bool UTargetPoint_RegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTargetPoint_RegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(CVarTargetPointCellSize.GetValueOnGameThread(), 1.0f);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UTargetPoint_RegistrySubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UTargetPoint_RegistrySubsystem::OnLevelRemoved);
+}
+
+void UTargetPoint_RegistrySubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	Super::Deinitialize();
+}
+
+void UTargetPoint_RegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 액터 BeginPlay보다 먼저 호출되므로 순찰자가 시작할 때 이미 색인이 준비되어 있다.
+	// 레벨 → 액터 배열 순서로 훑는다. 레벨에 저장된 순서라 실행마다 같지만,
+	// GetAllActorsOfClass(TActorIterator)는 UObject 해시 순서로 돌기 때문에 [0], [1] 쌍이 레지스트리가 없을 때와 다를 수 있다.
+	for (ULevel* Level : InWorld.GetLevels())
+	{
+		if (Level && Level->bIsVisible)
+		{
+			RegisterLevel(Level);
+		}
+	}
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UTargetPoint_RegistrySubsystem::OnActorSpawned));
+	ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UTargetPoint_RegistrySubsystem::OnActorDestroyed));
+}
+
+void UTargetPoint_RegistrySubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld() && World->HasBegunPlay())
+	{
+		RegisterLevel(Level);
+	}
+}
+
+void UTargetPoint_RegistrySubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		UnregisterLevel(Level);
+	}
+}
+
+void UTargetPoint_RegistrySubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (ATargetPoint* Waypoint = Cast<ATargetPoint>(Actor))
+	{
+		RegisterWaypoint(Waypoint);
+	}
+}
+
+void UTargetPoint_RegistrySubsystem::OnActorDestroyed(AActor* Actor)
+{
+	// 파괴된 웨이포인트가 그룹 앞쪽에 남아 있으면 조회마다 건너뛰어야 하므로 바로 뺀다
+	if (ATargetPoint* Waypoint = Cast<ATargetPoint>(Actor))
+	{
+		UnregisterWaypoint(Waypoint);
+	}
+}
+
+void UTargetPoint_RegistrySubsystem::RegisterLevel(ULevel* Level)
+{
+	AISTUDY_SCOPE_CYCLE_COUNTER(STAT_TargetPointRegistry_Scan);
+
+	if (!Level || LevelWaypoints.Contains(Level))
+	{
+		return;
+	}
+
+	// 추가된 레벨의 액터만 훑는다
+	LevelWaypoints.Add(Level);
+	for (AActor* Actor : Level->Actors)
+	{
+		if (ATargetPoint* Waypoint = Cast<ATargetPoint>(Actor))
+		{
+			RegisterWaypoint(Waypoint);
+		}
+	}
+}
+
+void UTargetPoint_RegistrySubsystem::UnregisterLevel(ULevel* Level)
+{
+	TArray<TWeakObjectPtr<ATargetPoint>> Waypoints;
+	if (!LevelWaypoints.RemoveAndCopyValue(Level, Waypoints))
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<ATargetPoint>& Waypoint : Waypoints)
+	{
+		UnregisterWaypoint(Waypoint.Get());
+	}
+}
+
+FIntPoint UTargetPoint_RegistrySubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UTargetPoint_RegistrySubsystem::RegisterWaypoint(ATargetPoint* Waypoint)
+{
+	if (!IsValid(Waypoint))
+	{
+		return;
+	}
+
+	// 월드 시작 시 웨이포인트 수만큼 불리므로 중복 확인은 배열이 아닌 맵으로 한다
+	if (RegisteredCells.Contains(Waypoint))
+	{
+		return;
+	}
+	const FIntPoint Cell = ToCell(Waypoint->GetActorLocation());
+	RegisteredCells.Add(Waypoint, Cell);
+
+	TArray<TWeakObjectPtr<ATargetPoint>>& All = Groups.FindOrAdd(NAME_None);
+	All.Add(Waypoint);
+	for (const FName& Tag : Waypoint->Tags)
+	{
+		Groups.FindOrAdd(Tag).Add(Waypoint);
+	}
+	Cells.FindOrAdd(Cell).Add(Waypoint);
+	if (TArray<TWeakObjectPtr<ATargetPoint>>* LevelList = LevelWaypoints.Find(Waypoint->GetLevel()))
+	{
+		LevelList->Add(Waypoint);
+	}
+
+	SET_DWORD_STAT(STAT_TargetPointRegistry_Num, RegisteredCells.Num());
+}
+
+void UTargetPoint_RegistrySubsystem::UnregisterWaypoint(ATargetPoint* Waypoint)
+{
+	FIntPoint Cell;
+	if (!Waypoint || !RegisteredCells.RemoveAndCopyValue(Waypoint, Cell))
+	{
+		return;
+	}
+
+	// 순서를 유지해야 GetPatrolPair 결과가 바뀌지 않으므로 Swap 없이 제거
+	for (TPair<FName, TArray<TWeakObjectPtr<ATargetPoint>>>& Pair : Groups)
+	{
+		Pair.Value.Remove(Waypoint);
+	}
+	// 등록 뒤에 옮겨졌을 수 있으므로 등록 당시 셀에서 뺀다
+	if (TArray<TWeakObjectPtr<ATargetPoint>>* Bucket = Cells.Find(Cell))
+	{
+		Bucket->RemoveSwap(Waypoint);
+	}
+	SET_DWORD_STAT(STAT_TargetPointRegistry_Num, RegisteredCells.Num());
+}
+
+int32 UTargetPoint_RegistrySubsystem::GetNumWaypoints() const
+{
+	const TArray<TWeakObjectPtr<ATargetPoint>>* All = Groups.Find(NAME_None);
+	return All ? All->Num() : 0;
+}
+
+bool UTargetPoint_RegistrySubsystem::GetPatrolPair(FName Group, ATargetPoint*& OutFirst, ATargetPoint*& OutSecond) const
+{
+	OutFirst = nullptr;
+	OutSecond = nullptr;
+
+	const TArray<TWeakObjectPtr<ATargetPoint>>* Waypoints = Groups.Find(Group);
+	if (!Waypoints)
+	{
+		return false;
+	}
+
+	// 파괴된 항목만 건너뛰므로 보통 앞의 두 개에서 끝난다
+	for (const TWeakObjectPtr<ATargetPoint>& Waypoint : *Waypoints)
+	{
+		if (ATargetPoint* Valid = Waypoint.Get())
+		{
+			if (!OutFirst)
+			{
+				OutFirst = Valid;
+			}
+			else
+			{
+				OutSecond = Valid;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void UTargetPoint_RegistrySubsystem::GetWaypointsInGroup(FName Group, TArray<ATargetPoint*>& OutWaypoints) const
+{
+	OutWaypoints.Reset();
+	if (const TArray<TWeakObjectPtr<ATargetPoint>>* Waypoints = Groups.Find(Group))
+	{
+		for (const TWeakObjectPtr<ATargetPoint>& Waypoint : *Waypoints)
+		{
+			if (ATargetPoint* Valid = Waypoint.Get())
+			{
+				OutWaypoints.Add(Valid);
+			}
+		}
+	}
+}
+
+void UTargetPoint_RegistrySubsystem::GetWaypointsNear(const FVector& Location, float Radius, TArray<ATargetPoint*>& OutWaypoints) const
+{
+	OutWaypoints.Reset();
+
+	const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+	const FIntPoint MinCell = ToCell(Location - FVector(Radius));
+	const FIntPoint MaxCell = ToCell(Location + FVector(Radius));
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const TArray<TWeakObjectPtr<ATargetPoint>>* Bucket = Cells.Find(FIntPoint(X, Y));
+			if (!Bucket)
+			{
+				continue;
+			}
+			for (const TWeakObjectPtr<ATargetPoint>& Waypoint : *Bucket)
+			{
+				ATargetPoint* Valid = Waypoint.Get();
+				if (Valid && FVector::DistSquared(Valid->GetActorLocation(), Location) <= RadiusSq)
+				{
+					OutWaypoints.Add(Valid);
+				}
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 순찰자 시작 비용과 레지스트리 등록 비용 측정 (AIStudy.TargetPoints.Benchmark [Patrollers])
+
+static void RunTargetPointBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	const int32 NumPatrollers = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+
+	// 기존 방식: 순찰자마다 BeginPlay와 StartMoving에서 두 번씩 전체 액터를 훑는다
+	TArray<AActor*> FoundTargets;
+	const double ScanStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumPatrollers * 2; ++Index)
+	{
+		FoundTargets.Reset();
+		UGameplayStatics::GetAllActorsOfClass(World, ATargetPoint::StaticClass(), FoundTargets);
+	}
+	const double ScanMs = (FPlatformTime::Seconds() - ScanStart) * 1000.0;
+
+	double RegistryMs = 0.0;
+	if (const UTargetPoint_RegistrySubsystem* Registry = World->GetSubsystem<UTargetPoint_RegistrySubsystem>())
+	{
+		ATargetPoint* First = nullptr;
+		ATargetPoint* Second = nullptr;
+		const double RegistryStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumPatrollers * 2; ++Index)
+		{
+			Registry->GetPatrolPair(NAME_None, First, Second);
+		}
+		RegistryMs = (FPlatformTime::Seconds() - RegistryStart) * 1000.0;
+	}
+
+	// 월드 시작 시 등록 비용: 같은 웨이포인트를 색인이 비어 있는 임시 레지스트리에 다시 등록한다
+	UTargetPoint_RegistrySubsystem* Scratch = NewObject<UTargetPoint_RegistrySubsystem>(World);
+	const double RegisterStart = FPlatformTime::Seconds();
+	for (TActorIterator<ATargetPoint> It(World); It; ++It)
+	{
+		Scratch->RegisterWaypoint(*It);
+	}
+	const double RegisterMs = (FPlatformTime::Seconds() - RegisterStart) * 1000.0;
+
+	UE_LOG(LogAIStudy, Display, TEXT("TargetPoints: %d patrollers, %d target points: GetAllActorsOfClass %.3f ms, registry %.3f ms, startup registration %.3f ms"),
+		NumPatrollers, FoundTargets.Num(), ScanMs, RegistryMs, RegisterMs);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs TargetPointBenchmarkCommand(
+	TEXT("AIStudy.TargetPoints.Benchmark"),
+	TEXT("N명의 순찰자 시작 시 웨이포인트 조회 비용을 GetAllActorsOfClass와 레지스트리로 비교하고, 월드 시작 시 등록 비용을 잰다. 인자: [Patrollers]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunTargetPointBenchmark));
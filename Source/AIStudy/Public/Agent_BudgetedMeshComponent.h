@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Agent_BudgetedMeshComponent.generated.h"
+
+// AI 캐릭터용 스켈레탈 메시. 애니메이션 예산 할당기(AnimationBudgetAllocator)에 등록되어
+// 고정 ms 예산 안에서 중요도 순으로 틱 간격, 보간, 평가 생략이 정해진다.
+// 중요도는 직접 계산하지 않고 UAgent_SignificanceSubsystem이 관찰자 거리/시야로 넣어 준다.
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class AISTUDY_API UAgent_BudgetedMeshComponent : public USkeletalMeshComponentBudgeted
+{
+	GENERATED_BODY()
+
+public:
+	UAgent_BudgetedMeshComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// 플레이어가 조종하는 폰은 LOD 서브시스템에 등록되지 않아 중요도를 받지 못하므로 건너뛰지 않는 최고 중요도로 둔다.
+	// AI가 다시 빙의하면 LOD 서브시스템이 다음 갱신에서 중요도를 덮어쓴다.
+	void MarkPlayerControlled();
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "NavigationData.h"
+#include "Agent_MovementComponent.generated.h"
+
+// 이동 컴포넌트가 사용할 회피 방식
+UENUM(BlueprintType)
+enum class EAgentAvoidanceMode : uint8
+{
+	Engine UMETA(DisplayName = "Engine RVO"),	// 기본 CharacterMovement 동작 (bUseRVOAvoidance를 따른다)
+	ORCA UMETA(DisplayName = "ORCA"),			// URVO_ORCASubsystem이 계산한 속도를 사용
+};
+
+// AI 에이전트용 CharacterMovementComponent.
+// 회피 방식을 엔진 RVO와 URVO_ORCASubsystem 사이에서 전환할 수 있다.
+// 가벼운 NavWalking 모드를 켜면 내비메시를 벗어나지 않는 에이전트는 바닥 스윕, 계단 오르기, 캡슐 충돌 없이
+// 경로 방향으로 움직인 뒤 내비메시 폴리곤 높이로만 맞춘다. 바닥 높이는 UAgent_NavFloorSubsystem이 일괄 투영하고,
+// 캡슐 스윕은 주변에 움직이는 장애물이 있을 때만 한다. 속도는 실제 이동량으로 갱신되어 회피와 애님 BP가 그대로 읽는다.
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class AISTUDY_API UAgent_MovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	// 회피 방식 전환. ORCA로 바꾸면 엔진 RVO는 끈다.
+	UFUNCTION(BlueprintCallable, Category = "Avoidance")
+	void SetAvoidanceMode(EAgentAvoidanceMode NewMode);
+
+	UFUNCTION(BlueprintPure, Category = "Avoidance")
+	EAgentAvoidanceMode GetAvoidanceMode() const { return AvoidanceMode; }
+
+	// 회피 전 원래 가려던 속도 (ORCA 입력)
+	const FVector& GetPreferredVelocity() const { return PreferredVelocity; }
+
+	// 가벼운 NavWalking 전환. 켜면 지상 이동 모드가 MOVE_NavWalking이 된다.
+	// 플레이어가 조종하는 동안은 켜 두어도 일반 Walking을 쓰고, 컨트롤러가 바뀌면 다시 판단한다.
+	UFUNCTION(BlueprintCallable, Category = "Lean Movement")
+	void SetLeanNavWalking(bool bEnable);
+
+	// 지금 가벼운 NavWalking이 적용되어 있는지 (플레이어 조종 중이면 false)
+	UFUNCTION(BlueprintPure, Category = "Lean Movement")
+	bool IsLeanNavWalking() const { return bLeanNavWalkingActive; }
+
+	// UCharacterMovementComponent
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Avoidance")
+	EAgentAvoidanceMode AvoidanceMode = EAgentAvoidanceMode::Engine;
+
+	// 가벼운 NavWalking 사용 (AIStudy.Movement.Lean CVar로도 켤 수 있다)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lean Movement")
+	bool bUseLeanNavWalking = false;
+
+	// 일괄 투영한 바닥을 재사용할 수 있는 목적지와의 최대 수평 거리
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lean Movement", meta = (ClampMin = "0.0"))
+	float NavFloorReuseDistance = 20.0f;
+
+	// 주변 동적 장애물 확인 간격(초). 확인 반경은 이 시간 동안 최고 속도로 갈 수 있는 거리만큼 넓힌다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lean Movement", meta = (ClampMin = "0.0"))
+	float ObstacleCheckInterval = 0.25f;
+
+	virtual void PhysNavWalking(float DeltaTime, int32 Iterations) override;
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+
+private:
+	friend class URVO_ORCASubsystem;
+	friend class UAgent_NavFloorSubsystem;
+
+	void RegisterWithORCA();
+	void UnregisterFromORCA();
+
+	// bUseLeanNavWalking과 소유 폰의 조종 주체로 지상 이동 모드를 정한다
+	void UpdateLeanNavWalking();
+	UFUNCTION()
+	void OnOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	// 캐시된 바닥(일괄 투영 결과 또는 지난 개별 투영)이 목적지와 가까우면 재사용, 아니면 개별 투영
+	bool FindLeanNavFloor(const FVector& Destination, FNavLocation& OutFloor);
+	void SetBatchedNavFloor(const FVector& Query, bool bSuccess, const FNavLocation& Floor);
+	// 일정 간격으로 주변 WorldDynamic/PhysicsBody를 확인해 캡슐 스윕과 WorldDynamic 충돌을 켜고 끈다
+	void UpdateObstacleProximity(float DeltaTime);
+
+	// ORCA 서브시스템 내 인덱스
+	int32 ORCAIndex = INDEX_NONE;
+
+	FVector PreferredVelocity = FVector::ZeroVector;
+	// 마지막 ORCA 결과. 이웃 때문에 속도가 바뀐 경우에만 bHasORCAVelocity가 true.
+	FVector2f ORCAVelocity = FVector2f::ZeroVector;
+	bool bHasORCAVelocity = false;
+
+	// 가벼운 NavWalking 적용 여부 (요청했더라도 플레이어가 조종하면 끈다)
+	bool bLeanNavWalkingActive = false;
+
+	// 가벼운 NavWalking 바닥 캐시
+	FVector NavFloorQuery = FVector::ZeroVector;
+	FNavLocation NavFloor;
+	bool bHasNavFloor = false;
+	TWeakObjectPtr<const ANavigationData> LeanNavData;
+
+	float ObstacleCheckTimer = 0.0f;
+	bool bNearDynamicObstacle = false;
+};
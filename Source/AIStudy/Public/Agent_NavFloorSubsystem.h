@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "Agent_NavFloorSubsystem.generated.h"
+
+class UAgent_MovementComponent;
+
+// 가벼운 NavWalking 에이전트의 바닥 높이를 프레임마다 한 번에 투영하는 서브시스템.
+// 에이전트는 이동 후 다음 프레임 목적지(위치 + 속도 * DeltaTime)를 요청하고,
+// 모든 틱이 끝난 뒤 내비게이션 데이터별로 BatchProjectPoints를 한 번 호출해 결과를 돌려준다.
+// 다음 프레임 목적지가 예측과 가까우면 에이전트는 개별 투영 없이 이 결과를 쓴다.
+UCLASS()
+class AISTUDY_API UAgent_NavFloorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RequestFloor(UAgent_MovementComponent* Agent, const ANavigationData* NavData, const FVector& Point, const FVector& Extent);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 같은 내비게이션 데이터를 쓰는 요청 묶음. 투영 범위는 처음 요청한 에이전트 것을 쓴다 (같은 에이전트 타입이면 같다)
+	struct FBatch
+	{
+		TWeakObjectPtr<const ANavigationData> NavData;
+		FVector Extent = FVector::ZeroVector;
+		TArray<FNavigationProjectionWork> Workload;
+		TArray<TWeakObjectPtr<UAgent_MovementComponent>> Agents;
+	};
+
+	TArray<FBatch> Batches;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Agent_PoolSubsystem.generated.h"
+
+class AController;
+
+// 누적 풀 통계 (AIStudy.Pool.Report)
+struct FAgentPoolStats
+{
+	uint64 NumAcquires = 0;
+	uint64 NumHits = 0;
+	uint64 NumReleases = 0;
+	// 풀이 가득 차서 파괴한 수
+	uint64 NumOverflows = 0;
+	uint64 NumPrewarmed = 0;
+
+	double GetHitRate() const { return NumAcquires > 0 ? static_cast<double>(NumHits) / NumAcquires : 0.0; }
+};
+
+// AI 폰과 컨트롤러를 짝으로 재사용하는 풀.
+// 스폰할 때마다 NavInvoker, 카메라 붐, 인지 컴포넌트 등을 새로 만들고 파괴 후 GC가 몰리는 비용을 없앤다.
+// 돌려받은 에이전트는 IAgent_Poolable로 상태를 초기화한 뒤 숨기고 틱/충돌/회피를 끈 채 공간 해시에서 빼 둔다.
+// 폰 클래스와 컨트롤러 클래스 쌍마다 따로 쌓는다.
+UCLASS()
+class AISTUDY_API UAgent_PoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 미리 Count쌍을 만들어 풀에 넣어 둔다
+	void Prewarm(UClass* PawnClass, UClass* ControllerClass, int32 Count);
+
+	// 풀에 있으면 꺼내서 Transform으로 옮기고, 없으면 새로 스폰한다.
+	// Configure는 두 경우 모두 BeginPlay/OnPoolAcquired 전에 불린다.
+	APawn* Acquire(UClass* PawnClass, UClass* ControllerClass, const FTransform& Transform, TFunctionRef<void(APawn*)> Configure);
+
+	// 풀로 돌려놓는다. 풀이 가득 찼으면 컨트롤러와 함께 파괴한다.
+	void Release(APawn* Pawn);
+
+	// 풀에 있는 모든 에이전트 파괴
+	void Drain();
+
+	int32 GetNumParked() const;
+	const FAgentPoolStats& GetStats() const { return Stats; }
+	void LogReport() const;
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FPoolKey = TPair<TObjectKey<UClass>, TObjectKey<UClass>>;
+
+	// 컨트롤러 클래스가 없으면 폰 기본값의 AIControllerClass로 스폰되므로 돌려받을 때와 같은 키가 되도록 채운다
+	static FPoolKey MakeKey(UClass* PawnClass, UClass* ControllerClass);
+
+	APawn* SpawnPawn(UClass* PawnClass, UClass* ControllerClass, const FTransform& Transform, TFunctionRef<void(APawn*)> Configure) const;
+	void Park(APawn& Pawn, AController* Controller) const;
+	void Unpark(APawn& Pawn, AController* Controller, const FTransform& Transform) const;
+	static void DestroyPair(APawn& Pawn);
+
+	// 마지막에 넣은 것부터 꺼낸다 (캐시에 남아 있을 가능성이 높다)
+	TMap<FPoolKey, TArray<TWeakObjectPtr<APawn>>> Pools;
+	FAgentPoolStats Stats;
+};
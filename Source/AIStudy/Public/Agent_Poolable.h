@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Agent_Poolable.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UAgent_Poolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// UAgent_PoolSubsystem이 재사용하는 폰/컨트롤러.
+// BeginPlay/EndPlay는 한 번만 불리므로 풀에서 꺼낼 때와 돌려놓을 때 같은 등록/해제를 여기서 다시 한다.
+class AISTUDY_API IAgent_Poolable
+{
+	GENERATED_BODY()
+
+public:
+	// 풀에서 꺼낸 직후 (위치와 설정이 적용되고 틱/충돌이 켜진 뒤). 서브시스템 등록과 이동 시작
+	virtual void OnPoolAcquired() = 0;
+	// 풀로 돌아가기 직전. 이동/경로 요청/타이머/델리게이트를 정리하고 기본값으로 되돌린다
+	virtual void OnPoolReleased() = 0;
+};
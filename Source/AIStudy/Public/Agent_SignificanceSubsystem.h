@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Agent_SignificanceSubsystem.generated.h"
+
+class UActorComponent;
+class UDamageType;
+class USkeletalMeshComponentBudgeted;
+
+// 에이전트 LOD 단계 (관찰자에서 멀수록 뒤쪽)
+UENUM(BlueprintType)
+enum class EAgentLODTier : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant,
+	MAX UMETA(Hidden)
+};
+
+// 로컬 플레이어 시점과의 거리/시야로 에이전트를 LOD 단계로 나누는 서브시스템.
+// 단계마다 폰/컨트롤러/컴포넌트의 틱 간격, 경로 추종 정밀도, 추적자 브레인 평가 간격을 바꾸고,
+// Dormant 단계에서는 틱, 경로 추종, 시야 인지를 모두 멈춘다.
+// 잠든 에이전트는 관찰자가 다가오거나, 피해를 입거나, (추적자의 경우) 감지 반경에 대상이 들어오면 깨어난다.
+// 메시가 애니메이션 예산 할당기에 등록되어 있으면 같은 거리/시야 점수를 할당기 중요도로 넘기고 메시 틱 간격은 할당기에 맡긴다.
+UCLASS()
+class AISTUDY_API UAgent_SignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterAgent(APawn* Pawn);
+	void UnregisterAgent(APawn* Pawn);
+
+	// 이벤트로 깨우기. Duration 동안은 최소 Low 단계를 유지한다 (음수면 기본값).
+	UFUNCTION(BlueprintCallable, Category = "AI|LOD")
+	void WakeAgent(APawn* Pawn, float Duration = -1.0f);
+
+	UFUNCTION(BlueprintPure, Category = "AI|LOD")
+	EAgentLODTier GetAgentTier(const APawn* Pawn) const;
+
+	bool IsDormant(const APawn* Pawn) const { return GetAgentTier(Pawn) == EAgentLODTier::Dormant; }
+
+	// 로컬 플레이어 외의 관찰 지점 (헤드리스 벤치마크 등). 방향이 없어 항상 시야 안으로 취급한다.
+	void AddViewpointOverride(const FVector& Location) { ViewpointOverrides.Add(Location); }
+	void ClearViewpointOverrides() { ViewpointOverrides.Reset(); }
+
+	// 로컬 플레이어 시점과 관찰 지점 오버라이드 (Mass 에이전트 승격에서도 사용)
+	struct FViewpoint
+	{
+		FVector Location;
+		FVector Direction;
+		bool bHasDirection;
+	};
+	void GatherViewpoints(TArray<FViewpoint>& OutViewpoints) const;
+
+	int32 GetTierPopulation(EAgentLODTier Tier) const { return TierPopulation[static_cast<int32>(Tier)]; }
+
+	// 컴포넌트 틱 켜기/끄기. 예산 할당기에 등록된 메시는 할당기가 틱을 관리하므로 직접 바꾸면 할당기가 되돌린다
+	static void SetAgentComponentTickEnabled(UActorComponent& Component, bool bEnabled);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FAgentEntry
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		// 폰이 파괴된 뒤에도 맵에서 지울 수 있도록 키를 따로 보관
+		TObjectKey<APawn> Key;
+		EAgentLODTier Tier = EAgentLODTier::High;
+		double WakeUntil = 0.0;
+		// 애니메이션 예산 할당기에 등록되는 메시 (없으면 null)
+		TWeakObjectPtr<USkeletalMeshComponentBudgeted> BudgetedMesh;
+
+		// 잠들기 직전에 켜져 있던 틱 (깨울 때 이것만 되돌린다)
+		bool bPawnTickWasEnabled = false;
+		bool bControllerTickWasEnabled = false;
+		TArray<TWeakObjectPtr<UActorComponent>> SuspendedComponents;
+	};
+
+	// 가장 가까운 관찰자 기준 거리. 시야 밖이면 OffscreenScale을 곱한다
+	float ComputeViewScore(const APawn& Pawn, const TArray<FViewpoint>& Viewpoints, bool& bOutInView) const;
+	EAgentLODTier EvaluateTier(const FAgentEntry& Entry, float Score, double Now) const;
+	void UpdateAnimationSignificance(const FAgentEntry& Entry, float Score, bool bInView) const;
+	bool ShouldWakeOnProximity(const APawn& Pawn) const;
+	void ApplyTier(FAgentEntry& Entry, EAgentLODTier NewTier);
+	void RemoveAgentAt(int32 Index);
+	void SuspendActor(FAgentEntry& Entry, AActor* Actor, bool& bOutTickWasEnabled);
+	void ResumeActor(AActor* Actor, bool bTickWasEnabled);
+
+	UFUNCTION()
+	void OnAgentDamaged(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser);
+
+	TArray<FAgentEntry> Agents;
+	TMap<TObjectKey<APawn>, int32> AgentIndices;
+	TArray<FVector> ViewpointOverrides;
+	int32 TierPopulation[static_cast<int32>(EAgentLODTier::MAX)] = {};
+	float TimeUntilUpdate = 0.0f;
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTService.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BehaviorTree/Decorators/BTDecorator_BlackboardBase.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Chaser_AIController.h"
+#include "Path_RequestSubsystem.h"
+#include "BT_NPCNodes.generated.h"
+
+class UBehaviorTree;
+
+// NPC 행동 트리용 네이티브 노드.
+// 모두 노드 인스턴스를 만들지 않고(bCreateNodeInstance = false) 상태는 노드 메모리에 둔다.
+// 블랙보드 키는 InitializeFromAsset에서 한 번 해석하고 이후에는 키 ID로만 읽고 쓴다.
+
+// 순찰 그룹의 웨이포인트를 차례로 골라 블랙보드 벡터 키에 쓴다 (이동은 UBTTask_NPCMoveTo가 한다)
+UCLASS()
+class AISTUDY_API UBTTask_NPCPatrol : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_NPCPatrol();
+
+	// UTargetPoint_RegistrySubsystem 그룹 (None이면 모든 웨이포인트)
+	UPROPERTY(EditAnywhere, Category = "Patrol")
+	FName PatrolGroup;
+
+	void SetBlackboardKey(FName KeyName) { BlackboardKey.SelectedKeyName = KeyName; }
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+
+private:
+	struct FMemory
+	{
+		int32 NextWaypoint = 0;
+	};
+};
+
+// 블랙보드의 액터 또는 위치로 이동. UPath_RequestSubsystem에 요청하고 이동 완료 메시지로 끝난다
+UCLASS()
+class AISTUDY_API UBTTask_NPCMoveTo : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_NPCMoveTo();
+
+	UPROPERTY(EditAnywhere, Category = "Movement", meta = (ClampMin = "0.0"))
+	float AcceptanceRadius = 50.0f;
+
+	// 목표가 액터면 움직이는 목표를 따라 경로를 갱신
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	bool bObserveGoalActor = true;
+
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	EPathRequestPriority Priority = EPathRequestPriority::Normal;
+
+	// 목표까지 못 가면 가장 가까운 곳까지의 부분 경로로 이동
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	bool bAllowPartialPath = true;
+
+	void SetBlackboardKey(FName KeyName) { BlackboardKey.SelectedKeyName = KeyName; }
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+
+private:
+	struct FMemory
+	{
+		// ExecuteTask 안에서 요청 결과가 바로 오면 FinishLatentTask 대신 여기에 담아 반환값으로 돌려준다
+		bool bExecuting = false;
+		TOptional<EPathFollowingRequestResult::Type> ImmediateResult;
+	};
+
+	void OnPathRequestFinished(EPathFollowingRequestResult::Type Result, TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp) const;
+};
+
+// 가장 가까운 추적 대상과의 거리로 EAIState를 갱신해 블랙보드에 쓴다 (AChaser_AIController::UpdateAIState와 같은 규칙).
+// 틱 간격에 무작위 편차를 두어 여러 NPC의 평가가 한 프레임에 몰리지 않게 한다.
+UCLASS()
+class AISTUDY_API UBTService_NPCUpdateTarget : public UBTService
+{
+	GENERATED_BODY()
+
+public:
+	UBTService_NPCUpdateTarget();
+
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector TargetActorKey;
+
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector StateKey;
+
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector LastKnownLocationKey;
+
+	UPROPERTY(EditAnywhere, Category = "AI")
+	float ChaseRadius = 1000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "AI")
+	float DetectionRadius = 1500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "AI")
+	float LoseInterestRadius = 2000.0f;
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+};
+
+// 블랙보드의 EAIState가 지정한 상태인지 검사. 값이 바뀌면 관찰자 중단 설정에 따라 분기를 다시 평가한다
+UCLASS()
+class AISTUDY_API UBTDecorator_NPCState : public UBTDecorator_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTDecorator_NPCState();
+
+	UPROPERTY(EditAnywhere, Category = "AI")
+	EAIState State = EAIState::Chasing;
+
+	// 코드로 트리를 만들 때 쓰는 설정 함수
+	void Setup(FName KeyName, EAIState InState, EBTFlowAbortMode::Type AbortMode);
+
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+};
+
+namespace NPCBehavior
+{
+	// 블랙보드 키 이름
+	extern AISTUDY_API const FName TargetActorKey;
+	extern AISTUDY_API const FName StateKey;
+	extern AISTUDY_API const FName LastKnownLocationKey;
+	extern AISTUDY_API const FName PatrolLocationKey;
+
+	// 위 노드로 NPC 트리를 만든다 (BT_NPC 에셋이 비어 있을 때 ANPC_AIController가 쓴다).
+	// 추적 > 의심(마지막 위치로 이동) > 순찰 순의 셀렉터에 대상 갱신 서비스를 단다.
+	AISTUDY_API UBehaviorTree* CreateTree(UObject* Outer);
+}
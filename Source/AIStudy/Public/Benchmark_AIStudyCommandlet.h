@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Benchmark_AIStudyCommandlet.generated.h"
+
+class APawn;
+class ATargetPoint;
+class UPath_RequestSubsystem;
+struct FMassEntityHandle;
+struct FPathRequestCounters;
+struct FReplay_AIStream;
+enum class EAIState : uint8;
+
+// AI 모듈 확장성 측정용 헤드리스 벤치마크.
+// 테스트 맵을 게임 월드로 띄운 뒤 에이전트 수를 단계별로 늘려 가며 고정 스텝으로 프레임을 돌리고,
+// 프레임별 게임 스레드/경로 탐색/회피/인지/행동 트리/애니메이션/이동 시간, 메모리, 경로 요청 수를 CSV로 기록한다.
+//
+// 예) UnrealEditor-Cmd AIStudy.uproject -run=Benchmark_AIStudy -nullrhi -unattended
+//       -Counts=10,100,500,1000,2000,5000 -Frames=300 -Seed=12345 -Mix=RVO:1,Chaser:1,Patrol:1[,NPC:1]
+//       [-Map=/Game/...] [-Output=경로.csv] [-FlowField] [-ORCA] [-PredictiveInvoker] [-LOD] [-Mass] [-RangeEvents] [-CVars=이름=값,...]
+//       [-PathQueries=N]  (에이전트 단계 대신 일반 Recast와 계층 탐색의 쿼리 시간을 경로 길이별로 비교)
+//       [-Record=경로.aireplay]  (실행 전체를 결정적 재생 스트림으로 기록)
+//       [-Replay=경로.aireplay]  (에이전트 단계 대신 기록된 스트림을 다시 돌려 같은 CSV를 만들고 분기하면 1을 반환)
+//       [-CheckRangeEvents]  (가장 큰 단계의 배치를 폴링과 범위 이벤트로 한 번씩 돌려 추적자 상태 전환 순서가 다르면 1을 반환)
+//       [-NPCControllerClass=경로]  (NPC 컨트롤러 교체. 블루프린트 노드로 만든 트리와 네이티브 트리의 BehaviorTreeMs 비교용)
+//       [-AnimBudget=ms]  (애니메이션 예산 할당기를 이 예산으로 켠다. 없으면 할당기를 꺼서 모든 메시가 매 프레임 평가된다.
+//                          메시/애님이 있는 블루프린트 클래스를 넘겨야 의미가 있고, 워커 스레드 평가까지 AnimationMs에 넣으려면
+//                          -CVars=a.ParallelAnimEvaluation=0 으로 게임 스레드에서 평가하게 한다.
+//                          중요도용 관찰 지점이 생기므로 -LOD 없이 예산만 보려면 AIStudy.LOD.Enable=0을 함께 준다)
+//       [-LeanMovement]  (UAgent_MovementComponent를 가벼운 NavWalking으로 전환. 요약의 movement ms/agent로 전체 걷기와 비교)
+//       [-NavCache=Cold|Warm|Off]  (내비메시 타일 캐시. Cold로 한 번 돌려 캐시를 만든 뒤 Warm으로 다시 돌려
+//                                   로그의 경로 탐색 가능 시간과 복원/빌드 타일 열 수를 비교한다)
+//       [-Squad=N]  (RVO 에이전트를 N명씩 분대로 묶어 리더 근처에 스폰하고 목표를 공유한다. 같은 명령에 -CVars=AIStudy.Squad.Enable=0 을 붙여
+//                    같은 배치에서 각자 경로를 찾을 때와 요약의 경로 요청 수, RVO 진행 방향 변화를 비교한다)
+//       [-Pool]  (스폰/제거를 UAgent_PoolSubsystem으로 돌리고 시작 전에 최대 단계 수만큼 미리 만들어 둔다)
+//       [-Churn=K]  (측정 프레임마다 에이전트 K개를 제거하고 같은 종류를 새 위치에 다시 스폰. 히치는 p95/max로 본다.
+//                    GC까지 포함하려면 -CVars=gc.TimeBetweenPurgingPendingKillObjects=5 등으로 GC 주기를 줄인다)
+UCLASS()
+class AISTUDY_API UBenchmark_AIStudyCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBenchmark_AIStudyCommandlet();
+
+	// UCommandlet
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// 한 프레임 측정값
+	struct FFrameSample
+	{
+		int32 NumAgents = 0;
+		int32 Frame = 0;
+		double GameThreadMs = 0.0;
+		double PathfindingMs = 0.0;
+		double AvoidanceMs = 0.0;
+		double PerceptionMs = 0.0;
+		double BrainMs = 0.0;
+		double BehaviorTreeMs = 0.0;
+		double AnimationMs = 0.0;
+		double MovementMs = 0.0;
+		double UsedMemoryMB = 0.0;
+		uint64 PathQueued = 0;
+		uint64 PathServed = 0;
+		uint64 PathDropped = 0;
+		uint64 PathDeduped = 0;
+		int32 PathInFlight = 0;
+		// 움직이는 RVO 에이전트의 진행 방향이 한 프레임 동안 바뀐 평균 각도 (회피 흔들림)
+		double RVOHeadingChangeDeg = 0.0;
+	};
+
+	// 추적자 하나의 상태 전환 (-CheckRangeEvents)
+	struct FStateTransition
+	{
+		int32 Frame;
+		EAIState State;
+
+		bool operator==(const FStateTransition& Other) const { return Frame == Other.Frame && State == Other.State; }
+	};
+
+	// 에이전트 종류별 비중
+	struct FAgentMix
+	{
+		float RVO = 1.0f;
+		float Chaser = 1.0f;
+		float Patrol = 1.0f;
+		// ANPC_AIController가 행동 트리로 움직이는 NPC (기본 0)
+		float NPC = 0.0f;
+	};
+
+	UWorld* LoadWorld(const FString& MapPath) const;
+	void DestroyWorld(UWorld* World) const;
+	void TickWorld(UWorld* World, float DeltaTime) const;
+	void WaitForNavigation(UWorld* World, float DeltaTime) const;
+
+	void SpawnWaypoints(UWorld* World, FRandomStream& Random, float HalfExtent);
+	void SpawnAgents(UWorld* World, int32 NumAgents, const FAgentMix& Mix, FRandomStream& Random, float HalfExtent, TArray<APawn*>& OutPawns) const;
+	APawn* SpawnAgent(UWorld* World, UClass* PawnClass, UClass* ControllerClass, const FVector& Location, TFunctionRef<void(APawn*)> Configure) const;
+	// 분대 이름을 주면 그 분대 리더 근처에서 리더와 같은 목표로 스폰한다 (리더가 없으면 새 분대의 리더)
+	APawn* SpawnRVOAgent(UWorld* World, FRandomStream& Random, float HalfExtent, FName SquadName = NAME_None) const;
+	APawn* SpawnChaserAgent(UWorld* World, FRandomStream& Random, float HalfExtent) const;
+	APawn* SpawnPatrolAgent(UWorld* World, FRandomStream& Random, float HalfExtent, FName Group) const;
+	APawn* SpawnNPCAgent(UWorld* World, FRandomStream& Random, float HalfExtent) const;
+	// -Pool이면 풀로 돌려놓고, 아니면 컨트롤러와 함께 파괴
+	void ReleaseAgent(UWorld* World, APawn* Pawn) const;
+	void DestroyAgents(UWorld* World, TArray<APawn*>& Pawns) const;
+	// -Churn: Count개를 무작위로 골라 제거하고 같은 종류를 다시 스폰
+	void ChurnAgents(UWorld* World, TArray<APawn*>& Pawns, int32 Count, FRandomStream& Random, float HalfExtent) const;
+	// -Mass: 같은 비율의 에이전트를 Mass 엔티티로 생성 (관찰자 근처만 액터로 승격)
+	void SpawnMassAgents(UWorld* World, int32 NumAgents, const FAgentMix& Mix, FRandomStream& Random, float HalfExtent, TArray<FMassEntityHandle>& OutEntities) const;
+	FVector FindSpawnLocation(UWorld* World, FRandomStream& Random, float HalfExtent, const FVector& Center = FVector::ZeroVector) const;
+
+	// -PathQueries: 같은 시작/끝 쌍을 일반 Recast와 계층 탐색으로 각각 동기 탐색해 시간과 길이를 CSV로 기록
+	void RunPathQueryBenchmark(UWorld* World, int32 NumQueries, FRandomStream& Random, float HalfExtent, float DeltaTime, const FString& OutputPath) const;
+
+	// -CheckRangeEvents: 같은 시드의 배치를 폴링과 범위 이벤트로 각각 새 월드에서 돌려 추적자별 상태 전환을 비교
+	bool RunRangeEventsCheck(const FString& MapPath, int32 NumAgents, const FAgentMix& Mix, int32 Frames, int32 Seed, float DeltaTime, float HalfExtent);
+	// 한 모드로 월드를 띄워 추적자별(스폰 순서) 상태 전환을 모은다
+	bool CollectChaserTransitions(const FString& MapPath, bool bRangeEvents, int32 NumAgents, const FAgentMix& Mix, int32 Frames, int32 Seed, float DeltaTime,
+		float HalfExtent, TArray<TArray<FStateTransition>>& OutTransitions);
+
+	// -Replay: 기록된 스폰/궤적/인지 이벤트로 월드를 다시 돌리며 프레임을 측정
+	bool RunReplay(UWorld* World, FReplay_AIStream&& Stream, const FString& OutputPath) const;
+
+	// 이번 프레임 측정값을 추가하고 경로 요청 카운터 차이를 채운다
+	static FFrameSample& AddSample(TArray<FFrameSample>& Samples, int32 NumAgents, int32 Frame, double GameThreadMs,
+		const UPath_RequestSubsystem* PathRequests, FPathRequestCounters& PreviousCounters);
+
+	// 지난 프레임과 비교한 RVO 에이전트 진행 방향 변화 평균 (도)
+	static double MeasureHeadingChange(const TArray<APawn*>& Pawns, TMap<const APawn*, FVector>& InOutHeadings);
+
+	static void ApplyCVars(const FString& CVarList);
+	static FAgentMix ParseMix(const FString& MixString);
+	static void SplitMix(int32 NumAgents, const FAgentMix& Mix, int32& OutNumRVO, int32& OutNumChasers, int32& OutNumPatrol, int32& OutNumNPC);
+	static void WriteCsv(const FString& Path, const TArray<FFrameSample>& Samples);
+	static void LogSummary(int32 NumAgents, const TArray<FFrameSample>& Samples, int32 FirstSample);
+
+	// 명령행 옵션
+	UClass* RVOClass = nullptr;
+	UClass* ChaserPawnClass = nullptr;
+	UClass* PatrolClass = nullptr;
+	UClass* NPCControllerClass = nullptr;
+	bool bUseFlowField = false;
+	bool bUseORCA = false;
+	bool bUsePredictiveInvoker = false;
+	bool bUseLOD = false;
+	bool bUseMass = false;
+	bool bUseRangeEvents = false;
+	bool bUseLeanMovement = false;
+	bool bUsePool = false;
+	// 0이면 애니메이션 예산 할당기를 끈다
+	float AnimBudgetMs = 0.0f;
+	int32 ChurnPerFrame = 0;
+	// 0이면 분대 없이 각자 이동
+	int32 SquadSize = 0;
+
+	// 순찰 그룹별 웨이포인트와 RVO 목표
+	TArray<FName> PatrolGroups;
+	TArray<ATargetPoint*> Waypoints;
+};
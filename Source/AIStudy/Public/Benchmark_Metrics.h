@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 헤드리스 벤치마크가 프레임마다 읽어 가는 시간 지표
+enum class EBenchmarkMetric : uint8
+{
+	Pathfinding,	// 경로 요청 디스패치, 경로 캐시, 흐름장 갱신, 분대 대형 조향
+	Avoidance,		// ORCA 풀이
+	Perception,		// 인지 갱신 처리
+	Brain,			// 추적자 상태 평가와 이동 명령
+	BehaviorTree,	// NPC 행동 트리 틱 (서비스, 태스크, 데코레이터)
+	Animation,		// 예산 메시 애니메이션 틱 (게임 스레드 몫)
+	Movement,		// UAgent_MovementComponent 틱 (캐릭터 이동 시뮬레이션)
+	MAX
+};
+
+// 벤치마크 실행 중에만 켜지는 게임 스레드 전용 시간 누적기.
+// 꺼져 있을 때 스코프 비용은 bool 검사 하나다.
+struct AISTUDY_API FBenchmark_Metrics
+{
+	static void SetEnabled(bool bInEnabled);
+	static bool IsEnabled() { return bEnabled; }
+
+	// 이번 프레임 누적값 초기화
+	static void ResetFrame();
+	static double GetMilliseconds(EBenchmarkMetric Metric) { return Seconds[static_cast<int32>(Metric)] * 1000.0; }
+	static void AddSeconds(EBenchmarkMetric Metric, double InSeconds) { Seconds[static_cast<int32>(Metric)] += InSeconds; }
+
+	struct FScope
+	{
+		explicit FScope(EBenchmarkMetric InMetric)
+			: Metric(InMetric)
+			, StartTime(bEnabled ? FPlatformTime::Seconds() : 0.0)
+		{
+		}
+
+		~FScope()
+		{
+			if (bEnabled)
+			{
+				AddSeconds(Metric, FPlatformTime::Seconds() - StartTime);
+			}
+		}
+
+		EBenchmarkMetric Metric;
+		double StartTime;
+	};
+
+private:
+	static bool bEnabled;
+	static double Seconds[static_cast<int32>(EBenchmarkMetric::MAX)];
+};
+
+#define AISTUDY_BENCHMARK_SCOPE(Metric) FBenchmark_Metrics::FScope PREPROCESSOR_JOIN(BenchmarkScope_, __LINE__)(EBenchmarkMetric::Metric)
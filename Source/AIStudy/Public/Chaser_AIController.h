@@ -5,6 +5,7 @@
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "Kismet/GameplayStatics.h"
+#include "Agent_Poolable.h"
 #include "Chaser_AIController.generated.h"
 
 // AI 상태 열거형 정의
@@ -17,7 +18,7 @@ enum class EAIState : uint8
 	};
 
 UCLASS()
-class AISTUDY_API AChaser_AIController : public AAIController
+class AISTUDY_API AChaser_AIController : public AAIController, public IAgent_Poolable
 {
 	GENERATED_BODY()
 
@@ -58,11 +59,83 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
 	float LoseInterestRadius = 2000.0f;
+
+	// true면 개별 Tick 대신 UChaser_BrainSubsystem이 모든 추적자의 상태를 일괄 갱신
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+	bool bUseBrainSubsystem = true;
+
+	// true면 폴링 대신 UChaser_RangeEventSubsystem이 반경 경계를 넘을 때만 상태를 평가 (AIStudy.Chaser.RangeEvents로도 켤 수 있음)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+	bool bUseRangeEvents = false;
+
+	// true면 MoveToActor 대신 UPath_RequestSubsystem을 통해 비동기로 경로를 요청
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+	bool bUsePathRequestScheduler = true;
+
+	// true면 공간 해시에서 가장 가까운 추적 대상(플레이어/미끼)을 골라 TargetActor로 사용
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	bool bUseSpatialTargetSelection = true;
+
+	// true면 엔진 시야 감각 대신 UPerception_BatchedSightSubsystem의 일괄 비동기 트레이스로 시야를 판정
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+	bool bUseBatchedSight = true;
+
+	// 현재 상태 조회
+	UFUNCTION(BlueprintPure, Category = "AI")
+	EAIState GetAIState() const { return CurrentState; }
+
+	// 추적 중인지
+	bool IsChasing() const { return bIsChasing; }
+
+	// 마지막으로 타겟을 본 위치
+	const FVector& GetLastKnownLocation() const { return LastKnownLocation; }
+
+	// IAgent_Poolable
+	virtual void OnPoolAcquired() override;
+	virtual void OnPoolReleased() override;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
 
 private:
+	friend class UChaser_BrainSubsystem;
+	friend class UChaser_RangeEventSubsystem;
+	friend class UPerception_BatchedSightSubsystem;
+	// Mass 엔티티와 액터 사이 승격/강등 시 상태를 주고받는다
+	friend class UMass_AgentPromotionProcessor;
+
+	// 브레인/범위 이벤트/일괄 시야 서브시스템 등록과 해제 (BeginPlay/EndPlay와 풀 재사용에서 공유)
+	void RegisterWithSubsystems();
+	void UnregisterFromSubsystems();
+
+	// 추적 중 타겟을 향해 이동 요청 및 마지막 위치 갱신
+	void MoveTowardTarget(APawn* ControlledPawn);
+
+	// LoseInterestRadius 안의 가장 가까운 추적 대상으로 TargetActor 갱신 (없으면 유지)
+	void RefreshTarget();
+
+	// 감지 이벤트의 액터가 추적 대상인지 판정
+	bool IsChaseTarget(const AActor* Actor) const;
+
+	// 현재 상태를 상태별 프레임 카운터에 반영
+	void CountState() const;
+
+	// 상태나 타겟이 바뀌었음을 범위 이벤트 서브시스템에 알려 다음 갱신에서 다시 평가하게 한다
+	void WakeRangeEvents();
+
+	// 브레인 서브시스템 SoA 배열에서의 인덱스 (미등록 시 INDEX_NONE)
+	int32 BrainIndex = INDEX_NONE;
+
+	// 범위 이벤트 서브시스템 항목 인덱스 (미등록 시 INDEX_NONE)
+	int32 RangeEventIndex = INDEX_NONE;
+
+	// 일괄 시야 서브시스템 관찰자 배열에서의 인덱스 (미등록 시 INDEX_NONE)
+	int32 SightIndex = INDEX_NONE;
+
 	// 타겟 추적 중인지 여부
 	bool bIsChasing = false;
 	// 현재 상태 변수
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaser_AIController.h"
+#include "Chaser_BrainSubsystem.generated.h"
+
+// 모든 AChaser_AIController의 Idle/Suspicious/Chasing 전환을 한 번에 계산하는 월드 서브시스템.
+// 컨트롤러는 BeginPlay에서 등록만 하고 개별 Tick은 끈다.
+// 상태는 SoA(구조체 배열 대신 배열 구조체)로 모아 거리 제곱 비교로 일괄 평가한다.
+UCLASS()
+class AISTUDY_API UChaser_BrainSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 추적자 등록/해제
+	void RegisterChaser(AChaser_AIController* Chaser);
+	void UnregisterChaser(AChaser_AIController* Chaser);
+
+	int32 GetNumChasers() const { return Controllers.Num(); }
+
+	// LOD 단계별 평가 간격. 0이면 매 프레임, DormantInterval이면 깨울 때까지 평가하지 않는다.
+	void SetUpdateInterval(AChaser_AIController* Chaser, float Interval);
+	static constexpr float DormantInterval = -1.0f;
+
+	// 평가 결과로 실행할 동작 플래그
+	enum EBrainAction : uint8
+	{
+		Action_None = 0,
+		Action_StartChasing = 1 << 0,
+		Action_StopChasing = 1 << 1,
+		Action_MoveToTarget = 1 << 2,
+	};
+
+	// 추적자 하나의 전환 규칙. State는 새 상태로 바뀌고 실행할 EBrainAction 플래그를 돌려준다.
+	// UChaser_RangeEventSubsystem도 같은 규칙을 써서 폴링 방식과 결과가 같게 한다.
+	static uint8 EvaluateChaser(EAIState& State, bool bChasing, double DistSq, double DetectionSq, double ChaseSq, double LoseInterestSq);
+	// 평가 결과를 컨트롤러에 반영 (StartChasing/StopChasing/MoveToActor)
+	static void ApplyChaserAction(AChaser_AIController& Chaser, uint8 Action, EAIState OldState, EAIState NewState);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 컨트롤러에서 위치/상태/반경을 읽어 SoA 배열에 채움
+	void GatherAgents();
+	// SoA 배열만으로 상태 전환과 이동 동작을 계산
+	void EvaluateTransitions();
+	// 계산 결과를 컨트롤러에 반영 (StartChasing/StopChasing/MoveToActor)
+	void ApplyResults();
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AChaser_AIController>> Controllers;
+
+	// SoA 상태 배열 (모두 Controllers와 같은 인덱스)
+	TArray<FVector> PawnLocations;
+	TArray<FVector> TargetLocations;
+	TArray<double> DistanceSquared;
+	TArray<double> DetectionRadiusSq;
+	TArray<double> ChaseRadiusSq;
+	TArray<double> LoseInterestRadiusSq;
+	TArray<EAIState> States;
+	TArray<EAIState> NewStates;
+	TArray<uint8> Chasing;
+	TArray<uint8> Valid;
+	TArray<uint8> Actions;
+	TArray<uint8> NeedsControlRotation;
+
+	// LOD 평가 간격과 마지막 평가 후 경과 시간. 이번 프레임 평가 대상이면 Due가 1.
+	TArray<float> UpdateIntervals;
+	TArray<float> ElapsedTimes;
+	TArray<uint8> Due;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "Net_AIMovement.h"
+#include "Chaser_Character.generated.h"
+
+class UNet_ChaserStateComponent;
+
+// 추적자 폰. 기본 컨트롤러가 AChaser_AIController이고 메시가 애니메이션 예산 할당기에 등록된다.
+// 이동은 UAgent_MovementComponent (ORCA 회피, 가벼운 NavWalking 선택 가능).
+// 이동은 FNet_AIMovement로만 복제하고, 상태는 UNet_ChaserStateComponent가 가까운 연결에만 복제한다.
+UCLASS()
+class AISTUDY_API AChaser_Character : public ACharacter
+{
+	GENERATED_BODY()
+
+public:
+	AChaser_Character(const FObjectInitializer& ObjectInitializer);
+
+	UNet_ChaserStateComponent* GetChaserState() const { return ChaserState; }
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+private:
+	UFUNCTION()
+	void OnRep_AIMovement();
+
+	UPROPERTY(VisibleAnywhere, Category = "AI")
+	TObjectPtr<UNet_ChaserStateComponent> ChaserState;
+
+	UPROPERTY(ReplicatedUsing = OnRep_AIMovement)
+	FNet_AIMovement AIMovement;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaser_AIController.h"
+#include "Chaser_RangeEventSubsystem.generated.h"
+
+// 추적자의 Detection/Chase/LoseInterest 반경을 범위 트리거로 다루는 월드 서브시스템.
+// 공간 해시 갱신마다 가장 많이 움직인 폰의 이동 거리를 누적해 "이동 축"을 만들고,
+// 추적 중이 아닌 추적자는 가장 가까운 반경 경계까지의 여유 거리만큼 이동 축이 지날 때까지 재운다.
+// 두 폰 사이 거리는 갱신당 최대 2 * MaxStep만 변하므로 그 전에는 경계를 넘을 수 없다.
+// 추적 중인 추적자는 매 프레임 MoveToActor를 다시 요청하므로 폴링 방식과 같이 매 갱신 평가한다.
+UCLASS()
+class AISTUDY_API UChaser_RangeEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 추적자 등록/해제
+	void RegisterChaser(AChaser_AIController* Chaser);
+	void UnregisterChaser(AChaser_AIController* Chaser);
+
+	// 인지 이벤트나 추적 시작/중지로 상태가 바뀌었을 때 다음 갱신에서 다시 평가
+	void WakeChaser(AChaser_AIController* Chaser);
+	// LOD Dormant 단계: 깨울 때까지 평가하지 않는다
+	void SetDormant(AChaser_AIController* Chaser, bool bDormant);
+
+	int32 GetNumChasers() const { return Entries.Num(); }
+	int32 GetNumSleeping() const { return NumSleeping; }
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FRangeEntry
+	{
+		TWeakObjectPtr<AChaser_AIController> Controller;
+		// 힙 노드의 유효성 확인용. 다시 재우거나 깨우면 새 값을 받아 이전 노드는 버려진다.
+		uint32 Serial = 0;
+		// ActiveIndices에서의 위치 (매 갱신 평가 대상이 아니면 INDEX_NONE)
+		int32 ActiveSlot = INDEX_NONE;
+		// StateCounts에 반영된 상태
+		EAIState CountedState = EAIState::Idle;
+		bool bDormant = false;
+		bool bSleeping = false;
+	};
+
+	struct FWakeNode
+	{
+		double Key;
+		int32 Index;
+		uint32 Serial;
+
+		bool operator<(const FWakeNode& Other) const { return Key < Other.Key; }
+	};
+
+	// USpatial_HashSubsystem::OnUpdated에 연결되어 폰 위치 갱신 직후 호출된다
+	void OnSpatialHashUpdated(float MaxStep);
+
+	// 추적자 하나를 폴링 규칙으로 평가하고, 추적 중이 아니면 여유 거리를 구해 재운다
+	void EvaluateEntry(int32 Index, float DeltaTime);
+	// 다음 평가까지 남은 이동 축 거리 (음수면 매 갱신 평가)
+	double ComputeSlack(const AChaser_AIController& Chaser) const;
+	void Sleep(int32 Index, double Slack);
+	void SetActive(int32 Index);
+	void SetInactive(int32 Index);
+	void UpdateStateCount(FRangeEntry& Entry, const AChaser_AIController& Chaser);
+
+	// 잠든 추적자를 폴링 규칙으로 다시 평가해 전환이 빠졌는지 확인 (AIStudy.Chaser.RangeEvents.Verify)
+	void VerifySleepers();
+
+	TSparseArray<FRangeEntry> Entries;
+	TArray<FWakeNode> WakeHeap;
+	// 매 갱신 평가하는 추적자 인덱스 (추적 중이거나 방금 깨운 추적자)
+	TArray<int32> ActiveIndices;
+	// 이번 갱신에 평가할 인덱스 (버퍼 재사용)
+	TArray<int32> DueIndices;
+
+	// 지금까지 누적된 이동 축 거리
+	double Travel = 0.0;
+	int32 NumSleeping = 0;
+	uint32 NextSerial = 0;
+	// 상태별 추적자 수 (상태가 바뀔 때만 갱신해 매 프레임 전체를 세지 않는다)
+	int32 StateCounts[3] = { 0, 0, 0 };
+	double LastUpdateTime = -1.0;
+
+	FDelegateHandle HashUpdatedHandle;
+};
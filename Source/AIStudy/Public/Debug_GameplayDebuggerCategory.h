@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebuggerCategory.h"
+
+class APawn;
+
+// Gameplay Debugger "AIStudy" 카테고리 (작은따옴표 키 → 숫자 키로 켜고 끔).
+// 카테고리가 켜져 있을 때만 서버에서 시점 근처(또는 선택한) 에이전트의 상태를 모아
+// 추적자 상태/타겟 선, 마지막 목격 위치, 순찰 구간, RVO 회피 반경을 하나의 도형 버퍼로 만든다.
+// 도형과 요약은 Gameplay Debugger 복제로 클라이언트에 전달되므로 데디케이티드 서버도 확인할 수 있다.
+class FGameplayDebuggerCategory_AIStudy : public FGameplayDebuggerCategory
+{
+public:
+	FGameplayDebuggerCategory_AIStudy();
+
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+	virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+protected:
+	// 복제되는 요약 (도형은 카테고리가 따로 복제한다)
+	struct FRepData
+	{
+		int32 NumNearby = 0;
+		int32 NumShown = 0;
+		int32 NumIdle = 0;
+		int32 NumSuspicious = 0;
+		int32 NumChasing = 0;
+		int32 NumPatrol = 0;
+		int32 NumRVO = 0;
+		// 선택한 에이전트 설명 (없으면 비어 있음)
+		FString SelectedDescription;
+
+		void Serialize(FArchive& Ar);
+	};
+
+	// 에이전트 하나의 도형을 추가하고 요약을 갱신
+	void CollectAgent(const APawn& Pawn, bool bSelected);
+
+	FRepData DataPack;
+};
+#endif // WITH_GAMEPLAY_DEBUGGER
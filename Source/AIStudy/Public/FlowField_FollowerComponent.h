@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FlowField_FollowerComponent.generated.h"
+
+// UFlowField_Subsystem의 흐름장에서 방향을 읽어 소유 폰에 이동 입력을 넣는 컴포넌트.
+// 이동 입력은 CharacterMovementComponent를 거치므로 RVO 회피와 애님 BP 속도도 그대로 동작한다.
+// 흐름장 밖이거나 도달 불가한 위치에서는 일반 MoveToActor로 잠시 돌아간다.
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class AISTUDY_API UFlowField_FollowerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFlowField_FollowerComponent();
+
+	// 목표 설정 (nullptr이면 정지)
+	UFUNCTION(BlueprintCallable, Category = "AI Movement")
+	void SetGoal(AActor* InGoal, float InAcceptanceRadius = 50.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "AI Movement")
+	void ClearGoal();
+
+	UFUNCTION(BlueprintPure, Category = "AI Movement")
+	AActor* GetGoal() const { return Goal.Get(); }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	void SetFallbackActive(bool bActive);
+
+	TWeakObjectPtr<AActor> Goal;
+	float AcceptanceRadius = 50.0f;
+	bool bFallbackActive = false;
+};
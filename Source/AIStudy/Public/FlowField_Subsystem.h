@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FlowField_Subsystem.generated.h"
+
+class ANavigationData;
+
+// 목표 하나에 대한 흐름장(flow field).
+// 내비메시를 투영한 격자 위에서 목표까지의 누적 비용(integration)을 구하고, 셀마다 다음 셀 방향을 저장한다.
+struct FFlowField
+{
+	TWeakObjectPtr<AActor> Goal;
+	FVector Origin = FVector::ZeroVector;
+	float CellSize = 100.0f;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	FIntPoint GoalCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	// 셀별 데이터 (Y * SizeX + X)
+	TArray<uint8> Walkable;
+	TArray<float> Heights;
+	TArray<float> Integration;
+	TArray<uint8> Directions;
+
+	int32 NumFollowers = 0;
+	bool bWalkabilityDirty = true;
+
+	static constexpr uint8 NoDirection = 0xFF;
+
+	bool IsValidCell(int32 X, int32 Y) const { return X >= 0 && Y >= 0 && X < SizeX && Y < SizeY; }
+	int32 ToIndex(int32 X, int32 Y) const { return Y * SizeX + X; }
+	FIntPoint ToCell(const FVector& Location) const;
+	FVector GetCellCenter(int32 X, int32 Y) const;
+	SIZE_T GetAllocatedSize() const;
+};
+
+// 같은 목표를 향하는 다수 에이전트가 각자 A*를 돌리는 대신 하나의 흐름장을 공유하도록 하는 서브시스템.
+// 목표마다 한 번 격자의 보행 가능 여부를 내비메시에 투영해 만들고,
+// 목표가 다른 셀로 움직이면 보행 정보는 재사용한 채 누적 비용만 다시 계산한다.
+UCLASS()
+class AISTUDY_API UFlowField_Subsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 목표에 대한 흐름장 사용 시작/종료 (참조 카운트)
+	void AcquireField(AActor* Goal);
+	void ReleaseField(AActor* Goal);
+
+	// Location에서 목표로 가는 이동 방향. 흐름장 밖이거나 도달 불가면 false.
+	bool SampleDirection(const AActor* Goal, const FVector& Location, FVector& OutDirection) const;
+
+	int32 GetNumFields() const { return Fields.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+	// UTickableWorldSubsystem
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 목표 주변으로 격자를 잡고 보행 가능 여부와 바닥 높이를 일괄 투영
+	void BuildWalkability(FFlowField& Field, const FVector& Center) const;
+	// 목표 셀에서 다익스트라로 누적 비용과 방향을 계산
+	void BuildIntegration(FFlowField& Field) const;
+
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	TMap<TObjectKey<AActor>, FFlowField> Fields;
+	FDelegateHandle NavGenerationHandle;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Chaser_AIController.h"
+#include "Mass_AgentFragments.generated.h"
+
+class APawn;
+
+// Mass 에이전트 종류 (액터 버전: ARVO_Character, AChaser_AIController, AAIStudyCharacter)
+UENUM(BlueprintType)
+enum class EMassAgentType : uint8
+{
+	RVO,
+	Chaser,
+	Patrol
+};
+
+// 종류와 이동 파라미터
+USTRUCT()
+struct AISTUDY_API FMassAgentFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EMassAgentType Type = EMassAgentType::RVO;
+	float Radius = 42.0f;
+	float MaxSpeed = 500.0f;
+	// 캡슐 중심과 바닥(내비메시) 사이 높이
+	float HalfHeight = 96.0f;
+	// 회피 이웃 탐색 반경 (ARVO_Character::AvoidanceRadius 기본값)
+	float NeighborDistance = 300.0f;
+};
+
+// 목표 지점과 속도. Goal은 행동 프로세서가 정하고 이동 프로세서가 따라간다.
+USTRUCT()
+struct AISTUDY_API FMassAgentMoveFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Goal = FVector::ZeroVector;
+	FVector2f Velocity = FVector2f::ZeroVector;
+	float AcceptanceRadius = 50.0f;
+	bool bHasGoal = false;
+
+	// RVO 에이전트의 목표 액터 (승격 시 TargetActor로 넘긴다)
+	TWeakObjectPtr<AActor> GoalActor;
+};
+
+// AAIStudyCharacter처럼 두 웨이포인트를 오가는 순찰
+USTRUCT()
+struct AISTUDY_API FMassPatrolFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector PointA = FVector::ZeroVector;
+	FVector PointB = FVector::ZeroVector;
+	TWeakObjectPtr<AActor> ActorA;
+	TWeakObjectPtr<AActor> ActorB;
+
+	// AAIStudyCharacter::bIsSucceeded와 같은 의미 (true면 A로 이동)
+	bool bIsSucceeded = false;
+	// 도착 후 다음 이동까지 남은 대기 시간
+	float WaitTime = 0.0f;
+};
+
+// AChaser_AIController의 EAIState 상태 기계
+USTRUCT()
+struct AISTUDY_API FMassChaseFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EAIState State = EAIState::Idle;
+	bool bIsChasing = false;
+	FVector LastKnownLocation = FVector::ZeroVector;
+
+	float DetectionRadius = 1500.0f;
+	float ChaseRadius = 1000.0f;
+	float LoseInterestRadius = 2000.0f;
+};
+
+// 플레이어 근처에서 승격된 액터. 승격 중에는 액터가 위치의 원본이다.
+USTRUCT()
+struct AISTUDY_API FMassAgentActorFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<APawn> Actor;
+};
+
+// 추적자가 쫓는 대상 (RVO/순찰 에이전트)
+USTRUCT()
+struct AISTUDY_API FMassChaseTargetTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+// 액터로 승격되어 Mass 시뮬레이션에서 빠진 상태
+USTRUCT()
+struct AISTUDY_API FMassAgentPromotedTag : public FMassTag
+{
+	GENERATED_BODY()
+};
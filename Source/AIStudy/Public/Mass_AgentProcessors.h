@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "Spatial_HashGrid.h"
+#include "RVO_ORCASubsystem.h"
+#include "Mass_AgentProcessors.generated.h"
+
+// 순찰 에이전트: 두 웨이포인트를 오가며 도착하면 잠시 쉬고 방향을 바꾼다 (AAIStudyCharacter와 같은 규칙)
+UCLASS()
+class AISTUDY_API UMass_AgentPatrolProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UMass_AgentPatrolProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+// 추적자: 추적 대상 위치를 공간 해시로 모은 뒤 EAIState 상태 기계를 청크 단위 병렬로 평가한다.
+// 전환 규칙은 UChaser_BrainSubsystem::EvaluateTransitions와 같다.
+UCLASS()
+class AISTUDY_API UMass_AgentChaseProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UMass_AgentChaseProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery TargetQuery;
+	FMassEntityQuery ChaserQuery;
+
+	// 이번 프레임 추적 대상 위치 (버퍼 재사용)
+	TArray<FVector> TargetLocations;
+	FSpatial_HashGrid TargetGrid;
+};
+
+// 이동: 목표 방향 선호 속도를 ORCA로 풀어 회피 속도를 얻고 위치를 적분한다
+UCLASS()
+class AISTUDY_API UMass_AgentMovementProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UMass_AgentMovementProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+	FORCAAgentData Data;
+};
+
+// 직선 이동을 내비메시 위로 되돌리는 투영. 프레임마다 일부 엔티티만 돌아가며 처리한다.
+UCLASS()
+class AISTUDY_API UMass_AgentNavProjectionProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UMass_AgentNavProjectionProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+	uint32 Cursor = 0;
+};
+
+// 관찰자 근처 엔티티를 액터로 승격하고, 멀어지면 액터 상태를 엔티티로 되돌린 뒤 액터를 없앤다.
+// 승격 중에는 액터 위치를 엔티티로 동기화해 Mass 쪽 추적자도 계속 쫓을 수 있게 한다.
+UCLASS()
+class AISTUDY_API UMass_AgentPromotionProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UMass_AgentPromotionProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	APawn* SpawnActorFor(UWorld* World, const struct FMassAgentFragment& Agent, const FTransform& Transform, const struct FMassAgentMoveFragment& Move,
+		const struct FMassPatrolFragment* Patrol, const struct FMassChaseFragment* Chase) const;
+
+	FMassEntityQuery SimulatedQuery;
+	FMassEntityQuery PromotedQuery;
+};
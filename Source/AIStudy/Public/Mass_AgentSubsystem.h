@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "Mass_AgentFragments.h"
+#include "Mass_AgentSubsystem.generated.h"
+
+class ARVO_Character;
+class AAIStudyCharacter;
+struct FMassEntityManager;
+
+// Mass 에이전트 생성 파라미터
+struct FMassAgentSpawnParams
+{
+	EMassAgentType Type = EMassAgentType::RVO;
+	FVector Location = FVector::ZeroVector;
+
+	// RVO: 이동할 목표 액터
+	AActor* Goal = nullptr;
+	// 순찰: 오갈 두 웨이포인트
+	AActor* PatrolA = nullptr;
+	AActor* PatrolB = nullptr;
+};
+
+// 순찰/추적/회피 에이전트를 액터 대신 Mass 엔티티로 만드는 서브시스템.
+// 종류별 아키타입을 한 번 만들어 두고 일괄 생성하며, 행동과 이동은 UMass_Agent*Processor들이 청크 단위 병렬로 처리한다.
+// 관찰자 근처의 엔티티만 아래 클래스의 액터로 승격된다.
+UCLASS()
+class AISTUDY_API UMass_AgentSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void SpawnAgents(TConstArrayView<FMassAgentSpawnParams> Params, TArray<FMassEntityHandle>& OutEntities);
+
+	// 승격된 액터도 함께 제거
+	void DestroyAgents(TConstArrayView<FMassEntityHandle> Entities);
+
+	// 승격 시 스폰할 클래스 (기본은 C++ 클래스)
+	UPROPERTY(EditAnywhere, Category = "Mass")
+	TSubclassOf<ARVO_Character> RVOActorClass;
+
+	UPROPERTY(EditAnywhere, Category = "Mass")
+	TSubclassOf<APawn> ChaserPawnClass;
+
+	UPROPERTY(EditAnywhere, Category = "Mass")
+	TSubclassOf<AAIStudyCharacter> PatrolActorClass;
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FMassEntityManager& GetEntityManager() const;
+	const FMassArchetypeHandle& GetArchetype(EMassAgentType Type);
+
+	FMassArchetypeHandle Archetypes[3];
+};
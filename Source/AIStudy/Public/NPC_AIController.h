@@ -4,14 +4,45 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "Agent_Poolable.h"
 #include "NPC_AIController.generated.h"
 
+class UBehaviorTree;
+
+// 행동 트리 틱 시간을 벤치마크 지표(BehaviorTree)로 모으는 컴포넌트
+UCLASS()
+class AISTUDY_API UNPC_BehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+};
+
 /**
- * 
+ * 빙의하면 NPC 행동 트리를 실행하는 컨트롤러.
+ * BehaviorTree에 노드가 있으면 그것을, 없으면(BT_NPC처럼 비어 있으면) BT_NPCNodes의 네이티브 노드로 만든 트리를 쓴다.
  */
 UCLASS()
-class AISTUDY_API ANPC_AIController : public AAIController
+class AISTUDY_API ANPC_AIController : public AAIController, public IAgent_Poolable
 {
 	GENERATED_BODY()
-	
+
+public:
+	ANPC_AIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// 실행할 행동 트리 (비워 두면 네이티브 트리)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	UBehaviorTree* BehaviorTree;
+
+	// IAgent_Poolable
+	virtual void OnPoolAcquired() override;
+	virtual void OnPoolReleased() override;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+
+private:
+	void StartBehavior();
 };
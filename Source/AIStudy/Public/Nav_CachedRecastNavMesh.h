@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Nav_CachedRecastNavMesh.generated.h"
+
+// UNav_TileCacheSubsystem의 디스크 타일 캐시를 쓰는 Recast 내비메시.
+// 전체 재빌드 때 입력 해시가 캐시와 같은 타일 열은 캐시에서 붙이고 빌드 대기열에서 뺀다.
+// 이후 더티 영역도 입력이 그대로인 복원 타일이면 다시 빌드하지 않는다.
+// 더티 영역과 생성기 틱은 UNav_RebuildGovernorSubsystem을 거쳐 프레임 예산 안에서 처리한다.
+// DefaultEngine.ini의 SupportedAgents에서 내비 데이터 클래스로 지정한다.
+UCLASS()
+class AISTUDY_API ANav_CachedRecastNavMesh : public ARecastNavMesh
+{
+	GENERATED_BODY()
+
+public:
+	// 캐시에서 읽은 Detour 타일 데이터를 붙인다. 성공하면 내비메시가 TileData의 소유권을 가진다 (dtAlloc으로 할당한 버퍼)
+	bool AttachCachedTile(uint8* TileData, int32 DataSize);
+
+	// 빌드할 타일 없이 캐시만으로 준비됐을 때 생성 완료를 알린다 (계층 탐색/플로우 필드 갱신용)
+	void BroadcastGenerationFinished();
+
+protected:
+	virtual FRecastNavMeshGenerator* CreateGeneratorInstance() override;
+};
+
+namespace NavTile
+{
+	// 타일 열의 월드 경계. XY는 타일 사각형, Z는 열 전체
+	AISTUDY_API FBox GetTileBounds(const ARecastNavMesh& NavMesh, const FIntPoint& Tile);
+}
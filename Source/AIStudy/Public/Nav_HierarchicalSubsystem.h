@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Nav_HierarchicalSubsystem.generated.h"
+
+class ANavigationData;
+class ARecastNavMesh;
+
+// 이 필터(또는 파생 필터)를 기본 내비 필터로 쓰는 컨트롤러의 먼 경로 요청은
+// UPath_RequestSubsystem이 계층 경로 탐색으로 보낸다. 영역 비용은 기본 필터와 같다.
+UCLASS()
+class AISTUDY_API UNav_HierarchicalQueryFilter : public UNavigationQueryFilter
+{
+	GENERATED_BODY()
+};
+
+// 누적 쿼리 통계 (AIStudy.HPA.Report)
+struct FNavHierarchicalStats
+{
+	uint64 NumQueries = 0;
+	uint64 NumFallbacks = 0;
+	uint64 NumClusterRebuilds = 0;
+	double TotalAbstractSeconds = 0.0;
+	double TotalRefineSeconds = 0.0;
+};
+
+// Recast 내비메시 타일을 ClusterTiles x ClusterTiles 클러스터로 묶은 HPA* 추상 그래프.
+// 인접 클러스터 경계를 가로지르는 폴리곤 변을 묶어 포털 노드로 만들고,
+// 클러스터 안 포털 쌍의 경로 길이를 미리 계산해 둔다.
+// 먼 쿼리는 추상 그래프에서 포털 순서를 먼저 찾고, 이웃한 포털 사이 구간만 내비메시에서 다시 탐색해 이어 붙인다.
+// 타일이 다시 빌드되면 바뀐 타일이 속한 클러스터와 그 이웃만 프레임 예산 안에서 갱신한다.
+// 포털 쌍 비용 계산은 ms 예산으로 나눠 남은 쌍을 다음 프레임에 이어서 하고, 끝날 때까지 그 클러스터는 추상 탐색에서 건너뛴다.
+UCLASS()
+class AISTUDY_API UNav_HierarchicalSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 이 필터 클래스의 요청을 계층 탐색으로 보낼지 (UNav_HierarchicalQueryFilter 또는 AIStudy.HPA.AllRequests)
+	static bool WantsHierarchical(TSubclassOf<UNavigationQueryFilter> FilterClass);
+
+	// 시작과 끝이 충분히 멀고 그래프가 있으면 계층 탐색을 쓸 만한지. 처음 불리면 그래프 빌드를 시작한다.
+	bool ShouldUseHierarchical(const ANavigationData& NavData, const FVector& Start, const FVector& End);
+
+	// 그래프를 만들기 시작 (쿼리가 오기 전에는 빌드하지 않는다)
+	void RequestGraph() { bGraphRequested = true; }
+
+	// 계층 경로 탐색. 실패하거나 같은/이웃 클러스터 안의 쿼리면 nullptr (호출자가 일반 탐색으로 대체)
+	FNavPathSharedPtr FindPath(const ANavigationData& NavData, const FVector& Start, const FVector& End, FSharedConstNavQueryFilter Filter, const UObject* Querier = nullptr);
+
+	// 모든 클러스터를 다시 빌드하도록 표시
+	void MarkAllDirty();
+
+	int32 GetNumClusters() const { return Clusters.Num(); }
+	int32 GetNumPortals() const { return Portals.Num(); }
+	int32 GetNumDirtyClusters() const { return DirtyClusters.Num(); }
+	const FNavHierarchicalStats& GetStats() const { return Stats; }
+	// FindPath 한 번의 평균 게임 스레드 시간 (경로 요청 예산 판단용, 아직 쿼리가 없으면 0)
+	double GetAverageQuerySeconds() const;
+	void LogReport() const;
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 두 클러스터 경계 위의 포털. 양쪽 클러스터 모두에 속한다.
+	struct FPortal
+	{
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Clusters[2];
+		// 각 클러스터 Portals 배열에서의 위치
+		int32 Slots[2] = { INDEX_NONE, INDEX_NONE };
+	};
+
+	struct FCluster
+	{
+		// 이 클러스터에 속한 내비메시 타일 인덱스
+		TArray<int32> Tiles;
+		// 타일별 (첫 폴리곤 참조, 폴리곤 수). 타일이 다시 빌드되면 참조의 salt가 바뀐다.
+		TArray<TPair<NavNodeRef, int32>> TileFingerprints;
+		// 경계 포털 인덱스 (Portals 희소 배열)
+		TArray<int32> Portals;
+		// 포털 쌍 경로 길이 (Portals.Num() 제곱, 연결되지 않으면 음수)
+		TArray<float> Costs;
+		// 계산 중인 비용 행렬과 다음에 계산할 쌍. 포털 수가 바뀌면 처음부터 다시 한다
+		TArray<float> PendingCosts;
+		int32 NextCostI = 0;
+		int32 NextCostJ = 1;
+	};
+
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+	ARecastNavMesh* GetNavMesh() const;
+
+	// 타일을 클러스터로 다시 분류하고 지문이 바뀐 클러스터를 더럽힘 표시
+	void RefreshTiles(const ARecastNavMesh& NavMesh);
+	// 더럽혀진 클러스터 하나의 포털을 다시 만들고 그 클러스터와 이웃의 비용 행렬 계산을 예약
+	void RebuildCluster(const ARecastNavMesh& NavMesh, const FIntPoint& ClusterKey);
+	void QueueCostRebuild(const FIntPoint& ClusterKey);
+	// Deadline까지 비용 행렬을 이어서 계산. 다 끝나면 true
+	bool ContinueCosts(const ARecastNavMesh& NavMesh, const FIntPoint& ClusterKey, double Deadline);
+	void RemovePortalsBetween(const FIntPoint& A, const FIntPoint& B);
+	void DetachPortal(int32 PortalIndex);
+
+	FIntPoint GetClusterForPoly(const ARecastNavMesh& NavMesh, NavNodeRef PolyRef) const;
+	float CalcPathLength(const ANavigationData& NavData, const FVector& From, const FVector& To, FSharedConstNavQueryFilter Filter) const;
+
+	TMap<FIntPoint, FCluster> Clusters;
+	TSparseArray<FPortal> Portals;
+	TArray<FIntPoint> DirtyClusters;
+	// 비용 행렬 계산이 남은 클러스터 (앞에서부터 처리)
+	TArray<FIntPoint> PendingCostClusters;
+
+	TWeakObjectPtr<ARecastNavMesh> BuiltNavMesh;
+	int32 ClusterTiles = 4;
+	bool bTilesDirty = true;
+	bool bGraphRequested = false;
+
+	FNavHierarchicalStats Stats;
+	FDelegateHandle NavGenerationHandle;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Nav_InvokerProxy.generated.h"
+
+// 예측 위치에 놓이는 내비게이션 인보커 대리 액터.
+// 내비게이션 시스템은 인보커를 액터 단위로 관리하므로, 에이전트 하나가 여러 위치를 요청하려면 별도 액터가 필요하다.
+UCLASS(NotPlaceable, Transient)
+class AISTUDY_API ANav_InvokerProxy : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ANav_InvokerProxy();
+};
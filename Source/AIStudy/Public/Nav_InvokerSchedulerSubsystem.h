@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Nav_InvokerSchedulerSubsystem.generated.h"
+
+class ANav_InvokerProxy;
+class ARecastNavMesh;
+class UNav_PredictiveInvokerComponent;
+
+// 모든 UNav_PredictiveInvokerComponent의 예측 위치를 모아 도착 예상 시간 순으로 프록시 인보커에 배정하는 서브시스템.
+// 도착이 가까운 타일일수록 높은 인보커 우선순위를 주고,
+// 재빌드 대기열이 포화 상태면 먼 예측 위치는 버린다.
+// 요청한 타일이 준비될 때까지 걸린 시간을 인보커별로 기록한다.
+UCLASS()
+class AISTUDY_API UNav_InvokerSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterInvoker(UNav_PredictiveInvokerComponent* Invoker);
+	void UnregisterInvoker(UNav_PredictiveInvokerComponent* Invoker);
+
+	int32 GetNumInvokers() const { return Invokers.Num(); }
+	int32 GetNumProxiesInUse() const { return NumProxiesInUse; }
+	int32 GetNumPendingTiles() const { return PendingTiles.Num(); }
+
+	// 등록된 인보커의 지연 통계를 로그로 출력
+	void LogLatencyReport() const;
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 예측 위치를 모아 정렬하고 프록시에 배정
+	void UpdateAssignments(ARecastNavMesh& NavMesh);
+	// 대기 중인 타일이 준비됐는지 확인하고 지연 시간을 기록
+	void UpdatePendingTiles(const ARecastNavMesh& NavMesh, double Now);
+
+	ANav_InvokerProxy* GetOrSpawnProxy(int32 Index, const FVector& Location);
+	void ReleaseProxies(int32 FirstUnused);
+
+	FIntPoint ToTileKey(const FVector& Location) const;
+
+	struct FPendingTile
+	{
+		FVector Location = FVector::ZeroVector;
+		double RequestTime = 0.0;
+		TWeakObjectPtr<UNav_PredictiveInvokerComponent> Owner;
+		bool bLate = false;
+	};
+
+	TArray<TWeakObjectPtr<UNav_PredictiveInvokerComponent>> Invokers;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ANav_InvokerProxy>> Proxies;
+
+	int32 NumProxiesInUse = 0;
+	TMap<FIntPoint, FPendingTile> PendingTiles;
+	float TileSize = 1000.0f;
+	float TimeUntilUpdate = 0.0f;
+};
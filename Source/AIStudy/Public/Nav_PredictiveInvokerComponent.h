@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Nav_PredictiveInvokerComponent.generated.h"
+
+// 내비메시 생성을 미리 요청할 위치와 도착 예상 시간
+struct FNavInvokerSample
+{
+	FVector Location = FVector::ZeroVector;
+	float TimeToArrival = 0.0f;
+	class UNav_PredictiveInvokerComponent* Owner = nullptr;
+};
+
+// 인보커별 타일 생성 지연 통계
+USTRUCT(BlueprintType)
+struct FNavInvokerLatencyStats
+{
+	GENERATED_BODY()
+
+	// 요청 후 준비된 타일 수
+	UPROPERTY(BlueprintReadOnly, Category = Navigation)
+	int32 NumTilesReady = 0;
+
+	// 타일이 준비되기 전에 에이전트가 먼저 도착한 횟수
+	UPROPERTY(BlueprintReadOnly, Category = Navigation)
+	int32 NumLateTiles = 0;
+
+	// 포화 상태에서 버려진 예측 위치 수
+	UPROPERTY(BlueprintReadOnly, Category = Navigation)
+	int32 NumDropped = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = Navigation)
+	float TotalLatency = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Navigation)
+	float MaxLatency = 0.0f;
+
+	float GetAverageLatencyMs() const { return NumTilesReady > 0 ? TotalLatency / NumTilesReady * 1000.0f : 0.0f; }
+};
+
+// 속도와 경로 통로(corridor)를 따라 앞으로 도착할 위치의 내비메시 타일을 미리 생성하도록 요청하는 인보커.
+// 직접 인보커로 등록하지 않고 UNav_InvokerSchedulerSubsystem이 모든 인보커의 예측 위치를
+// 도착 예상 시간 순으로 모아 프록시 인보커에 배정한다.
+// 현재 위치 주변은 기존 UNavigationInvokerComponent가 계속 담당한다.
+UCLASS(ClassGroup = (Navigation), meta = (BlueprintSpawnableComponent))
+class AISTUDY_API UNav_PredictiveInvokerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UNav_PredictiveInvokerComponent();
+
+	// 몇 초 앞까지 예측할지
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Navigation)
+	float LookaheadTime = 3.0f;
+
+	// 예측 위치 간격. 0이면 내비메시 타일 크기를 사용
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Navigation)
+	float SampleSpacing = 0.0f;
+
+	// 이 속도보다 느리면 예측하지 않는다
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Navigation)
+	float MinSpeed = 10.0f;
+
+	// 예측 위치를 Samples에 추가 (경로가 있으면 경로 통로, 없으면 현재 속도 방향)
+	void GatherSamples(TArray<FNavInvokerSample>& OutSamples, float DefaultSpacing);
+
+	UFUNCTION(BlueprintPure, Category = Navigation)
+	const FNavInvokerLatencyStats& GetLatencyStats() const { return LatencyStats; }
+
+	// UActorComponent
+	virtual void Activate(bool bReset = false) override;
+	virtual void Deactivate() override;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	friend class UNav_InvokerSchedulerSubsystem;
+
+	FNavInvokerLatencyStats LatencyStats;
+};
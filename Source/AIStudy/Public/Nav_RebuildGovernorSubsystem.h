@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Nav_RebuildGovernorSubsystem.generated.h"
+
+class ARecastNavMesh;
+struct FNavigationDirtyArea;
+struct FPendingTileElement;
+
+// 누적 거버너 통계 (AIStudy.NavGovernor.Report)
+struct FNavRebuildGovernorStats
+{
+	uint64 NumHitches = 0;
+	uint64 NumCoalescedAreas = 0;
+	uint64 NumDeferredTiles = 0;
+	uint64 NumReleasedTiles = 0;
+	// 게임 스레드 예산이 바닥나 생성기 틱을 건너뛴 프레임
+	uint64 NumSkippedBuildTicks = 0;
+	int32 MaxQueueDepth = 0;
+};
+
+// 동적 내비메시 재빌드가 AI 틱과 같은 프레임을 두고 다투지 않도록 빌드 속도를 조절하는 서브시스템.
+// - 최근 프레임 시간과 워커에서 도는 타일 작업량을 지수 평균으로 보고, 넘치면 동시 타일 작업 수를 반으로 줄이고
+//   여유가 있으면 하나씩 늘린다.
+// - 생성기 게임 스레드 작업(완료 타일 붙이기)은 프레임마다 채워지는 예산 안에서만 틱한다.
+// - 겹치는 더티 영역은 합쳐서 넘긴다 (움직이는 모디파이어는 이전/새 경계가 매번 겹친다).
+// - 에이전트가 서 있지도 않고 경로가 지나지도 않는 타일은 미뤄 두었다가 여유가 생기거나 급해지면 다시 넣는다.
+// ANav_CachedRecastNavMesh의 생성기가 부른다.
+UCLASS()
+class AISTUDY_API UNav_RebuildGovernorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 겹치는 같은 종류의 더티 영역을 합친다
+	void CoalesceDirtyAreas(TArray<FNavigationDirtyArea>& DirtyAreas);
+	// 급하지 않은 타일을 대기열에서 빼서 미뤄 둔다
+	void DeferPendingTiles(const ARecastNavMesh& NavMesh, TArray<FPendingTileElement>& PendingTiles);
+
+	// 이번 프레임에 생성기 게임 스레드 작업을 돌릴 예산이 남았는지
+	bool ShouldTickBuild();
+	void OnBuildTicked(ARecastNavMesh& NavMesh, double ElapsedMs);
+
+	int32 GetNumDeferredTiles(const ARecastNavMesh& NavMesh) const;
+	int32 GetConcurrency() const { return Concurrency; }
+	const FNavRebuildGovernorStats& GetStats() const { return Stats; }
+	void LogReport() const;
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FDeferredTile
+	{
+		double DeferTime = 0.0;
+		bool bRebuildGeometry = false;
+	};
+
+	struct FNavMeshState
+	{
+		TWeakObjectPtr<ARecastNavMesh> NavMesh;
+		TMap<FIntPoint, FDeferredTile> Deferred;
+		// 에이전트가 서 있거나 경로가 지나는 타일
+		TSet<FIntPoint> UrgentTiles;
+		double UrgentUpdateTime = -1.0;
+		int32 AppliedConcurrency = INDEX_NONE;
+		// 처음 덮어쓰기 전 내비메시 인스턴스의 동시 작업 수 (꺼질 때 되돌린다)
+		int32 OriginalConcurrency = INDEX_NONE;
+	};
+
+	// 프레임/워커 시간을 보고 동시 작업 수와 게임 스레드 예산을 정한다
+	void UpdateBudget(double FrameMs);
+	void UpdateUrgentTiles(FNavMeshState& State, double Now);
+	void ReleaseDeferredTiles(FNavMeshState& State, double Now);
+
+	TMap<TObjectKey<ARecastNavMesh>, FNavMeshState> States;
+
+	double LastTickTime = 0.0;
+	double FrameMsAverage = 0.0;
+	double NavMsAverage = 0.0;
+	double WorkerMsAverage = 0.0;
+	// 이번 프레임에 생성기 틱이 쓴 게임 스레드 시간과 워커에서 돌던 작업 수
+	double NavMsThisFrame = 0.0;
+	int32 NumRunningTasks = 0;
+	int32 QueueDepth = 0;
+
+	int32 Concurrency = 0;
+	double SliceBudgetMs = 0.0;
+	double BudgetTokensMs = 0.0;
+	int32 NumConsecutiveSkips = 0;
+	bool bReleasing = false;
+
+	FNavRebuildGovernorStats Stats;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Nav_TileCacheSubsystem.generated.h"
+
+class ANavigationData;
+class ANav_CachedRecastNavMesh;
+class ARecastNavMesh;
+
+// 타일 캐시 통계 (AIStudy.NavCache.Report). 마지막 전체 재빌드 기준
+struct FNavTileCacheStats
+{
+	int32 NumRestoredTiles = 0;
+	int32 NumRestoredColumns = 0;
+	// 캐시에 있었지만 입력 해시가 달라 다시 빌드한 타일 열
+	int32 NumRejectedColumns = 0;
+	// 복원 뒤 빌드 대기열에 남은 타일 열
+	int32 NumQueuedColumns = 0;
+	// 복원 타일에 들어온 더티 중 입력이 그대로라 건너뛴 수
+	int32 NumSkippedDirtyColumns = 0;
+	double LoadMs = 0.0;
+	// 전체 재빌드 시작부터 생성 완료까지 (경로 탐색 가능 시점)
+	double TimeToPathableMs = 0.0;
+	int32 NumSavedTiles = 0;
+	int64 SavedBytes = 0;
+	double SaveMs = 0.0;
+	bool bWarm = false;
+};
+
+// 런타임에 생성한 Recast 타일을 디스크에 저장해 두고 다음 실행에서 다시 붙이는 서브시스템.
+// 타일 열(X, Y)마다 에이전트/해상도 파라미터와 열에 닿는 내비 옥트리 요소(충돌 지오메트리, 내비 모디파이어)의 해시를 키로 쓰고,
+// 전체 재빌드 때 해시가 같은 열은 메모리 매핑한 캐시 파일에서 Detour 타일을 복사해 붙이고 빌드하지 않는다.
+// 생성이 끝날 때마다 Saved/NavTileCache/<맵>_<내비메시>.navtiles에 현재 타일을 다시 쓴다.
+// ANav_CachedRecastNavMesh의 생성기가 부른다.
+UCLASS()
+class AISTUDY_API UNav_TileCacheSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 캐시 파일에서 Columns 중 입력 해시가 같은 열의 타일을 붙이고 복원한 열을 돌려준다
+	void RestoreTiles(ANav_CachedRecastNavMesh& NavMesh, const TSet<FIntPoint>& Columns, TSet<FIntPoint>& OutRestored);
+	// 복원 뒤 빌드할 타일 열 수. 0이면 다음 틱에 생성 완료를 알린다
+	void OnBuildQueued(ANav_CachedRecastNavMesh& NavMesh, int32 NumQueuedColumns);
+
+	bool HasRestoredTiles(const ARecastNavMesh& NavMesh) const;
+	// 복원한 열의 입력이 캐시를 쓴 때와 같은지. 바뀌었으면 복원 목록에서 빼고 false (다시 빌드된다)
+	bool IsRestoredTileUnchanged(const ARecastNavMesh& NavMesh, const FIntPoint& Column);
+
+	// 내비메시의 현재 타일을 캐시 파일로 쓴다
+	bool SaveCache(const ARecastNavMesh& NavMesh);
+	FString GetCachePath(const ARecastNavMesh& NavMesh) const;
+	// 모든 캐시 파일 삭제 (콜드 시작 측정용)
+	static void ClearCache();
+
+	const FNavTileCacheStats& GetStats() const { return Stats; }
+	void LogReport() const;
+
+	// UTickableWorldSubsystem
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FNavMeshState
+	{
+		TWeakObjectPtr<ARecastNavMesh> NavMesh;
+		// 복원한 열과 캐시에 기록된 입력 해시
+		TMap<FIntPoint, uint32> Restored;
+		// 마지막 전체 재빌드가 다룬 열 (타일이 없는 빈 열도 캐시에 남겨 다음에 건너뛴다)
+		TSet<FIntPoint> BuildColumns;
+		double BuildStartTime = 0.0;
+		double LastSaveTime = 0.0;
+		bool bWaitingForPathable = false;
+		// 빌드 없이 캐시만으로 준비됨 (다시 쓸 것이 없다)
+		bool bRestoredOnly = false;
+		bool bSaveRequested = false;
+	};
+
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+	// 빌드 중이거나 더티 영역/거버너가 미룬 타일이 있으면 타일과 입력 해시가 어긋날 수 있으므로 저장을 미룬다
+	bool CanSave(const ARecastNavMesh& NavMesh) const;
+
+	// 내비메시의 config 생성 파라미터, 원점, 엔진/Detour 버전 해시. 다르면 캐시 전체를 버린다
+	uint32 ComputeParamsHash(const ARecastNavMesh& NavMesh) const;
+	uint32 ComputeColumnHash(const ARecastNavMesh& NavMesh, const FIntPoint& Column) const;
+	FBox GetColumnBounds(const ARecastNavMesh& NavMesh, const FIntPoint& Column) const;
+
+	TMap<TObjectKey<ARecastNavMesh>, FNavMeshState> States;
+	// 캐시만으로 준비된 내비메시. 재빌드 호출 안에서 알리지 않고 다음 틱에 알린다
+	TArray<TWeakObjectPtr<ANav_CachedRecastNavMesh>> PendingFinished;
+	FNavTileCacheStats Stats;
+	FDelegateHandle NavGenerationHandle;
+};
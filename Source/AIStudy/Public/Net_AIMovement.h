@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "Net_AIMovement.generated.h"
+
+class ACharacter;
+struct FLifetimeProperty;
+
+// AI 에이전트용 간결한 이동 복제 데이터.
+// 위치/속도는 cm 단위 정수, 요는 1바이트로 양자화한다. 서버에서 미리 양자화해 두므로 값이 실제로 바뀐 경우에만 다시 보낸다.
+// 기울기(Pitch/Roll), 이동 모드, 기반(Based) 이동, 루트 모션은 보내지 않는다 (내비메시 위를 걷는 AI에는 필요 없다).
+USTRUCT()
+struct AISTUDY_API FNet_AIMovement
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY()
+	float Yaw = 0.0f;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FNet_AIMovement> : public TStructOpsTypeTraitsBase2<FNet_AIMovement>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+namespace NetAIMovement
+{
+	// 캐릭터 기본 이동 복제(FRepMovement와 ACharacter의 이동 관련 속성)를 끈다. GetLifetimeReplicatedProps에서 Super 다음에 호출
+	AISTUDY_API void DisableDefaultMovementReplication(const UClass* ThisClass, TArray<FLifetimeProperty>& OutLifetimeProps);
+
+	// 서버: 현재 자세를 양자화해 담는다 (PreReplication에서 호출)
+	AISTUDY_API FNet_AIMovement Capture(const ACharacter& Character);
+
+	// 클라이언트: 받은 값을 ReplicatedMovement에 옮기고 엔진의 시뮬레이티드 프록시 보정(스무딩)을 그대로 탄다
+	AISTUDY_API void Apply(ACharacter& Character, const FNet_AIMovement& Movement);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Chaser_AIController.h"
+#include "Net_ChaserStateComponent.generated.h"
+
+class APlayerController;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnChaserStateReplicated, EAIState, NewState);
+
+// 추적자의 EAIState를 가까운 연결에만 복제하는 컴포넌트.
+// COND_NetGroup으로 등록되어 같은 이름의 넷 조건 그룹에 들어간 플레이어 컨트롤러에만 복제된다.
+// 그룹 가입/탈퇴는 UNet_ReplicationGraph가 거리 버킷을 갱신할 때 함께 한다.
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class AISTUDY_API UNet_ChaserStateComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UNet_ChaserStateComponent();
+
+	// 서버: 컨트롤러 상태를 옮긴다 (소유 폰의 PreReplication에서 호출)
+	void SetState(EAIState NewState) { State = NewState; }
+	EAIState GetState() const { return State; }
+
+	// 서버: 이 플레이어에게 상태를 보낼지 (넷 조건 그룹 가입/탈퇴)
+	void SetRelevantTo(APlayerController* PlayerController, bool bRelevant) const;
+
+	// 클라이언트: 상태를 받았을 때 (애님/이펙트용)
+	UPROPERTY(BlueprintAssignable, Category = "AI")
+	FOnChaserStateReplicated OnStateReplicated;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+private:
+	UFUNCTION()
+	void OnRep_State();
+
+	UPROPERTY(ReplicatedUsing = OnRep_State)
+	EAIState State = EAIState::Idle;
+
+	// 컴포넌트마다 하나인 넷 조건 그룹 이름
+	FName NetGroup;
+};
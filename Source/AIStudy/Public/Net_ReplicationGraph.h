@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "Net_ReplicationGraph.generated.h"
+
+class UNet_ChaserStateComponent;
+
+// 데디케이티드 서버용 복제 그래프.
+// UBasicReplicationGraph의 2D 격자 공간화 노드(거리 컬링)와 항상 관련 노드 위에,
+// AI 폰(RVO/추적자/순찰자)을 연결마다 시점과의 거리로 근/중/원 버킷에 나눠 복제 주기를 늘린다.
+// 추적자 상태(UNet_ChaserStateComponent)는 AIStudy.Net.StateRadius 안의 연결에만 복제한다.
+//
+// 루프백 검증 (서버 틱 ms와 클라이언트별 bytes/s를 AIStudy.Net.ReportInterval마다 로그로 남긴다):
+//   서버   UnrealEditor-Cmd AIStudy.uproject /Game/ThirdPerson/Maps/ThirdPersonMap -server -log -unattended
+//            -ExecCmds="AIStudy.Net.ReportInterval 5, AIStudy.Net.SpawnTestAgents 300"
+//   클라   UnrealEditor-Cmd AIStudy.uproject 127.0.0.1 -game -nullrhi -nosound -unattended -log  (클라이언트 수만큼)
+// 비교 기준은 -ini:Engine:[/Script/OnlineSubsystemUtils.IpNetDriver]:ReplicationDriverClassName= 로 그래프를 끈 실행.
+UCLASS(Transient, Config = Engine)
+class AISTUDY_API UNet_ReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	// 서버 프레임/복제 시간과 연결별 송신량 로그
+	void LogReport() const;
+
+	// UReplicationGraph
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+private:
+	struct FAIPawnEntry
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		// 추적자면 상태 컴포넌트 (아니면 null)
+		TWeakObjectPtr<UNet_ChaserStateComponent> ChaserState;
+	};
+
+	// 거리 버킷 대상 (AI가 조종하는 순찰자를 위해 플레이어 템플릿 클래스도 포함)
+	static bool IsAIPawnClass(const UClass* Class);
+	// 클래스 단위로 AI 컬링 거리를 주는 AI 전용 폰 클래스 (RVO/추적자와 그 블루프린트 하위 클래스)
+	static bool IsAIOnlyPawnClass(const UClass* Class);
+
+	// 연결별 거리 버킷(복제 주기)과 추적자 상태 그룹 갱신
+	void UpdateAIBuckets();
+
+	TArray<FAIPawnEntry> AIPawns;
+	float TimeUntilBucketUpdate = 0.0f;
+
+	// 버킷별 (연결, 폰) 수. 마지막 갱신 기준
+	int32 BucketPopulation[3] = {};
+
+	// 보고 구간 누적
+	double ReplicateSeconds = 0.0;
+	double FrameMilliseconds = 0.0;
+	int32 NumReportFrames = 0;
+	float TimeUntilReport = 0.0f;
+};
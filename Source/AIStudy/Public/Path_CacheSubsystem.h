@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "UObject/ObjectKey.h"
+#include "Path_CacheSubsystem.generated.h"
+
+class ANavigationData;
+
+// 양자화된 시작/끝 위치와 쿼리 필터로 만든 경로 캐시 키
+struct FPathCacheKey
+{
+	FIntVector Start = FIntVector::ZeroValue;
+	FIntVector End = FIntVector::ZeroValue;
+	TObjectKey<UClass> FilterClass;
+	TObjectKey<const ANavigationData> NavData;
+
+	bool operator==(const FPathCacheKey& Other) const
+	{
+		return Start == Other.Start && End == Other.End && FilterClass == Other.FilterClass && NavData == Other.NavData;
+	}
+
+	friend uint32 GetTypeHash(const FPathCacheKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.Start), GetTypeHash(Key.End));
+		Hash = HashCombine(Hash, GetTypeHash(Key.FilterClass));
+		return HashCombine(Hash, GetTypeHash(Key.NavData));
+	}
+};
+
+// 같은 두 지점을 오가는 순찰 경로를 재사용하기 위한 캐시.
+// 경로 객체(FNavPath)를 그대로 공유하고, 캐시한 경로는 내비 데이터의 활성 경로로 등록해
+// 경로 통로(corridor)가 지나는 내비메시 타일이 다시 빌드될 때만 무효화된다(RuntimeGeneration=Dynamic 대응).
+UCLASS()
+class AISTUDY_API UPath_CacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 캐시된 유효한 경로 (없으면 nullptr)
+	FNavPathSharedPtr FindPath(const ANavigationData& NavData, const FVector& Start, const FVector& End, TSubclassOf<UNavigationQueryFilter> FilterClass);
+
+	// 새로 찾은 경로를 캐시에 추가
+	void AddPath(const ANavigationData& NavData, const FVector& Start, const FVector& End, TSubclassOf<UNavigationQueryFilter> FilterClass, FNavPathSharedPtr Path);
+
+	void Flush();
+
+	int32 GetNumEntries() const { return Entries.Num(); }
+	uint64 GetNumHits() const { return NumHits; }
+	uint64 GetNumMisses() const { return NumMisses; }
+	float GetHitRate() const { return (NumHits + NumMisses) > 0 ? static_cast<float>(NumHits) / static_cast<float>(NumHits + NumMisses) : 0.0f; }
+	SIZE_T GetAllocatedSize() const { return AllocatedBytes; }
+
+	// UWorldSubsystem
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEntry
+	{
+		FNavPathSharedPtr Path;
+		FDelegateHandle ObserverHandle;
+		SIZE_T Bytes = 0;
+	};
+
+	FPathCacheKey MakeKey(const ANavigationData& NavData, const FVector& Start, const FVector& End, TSubclassOf<UNavigationQueryFilter> FilterClass) const;
+	void RemoveEntry(const FPathCacheKey& Key);
+	void OnPathEvent(FNavigationPath* Path, ENavPathEvent::Type Event);
+	void UpdateStats() const;
+
+	TMap<FPathCacheKey, FEntry> Entries;
+	// 경로 이벤트에서 키를 찾기 위한 역색인
+	TMap<const FNavigationPath*, FPathCacheKey> PathToKey;
+	// 추가 순서 (가장 오래된 항목부터 제거)
+	TArray<FPathCacheKey> InsertionOrder;
+
+	uint64 NumHits = 0;
+	uint64 NumMisses = 0;
+	SIZE_T AllocatedBytes = 0;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "AITypes.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Path_RequestSubsystem.generated.h"
+
+class AAIController;
+class ANavigationData;
+class UNavigationQueryFilter;
+
+// 경로 요청 우선순위 (값이 클수록 먼저 처리)
+UENUM(BlueprintType)
+enum class EPathRequestPriority : uint8
+{
+	Patrol,
+	Normal,
+	Chase,
+	MAX UMETA(Hidden)
+};
+
+// 비동기 경로 요청이 끝났을 때 호출 (이동 시작 성공/실패, 이미 도착). 같은 컨트롤러의 새 요청으로 교체되면 호출되지 않는다
+DECLARE_DELEGATE_OneParam(FOnPathRequestFinished, EPathFollowingRequestResult::Type /*Result*/);
+
+// 누적 카운터 (벤치마크/디버그 출력용)
+struct FPathRequestCounters
+{
+	uint64 Queued = 0;
+	uint64 Served = 0;
+	uint64 Dropped = 0;
+	uint64 Deduped = 0;
+	double TotalLatencySeconds = 0.0;
+
+	double GetAverageLatencyMs() const { return Served > 0 ? (TotalLatencySeconds / Served) * 1000.0 : 0.0; }
+};
+
+// 모든 AI의 경로 요청을 모아 중복을 제거하고, 프레임당 시간 예산 안에서
+// 내비게이션 시스템의 비동기 경로 API(FindPathAsync)로 보내는 월드 서브시스템.
+// 목표가 임계 거리 이상 움직였을 때만 다시 요청하고, 추적 요청을 순찰보다 먼저 처리한다.
+UCLASS()
+class AISTUDY_API UPath_RequestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 액터를 향한 이동 요청. bObserveGoal이면 MoveToActor처럼 경로가 목표 이동을 따라간다.
+	// bAllowPartialPath는 MoveToActor/MoveToLocation의 같은 인자처럼 쿼리와 경로 추종 모두에 적용된다.
+	bool RequestMoveToActor(AAIController* Controller, AActor* GoalActor, float AcceptanceRadius, EPathRequestPriority Priority,
+		bool bObserveGoal = false, FOnPathRequestFinished OnFinished = FOnPathRequestFinished(), bool bAllowPartialPath = true);
+
+	// 위치를 향한 이동 요청. bUsePathCache면 UPath_CacheSubsystem에서 같은 구간의 경로를 재사용한다.
+	bool RequestMoveToLocation(AAIController* Controller, const FVector& GoalLocation, float AcceptanceRadius, EPathRequestPriority Priority,
+		FOnPathRequestFinished OnFinished = FOnPathRequestFinished(), bool bUsePathCache = false, bool bAllowPartialPath = true);
+
+	// 대기/진행 중인 요청 취소 (StopMovement와 함께 호출)
+	void CancelRequest(AAIController* Controller);
+
+	const FPathRequestCounters& GetCounters() const { return Counters; }
+	int32 GetNumQueued() const;
+	int32 GetNumInFlight() const { return InFlight.Num(); }
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 요청자별 최신 요청. 큐에는 요청자만 들어가고 목표는 여기서 덮어써 자연스럽게 합쳐진다.
+	struct FRequesterState
+	{
+		TWeakObjectPtr<AActor> GoalActor;
+		FVector GoalLocation = FVector::ZeroVector;
+		FVector LastRequestedGoal = FVector::ZeroVector;
+		float AcceptanceRadius = 0.0f;
+		EPathRequestPriority Priority = EPathRequestPriority::Normal;
+		FOnPathRequestFinished OnFinished;
+		// 경로 캐시에 넣을 때 사용하는 쿼리 정보
+		TWeakObjectPtr<const ANavigationData> QueryNavData;
+		TSubclassOf<UNavigationQueryFilter> QueryFilterClass;
+		FVector QueryStart = FVector::ZeroVector;
+		double QueuedTime = 0.0;
+		uint32 InFlightQueryId = 0;
+		bool bObserveGoal = false;
+		bool bUsePathCache = false;
+		bool bAllowPartialPath = true;
+		bool bQueued = false;
+		bool bHasRequested = false;
+	};
+
+	bool RequestMoveInternal(AAIController* Controller, AActor* GoalActor, const FVector& GoalLocation, float AcceptanceRadius,
+		EPathRequestPriority Priority, bool bObserveGoal, bool bUsePathCache, bool bAllowPartialPath, FOnPathRequestFinished&& OnFinished);
+
+	enum class EDispatchResult : uint8
+	{
+		Completed,	// 캐시/계층 경로로 바로 이동했거나 실패로 끝남
+		QuerySent,	// 비동기 쿼리를 보냄
+		Deferred,	// 계층 탐색을 돌릴 예산이 모자라 다음 프레임으로 미룸
+	};
+
+	// 큐에서 꺼낸 요청 하나를 처리. 게임 스레드에서 동기로 도는 계층 탐색은 평균 비용이 RemainingSeconds 안일 때만 한다.
+	// bSynchronous면 (AI 기록/재생 중) 비동기 쿼리 대신 FindPathSync로 찾아 바로 이동을 시작한다
+	EDispatchResult DispatchRequest(const TWeakObjectPtr<AAIController>& Requester, double RemainingSeconds, bool bSynchronous);
+	void OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	// 탐색 결과로 경로 캐시에 넣고 이동을 시작 (실패면 요청 실패)
+	void CompletePath(const TWeakObjectPtr<AAIController>& Requester, FRequesterState& State, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	// 찾은(또는 캐시된) 경로로 이동을 시작하고 요청을 완료
+	void StartMove(AAIController* Controller, FRequesterState& State, FNavPathSharedPtr Path);
+	void FinishRequest(FRequesterState& State, EPathFollowingRequestResult::Type Result);
+	void DropLowestPriority();
+
+	TMap<TWeakObjectPtr<AAIController>, FRequesterState> Requesters;
+	TArray<TWeakObjectPtr<AAIController>> Queues[static_cast<int32>(EPathRequestPriority::MAX)];
+	TMap<uint32, TWeakObjectPtr<AAIController>> InFlight;
+
+	FPathRequestCounters Counters;
+	double NextCleanupTime = 0.0;
+};
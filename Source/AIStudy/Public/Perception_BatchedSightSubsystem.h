@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "Perception_BatchedSightSubsystem.generated.h"
+
+class AChaser_AIController;
+
+// 누적 시야 통계 (AIStudy.Sight.Report)
+struct FBatchedSightStats
+{
+	uint64 NumTraces = 0;
+	uint64 NumOverruns = 0;
+	uint64 NumDetections = 0;
+	double TotalLatency = 0.0;
+	double MaxLatency = 0.0;
+};
+
+// 엔진 시야 감각 대신 추적자 시야를 일괄 비동기 트레이스로 판정하는 서브시스템.
+// 관찰자마다 공간 해시로 주변 추적 대상을 찾아 거리/시야각 검사를 통과한 쌍만 모으고,
+// 거리와 마지막 확인 이후 시간으로 우선순위를 매겨 프레임당 예산만큼 AsyncLineTraceByChannel을 보낸다.
+// 결과는 다음 프레임에 도착하며, 보임/안 보임이 바뀐 쌍만 OnTargetPerceptionUpdated 이벤트로 전달한다.
+UCLASS()
+class AISTUDY_API UPerception_BatchedSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterObserver(AChaser_AIController* Observer);
+	void UnregisterObserver(AChaser_AIController* Observer);
+
+	const FBatchedSightStats& GetStats() const { return Stats; }
+	void LogReport() const;
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 관찰자-대상 한 쌍의 상태
+	struct FSightPair
+	{
+		TWeakObjectPtr<AActor> Target;
+		double LastCheckTime = -UE_BIG_NUMBER;
+		// 시야각 안에 들어온 시각 (감지 지연 측정용, 음수면 없음)
+		double CandidateSince = -1.0;
+		uint64 LastGatherFrame = 0;
+		bool bVisible = false;
+		bool bTraceInFlight = false;
+	};
+
+	struct FSightObserver
+	{
+		TWeakObjectPtr<AChaser_AIController> Controller;
+		TMap<TObjectKey<AActor>, FSightPair> Pairs;
+	};
+
+	struct FSightCandidate
+	{
+		int32 ObserverIndex;
+		TObjectKey<AActor> TargetKey;
+		AActor* Target;
+		FVector EyeLocation;
+		float Score;
+	};
+
+	struct FInFlightTrace
+	{
+		TWeakObjectPtr<AChaser_AIController> Controller;
+		TObjectKey<AActor> TargetKey;
+		FVector EyeLocation;
+		FVector TargetLocation;
+	};
+
+	struct FSightEvent
+	{
+		TWeakObjectPtr<AChaser_AIController> Controller;
+		TWeakObjectPtr<AActor> Target;
+		FVector EyeLocation;
+		FVector TargetLocation;
+		bool bSensed;
+	};
+
+	void GatherCandidates(double Now, TArray<FSightCandidate>& OutCandidates);
+	void IssueTraces(TArray<FSightCandidate>& Candidates);
+	void OnTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+	// 트레이스 결과로 쌍의 보임 상태를 갱신하고 바뀌었으면 이벤트를 쌓는다
+	void HandleTraceResult(const FInFlightTrace& Trace, bool bVisible);
+	void DispatchEvents();
+
+	TArray<FSightObserver> Observers;
+	TMap<uint32, FInFlightTrace> InFlight;
+	uint32 NextTraceId = 0;
+	TArray<FSightEvent> PendingEvents;
+	FTraceDelegate TraceDelegate;
+
+	FBatchedSightStats Stats;
+	// 이번 프레임 완료된 감지의 최대 지연 (스탯 표시용)
+	double FrameMaxLatency = 0.0;
+};
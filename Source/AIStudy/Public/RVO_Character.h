@@ -1,19 +1,22 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "Agent_Poolable.h"
+#include "Net_AIMovement.h"
 #include "RVO_Character.generated.h"
 
 UCLASS()
-class AISTUDY_API ARVO_Character : public ACharacter
+class AISTUDY_API ARVO_Character : public ACharacter, public IAgent_Poolable
 {
 	GENERATED_BODY()
 public:
 	// Sets default values for this character's properties
-	ARVO_Character();
+	ARVO_Character(const FObjectInitializer& ObjectInitializer);
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// Called every frame
@@ -26,10 +29,30 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI Movement")
 	void MoveToTarget();
 
-	// RVO 회피 활성화/비활성화
+	// 분대에 들어간다. 같은 이름의 분대는 리더 한 명만 경로를 찾고 나머지는 리더 경로 위 대형 슬롯을 따라간다.
+	// 분대 목표는 리더의 TargetActor이고 흐름장 모드에서는 들어가지 않는다
+	UFUNCTION(BlueprintCallable, Category = "AI Movement")
+	void JoinSquad(FName InSquadName);
+
+	// 분대에서 나와 혼자 TargetActor로 간다
+	UFUNCTION(BlueprintCallable, Category = "AI Movement")
+	void LeaveSquad();
+
+	UFUNCTION(BlueprintPure, Category = "AI Movement")
+	FName GetSquadName() const { return SquadName; }
+
+	// RVO 회피 활성화/비활성화 (bUseORCAAvoidance면 엔진 RVO 대신 ORCA 서브시스템 사용)
 	UFUNCTION(BlueprintCallable, Category = "RVO")
 	void SetRVOAvoidanceEnabled(bool bEnable);
 
+	// IAgent_Poolable
+	virtual void OnPoolAcquired() override;
+	virtual void OnPoolReleased() override;
+
+	// 이동은 FNet_AIMovement로만 복제 (RVO 설정과 캐릭터 이동 모드는 보내지 않는다)
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 public:
 	// 이동할 타겟 액터
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
@@ -41,8 +64,36 @@ public:
 	// RVO 계급 설정
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RVO")
 	float AvoidanceWeight = 0.5f;
+	// true면 엔진 RVO 대신 URVO_ORCASubsystem의 ORCA 풀이로 회피
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RVO")
+	bool bUseORCAAvoidance = false;
+
+	// true면 MoveToActor 대신 UPath_RequestSubsystem을 통해 비동기로 경로를 요청
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
+	bool bUsePathRequestScheduler = true;
+
+	// true면 개별 경로 탐색 대신 같은 목표를 공유하는 흐름장을 따라 이동
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Movement")
+	bool bUseFlowField = false;
+
+	// 시작할 때 들어갈 분대 (None이면 혼자 이동). 실행 중에는 JoinSquad/LeaveSquad로 바꾼다
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Movement")
+	FName SquadName;
+
+	// 흐름장 이동 컴포넌트
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI Movement")
+	class UFlowField_FollowerComponent* FlowFieldFollower;
 
 private:
+	// LOD 등록, 컨트롤러 캐싱, 이동 시작 (BeginPlay와 풀에서 꺼낼 때 공유)
+	void StartAgent();
+
 	// AI 컨트롤러 캐싱
 	class AAIController* AIController;
+
+	UFUNCTION()
+	void OnRep_AIMovement();
+
+	UPROPERTY(ReplicatedUsing = OnRep_AIMovement)
+	FNet_AIMovement AIMovement;
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RVO_ORCASubsystem.generated.h"
+
+class UAgent_MovementComponent;
+
+// ORCA 풀이 입력/출력 (모든 배열은 같은 인덱스)
+struct AISTUDY_API FORCAAgentData
+{
+	TArray<FVector> Positions;
+	TArray<FVector2f> Velocities;
+	TArray<FVector2f> PreferredVelocities;
+	TArray<float> Radii;
+	TArray<float> MaxSpeeds;
+	TArray<float> NeighborDistances;
+
+	// 출력
+	TArray<FVector2f> NewVelocities;
+	TArray<uint8> Constrained;
+
+	void Reset(int32 NumAgents);
+	void Add(const FVector& Position, const FVector2f& Velocity, const FVector2f& PreferredVelocity, float Radius, float MaxSpeed, float NeighborDistance);
+	int32 Num() const { return Positions.Num(); }
+};
+
+// ORCA 풀이 설정
+struct FORCASolverSettings
+{
+	float TimeHorizon = 1.5f;
+	float TimeStep = 1.0f / 30.0f;
+	int32 MaxNeighbors = 10;
+	float MaxHeightDifference = 200.0f;
+	float CellSize = 300.0f;
+	bool bParallel = true;
+};
+
+// 엔진 RVO 대신 ORCA(Optimal Reciprocal Collision Avoidance)로 회피 속도를 계산하는 서브시스템.
+// 등록된 UAgent_MovementComponent의 위치/속도를 SoA로 모으고, 공간 해시로 이웃을 찾은 뒤
+// 에이전트마다 ORCA 반평면에 대한 선형 계획을 ParallelFor로 푼다.
+// 결과는 다음 프레임 이동 단계의 CalcVelocity에서 적용된다.
+UCLASS()
+class AISTUDY_API URVO_ORCASubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterAgent(UAgent_MovementComponent* Agent);
+	void UnregisterAgent(UAgent_MovementComponent* Agent);
+
+	int32 GetNumAgents() const { return Agents.Num(); }
+
+	// 에이전트 데이터만으로 풀이 (벤치마크에서도 사용)
+	static void Solve(FORCAAgentData& Data, const FORCASolverSettings& Settings);
+
+	// 현재 CVar 값으로 채운 설정
+	static FORCASolverSettings GetSettings(float DeltaTime);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAgent_MovementComponent>> Agents;
+
+	FORCAAgentData Data;
+};
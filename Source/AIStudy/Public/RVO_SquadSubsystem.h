@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationSystemTypes.h"
+#include "UObject/ObjectKey.h"
+#include "RVO_SquadSubsystem.generated.h"
+
+class ARVO_Character;
+
+// 누적 분대 통계 (AIStudy.Squad.Report)
+struct FRVOSquadStats
+{
+	// 리더 경로가 바뀌어 통로를 다시 복사한 횟수
+	uint64 NumCorridorUpdates = 0;
+	// 막혀서 개별 경로로 돌린 횟수와 다시 대형으로 돌아온 횟수
+	uint64 NumFallbacks = 0;
+	uint64 NumRejoins = 0;
+	uint64 NumLeaderChanges = 0;
+	// 뒤처진 분대원을 기다리느라 리더 경로 추종을 멈춘 횟수
+	uint64 NumLeaderWaits = 0;
+	uint64 NumSlotRaycasts = 0;
+};
+
+// 같은 목표로 가는 ARVO_Character를 분대로 묶어 경로 탐색을 리더 한 명만 하게 하는 서브시스템.
+// 리더는 평소처럼 경로 스케줄러로 목표를 따라가고 목표가 움직일 때의 재탐색도 리더만 한다.
+// 분대원은 리더 경로를 통로로 복사해 두고, 통로 위 리더 진행 거리에서 슬롯만큼 뒤/옆인 지점을 향해 이동 입력만 넣는다.
+// 회피는 그대로 엔진 RVO나 ORCA가 맡지만 분대원끼리 같은 점을 다투지 않으므로 밀어내기가 줄어든다.
+// 통로에서 너무 멀어지거나 한동안 전진하지 못한 분대원만 개별 경로로 돌리고, 통로 근처로 돌아오면 다시 대형에 넣는다.
+// 막혀서 돌린 분대원은 막힌 곳을 지나 전진한 뒤에만 다시 넣는다.
+UCLASS()
+class AISTUDY_API URVO_SquadSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ARVO_Character::JoinSquad/LeaveSquad에서 부른다. 처음 들어온 캐릭터가 리더가 된다
+	bool AddMember(ARVO_Character* Character, FName SquadName);
+	void RemoveMember(ARVO_Character* Character);
+
+	// 리더 경로를 따라 대형으로 이동하는 중인지 (이때는 개별 경로를 찾지 않는다)
+	bool IsFollowingSquad(const ARVO_Character* Character) const;
+	ARVO_Character* GetLeader(FName SquadName) const;
+
+	int32 GetNumSquads() const { return Squads.Num(); }
+	const FRVOSquadStats& GetStats() const { return Stats; }
+	void LogReport() const;
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FMember
+	{
+		TWeakObjectPtr<ARVO_Character> Character;
+		// 리더 기준 대형 오프셋 (X 통로 뒤쪽, Y 진행 방향 오른쪽)
+		FVector2D SlotOffset = FVector2D::ZeroVector;
+		// 옆 오프셋 중 벽에 막히지 않는 비율
+		float LateralScale = 1.0f;
+		double NextSlotCheckTime = 0.0;
+		// 막힘 판정: 마지막으로 통로를 따라 전진한 진행 거리와 시간 (음수면 다음 틱에 다시 잡는다)
+		float ProgressMark = -1.0f;
+		double ProgressTime = 0.0;
+		double IndividualTime = 0.0;
+		// 막혀서 개별 경로로 돌린 위치. 통로 위에서 이곳을 지나야 다시 대형에 넣는다
+		FVector BlockedLocation = FVector::ZeroVector;
+		bool bBlocked = false;
+		bool bIndividual = false;
+	};
+
+	struct FSquad
+	{
+		// [0]이 리더
+		TArray<FMember> Members;
+		// 리더 경로 사본과 각 점까지의 누적 거리. 리더가 도착해 경로를 놓아도 마지막 통로로 대형을 맞춘다
+		TArray<FVector> Corridor;
+		TArray<float> CorridorDistances;
+		FNavPathWeakPtr CorridorSource;
+		double CorridorTimeStamp = -1.0;
+		double LeaderWaitTime = 0.0;
+		bool bLeaderWaiting = false;
+	};
+
+	void TickSquad(FSquad& Squad, double Now);
+	// 리더 경로가 바뀌었으면 통로를 다시 복사한다
+	void UpdateCorridor(FSquad& Squad);
+	// 슬롯을 향해 이동 입력을 넣고 슬롯보다 뒤처진 거리를 돌려준다 (개별 경로 중이면 0)
+	float SteerMember(FSquad& Squad, FMember& Member, float LeaderDistance, double Now);
+	void SetIndividual(FMember& Member, bool bIndividual, double Now);
+	void SetLeaderWaiting(FSquad& Squad, bool bWaiting, double Now);
+	// 리더가 바뀌면 새 리더만 경로를 요청하고 슬롯을 다시 나눈다
+	void OnLeaderChanged(FSquad& Squad);
+	void AssignSlots(FSquad& Squad) const;
+
+	// 통로 위 가장 가까운 점의 진행 거리와 그 점까지의 거리
+	static float ProjectOntoCorridor(const FSquad& Squad, const FVector& Location, float& OutDistanceToCorridor);
+	static FVector GetCorridorPoint(const FSquad& Squad, float Distance, FVector& OutDirection);
+
+	TMap<FName, FSquad> Squads;
+	TMap<TObjectKey<ARVO_Character>, FName> MemberSquads;
+	FRVOSquadStats Stats;
+};
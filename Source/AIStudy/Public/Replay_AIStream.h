@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 기록되는 액터 종류
+enum class EReplayActorType : uint8
+{
+	Waypoint,
+	RVO,
+	Chaser,
+	Patrol,
+	// ANPC_AIController가 행동 트리로 움직이는 폰
+	NPC,
+	// 플레이어 등 AI가 아닌 폰. 재생 시 기록된 궤적으로 순간이동시킨다
+	Driven,
+};
+
+// 액터 스폰(또는 레벨에 배치된 액터 연결) 이벤트
+struct FReplaySpawnEvent
+{
+	// 1부터 시작. 0은 없음
+	uint32 Id = 0;
+	EReplayActorType Type = EReplayActorType::Waypoint;
+	// 스트림 클래스 테이블 인덱스
+	int32 ClassIndex = INDEX_NONE;
+	int32 ControllerClassIndex = INDEX_NONE;
+	// 비어 있지 않으면 레벨에 배치된 액터로, 재생 시 스폰하지 않고 이름으로 찾는다
+	FString PlacedName;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	TArray<FName> Tags;
+
+	// 종류별 설정. RVO: 목표와 분대, 순찰: A/B 웨이포인트와 그룹
+	uint32 Refs[2] = { 0, 0 };
+	FName Group;
+	// 종류별 bool 속성 (ReplayFlags)
+	uint8 Flags = 0;
+	float Radius = 0.0f;
+	float Weight = 0.0f;
+
+	friend FArchive& operator<<(FArchive& Ar, FReplaySpawnEvent& Event);
+};
+
+namespace ReplayFlags
+{
+	// RVO
+	constexpr uint8 FlowField = 1 << 0;
+	constexpr uint8 ORCA = 1 << 1;
+	constexpr uint8 PathScheduler = 1 << 2;
+	// 순찰
+	constexpr uint8 PredictiveInvoker = 1 << 3;
+	constexpr uint8 Succeeded = 1 << 4;
+}
+
+// 추적자 인지 이벤트
+struct FReplayPerceptionEvent
+{
+	uint32 ChaserId = 0;
+	uint32 TargetId = 0;
+	bool bSensed = false;
+	FVector StimulusLocation = FVector::ZeroVector;
+	FVector ReceiverLocation = FVector::ZeroVector;
+	// 프레임 안에서 몇 번째 인지 콜백이었는지. 재생 시 같은 순번의 콜백 자리에 주입한다
+	uint32 CallIndex = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FReplayPerceptionEvent& Event);
+};
+
+// Driven 액터의 프레임 끝 자세 (바뀐 프레임에만 기록)
+struct FReplayPose
+{
+	uint32 Id = 0;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	friend FArchive& operator<<(FArchive& Ar, FReplayPose& Pose);
+};
+
+// 한 프레임 기록
+struct FReplayFrame
+{
+	float DeltaTime = 0.0f;
+	TArray<FReplaySpawnEvent> Spawns;
+	TArray<uint32> Despawns;
+	TArray<FReplayPose> Poses;
+	TArray<FReplayPerceptionEvent> Perception;
+	// 모든 에이전트의 양자화 위치와 추적자 상태 해시 (분기 감지용)
+	uint32 Checksum = 0;
+	// 스냅샷 프레임이면 에이전트별 양자화 위치 (Id, 위치). 분기한 에이전트를 찾는 데 쓴다
+	TArray<TPair<uint32, FIntVector>> Snapshot;
+
+	friend FArchive& operator<<(FArchive& Ar, FReplayFrame& Frame);
+};
+
+// AI 시뮬레이션 기록 스트림.
+// 시드, AIStudy.* 콘솔 변수, 클래스 테이블과 프레임별 스폰/제거, Driven 궤적, 인지 이벤트, 체크섬을 담는다.
+// 정수는 가변 길이로 쓰고 파일로 저장할 때 전체를 Oodle로 압축한다.
+struct AISTUDY_API FReplay_AIStream
+{
+	static constexpr uint32 Magic = 0x50524941; // 'AIRP'
+	static constexpr uint32 Version = 2;
+
+	// 맵 패키지 이름 (PIE 접두사 제거)
+	FString MapName;
+	int32 Seed = 0;
+	int32 SnapshotInterval = 0;
+	// 기록 시작 시점의 AIStudy.* 콘솔 변수 (이름, 값)
+	TArray<TPair<FString, FString>> CVars;
+	// 클래스 경로 테이블
+	TArray<FString> Classes;
+	TArray<FReplayFrame> Frames;
+
+	// 기록된 콘솔 변수 적용. 서브시스템 초기화 때 읽는 변수도 있으므로 월드를 띄우기 전에 부른다
+	void ApplyCVars() const;
+
+	int32 FindOrAddClass(const UClass* Class);
+	UClass* LoadClass(int32 ClassIndex) const;
+
+	bool SaveToFile(const FString& Path) const;
+	bool LoadFromFile(const FString& Path);
+
+	// 위치 양자화 (cm)
+	static FIntVector Quantize(const FVector& Location);
+
+	friend FArchive& operator<<(FArchive& Ar, FReplay_AIStream& Stream);
+};
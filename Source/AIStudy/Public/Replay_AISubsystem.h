@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Perception/AIPerceptionTypes.h"
+#include "UObject/ObjectKey.h"
+#include "Replay_AIStream.h"
+#include "Replay_AISubsystem.generated.h"
+
+class AChaser_AIController;
+
+// 재생 분기 보고 (AIStudy.Replay.Report)
+struct FReplayDivergence
+{
+	int32 NumFrames = 0;
+	int32 NumReplayedFrames = 0;
+	int32 NumDivergedFrames = 0;
+	int32 FirstDivergedFrame = INDEX_NONE;
+	// 스냅샷 프레임에서 측정한 가장 큰 위치 오차 (cm)와 그 에이전트
+	int32 MaxSnapshotError = 0;
+	uint32 MaxErrorAgent = 0;
+	int32 NumMissingAgents = 0;
+	// 같은 순번의 실시간 콜백이 오지 않아 프레임 끝에 주입한 인지 이벤트 수
+	int32 NumLatePerception = 0;
+};
+
+// AI 시뮬레이션을 결정적으로 기록/재생하는 서브시스템.
+// 기록: 웨이포인트/RVO/추적자/순찰자/행동 트리 NPC와 플레이어 폰의 스폰, 제거, 플레이어 궤적, 추적자 인지 이벤트,
+//       시드와 AIStudy.* 콘솔 변수를 FReplay_AIStream에 모으고 프레임마다 위치/상태 체크섬을 남긴다.
+// 재생: 같은 맵에서 기록된 스폰을 같은 프레임 경계에 재현하고, 플레이어는 기록된 궤적으로 순간이동,
+//       실시간 인지 이벤트는 버리고 기록된 이벤트를 원래 발생한 콜백 자리에 주입한다. 체크섬이 다르면 분기로 집계한다.
+// 기록/재생 중에는 IsDeterministic이 참이 되어 경로 요청, 일괄 시야 트레이스, 계층 비용 재계산이
+// 벽시계 예산과 비동기 완료 시점에 흔들리지 않도록 동기로 처리된다 (내비메시 타일 생성 자체는 대상이 아니다).
+// 헤드리스 재생은 벤치마크 커맨들릿의 -Replay=로 돌린다 (같은 캡처를 코드 변경 전후로 비교).
+UCLASS()
+class AISTUDY_API UReplay_AISubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 기록 시작. 시드로 전역 난수를 다시 초기화하고 이미 있는 에이전트는 이름으로 연결해 둔다
+	void StartRecording(int32 Seed);
+	// 기록을 끝내고 파일로 저장 (경로가 비어 있으면 저장하지 않는다)
+	bool StopRecording(const FString& Path);
+
+	// 재생 시작. 기록된 콘솔 변수와 시드를 적용하고 첫 프레임 스폰을 만든다
+	bool StartReplay(FReplay_AIStream&& InStream);
+	// 재생을 끝내고 분기 결과를 로그로 출력 (결과는 GetDivergence로 계속 볼 수 있다)
+	void StopReplay();
+
+	bool IsRecording() const { return Mode == EMode::Recording; }
+	bool IsReplaying() const { return Mode == EMode::Replaying; }
+	// 기록/재생 중이면 참. 결과가 도착 프레임에 따라 달라지는 비동기 처리는 이때 동기로 돌린다
+	static bool IsDeterministic(const UWorld* World);
+	bool IsReplayFinished() const { return IsReplaying() && CurrentFrame >= Stream.Frames.Num(); }
+	// 재생 중 다음에 돌릴 프레임의 기록된 델타 타임
+	float GetReplayDeltaTime() const;
+	int32 GetNumLiveAgents() const;
+	const FReplay_AIStream& GetStream() const { return Stream; }
+	const FReplayDivergence& GetDivergence() const { return Divergence; }
+	void LogReport() const;
+
+	// 추적자 인지 이벤트 훅. 기록 중이면 콜백 순번과 함께 버퍼에 쌓고,
+	// 재생 중이면 같은 순번에 기록된 이벤트를 주입한 뒤 실시간 이벤트는 막는다
+	bool FilterPerception(AChaser_AIController* Chaser, AActor* Actor, const FAIStimulus& Stimulus);
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EMode : uint8
+	{
+		None,
+		Recording,
+		Replaying,
+	};
+
+	struct FPendingSpawn
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FTransform Transform;
+		bool bPlaced = false;
+	};
+
+	struct FPendingPerception
+	{
+		TWeakObjectPtr<AChaser_AIController> Chaser;
+		TWeakObjectPtr<AActor> Target;
+		FVector StimulusLocation;
+		FVector ReceiverLocation;
+		bool bSensed;
+		uint32 CallIndex;
+	};
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+
+	// 기록: 대기 중인 스폰을 분류해 스폰 이벤트로 쓴다
+	void FlushSpawns(FReplayFrame& Frame);
+	bool MakeSpawnEvent(AActor& Actor, const FTransform& Transform, bool bPlaced, FReplaySpawnEvent& OutEvent);
+	void RecordFrame(float DeltaTime);
+
+	// 재생: 프레임 하나의 스폰/제거/자세를 적용 (월드 틱 전에 불린다)
+	void ApplyFrameStart(const FReplayFrame& Frame);
+	AActor* SpawnFromEvent(const FReplaySpawnEvent& Event);
+	// 순번이 LastCallIndex 이하인, 아직 주입하지 않은 기록 이벤트를 주입
+	void InjectPerception(const FReplayFrame& Frame, uint32 LastCallIndex);
+	void CompareFrame(const FReplayFrame& Frame);
+
+	uint32 GetId(const AActor* Actor) const;
+	AActor* GetActor(uint32 Id) const;
+	// 살아 있는 에이전트의 양자화 위치와 추적자 상태 해시
+	uint32 ComputeChecksum(TArray<TPair<uint32, FIntVector>>* OutSnapshot) const;
+	void Reset();
+
+	EMode Mode = EMode::None;
+	FReplay_AIStream Stream;
+	int32 CurrentFrame = 0;
+
+	// Id - 1 인덱스의 액터 (제거되면 null)
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TMap<TObjectKey<AActor>, uint32> ActorIds;
+	// Driven 액터 Id와 마지막으로 기록한 자세
+	TMap<uint32, FTransform> DrivenPoses;
+
+	TArray<FPendingSpawn> PendingSpawns;
+	TArray<uint32> PendingDespawns;
+	TArray<FPendingPerception> PendingPerception;
+	// 이번 프레임 실시간 인지 콜백 수와 다음에 주입할 기록 이벤트
+	uint32 PerceptionCallIndex = 0;
+	int32 NextPerceptionEvent = 0;
+	bool bInjecting = false;
+
+	FReplayDivergence Divergence;
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+};
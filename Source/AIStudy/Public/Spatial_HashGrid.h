@@ -0,0 +1,158 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// XY 평면 균일 격자 기반 공간 해시.
+// 항목은 안정적인 정수 핸들로 관리하고, 셀이 바뀐 경우에만 버킷을 옮겨 갱신 비용을 줄인다.
+// 쿼리 함수는 읽기 전용이라 Build/Update가 끝난 뒤에는 여러 스레드에서 동시에 호출해도 안전하다.
+struct AISTUDY_API FSpatial_HashGrid
+{
+public:
+	explicit FSpatial_HashGrid(float InCellSize = 500.0f);
+
+	// 모든 항목 제거 후 셀 크기 재설정
+	void Reset(float InCellSize);
+
+	// 위치 배열로 한 번에 다시 구성 (핸들은 배열 인덱스와 같다)
+	void Build(TConstArrayView<FVector> InLocations);
+
+	// 증분 갱신용 항목 추가/제거/이동
+	int32 AddItem(const FVector& Location);
+	void RemoveItem(int32 Handle);
+	void UpdateItem(int32 Handle, const FVector& Location);
+
+	bool IsValidHandle(int32 Handle) const { return Locations.IsValidIndex(Handle) && bActive[Handle]; }
+	const FVector& GetLocation(int32 Handle) const { return Locations[Handle]; }
+	int32 Num() const { return NumActive; }
+	float GetCellSize() const { return CellSize; }
+
+	// Radius 안의 항목을 모두 반환. Predicate(Handle)가 false인 항목은 제외.
+	template<typename PredicateType>
+	void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutHandles, PredicateType&& Predicate) const
+	{
+		const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+		const FIntPoint MinCell = ToCell(Center - FVector(Radius));
+		const FIntPoint MaxCell = ToCell(Center + FVector(Radius));
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				const TArray<int32>* Bucket = Cells.Find(FIntPoint(X, Y));
+				if (!Bucket)
+				{
+					continue;
+				}
+				for (const int32 Handle : *Bucket)
+				{
+					if (FVector::DistSquared(Locations[Handle], Center) <= RadiusSq && Predicate(Handle))
+					{
+						OutHandles.Add(Handle);
+					}
+				}
+			}
+		}
+	}
+
+	void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutHandles) const
+	{
+		QueryRadius(Center, Radius, OutHandles, [](int32) { return true; });
+	}
+
+	// MaxRadius 안에서 가까운 순으로 최대 K개. 중심 셀부터 고리 모양으로 넓혀 가며
+	// 현재 K번째 후보보다 먼 고리에 도달하면 탐색을 멈춘다.
+	template<typename PredicateType>
+	void FindNearest(const FVector& Center, float MaxRadius, int32 K, TArray<int32>& OutHandles, PredicateType&& Predicate) const
+	{
+		OutHandles.Reset();
+		if (K <= 0 || NumActive == 0)
+		{
+			return;
+		}
+
+		TArray<TPair<double, int32>, TInlineAllocator<16>> Best;
+		const double MaxRadiusSq = FMath::Square(static_cast<double>(MaxRadius));
+		const FIntPoint CenterCell = ToCell(Center);
+		const int32 MaxRing = FMath::CeilToInt(MaxRadius / CellSize);
+
+		for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+		{
+			// 이 고리 안의 점까지 가능한 최소 거리가 K번째 후보보다 멀면 종료
+			if (Best.Num() == K)
+			{
+				const double RingMinDist = FMath::Max(0.0, (Ring - 1) * static_cast<double>(CellSize));
+				if (FMath::Square(RingMinDist) > Best.Last().Key)
+				{
+					break;
+				}
+			}
+
+			for (int32 Y = -Ring; Y <= Ring; ++Y)
+			{
+				for (int32 X = -Ring; X <= Ring; ++X)
+				{
+					// 고리의 테두리 셀만 방문
+					if (FMath::Abs(X) != Ring && FMath::Abs(Y) != Ring)
+					{
+						continue;
+					}
+					const TArray<int32>* Bucket = Cells.Find(FIntPoint(CenterCell.X + X, CenterCell.Y + Y));
+					if (!Bucket)
+					{
+						continue;
+					}
+					for (const int32 Handle : *Bucket)
+					{
+						const double DistSq = FVector::DistSquared(Locations[Handle], Center);
+						if (DistSq > MaxRadiusSq || (Best.Num() == K && DistSq >= Best.Last().Key) || !Predicate(Handle))
+						{
+							continue;
+						}
+
+						// 작은 K를 가정한 삽입 정렬
+						int32 InsertIndex = Best.Num();
+						while (InsertIndex > 0 && Best[InsertIndex - 1].Key > DistSq)
+						{
+							--InsertIndex;
+						}
+						Best.Insert(TPair<double, int32>(DistSq, Handle), InsertIndex);
+						if (Best.Num() > K)
+						{
+							Best.Pop(EAllowShrinking::No);
+						}
+					}
+				}
+			}
+		}
+
+		for (const TPair<double, int32>& Entry : Best)
+		{
+			OutHandles.Add(Entry.Value);
+		}
+	}
+
+	int32 FindNearest(const FVector& Center, float MaxRadius) const
+	{
+		TArray<int32> Result;
+		FindNearest(Center, MaxRadius, 1, Result, [](int32) { return true; });
+		return Result.Num() > 0 ? Result[0] : INDEX_NONE;
+	}
+
+private:
+	FIntPoint ToCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+	}
+
+	void AddToCell(const FIntPoint& Cell, int32 Handle);
+	void RemoveFromCell(const FIntPoint& Cell, int32 Handle);
+
+	float CellSize;
+	float InvCellSize;
+	int32 NumActive = 0;
+
+	TArray<FVector> Locations;
+	TArray<FIntPoint> ItemCells;
+	TArray<bool> bActive;
+	TArray<int32> FreeHandles;
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
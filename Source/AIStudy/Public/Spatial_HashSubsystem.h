@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Spatial_HashGrid.h"
+#include "Spatial_HashSubsystem.generated.h"
+
+class APawn;
+
+// 위치 갱신이 끝난 뒤 알림. MaxStep은 이번 갱신에서 가장 많이 움직인 폰의 이동 거리이며,
+// 추적 대상이 새로 생기거나 사라지면 순간 이동과 같게 취급해 아주 큰 값이 된다.
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSpatialHashUpdated, float /*MaxStep*/);
+
+// 월드의 모든 폰 위치를 공간 해시에 유지하는 서브시스템.
+// 매 프레임 위치만 갱신하고 셀이 바뀐 폰만 버킷을 옮긴다.
+// 플레이어가 조종하는 폰과 ChaserTargetTag 태그가 붙은 폰(미끼 등)을 추적 대상으로 취급한다.
+UCLASS()
+class AISTUDY_API USpatial_HashSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 이 태그가 붙은 액터는 플레이어가 아니어도 추적 대상이 된다
+	static const FName ChaserTargetTag;
+
+	// Origin에서 MaxRadius 안의 가장 가까운 추적 대상 (Ignore는 제외)
+	APawn* FindNearestTarget(const FVector& Origin, float MaxRadius, const AActor* Ignore = nullptr) const;
+
+	// Radius 안의 폰 목록
+	void QueryPawnsInRadius(const FVector& Origin, float Radius, TArray<APawn*>& OutPawns, bool bTargetsOnly = false) const;
+
+	// 가까운 순으로 최대 K개의 폰
+	void FindNearestPawns(const FVector& Origin, float MaxRadius, int32 K, TArray<APawn*>& OutPawns, bool bTargetsOnly = false) const;
+
+	// 추적 대상 판정 (플레이어 조종 또는 태그)
+	static bool IsValidTarget(const AActor* Actor);
+
+	int32 GetNumTrackedPawns() const { return Grid.Num(); }
+
+	// 폰 추가/제거. 스폰된 폰은 자동으로 추가되고, 풀에 들어간 폰처럼 파괴되지 않고 빠질 때만 직접 부른다
+	void TrackPawn(APawn* Pawn);
+	void UntrackPawn(const APawn* Pawn);
+
+	FOnSpatialHashUpdated OnUpdated;
+
+	// UTickableWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnActorSpawned(AActor* Actor);
+
+	FSpatial_HashGrid Grid;
+
+	// Grid 핸들로 인덱싱되는 폰 정보
+	TArray<TWeakObjectPtr<APawn>> Pawns;
+	TArray<uint8> TargetFlags;
+
+	// 지난 갱신 이후 추적 대상이 추가되거나 직접 제거되었는지
+	bool bTargetsChanged = false;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TargetPoint_RegistrySubsystem.generated.h"
+
+class ATargetPoint;
+class ULevel;
+
+// 레벨의 ATargetPoint(및 파생 웨이포인트)를 태그 그룹과 공간 셀로 색인하는 서브시스템.
+// 월드 시작 시 한 번 훑고, 이후에는 스폰/파괴와 레벨 스트리밍 추가/제거 이벤트로 증분 갱신한다.
+// 순찰자는 GetAllActorsOfClass 대신 여기서 상수 시간에 웨이포인트를 얻는다.
+UCLASS()
+class AISTUDY_API UTargetPoint_RegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 그룹의 앞쪽 두 웨이포인트 (NAME_None은 모든 웨이포인트를 등록 순서대로)
+	bool GetPatrolPair(FName Group, ATargetPoint*& OutFirst, ATargetPoint*& OutSecond) const;
+
+	// 그룹의 웨이포인트 목록
+	void GetWaypointsInGroup(FName Group, TArray<ATargetPoint*>& OutWaypoints) const;
+
+	// Location에서 Radius 안의 웨이포인트
+	void GetWaypointsNear(const FVector& Location, float Radius, TArray<ATargetPoint*>& OutWaypoints) const;
+
+	void RegisterWaypoint(ATargetPoint* Waypoint);
+	void UnregisterWaypoint(ATargetPoint* Waypoint);
+
+	int32 GetNumWaypoints() const;
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RegisterLevel(ULevel* Level);
+	void UnregisterLevel(ULevel* Level);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+
+	FIntPoint ToCell(const FVector& Location) const;
+
+	// 그룹(태그)별 웨이포인트. NAME_None에는 모든 웨이포인트가 들어간다.
+	TMap<FName, TArray<TWeakObjectPtr<ATargetPoint>>> Groups;
+	// XY 셀별 웨이포인트
+	TMap<FIntPoint, TArray<TWeakObjectPtr<ATargetPoint>>> Cells;
+	// 등록된 웨이포인트와 등록 당시 셀 (중복 확인과 제거용)
+	TMap<TObjectKey<ATargetPoint>, FIntPoint> RegisteredCells;
+	// 레벨 제거 시 되돌리기 위한 레벨별 목록
+	TMap<TWeakObjectPtr<ULevel>, TArray<TWeakObjectPtr<ATargetPoint>>> LevelWaypoints;
+
+	float CellSize = 2000.0f;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};